@@ -10,6 +10,7 @@
 #include <iterator>
 #include <numeric>
 #include "ck/host/types.hpp"
+#include "ck/host/operation/cost_model.hpp"
 
 namespace ck {
 namespace host {
@@ -45,10 +46,24 @@ struct Problem_Conv_Fwd
     // returns the correct device op file for the operation
     std::string GetIncludeHeader() const;
 
-    // returns a list of instances based on the problem spec and provided fusion operations
+    // returns the shape of the implicit GEMM for the cost model
+    operation::GemmShape GetGemmShape() const;
+
+    // returns a list of instances based on the problem spec and provided fusion operations, or
+    // the top_k best ranked by the cost model if top_k is not 0
     std::vector<Solution> GetSolutions(const std::string& arch,
                                        const std::string& prologue,
-                                       const std::string& epilogue) const;
+                                       const std::string& epilogue,
+                                       std::size_t top_k = 0) const;
+
+    // returns the instances ranked best first by the cost model together with their scores,
+    // keeping the top_k best if top_k is not 0
+    std::vector<operation::RankedSolution>
+    GetRankedSolutions(const std::string& arch,
+                       const std::string& prologue,
+                       const std::string& epilogue,
+                       std::size_t top_k                          = 0,
+                       const operation::CostModelWeights& weights = {}) const;
 };
 
 } // namespace conv
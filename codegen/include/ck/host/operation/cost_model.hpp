@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "ck/host/types.hpp"
+#include "ck/host/operation/gemm.hpp"
+
+namespace ck {
+namespace host {
+namespace operation {
+
+// hardware limits the cost model needs, per compute unit
+struct ArchProperties
+{
+    std::size_t num_cu             = 0;
+    std::size_t simds_per_cu       = 4;
+    std::size_t wave_size          = 64;
+    std::size_t max_waves_per_simd = 8;
+    // unified vector registers per lane available to the waves of one SIMD
+    std::size_t vgprs_per_simd = 512;
+    std::size_t lds_bytes      = 65536;
+};
+
+// returns the properties of an xdlops arch, throws for unknown archs
+ArchProperties GetArchProperties(const std::string& arch);
+
+// shape of the (implicit) GEMM a solution computes. The contiguous lengths give the length of
+// the dimension of each tensor that is contiguous in memory, or 0 if it is strided, and are
+// checked against the vector dimension and width of the block transfers.
+struct GemmShape
+{
+    std::size_t M     = 0;
+    std::size_t N     = 0;
+    std::size_t K     = 0;
+    std::size_t batch = 1;
+
+    std::size_t a_contiguous_m = 0;
+    std::size_t a_contiguous_k = 0;
+    std::size_t b_contiguous_n = 0;
+    std::size_t b_contiguous_k = 0;
+    std::size_t e_contiguous_n = 0;
+
+    DataType ADataType = DataType::Half;
+    DataType BDataType = DataType::Half;
+    DataType EDataType = DataType::Half;
+};
+
+// Exponents of the terms of the cost model, see SolutionScore. The defaults weigh every term
+// equally; fit them to measured throughput with a linear regression of log(TFlops) against the
+// logs of the terms.
+struct CostModelWeights
+{
+    double cu_utilization = 1.0;
+    double tile_waste     = 1.0;
+    double k_loop         = 1.0;
+    double occupancy      = 1.0;
+    double data_reuse     = 1.0;
+    double vector_width   = 1.0;
+};
+
+// Analytical estimate of how well a tile configuration suits a problem. Every term is an
+// efficiency in [0, 1] and score is their weighted product, so higher is better:
+//
+//   cu_utilization  tiles / (CUs * rounds of tiles), the last round of tiles leaves CUs idle
+//   tile_waste      useful fraction of the M x N x K volume after padding to whole tiles
+//   k_loop          num_k_loops / (num_k_loops + 2), the pipeline prologue and the C shuffle
+//                   epilogue are amortized over the main loop
+//   occupancy       min(1, waves per SIMD / 2), with the waves limited by LDS and registers
+//                   estimated from the tile sizes; XDL GEMMs hide latency with 2 waves per SIMD
+//   data_reuse      min(1, MPerBlock * NPerBlock / (MPerBlock + NPerBlock) / 64), flops per
+//                   byte loaded into LDS relative to a 128 x 128 tile
+//   vector_width    bytes per global vector access relative to 16 bytes, averaged over A, B
+//                   and E
+//
+// A configuration whose vector width does not divide the contiguous length of its vector
+// dimension fails IsSupportedArgument; it is marked unsupported and scores 0.
+struct SolutionScore
+{
+    bool supported         = true;
+    double cu_utilization  = 0;
+    double tile_waste      = 0;
+    double k_loop          = 0;
+    double occupancy       = 0;
+    double data_reuse      = 0;
+    double vector_width    = 0;
+    std::size_t lds_bytes  = 0;
+    std::size_t vgprs      = 0;
+    std::size_t num_tiles  = 0;
+    std::size_t waves_simd = 0;
+    double score           = 0;
+};
+
+SolutionScore ScoreSolution(const TileDesc& tile,
+                            const BlockTransferDesc& a_block_transfer,
+                            const BlockTransferDesc& b_block_transfer,
+                            const CBlockTransferDesc& c_block_transfer,
+                            const GemmShape& shape,
+                            const ArchProperties& arch,
+                            const CostModelWeights& weights = {});
+
+// a solution and the score it was ranked by
+struct RankedSolution
+{
+    Solution solution;
+    SolutionScore score;
+};
+
+// sorts solutions best first by score, keeping the original order for equal scores, and keeps
+// the top_k best if top_k is not 0
+std::vector<RankedSolution> RankSolutions(std::vector<RankedSolution> solutions,
+                                          std::size_t top_k);
+
+} // namespace operation
+} // namespace host
+} // namespace ck
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/operation/cost_model.hpp"
+#include "ck/host/utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace ck {
+namespace host {
+namespace operation {
+
+ArchProperties GetArchProperties(const std::string& arch)
+{
+    static const std::unordered_map<std::string, std::size_t> num_cus = {
+        {"gfx908", 120}, {"gfx90a", 110}, {"gfx940", 228}, {"gfx942", 304}};
+
+    auto it = num_cus.find(arch);
+    if(it == num_cus.end())
+        throw std::runtime_error("Unknown arch for cost model: " + arch);
+
+    ArchProperties result;
+    result.num_cu = it->second;
+    return result;
+}
+
+static std::size_t GetElementBytes(DataType dt)
+{
+    switch(dt)
+    {
+    case DataType::Half: return 2;
+    case DataType::Float: return 4;
+    case DataType::Int8: return 1;
+    case DataType::Int32: return 4;
+    }
+    throw std::runtime_error("Incorrect data type");
+}
+
+// fraction of a 16 byte access the vector width uses, or 0 if the width does not divide the
+// contiguous length of the vector dimension
+static double GetVectorEfficiency(std::size_t scalar_per_vector,
+                                  std::size_t contiguous_length,
+                                  std::size_t element_bytes)
+{
+    if(scalar_per_vector > 1 &&
+       (contiguous_length == 0 || contiguous_length % scalar_per_vector != 0))
+        return 0;
+    return std::min(1.0, static_cast<double>(scalar_per_vector * element_bytes) / 16);
+}
+
+SolutionScore ScoreSolution(const TileDesc& tile,
+                            const BlockTransferDesc& a_block_transfer,
+                            const BlockTransferDesc& b_block_transfer,
+                            const CBlockTransferDesc& c_block_transfer,
+                            const GemmShape& shape,
+                            const ArchProperties& arch,
+                            const CostModelWeights& weights)
+{
+    SolutionScore result;
+    if(shape.M == 0 || shape.N == 0 || shape.K == 0 || shape.batch == 0)
+    {
+        result.supported = false;
+        return result;
+    }
+
+    const std::size_t m_per_block = tile.m_per_block;
+    const std::size_t n_per_block = tile.n_per_block;
+    const std::size_t k_per_block = tile.k_per_block;
+    const std::size_t block_size  = tile.block_size;
+    const std::size_t a_bytes     = GetElementBytes(shape.ADataType);
+    const std::size_t b_bytes     = GetElementBytes(shape.BDataType);
+    const std::size_t e_bytes     = GetElementBytes(shape.EDataType);
+
+    // CU utilization of the rounds of tiles
+    const std::size_t m_tiles = integer_divide_ceil(shape.M, m_per_block);
+    const std::size_t n_tiles = integer_divide_ceil(shape.N, n_per_block);
+    const std::size_t k_loops = integer_divide_ceil(shape.K, k_per_block);
+    result.num_tiles          = shape.batch * m_tiles * n_tiles;
+    const std::size_t rounds  = integer_divide_ceil(result.num_tiles, arch.num_cu);
+    result.cu_utilization = static_cast<double>(result.num_tiles) / (rounds * arch.num_cu);
+
+    // work wasted on padding to whole tiles
+    result.tile_waste = static_cast<double>(shape.M * shape.N * shape.K) /
+                        (m_tiles * m_per_block * n_tiles * n_per_block * k_loops * k_per_block);
+
+    result.k_loop = static_cast<double>(k_loops) / (k_loops + 2);
+
+    // LDS holds one K slice of the A and B tiles, the registers the fp32 accumulators and the
+    // A and B slices each thread stages between global memory and LDS
+    result.lds_bytes = (m_per_block * a_bytes + n_per_block * b_bytes) * k_per_block;
+    const std::size_t acc_vgprs = m_per_block * n_per_block / block_size;
+    const std::size_t copy_vgprs =
+        integer_divide_ceil(result.lds_bytes, block_size * sizeof(float));
+    result.vgprs = integer_divide_ceil(acc_vgprs + copy_vgprs + 32, 8) * 8;
+
+    const std::size_t waves_per_block = integer_divide_ceil(block_size, arch.wave_size);
+    const std::size_t block_waves_per_simd =
+        integer_divide_ceil(waves_per_block, arch.simds_per_cu);
+    const std::size_t blocks_per_cu =
+        std::min({arch.lds_bytes / result.lds_bytes,
+                  arch.vgprs_per_simd / result.vgprs / block_waves_per_simd,
+                  arch.max_waves_per_simd / block_waves_per_simd});
+    result.waves_simd = blocks_per_cu * block_waves_per_simd;
+    result.occupancy  = std::min(1.0, result.waves_simd / 2.0);
+
+    const double reuse =
+        static_cast<double>(m_per_block * n_per_block) / (m_per_block + n_per_block);
+    result.data_reuse = std::min(1.0, reuse / 64);
+
+    // vector dimension 2 is K, 1 is M for A and N for B
+    const double a_vector = GetVectorEfficiency(
+        a_block_transfer.src_scalar_per_vector,
+        a_block_transfer.src_vec_dim == 2 ? shape.a_contiguous_k : shape.a_contiguous_m,
+        a_bytes);
+    const double b_vector = GetVectorEfficiency(
+        b_block_transfer.src_scalar_per_vector,
+        b_block_transfer.src_vec_dim == 2 ? shape.b_contiguous_k : shape.b_contiguous_n,
+        b_bytes);
+    const double e_vector = GetVectorEfficiency(
+        c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl, shape.e_contiguous_n, e_bytes);
+    result.vector_width = (a_vector + b_vector + e_vector) / 3;
+
+    result.supported = blocks_per_cu > 0 && a_vector > 0 && b_vector > 0 && e_vector > 0;
+    if(!result.supported)
+    {
+        result.score = 0;
+        return result;
+    }
+
+    result.score = std::pow(result.cu_utilization, weights.cu_utilization) *
+                   std::pow(result.tile_waste, weights.tile_waste) *
+                   std::pow(result.k_loop, weights.k_loop) *
+                   std::pow(result.occupancy, weights.occupancy) *
+                   std::pow(result.data_reuse, weights.data_reuse) *
+                   std::pow(result.vector_width, weights.vector_width);
+    return result;
+}
+
+std::vector<RankedSolution> RankSolutions(std::vector<RankedSolution> solutions,
+                                          std::size_t top_k)
+{
+    std::stable_sort(solutions.begin(), solutions.end(), [](const auto& x, const auto& y) {
+        return x.score.score > y.score.score;
+    });
+    if(top_k != 0 && solutions.size() > top_k)
+        solutions.resize(top_k);
+    return solutions;
+}
+
+} // namespace operation
+} // namespace host
+} // namespace ck
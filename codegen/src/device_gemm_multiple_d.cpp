@@ -4,6 +4,7 @@
 
 #include "ck/host/device_gemm_multiple_d/problem.hpp"
 #include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/stringutils.hpp"
 #include "ck/host/utils.hpp"
 #include <algorithm>
 
@@ -17,13 +18,35 @@ std::string Problem::GetIncludeHeader() const
     return "ck/tensor_operation/gpu/device/impl/device_gemm_multiple_d_xdl_cshuffle.hpp";
 }
 
+operation::GemmShape Problem::GetGemmShape() const
+{
+    operation::GemmShape shape;
+    shape.M = this->M;
+    shape.N = this->N;
+    shape.K = this->K;
+    // row-major tensors are contiguous along their second dimension
+    shape.a_contiguous_m = this->TransA ? this->M : 0;
+    shape.a_contiguous_k = this->TransA ? 0 : this->K;
+    shape.b_contiguous_n = this->TransB ? 0 : this->N;
+    shape.b_contiguous_k = this->TransB ? this->K : 0;
+    shape.e_contiguous_n = this->TransE ? 0 : this->N;
+    shape.ADataType      = this->ADataType;
+    shape.BDataType      = this->BDataType;
+    shape.EDataType      = this->EDataType;
+    return shape;
+}
+
 // returns templated instances when provided with a problem specification
 std::vector<Solution> Problem::GetSolutions(const std::string& arch,
                                             const std::string& prologue,
-                                            const std::string& epilogue) const
+                                            const std::string& epilogue,
+                                            std::size_t top_k) const
 {
     if(get_xdlop_archs().count(arch) == 0)
         return {};
+    if(top_k != 0)
+        return Transform(GetRankedSolutions(arch, prologue, epilogue, top_k),
+                         [](const auto& ranked) { return ranked.solution; });
     auto ops = ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle::CreateOperations(
         *this, prologue, epilogue); // obtains vector of instances
     std::vector<Solution> result;
@@ -33,6 +56,34 @@ std::vector<Solution> Problem::GetSolutions(const std::string& arch,
     return result;
 }
 
+// scores the instances with the cost model and returns them best first
+std::vector<operation::RankedSolution>
+Problem::GetRankedSolutions(const std::string& arch,
+                            const std::string& prologue,
+                            const std::string& epilogue,
+                            std::size_t top_k,
+                            const operation::CostModelWeights& weights) const
+{
+    if(get_xdlop_archs().count(arch) == 0)
+        return {};
+    auto ops = ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle::CreateOperations(
+        *this, prologue, epilogue);
+    const auto shape      = GetGemmShape();
+    const auto properties = operation::GetArchProperties(arch);
+    std::vector<operation::RankedSolution> result;
+    std::transform(ops.begin(), ops.end(), std::back_inserter(result), [&](const auto& op) {
+        return operation::RankedSolution{op.ToSolution(),
+                                         operation::ScoreSolution(op.tile_desc,
+                                                                  op.a_block_transfer,
+                                                                  op.b_block_transfer,
+                                                                  op.c_block_transfer,
+                                                                  shape,
+                                                                  properties,
+                                                                  weights)};
+    });
+    return operation::RankSolutions(std::move(result), top_k);
+}
+
 } // namespace device_gemm_multiple_d
 } // namespace host
 } // namespace ck
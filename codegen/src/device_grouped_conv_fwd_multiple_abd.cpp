@@ -4,6 +4,7 @@
 
 #include "ck/host/device_grouped_conv_fwd_multiple_d/conv_fwd_problem.hpp"
 #include "ck/host/device_grouped_conv_fwd_multiple_d/conv_fwd_op.hpp"
+#include "ck/host/stringutils.hpp"
 #include "ck/host/utils.hpp"
 #include <algorithm>
 #include <iostream>
@@ -21,13 +22,38 @@ std::string Problem_Conv_Fwd::GetIncludeHeader() const
            "codegen_device_grouped_conv_fwd_multiple_abd_xdl_cshuffle.hpp";
 }
 
+// the implicit GEMM of each group has M = N * Ho * Wo, N = K and K = C * Y * X
+operation::GemmShape Problem_Conv_Fwd::GetGemmShape() const
+{
+    operation::GemmShape shape;
+    shape.M     = this->N * this->Ho * this->Wo;
+    shape.N     = this->K;
+    shape.K     = this->C * this->Y * this->X;
+    shape.batch = this->G;
+    // vector reads along GEMM K only cover the C of one filter tap
+    const bool a_c_contiguous = this->ALayout == Layout::NHWGC || this->ALayout == Layout::GNHWC;
+    const bool b_c_contiguous = this->BLayout == Layout::GKYXC;
+    const bool e_k_contiguous = this->ELayout == Layout::NHWGK || this->ELayout == Layout::GNHWK;
+    shape.a_contiguous_k      = a_c_contiguous ? this->C : 0;
+    shape.b_contiguous_k      = b_c_contiguous ? this->C : 0;
+    shape.e_contiguous_n      = e_k_contiguous ? this->K : 0;
+    shape.ADataType           = this->ADataType;
+    shape.BDataType           = this->BDataType;
+    shape.EDataType           = this->EDataType;
+    return shape;
+}
+
 // return vector of forward convolution instances when provided with a problem instance
 std::vector<Solution> Problem_Conv_Fwd::GetSolutions(const std::string& arch,
                                                      const std::string& prologue,
-                                                     const std::string& epilogue) const
+                                                     const std::string& epilogue,
+                                                     std::size_t top_k) const
 {
     if(get_xdlop_archs().count(arch) == 0)
         return {};
+    if(top_k != 0)
+        return Transform(GetRankedSolutions(arch, prologue, epilogue, top_k),
+                         [](const auto& ranked) { return ranked.solution; });
     auto ops = ck::host::conv::Operation_Conv_Fwd_Xdl_Cshuffle::CreateOperations(
         *this, prologue, epilogue);
     std::vector<Solution> result;
@@ -37,6 +63,34 @@ std::vector<Solution> Problem_Conv_Fwd::GetSolutions(const std::string& arch,
     return result;
 }
 
+// scores the instances with the cost model and returns them best first
+std::vector<operation::RankedSolution>
+Problem_Conv_Fwd::GetRankedSolutions(const std::string& arch,
+                                     const std::string& prologue,
+                                     const std::string& epilogue,
+                                     std::size_t top_k,
+                                     const operation::CostModelWeights& weights) const
+{
+    if(get_xdlop_archs().count(arch) == 0)
+        return {};
+    auto ops = ck::host::conv::Operation_Conv_Fwd_Xdl_Cshuffle::CreateOperations(
+        *this, prologue, epilogue);
+    const auto shape      = GetGemmShape();
+    const auto properties = operation::GetArchProperties(arch);
+    std::vector<operation::RankedSolution> result;
+    std::transform(ops.begin(), ops.end(), std::back_inserter(result), [&](const auto& op) {
+        return operation::RankedSolution{op.ToSolution(),
+                                         operation::ScoreSolution(op.tile_desc,
+                                                                  op.a_block_transfer,
+                                                                  op.b_block_transfer,
+                                                                  op.c_block_transfer,
+                                                                  shape,
+                                                                  properties,
+                                                                  weights)};
+    });
+    return operation::RankSolutions(std::move(result), top_k);
+}
+
 } // namespace conv
 } // namespace host
 } // namespace ck
@@ -163,25 +163,41 @@ TEST_CASE(test_problem_kernel)
     std::string epilogue = "";
     std::string prologue = "";
 
-    for(auto solution : prob.GetSolutions("gfx90a", prologue, epilogue))
+    auto solutions = prob.GetSolutions("gfx90a", prologue, epilogue);
+    auto headers   = get_headers_for_test();
+
+    // the sources have to outlive the compile as src_file only refers to its content
+    std::vector<std::string> srcs;
+    std::vector<std::vector<rtc::src_file>> kernel_srcs;
+    for(const auto& solution : solutions)
+    {
+        srcs.push_back(ck::host::InterpolateString(gemm_compile_check,
+                                                   {{"include", prob.GetIncludeHeader()},
+                                                    {"template", solution.ToTemplateString()},
+                                                    {"m", std::to_string(prob.M)},
+                                                    {"n", std::to_string(prob.N)},
+                                                    {"k", std::to_string(prob.K)}}));
+    }
+    for(const auto& src : srcs)
+    {
+        kernel_srcs.push_back(headers);
+        kernel_srcs.back().push_back({"main.cpp", src});
+    }
+
+    rtc::compile_options options;
+    options.kernel_name = "f";
+    auto kernels        = rtc::compile_kernels(kernel_srcs, options);
+
+    for(std::size_t i = 0; i < solutions.size(); i++)
     {
-        auto src  = ck::host::InterpolateString(gemm_compile_check,
-                                               {{"include", prob.GetIncludeHeader()},
-                                                {"template", solution.ToTemplateString()},
-                                                {"m", std::to_string(prob.M)},
-                                                {"n", std::to_string(prob.N)},
-                                                {"k", std::to_string(prob.K)}});
-        auto srcs = get_headers_for_test();
-        srcs.push_back({"main.cpp", src});
-        rtc::compile_options options;
-        options.kernel_name = "f";
-        auto k              = rtc::compile_kernel(srcs, options);
-        auto block_size     = solution.GetTemplateParameter<std::size_t>("BlockSize");
-        auto m_per_block    = solution.GetTemplateParameter<std::size_t>("MPerBlock");
-        auto n_per_block    = solution.GetTemplateParameter<std::size_t>("NPerBlock");
-        auto grid_size      = ck::host::integer_divide_ceil(prob.M, m_per_block) *
+        const auto& solution = solutions[i];
+        auto block_size      = solution.GetTemplateParameter<std::size_t>("BlockSize");
+        auto m_per_block     = solution.GetTemplateParameter<std::size_t>("MPerBlock");
+        auto n_per_block     = solution.GetTemplateParameter<std::size_t>("NPerBlock");
+        auto grid_size       = ck::host::integer_divide_ceil(prob.M, m_per_block) *
                          ck::host::integer_divide_ceil(prob.N, n_per_block);
-        k.launch(nullptr, grid_size * block_size, block_size)(a.data(), b.data(), c.data());
+        kernels[i].launch(nullptr, grid_size * block_size, block_size)(
+            a.data(), b.data(), c.data());
 
         CHECK(report(solution, check(rtc::from_gpu(c))));
     }
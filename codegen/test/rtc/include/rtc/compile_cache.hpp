@@ -0,0 +1,52 @@
+#ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_CACHE
+#define GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_CACHE
+
+#include <rtc/filesystem.hpp>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace rtc {
+
+struct src_file;
+
+// On-disk cache of code objects, keyed by a hash of everything that goes into a compile: the
+// compiler command line, the target and the path and content of every source and header.
+//
+// Entries are written to a temporary file and renamed into place, so processes and threads
+// sharing a directory never see partial code objects. Hits refresh the modification time of
+// the entry, and once the directory grows past max_bytes the least recently used entries are
+// removed.
+struct compile_cache
+{
+    fs::path path;
+    std::size_t max_bytes;
+
+    explicit compile_cache(fs::path p, std::size_t max = default_max_bytes());
+
+    // CK_RTC_CACHE_DIR, or empty to disable caching when it is not set
+    static fs::path default_path();
+    // CK_RTC_CACHE_MAX_SIZE in MiB, or 1 GiB
+    static std::size_t default_max_bytes();
+
+    static std::string key(const std::vector<src_file>& srcs,
+                           const std::string& command,
+                           const std::string& target);
+
+    std::optional<std::vector<char>> load(const std::string& k) const;
+    void store(const std::string& k, const std::vector<char>& obj) const;
+
+    // removes the least recently used entries until the cache holds at most max_bytes
+    void evict() const;
+
+    // total size of the entries in bytes
+    std::size_t size() const;
+
+    private:
+    fs::path entry_path(const std::string& k) const;
+};
+
+} // namespace rtc
+
+#endif
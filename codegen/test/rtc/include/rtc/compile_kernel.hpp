@@ -1,6 +1,7 @@
 #ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_KERNEL
 #define GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_KERNEL
 
+#include <rtc/compile_cache.hpp>
 #include <rtc/kernel.hpp>
 #include <rtc/filesystem.hpp>
 #include <string>
@@ -17,11 +18,34 @@ struct compile_options
 {
     std::string flags       = "";
     std::string kernel_name = "main";
+    // compiler command, defaults to CK_RTC_COMPILER or the ROCm clang
+    std::string compiler = "";
+    // offload arch, defaults to the arch of the current device
+    std::string target = "";
+    // code object cache directory, defaults to CK_RTC_CACHE_DIR, caching is disabled when empty
+    fs::path cache_dir = compile_cache::default_path();
 };
 
+std::string compiler();
+
 kernel compile_kernel(const std::vector<src_file>& src,
                       compile_options options = compile_options{});
 
+std::vector<char> compile_code_object(const std::vector<src_file>& src,
+                                      compile_options options = compile_options{});
+
+// Compiles every set of sources with up to jobs compiles running in parallel, with jobs
+// defaulting to CK_RTC_JOBS or the number of hardware threads. Identical sets of sources are
+// compiled once.
+std::vector<std::vector<char>>
+compile_code_objects(const std::vector<std::vector<src_file>>& srcs,
+                     compile_options options = compile_options{},
+                     std::size_t jobs        = 0);
+
+std::vector<kernel> compile_kernels(const std::vector<std::vector<src_file>>& srcs,
+                                    compile_options options = compile_options{},
+                                    std::size_t jobs        = 0);
+
 } // namespace rtc
 
 #endif
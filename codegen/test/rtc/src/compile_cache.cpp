@@ -0,0 +1,217 @@
+#include <rtc/compile_cache.hpp>
+#include <rtc/compile_kernel.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace rtc {
+
+// bump when the layout of the key or of the entries changes
+static const std::string cache_version = "ck-rtc-cache-1";
+static const std::string cache_suffix  = ".co";
+
+namespace {
+
+// 128-bit FNV-1a
+struct hasher
+{
+    using u128 = unsigned __int128;
+
+    u128 state = (u128{0x6c62272e07bb0142ull} << 64) | 0x62b821756295c58dull;
+
+    void bytes(const char* data, std::size_t n)
+    {
+        const u128 prime = (u128{1} << 88) | 0x13bu;
+        for(std::size_t i = 0; i < n; i++)
+        {
+            state ^= static_cast<unsigned char>(data[i]);
+            state *= prime;
+        }
+    }
+
+    // length prefixed, so that the boundaries between fields are part of the hash
+    void field(std::string_view s)
+    {
+        std::uint64_t n = s.size();
+        bytes(reinterpret_cast<const char*>(&n), sizeof(n));
+        bytes(s.data(), s.size());
+    }
+
+    std::string hex() const
+    {
+        static const char* digits = "0123456789abcdef";
+        std::string result(32, '0');
+        for(std::size_t i = 0; i < 32; i++)
+            result[31 - i] = digits[static_cast<unsigned>(state >> (4 * i)) & 0xf];
+        return result;
+    }
+};
+
+struct cache_entry
+{
+    fs::path path;
+    std::size_t size;
+    fs::file_time_type time;
+};
+
+std::vector<cache_entry> list_entries(const fs::path& dir)
+{
+    std::vector<cache_entry> result;
+    std::error_code ec;
+    for(fs::directory_iterator it{dir, ec}, end; not ec and it != end; it.increment(ec))
+    {
+        const auto& p = it->path();
+        if(p.extension() != cache_suffix)
+            continue;
+        // entries can disappear while another process evicts them
+        std::error_code entry_ec;
+        auto size = fs::file_size(p, entry_ec);
+        auto time = fs::last_write_time(p, entry_ec);
+        if(entry_ec)
+            continue;
+        result.push_back({p, static_cast<std::size_t>(size), time});
+    }
+    return result;
+}
+
+} // namespace
+
+compile_cache::compile_cache(fs::path p, std::size_t max) : path(std::move(p)), max_bytes(max)
+{
+    fs::create_directories(path);
+}
+
+fs::path compile_cache::default_path()
+{
+    const char* dir = std::getenv("CK_RTC_CACHE_DIR");
+    if(dir == nullptr)
+        return {};
+    return dir;
+}
+
+std::size_t compile_cache::default_max_bytes()
+{
+    const char* size = std::getenv("CK_RTC_CACHE_MAX_SIZE");
+    if(size == nullptr)
+        return std::size_t{1} << 30;
+    return std::stoull(size) << 20;
+}
+
+std::string compile_cache::key(const std::vector<src_file>& srcs,
+                               const std::string& command,
+                               const std::string& target)
+{
+    // headers are hashed in path order, as the order they are passed in does not change the
+    // compile; sources keep their order as the first one names the output
+    std::vector<const src_file*> headers;
+    std::vector<const src_file*> sources;
+    for(const auto& src : srcs)
+    {
+        if(src.path.extension().string() == ".cpp")
+            sources.push_back(&src);
+        else
+            headers.push_back(&src);
+    }
+    std::sort(headers.begin(), headers.end(), [](const auto* x, const auto* y) {
+        return x->path < y->path;
+    });
+
+    hasher h;
+    h.field(cache_version);
+    h.field(command);
+    h.field(target);
+    for(const auto& files : {sources, headers})
+    {
+        h.field(std::to_string(files.size()));
+        for(const auto* src : files)
+        {
+            h.field(src->path.generic_string());
+            h.field(src->content);
+        }
+    }
+    return h.hex();
+}
+
+fs::path compile_cache::entry_path(const std::string& k) const { return path / (k + cache_suffix); }
+
+std::optional<std::vector<char>> compile_cache::load(const std::string& k) const
+{
+    auto p = entry_path(k);
+    std::ifstream is(p.string(), std::ios::binary);
+    if(not is)
+        return std::nullopt;
+    std::vector<char> obj{std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{}};
+    if(is.bad() or obj.empty())
+        return std::nullopt;
+
+    // mark as recently used
+    std::error_code ec;
+    fs::last_write_time(p, fs::file_time_type::clock::now(), ec);
+    return obj;
+}
+
+void compile_cache::store(const std::string& k, const std::vector<char>& obj) const
+{
+    auto tmp = path / unique_string(k);
+    {
+        std::ofstream os(tmp.string(), std::ios::binary);
+        os.write(obj.data(), obj.size());
+        if(not os.flush())
+        {
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            throw std::runtime_error("Failed to write cache entry: " + tmp.string());
+        }
+    }
+    // rename is atomic, a concurrent store of the same key leaves one complete entry
+    std::error_code ec;
+    fs::rename(tmp, entry_path(k), ec);
+    if(ec)
+    {
+        fs::remove(tmp, ec);
+        return;
+    }
+    evict();
+}
+
+void compile_cache::evict() const
+{
+    auto entries = list_entries(path);
+    std::size_t total = 0;
+    for(const auto& e : entries)
+        total += e.size;
+    if(total <= max_bytes)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const auto& x, const auto& y) {
+        return x.time < y.time;
+    });
+    for(const auto& e : entries)
+    {
+        if(total <= max_bytes)
+            break;
+        std::error_code ec;
+        fs::remove(e.path, ec);
+        // a file that could not be removed still takes up space, a file that another process
+        // already removed does not
+        if(!ec)
+            total -= e.size;
+    }
+}
+
+std::size_t compile_cache::size() const
+{
+    auto entries = list_entries(path);
+    std::size_t total = 0;
+    for(const auto& e : entries)
+        total += e.size;
+    return total;
+}
+
+} // namespace rtc
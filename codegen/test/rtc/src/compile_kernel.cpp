@@ -5,6 +5,12 @@
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <thread>
+#include <unordered_map>
 
 namespace rtc {
 
@@ -55,17 +61,75 @@ void write_string(const std::string& filename, const std::string_view& buffer)
     write_buffer(filename, buffer.data(), buffer.size());
 }
 
-std::string compiler() { return "/opt/rocm/llvm/bin/clang++ -x hip --cuda-device-only"; }
+std::string compiler()
+{
+    const char* cmd = std::getenv("CK_RTC_COMPILER");
+    if(cmd != nullptr)
+        return cmd;
+    return "/opt/rocm/llvm/bin/clang++ -x hip --cuda-device-only";
+}
 // TODO: undo after extracting the codeobj
 // std::string compiler() { return "/opt/rocm/llvm/bin/clang++ -x hip"; }
 
-kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+static void resolve_options(compile_options& options)
 {
-    assert(not srcs.empty());
-    tmp_dir td{"compile"};
+    if(options.compiler.empty())
+        options.compiler = compiler();
+    if(options.target.empty())
+        options.target = get_device_name();
     options.flags += " -I. -O3";
     options.flags += " -std=c++17";
-    options.flags += " --offload-arch=" + get_device_name();
+    options.flags += " --offload-arch=" + options.target;
+}
+
+static std::size_t default_jobs()
+{
+    const char* jobs = std::getenv("CK_RTC_JOBS");
+    if(jobs != nullptr)
+        return std::stoull(jobs);
+    return std::thread::hardware_concurrency();
+}
+
+// calls f(i) for i in [0, n) on up to jobs threads, rethrowing the first exception
+template <class F>
+static void parallel_for(std::size_t n, std::size_t jobs, F f)
+{
+    std::atomic<std::size_t> next{0};
+    std::vector<std::exception_ptr> errors(n);
+    auto worker = [&] {
+        for(auto i = next++; i < n; i = next++)
+        {
+            try
+            {
+                f(i);
+            }
+            catch(...)
+            {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(std::size_t t = 1; t < std::min(std::max<std::size_t>(jobs, 1), n); t++)
+        threads.emplace_back(worker);
+    worker();
+    for(auto& t : threads)
+        t.join();
+
+    for(const auto& e : errors)
+    {
+        if(e)
+            std::rethrow_exception(e);
+    }
+}
+
+// expects resolved options
+static std::vector<char> compile_uncached(const std::vector<src_file>& srcs,
+                                          compile_options options)
+{
+    assert(not srcs.empty());
+    tmp_dir td{"compile"};
     std::string out;
 
     for(const auto& src : srcs)
@@ -83,21 +147,96 @@ kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options
     }
 
     options.flags += " -o " + out;
-    td.execute(compiler() + options.flags);
+    td.execute(options.compiler + " " + options.flags);
 
     auto out_path = td.path / out;
     if(not fs::exists(out_path))
         throw std::runtime_error("Output file missing: " + out);
 
-    auto obj = read_buffer(out_path.string());
+    return read_buffer(out_path.string());
+}
+
+// expects resolved options
+static std::vector<char> compile_cached(const std::vector<src_file>& srcs,
+                                        const compile_options& options,
+                                        const std::string& key)
+{
+    if(options.cache_dir.empty())
+        return compile_uncached(srcs, options);
+
+    compile_cache cache{options.cache_dir};
+    if(auto obj = cache.load(key))
+        return *obj;
+
+    auto obj = compile_uncached(srcs, options);
+    cache.store(key, obj);
+    return obj;
+}
+
+static std::string cache_key(const std::vector<src_file>& srcs, const compile_options& options)
+{
+    return compile_cache::key(srcs, options.compiler + " " + options.flags, options.target);
+}
+
+std::vector<char> compile_code_object(const std::vector<src_file>& srcs, compile_options options)
+{
+    resolve_options(options);
+    if(options.cache_dir.empty())
+        return compile_uncached(srcs, options);
+    return compile_cached(srcs, options, cache_key(srcs, options));
+}
 
-    std::ofstream ofh("obj.o", std::ios::binary);
-    for(auto i : obj)
-        ofh << i;
-    ofh.close();
-    // int s = std::system(("/usr/bin/cp " + out_path.string() + " codeobj.bin").c_str());
-    // assert(s == 0);
+kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+{
+    auto obj = compile_code_object(srcs, options);
     return kernel{obj.data(), options.kernel_name};
 }
 
+std::vector<std::vector<char>>
+compile_code_objects(const std::vector<std::vector<src_file>>& srcs,
+                     compile_options options,
+                     std::size_t jobs)
+{
+    resolve_options(options);
+    if(jobs == 0)
+        jobs = default_jobs();
+
+    std::vector<std::string> keys(srcs.size());
+    parallel_for(srcs.size(), jobs, [&](std::size_t i) { keys[i] = cache_key(srcs[i], options); });
+
+    // compile each distinct set of sources once
+    std::unordered_map<std::string, std::size_t> unique_index;
+    std::vector<std::size_t> unique;
+    std::vector<std::size_t> index(srcs.size());
+    for(std::size_t i = 0; i < srcs.size(); i++)
+    {
+        auto it = unique_index.emplace(keys[i], unique.size()).first;
+        if(it->second == unique.size())
+            unique.push_back(i);
+        index[i] = it->second;
+    }
+
+    std::vector<std::vector<char>> objs(unique.size());
+    parallel_for(unique.size(), jobs, [&](std::size_t u) {
+        objs[u] = compile_cached(srcs[unique[u]], options, keys[unique[u]]);
+    });
+
+    std::vector<std::vector<char>> result(srcs.size());
+    for(std::size_t i = 0; i < srcs.size(); i++)
+        result[i] = objs[index[i]];
+    return result;
+}
+
+std::vector<kernel> compile_kernels(const std::vector<std::vector<src_file>>& srcs,
+                                    compile_options options,
+                                    std::size_t jobs)
+{
+    auto objs = compile_code_objects(srcs, options, jobs);
+    std::vector<kernel> result;
+    result.reserve(objs.size());
+    for(const auto& obj : objs)
+        result.emplace_back(obj.data(), options.kernel_name);
+    return result;
+}
+
 } // namespace rtc
@@ -0,0 +1,161 @@
+#include <rtc/compile_cache.hpp>
+#include <rtc/compile_kernel.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <test.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Stands in for the compiler: copies the source to the output and logs every invocation
+const std::string stub_compiler = R"__ck__(
+out=
+src=
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -o) out="$2"; shift ;;
+        -c) src="$2"; shift ;;
+    esac
+    shift
+done
+echo "$src" >> "$CK_RTC_TEST_LOG"
+cat "$src" > "$out"
+)__ck__";
+
+// Fails without writing an output
+const std::string failing_compiler = R"__ck__(
+echo "$@" >> "$CK_RTC_TEST_LOG"
+exit 1
+)__ck__";
+
+struct stub_env
+{
+    rtc::tmp_dir td{"cache-test"};
+    rtc::fs::path log       = td.path / "log.txt";
+    rtc::fs::path cache_dir = td.path / "cache";
+
+    rtc::compile_options options(const std::string& script) const
+    {
+        auto path = td.path / "compiler.sh";
+        std::ofstream(path.string()) << script;
+        rtc::compile_options result;
+        result.compiler  = "CK_RTC_TEST_LOG=" + log.string() + " sh " + path.string();
+        result.target    = "gfx000";
+        result.cache_dir = cache_dir;
+        return result;
+    }
+
+    std::size_t invocations() const
+    {
+        std::ifstream is(log.string());
+        return std::count(
+            std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{}, '\n');
+    }
+};
+
+std::string to_string(const std::vector<char>& obj) { return {obj.begin(), obj.end()}; }
+
+TEST_CASE(test_cache_hit)
+{
+    stub_env env;
+    auto options = env.options(stub_compiler);
+
+    std::vector<rtc::src_file> srcs{{"main.cpp", "int main() {}\n"}, {"x.hpp", "#define X 1\n"}};
+
+    EXPECT(to_string(rtc::compile_code_object(srcs, options)) == "int main() {}\n");
+    EXPECT(env.invocations() == 1);
+    EXPECT(to_string(rtc::compile_code_object(srcs, options)) == "int main() {}\n");
+    EXPECT(env.invocations() == 1);
+
+    // the order of the headers does not matter
+    std::vector<rtc::src_file> reordered{srcs[1], srcs[0]};
+    rtc::compile_code_object(reordered, options);
+    EXPECT(env.invocations() == 1);
+
+    // headers, flags and target are part of the key
+    auto header_srcs = srcs;
+    header_srcs[1].content = "#define X 2\n";
+    rtc::compile_code_object(header_srcs, options);
+    EXPECT(env.invocations() == 2);
+
+    auto flag_options = options;
+    flag_options.flags += " -DY=1";
+    rtc::compile_code_object(srcs, flag_options);
+    EXPECT(env.invocations() == 3);
+
+    auto target_options   = options;
+    target_options.target = "gfx001";
+    rtc::compile_code_object(srcs, target_options);
+    EXPECT(env.invocations() == 4);
+
+    // without a cache directory every compile runs the compiler
+    auto uncached_options      = options;
+    uncached_options.cache_dir = "";
+    rtc::compile_code_object(srcs, uncached_options);
+    rtc::compile_code_object(srcs, uncached_options);
+    EXPECT(env.invocations() == 6);
+}
+
+TEST_CASE(test_batch_compile)
+{
+    stub_env env;
+    auto options = env.options(stub_compiler);
+
+    std::vector<std::string> contents;
+    for(int i = 0; i < 16; i++)
+        contents.push_back("kernel " + std::to_string(i % 12) + "\n");
+
+    std::vector<std::vector<rtc::src_file>> srcs;
+    for(const auto& content : contents)
+        srcs.push_back({{"main.cpp", content}, {"x.hpp", "#define X 1\n"}});
+
+    auto objs = rtc::compile_code_objects(srcs, options, 4);
+    EXPECT(objs.size() == srcs.size());
+    for(std::size_t i = 0; i < objs.size(); i++)
+        EXPECT(to_string(objs[i]) == contents[i]);
+    // duplicates are compiled once
+    EXPECT(env.invocations() == 12);
+
+    rtc::compile_code_objects(srcs, options, 4);
+    EXPECT(env.invocations() == 12);
+}
+
+TEST_CASE(test_compile_failure)
+{
+    stub_env env;
+    auto options = env.options(failing_compiler);
+
+    std::vector<rtc::src_file> srcs{{"main.cpp", "int main() {}\n"}};
+    EXPECT(test::throws<std::runtime_error>([&] { rtc::compile_code_object(srcs, options); },
+                                            "Output file missing"));
+    EXPECT(test::throws([&] { rtc::compile_code_objects({srcs, srcs}, options, 2); }));
+    EXPECT(rtc::compile_cache{env.cache_dir}.size() == 0);
+}
+
+TEST_CASE(test_cache_eviction)
+{
+    stub_env env;
+    rtc::compile_cache cache{env.cache_dir, 3 * 100};
+
+    const std::vector<char> obj(100, 'x');
+    const auto now = rtc::fs::file_time_type::clock::now();
+
+    for(const auto* key : {"a", "b", "c"})
+        cache.store(key, obj);
+    EXPECT(cache.size() == 300);
+
+    // make "b" the least recently used entry after loading "a"
+    rtc::fs::last_write_time(env.cache_dir / "a.co", now - std::chrono::hours(3));
+    rtc::fs::last_write_time(env.cache_dir / "b.co", now - std::chrono::hours(2));
+    rtc::fs::last_write_time(env.cache_dir / "c.co", now - std::chrono::hours(1));
+    EXPECT(cache.load("a").has_value());
+
+    cache.store("d", obj);
+    EXPECT(cache.size() == 300);
+    EXPECT(cache.load("a").has_value());
+    EXPECT(not cache.load("b").has_value());
+    EXPECT(cache.load("c").has_value());
+    EXPECT(to_string(cache.load("d").value_or(std::vector<char>{})) == to_string(obj));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
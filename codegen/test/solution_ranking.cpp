@@ -0,0 +1,121 @@
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_d/conv_fwd_problem.hpp"
+#include "ck/host/operation/cost_model.hpp"
+#include <algorithm>
+#include <test.hpp>
+
+using ck::host::operation::RankedSolution;
+
+std::size_t get_tile_size(const ck::host::Solution& solution)
+{
+    return solution.GetTemplateParameter<std::size_t>("MPerBlock") *
+           solution.GetTemplateParameter<std::size_t>("NPerBlock");
+}
+
+bool is_ranked(const std::vector<RankedSolution>& ranked)
+{
+    return std::is_sorted(ranked.begin(), ranked.end(), [](const auto& x, const auto& y) {
+        return x.score.score > y.score.score;
+    });
+}
+
+TEST_CASE(test_gemm_top_k)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M = 4096;
+    prob.N = 4096;
+    prob.K = 4096;
+
+    auto all    = prob.GetSolutions("gfx90a", "", "");
+    auto ranked = prob.GetRankedSolutions("gfx90a", "", "");
+    EXPECT(ranked.size() == all.size());
+    EXPECT(is_ranked(ranked));
+
+    auto top = prob.GetSolutions("gfx90a", "", "", 3);
+    EXPECT(top.size() == 3);
+    for(std::size_t i = 0; i < top.size(); i++)
+        EXPECT(top[i].ToTemplateString() == ranked[i].solution.ToTemplateString());
+
+    EXPECT(prob.GetSolutions("gfx1100", "", "", 3).empty());
+}
+
+TEST_CASE(test_gemm_tile_size)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.K = 1024;
+
+    // small problems need small tiles to occupy the CUs, large ones reuse more data per tile
+    prob.M     = 256;
+    prob.N     = 256;
+    auto small = prob.GetRankedSolutions("gfx942", "", "");
+    prob.M     = 8192;
+    prob.N     = 8192;
+    auto large = prob.GetRankedSolutions("gfx942", "", "");
+    EXPECT(get_tile_size(small.front().solution) < get_tile_size(large.front().solution));
+    EXPECT(small.front().score.cu_utilization > small.back().score.cu_utilization);
+    EXPECT(large.front().score.data_reuse == 1);
+}
+
+TEST_CASE(test_gemm_vector_alignment)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M      = 1024;
+    prob.N      = 1024;
+    prob.K      = 1020;
+    prob.TransB = true;
+
+    // K is not a multiple of the 8 wide K vectors of A and column-major B
+    for(const auto& ranked : prob.GetRankedSolutions("gfx90a", "", ""))
+    {
+        EXPECT(not ranked.score.supported);
+        EXPECT(ranked.score.score == 0);
+    }
+
+    prob.K = 1024;
+    for(const auto& ranked : prob.GetRankedSolutions("gfx90a", "", ""))
+        EXPECT(ranked.score.supported);
+}
+
+TEST_CASE(test_conv_ranking)
+{
+    ck::host::conv::Problem_Conv_Fwd prob;
+    prob.NumDim = 2;
+    prob.G      = 1;
+    prob.N      = 2;
+    prob.C      = 3;
+    prob.Hi     = 224;
+    prob.Wi     = 224;
+    prob.Ho     = 112;
+    prob.Wo     = 112;
+    prob.K      = 64;
+    prob.Y      = 7;
+    prob.X      = 7;
+
+    // only the instances reading one channel at a time support C = 3
+    auto ranked = prob.GetRankedSolutions("gfx90a", "", "");
+    EXPECT(is_ranked(ranked));
+    std::size_t num_supported = std::count_if(
+        ranked.begin(), ranked.end(), [](const auto& r) { return r.score.supported; });
+    EXPECT(num_supported > 0);
+    EXPECT(num_supported < ranked.size());
+    for(std::size_t i = 0; i < ranked.size(); i++)
+    {
+        const auto& solution = ranked[i].solution;
+        EXPECT(ranked[i].score.supported == (i < num_supported));
+        if(ranked[i].score.supported)
+            EXPECT(solution.GetTemplateParameter<int>("ABlockTransferSrcScalarPerVector") == 1);
+    }
+
+    // weights of 0 remove a term from the score
+    ck::host::operation::CostModelWeights weights;
+    weights.cu_utilization = 0;
+    weights.tile_waste     = 0;
+    weights.k_loop         = 0;
+    weights.occupancy      = 0;
+    weights.data_reuse     = 0;
+    weights.vector_width   = 0;
+    for(const auto& r : prob.GetRankedSolutions("gfx90a", "", "", 0, weights))
+        EXPECT(r.score.score == (r.score.supported ? 1 : 0));
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
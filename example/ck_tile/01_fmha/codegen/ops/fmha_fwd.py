@@ -103,6 +103,12 @@ float fmha_fwd_<trait_{F_idx}>(const ck_tile::stream_config& s, fmha_fwd_args a)
     constexpr ck_tile::index_t kBlockPerCu = k_::kBlockPerCu;
     return ck_tile::launch_kernel(s, ck_tile::make_kernel<blocks.x, kBlockPerCu>(k_{{}}, grids, blocks, 0, kargs));
 }}
+
+template<>
+fmha_fwd_kernel fmha_fwd_get_kernel_<trait_{F_idx}>()
+{{
+    return fmha_fwd_make_kernel<fmha_kernel_{F_idx}>(fmha_fwd_<trait_{F_idx}>);
+}}
 """
 
 FMHA_FWD_API_FILENAME="fmha_fwd_api.cpp"
@@ -130,6 +136,90 @@ FMHA_FWD_API_INNER_DISPATCH="""            {F_if}((t.is_group_mode == {F_mode})
             }}
 """
 
+FMHA_FWD_PLAN_API="""
+#include <mutex>
+#include <unordered_map>
+
+namespace {{
+{F_is_supported}
+struct fmha_fwd_traits_hash
+{{
+    std::size_t operator()(const fmha_fwd_traits& t) const
+    {{
+        std::size_t seed = std::hash<std::string>{{}}(t.data_type);
+        for(std::size_t v : {{static_cast<std::size_t>(t.hdim_q),
+                              static_cast<std::size_t>(t.hdim_v),
+                              static_cast<std::size_t>(t.is_group_mode),
+                              static_cast<std::size_t>(t.is_v_rowmajor),
+                              static_cast<std::size_t>(t.mask_type),
+                              static_cast<std::size_t>(t.bias_type),
+                              static_cast<std::size_t>(t.has_lse),
+                              static_cast<std::size_t>(t.has_dropout),
+                              static_cast<std::size_t>(t.do_fp8_static_quant)}})
+            seed ^= v + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }}
+}};
+
+struct fmha_fwd_traits_equal
+{{
+    bool operator()(const fmha_fwd_traits& x, const fmha_fwd_traits& y) const
+    {{
+        return x.hdim_q == y.hdim_q && x.hdim_v == y.hdim_v && x.data_type == y.data_type &&
+               x.is_group_mode == y.is_group_mode && x.is_v_rowmajor == y.is_v_rowmajor &&
+               x.mask_type == y.mask_type && x.bias_type == y.bias_type &&
+               x.has_lse == y.has_lse && x.has_dropout == y.has_dropout &&
+               x.do_fp8_static_quant == y.do_fp8_static_quant;
+    }}
+}};
+}} // namespace
+
+fmha_fwd_plan fmha_fwd_make_plan(const fmha_fwd_traits& t){{
+    fmha_fwd_plan p;
+{F_dispatch}
+    return p;
+}}
+
+const fmha_fwd_plan& fmha_fwd_get_plan(const fmha_fwd_traits& t){{
+    static std::mutex mutex;
+    static std::unordered_map<fmha_fwd_traits, fmha_fwd_plan, fmha_fwd_traits_hash, fmha_fwd_traits_equal> plans;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = plans.find(t);
+    if(it == plans.end())
+        it = plans.emplace(t, fmha_fwd_make_plan(t)).first;
+    return it->second;
+}}
+
+float fmha_fwd(const fmha_fwd_plan& p, fmha_fwd_args a, const ck_tile::stream_config& s){{
+    const fmha_fwd_kernel* kernel = p.select(a);
+    return kernel != nullptr ? kernel->run(s, a) : -1;
+}}
+
+fmha_fwd_launcher fmha_fwd_prepare(const fmha_fwd_plan& p, const fmha_fwd_args& a){{
+    fmha_fwd_launcher launcher;
+    if(const fmha_fwd_kernel* kernel = p.select(a))
+    {{
+        launcher.kernel = *kernel;
+        launcher.kargs  = kernel->make_kargs(a, launcher.grids);
+    }}
+    return launcher;
+}}
+"""
+
+FMHA_FWD_PLAN_IS_SUPPORTED="""
+bool {F_name}([[maybe_unused]] const fmha_fwd_args& a)
+{{
+    return ({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck});
+}}
+"""
+
+FMHA_FWD_PLAN_INNER_DISPATCH="""            if((t.is_group_mode == {F_mode}) && (t.is_v_rowmajor == {F_vlayout}) && ({F_mask_check}) && (t.bias_type == {F_bias_check}) && (t.has_lse == {F_lse})  && (t.has_dropout == {F_dropout}) && (t.do_fp8_static_quant == {F_squant})) {{
+                using trait_ = fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0max}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_dropout}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}>;
+                p.candidates.push_back({{{F_is_supported}, fmha_fwd_get_kernel_<trait_>()}});
+            }}
+"""
+
 @dataclass
 class FmhaFwdApiTrait:
     pipeline_tag : str
@@ -193,6 +283,10 @@ class FmhaFwdApiTrait:
             else :               return f'a.hdim_q % {bk0submax} == 0'
         else:   assert False
 
+    @property
+    def shape_checks(self) -> Tuple[str, str, str, str]:
+        return (self.scheck, self.skcheck, self.dcheck, self.dvcheck)
+
     @property
     def dvcheck(self) -> str:
         if self.pipeline_tag == 'qr_async':
@@ -257,8 +351,7 @@ class FmhaFwdApiPool:
 
         self.pool[trait.dtype][trait.hdim].append(copy.copy(trait))
 
-    @property
-    def api(self) -> str:
+    def _dispatch(self, inner_dispatch, is_supported_names = None) -> str:
         per_dtypes=str()
         for i, dtype in enumerate(self.pool.keys()):
             per_hdim_case=str()
@@ -267,22 +360,45 @@ class FmhaFwdApiPool:
                 inners=str()
                 for k, trait in enumerate(traits):
                     if_k = 'if' if k == 0 else 'else if'
-                    inners = inners + FMHA_FWD_API_INNER_DISPATCH.format(F_if=if_k, F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
+                    inners = inners + inner_dispatch.format(F_if=if_k, F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
                                    F_pipeline_enum=PIPELINE_ENUM_MAP[trait.pipeline_tag], F_mask=get_mask_map(self.mask_impl)[trait.mask],
                                    F_mask_check=get_mask_check_map(self.mask_impl)[trait.mask], F_bias_check=BIAS_CHECK_MAP[trait.bias], F_bias=BIAS_MAP[trait.bias],
                                    F_lse=BOOL_MAP[trait.lse], F_dropout=BOOL_MAP[trait.dropout] ,
                                    F_squant=BOOL_MAP[trait.squant], F_scheck=trait.scheck, F_skcheck=trait.skcheck, F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck,
                                    F_spad=BOOL_MAP[trait.spad], F_skpad=BOOL_MAP[trait.skpad], F_dpad=BOOL_MAP[trait.dpad], F_dvpad=BOOL_MAP[trait.dvpad],
                                    F_bm0=trait.bm0, F_bn0=trait.bn0, F_bk0=trait.bk0, F_bn1=trait.bn1, F_bk1=trait.bk1, F_bk0max=trait.bk0max,
-                                   F_hdim=hdim, F_dtype=FWD_DTYPE_MAP[dtype])
+                                   F_hdim=hdim, F_dtype=FWD_DTYPE_MAP[dtype],
+                                   F_is_supported=is_supported_names[trait.shape_checks] if is_supported_names else '')
                 if_j = 'if' if j == 0 else 'else if'
                 per_hdim_case = per_hdim_case + FMHA_FWD_API_PER_HDIM_CASE.format(F_if=if_j, F_hdim=hdim, F_inner_dispatch=inners)
             if_i = 'if' if i == 0 else 'else if'
             per_dtypes = per_dtypes + FMHA_FWD_API_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_hdim_case=per_hdim_case)
+        return per_dtypes
+
+    @property
+    def api(self) -> str:
+        per_dtypes = self._dispatch(FMHA_FWD_API_INNER_DISPATCH)
         if not per_dtypes:
             # empty string we add some ignore to suppress warning in api
             per_dtypes += '    (void)t ; (void)s ; (void)a;'
-        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API.format(F_dispatch = per_dtypes)
+
+        # the plan resolves the checks on the traits once, the checks on the shape of the args
+        # are left to one function per distinct set of checks
+        is_supported_names = dict()
+        is_supported = str()
+        for traits in (t for per_hdim in self.pool.values() for ts in per_hdim.values() for t in ts):
+            if traits.shape_checks not in is_supported_names:
+                name = f'fmha_fwd_is_supported_{len(is_supported_names)}'
+                is_supported_names[traits.shape_checks] = name
+                scheck, skcheck, dcheck, dvcheck = traits.shape_checks
+                is_supported = is_supported + FMHA_FWD_PLAN_IS_SUPPORTED.format(F_name=name,
+                                   F_scheck=scheck, F_skcheck=skcheck, F_dcheck=dcheck, F_dvcheck=dvcheck)
+        plan_per_dtypes = self._dispatch(FMHA_FWD_PLAN_INNER_DISPATCH, is_supported_names)
+        if not plan_per_dtypes:
+            plan_per_dtypes += '    (void)t;'
+
+        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API.format(F_dispatch = per_dtypes) + \
+            FMHA_FWD_PLAN_API.format(F_is_supported = is_supported, F_dispatch = plan_per_dtypes)
 
 @dataclass
 class FmhaFwdTileSize:
@@ -88,6 +88,10 @@ auto create_args(int argc, char* argv[])
         .insert("drop_prefs",
                 "0",
                 "seed and offset values are present on GPU; 0 - host, 1 - device/GPU")
+        .insert("s_randval",
+                "0",
+                "if set to 1 with dropout, store the random values and check them against the ones\n"
+                "the host generates, needs a [b, h, s, s_k] tensor")
         .insert("timer", "gpu", "gpu:gpu timer, cpu:cpu timer")
         .insert("warmup", "5", "number of iterations before benchmark the kernel")
         .insert("repeat", "20", "number of iterations to benchmark the kernel")
@@ -179,11 +183,9 @@ bool run(const ck_tile::ArgParser& arg_parser)
         uint8_t(std::floor(p_undrop * std::numeric_limits<uint8_t>::max()));
     float rp_undrop = 1.0 / p_undrop;
 
-    bool s_randval = false;
-    if(p_drop > 0.0f && do_validation)
-    {
-        s_randval = true;
-    }
+    // the references generate the random values of dropout themselves, storing them only helps
+    // debugging a mismatch
+    bool s_randval = p_drop > 0.0f && do_validation && arg_parser.get_bool("s_randval");
 
     mask_info mask = mask_info::decode(arg_parser.get_str("mask"), seqlen_q, seqlen_k);
 
@@ -309,7 +311,7 @@ bool run(const ck_tile::ArgParser& arg_parser)
     ck_tile::HostTensor<DDataType> d_host(
         std::array<ck_tile::index_t, 3>{shape_batch, nhead, shape_seqlen_q});
     ck_tile::HostTensor<RandValOutputDataType> randval_host(
-        p_drop > 0 ? get_lengths(true, shape_batch, nhead, shape_seqlen_q, max_seqlen_k)
+        s_randval ? get_lengths(true, shape_batch, nhead, shape_seqlen_q, max_seqlen_k)
                    : std::array<ck_tile::index_t, 4>{1, 1, 1, 1});
     ck_tile::HostTensor<QGradDataType> dq_host(
         get_lengths(i_perm, shape_batch, nhead, shape_seqlen_q, hdim_q));
@@ -596,11 +598,141 @@ bool run(const ck_tile::ArgParser& arg_parser)
     std::vector<ck_tile::HostTensor<KDataType>> k_host_refs;
     std::vector<ck_tile::HostTensor<VDataType>> v_host_refs;
     std::vector<ck_tile::HostTensor<ODataType>> o_host_refs;
-    std::vector<ck_tile::HostTensor<RandValOutputDataType>> randval_host_refs;
-    std::vector<ck_tile::HostTensor<AccDataType>> p_hp_host_refs;
-    std::vector<ck_tile::HostTensor<GemmDataType>> p_lp_host_refs;
+    std::vector<ck_tile::HostTensor<LSEDataType>> lse_host_refs;
+
+    if(s_randval)
+    {
+        randval_buf.FromDevice(randval_host.data());
+
+        for(ck_tile::index_t wb = 0; wb < batch; ++wb)
+        {
+            const ck_tile::index_t real_seqlen_q = seqstart_q_host[wb + 1] - seqstart_q_host[wb];
+            const ck_tile::index_t real_seqlen_k = seqstart_k_host[wb + 1] - seqstart_k_host[wb];
 
-    randval_buf.FromDevice(randval_host.data());
+            const ck_tile::index_t b = (mode == mode_enum::batch ? wb : 0);
+            const ck_tile::index_t query_offset =
+                (mode == mode_enum::batch ? 0 : seqstart_q_host[wb]);
+
+            const ck_tile::reference_fmha_philox_randval randval{
+                drop_seed, drop_offset, wb, nhead};
+
+            ck_tile::HostTensor<RandValOutputDataType> randval_host_ref(
+                {nhead, real_seqlen_q, real_seqlen_k});
+            ck_tile::HostTensor<RandValOutputDataType> randval_host_result(
+                {nhead, real_seqlen_q, real_seqlen_k});
+
+            // clang-format off
+            randval_host_ref.ForEach([&](auto& self, auto idx) { self(idx) = randval(idx[0], idx[1], idx[2]); });
+            randval_host_result.ForEach([&](auto& self, auto idx) { self(idx) = randval_host(b, idx[0], idx[1] + query_offset, idx[2]); });
+            // clang-format on
+
+            pass &= ck_tile::check_err(randval_host_result,
+                                       randval_host_ref,
+                                       std::string("Error: RandVal Incorrect results!"),
+                                       0,
+                                       0);
+        }
+    }
+
+    // The references recompute P tile by tile (reference_fmha_fwd/bwd), so no
+    // [nhead, seqlen_q, seqlen_k] tensor is needed apart from dbias.
+    const auto with_host_mask = [&](ck_tile::index_t real_seqlen_q,
+                                    ck_tile::index_t real_seqlen_k,
+                                    auto&& f) {
+        if(mask.type == mask_enum::no_mask)
+        {
+            f(FmhaMasks::NoMask{real_seqlen_q, real_seqlen_k});
+        }
+        else if(mask.type == mask_enum::window_generic)
+        {
+            f(ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
+                mask.left, mask.right, real_seqlen_q, real_seqlen_k));
+        }
+        else
+        {
+            // if left window size is negative, means causal
+            // else means generic (for current batch)
+            if(mask.left < 0)
+                f(ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::CausalMask>(
+                    mask.left,
+                    mask.right,
+                    real_seqlen_q,
+                    real_seqlen_k,
+                    mask.type == mask_enum::mask_top_left));
+            else
+                f(ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
+                    mask.left,
+                    mask.right,
+                    real_seqlen_q,
+                    real_seqlen_k,
+                    mask.type == mask_enum::mask_top_left));
+        }
+    };
+
+    // elementwise bias or alibi of batch wb
+    const auto make_host_bias = [&](ck_tile::index_t wb,
+                                    ck_tile::index_t real_seqlen_q,
+                                    ck_tile::index_t real_seqlen_k) {
+        const ck_tile::index_t query_offset =
+            (mode == mode_enum::batch ? 0 : seqstart_q_host[wb]);
+
+        auto alibi_host = [&]() {
+            if(mask.type != mask_enum::no_mask)
+            {
+                return ck_tile::make_alibi_from_lr_mask<AccDataType, false>(
+                    0,
+                    mask.left,
+                    mask.right,
+                    real_seqlen_q,
+                    real_seqlen_k,
+                    static_cast<ck_tile::GenericAttentionMaskEnum>(mask.type));
+            }
+            else
+            {
+                return ck_tile::Alibi<AccDataType, false>{
+                    0, real_seqlen_q, real_seqlen_k, ck_tile::AlibiMode::FROM_BOTTOM_RIGHT};
+            }
+        }();
+
+        const auto i_b_slope = bias.rank_info == 0 ? 0 : wb;
+
+        return [&, alibi_host, query_offset, i_b_slope](
+                   ck_tile::index_t i_h, ck_tile::index_t i_r, ck_tile::index_t i_c) {
+            if(bias.type == bias_enum::elementwise_bias)
+            {
+                return ck_tile::type_convert<AccDataType>(
+                    i_perm ? bias_host(0, 0, i_r + query_offset, i_c)
+                           : bias_host(0, i_r + query_offset, 0, i_c));
+            }
+            else if(bias.type == bias_enum::alibi)
+            {
+                auto alibi_head           = alibi_host;
+                AccDataType current_slope = alibi_slope_host(i_b_slope, i_h);
+                alibi_head.slope = alibi_head.mode == ck_tile::AlibiMode::VERTICAL
+                                       ? current_slope
+                                       : -current_slope;
+
+                AccDataType pixel = 0;
+                alibi_head.update(pixel, i_r, i_c);
+                return pixel;
+            }
+
+            return AccDataType{0};
+        };
+    };
+
+    // the random values of dropout are regenerated from the seed and offset like the kernel does
+    const auto with_host_dropout = [&](ck_tile::index_t wb, auto&& f) {
+        if(p_drop > 0)
+        {
+            f(ck_tile::make_reference_fmha_philox_dropout(
+                drop_seed, drop_offset, wb, nhead, p_undrop_in_uint8_t, rp_undrop));
+        }
+        else
+        {
+            f(ck_tile::reference_fmha_no_dropout{});
+        }
+    };
 
     for(ck_tile::index_t wb = 0; wb < batch; ++wb)
     {
@@ -617,16 +749,6 @@ bool run(const ck_tile::ArgParser& arg_parser)
         ck_tile::HostTensor<VDataType> v_host_ref({nhead, hdim_v, real_seqlen_k}); // v_g_o_n
         ck_tile::HostTensor<ODataType> o_host_ref({nhead, real_seqlen_q, hdim_v}); // o_g_m_o
         ck_tile::HostTensor<LSEDataType> lse_host_ref({nhead, real_seqlen_q});     // lse_g_m
-        ck_tile::HostTensor<RandValOutputDataType> randval_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // randval_g_m_n
-        ck_tile::HostTensor<AccDataType> s_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // s_g_m_n
-        ck_tile::HostTensor<AccDataType> p_hp_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // p_hp_g_m_n high precision
-        ck_tile::HostTensor<AccDataType> p_dropped_hp_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // p_dropped_hp_g_m_n high precision
-        ck_tile::HostTensor<GemmDataType> p_lp_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // p_lp_g_m_n low precision
 
         ck_tile::index_t nr = nhead / nhead_k;
 
@@ -645,138 +767,23 @@ bool run(const ck_tile::ArgParser& arg_parser)
         // clang-format on
 
         // reference
-        // S = scale * Q * K^T
-        ck_tile::reference_batched_gemm<QDataType, KDataType, AccDataType, AccDataType>(
-            q_host_ref,
-            k_host_ref,
-            s_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            ck_tile::scales(scale)); // s_g_m_n = scale * q_g_m_k@k_g_n_k
-
-        if(bias.type == bias_enum::elementwise_bias)
-        {
-            // elementwise bias
-            ck_tile::HostTensor<BiasDataType> bias_host_ref({1, real_seqlen_q, real_seqlen_k});
-            // clang-format off
-            if(i_perm)
-                bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, 0, i[1] + query_offset, i[2]); });
-            else
-                bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, i[1] + query_offset, 0, i[2]); });
-            // clang-format on
-
-            // broadcast from [1, real_seqlen_q, real_seqlen_k] to [nhead, real_seqlen_q,
-            // real_seqlen_k]
-            ck_tile::
-                reference_batched_elementwise<AccDataType, BiasDataType, AccDataType, AccDataType>(
-                    s_host_ref, bias_host_ref, s_host_ref);
-        }
-        else if(bias.type == bias_enum::alibi)
-        {
-            // alibi construct elementwise bias to verify
-            auto alibi_host = [&]() {
-                if(mask.type != mask_enum::no_mask)
-                {
-                    return ck_tile::make_alibi_from_lr_mask<AccDataType, false>(
-                        0,
-                        mask.left,
-                        mask.right,
-                        real_seqlen_q,
-                        real_seqlen_k,
-                        static_cast<ck_tile::GenericAttentionMaskEnum>(mask.type));
-                }
-                else
-                {
-                    return ck_tile::Alibi<AccDataType, false>{
-                        0, real_seqlen_q, real_seqlen_k, ck_tile::AlibiMode::FROM_BOTTOM_RIGHT};
-                }
-            }();
-
-            ck_tile::HostTensor<AccDataType> alibi_bias_host_ref(
-                {nhead, real_seqlen_q, real_seqlen_k});
-            auto i_b_slope = bias.rank_info == 0 ? 0 : wb;
-            for(auto i_h = 0; i_h < nhead; i_h++)
-            {
-                AccDataType current_slope = alibi_slope_host(i_b_slope, i_h);
-                alibi_host.slope = alibi_host.mode == ck_tile::AlibiMode::VERTICAL ? current_slope
-                                                                                   : -current_slope;
-                for(auto i_r = 0; i_r < real_seqlen_q; i_r++)
-                {
-                    for(auto i_c = 0; i_c < real_seqlen_k; i_c++)
-                    {
-                        AccDataType pixel = 0;
-                        alibi_host.update(pixel, i_r, i_c);
-                        alibi_bias_host_ref(i_h, i_r, i_c) = pixel;
-                    }
-                }
-            }
-            // [nhead, real_seqlen_q, real_seqlen_k]
-            ck_tile::
-                reference_batched_elementwise<AccDataType, AccDataType, AccDataType, AccDataType>(
-                    s_host_ref, alibi_bias_host_ref, s_host_ref);
-        }
-
-        if(mask.type == mask_enum::no_mask)
-        {
-            ck_tile::reference_batched_masking<AccDataType>(
-                s_host_ref, FmhaMasks::NoMask{real_seqlen_q, real_seqlen_k});
-        }
-        else if(mask.type == mask_enum::window_generic)
-        {
-            ck_tile::reference_batched_masking<AccDataType>(
-                s_host_ref,
-                ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
-                    mask.left, mask.right, real_seqlen_q, real_seqlen_k));
-        }
-        else
-        {
-            // if left window size is negative, means causal
-            // else means generic (for current batch)
-            if(mask.left < 0)
-                ck_tile::reference_batched_masking<AccDataType>(
-                    s_host_ref,
-                    ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::CausalMask>(
-                        mask.left,
-                        mask.right,
-                        real_seqlen_q,
-                        real_seqlen_k,
-                        mask.type == mask_enum::mask_top_left));
-            else
-                ck_tile::reference_batched_masking<AccDataType>(
-                    s_host_ref,
-                    ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
-                        mask.left,
-                        mask.right,
-                        real_seqlen_q,
-                        real_seqlen_k,
-                        mask.type == mask_enum::mask_top_left));
-        }
-        ck_tile::reference_batched_softmax<AccDataType, LSEDataType, AccDataType>(
-            s_host_ref, p_hp_host_ref, ck_tile::identity{}, lse_host_ref);
-
-        if(p_drop > 0)
-        {
-            p_hp_host_ref.ForEach(
-                [&](auto& self, auto idx) { p_dropped_hp_host_ref(idx) = self(idx); });
-            randval_host_ref.ForEach([&](auto& self, auto idx) {
-                self(idx) = randval_host(b, idx[0], idx[1] + query_offset, idx[2]);
-            });
-            ck_tile::reference_batched_dropout(
-                p_dropped_hp_host_ref, randval_host_ref, p_undrop_in_uint8_t, rp_undrop);
-            p_dropped_hp_host_ref.ForEach([&](auto& self, auto idx) {
-                p_lp_host_ref(idx) = ck_tile::type_convert<GemmDataType>(self(idx));
-            });
-        }
-        else
-        {
-            p_hp_host_ref.ForEach([&](auto& self, auto idx) {
-                p_lp_host_ref(idx) = ck_tile::type_convert<GemmDataType>(self(idx));
+        // O = dropout(softmax(scale * Q * K^T + bias)) * V
+        const auto v_t_host_ref = v_host_ref.transpose({0, 2, 1}); // v_g_o_n -> v_g_n_o
+
+        with_host_mask(real_seqlen_q, real_seqlen_k, [&](const auto& host_mask) {
+            with_host_dropout(wb, [&](const auto& host_dropout) {
+                ck_tile::reference_fmha_fwd<AccDataType, GemmDataType>(
+                    q_host_ref,
+                    ck_tile::make_reference_fmha_kv_view(k_host_ref),
+                    ck_tile::make_reference_fmha_kv_view(v_t_host_ref),
+                    o_host_ref,
+                    host_mask,
+                    scale,
+                    make_host_bias(wb, real_seqlen_q, real_seqlen_k),
+                    lse_host_ref,
+                    host_dropout);
             });
-        }
-
-        // O = P * V
-        ck_tile::reference_batched_gemm<GemmDataType, VDataType, AccDataType, ODataType>(
-            p_lp_host_ref, v_host_ref, o_host_ref); // o_g_m_o = p_lp_g_m_n@v_g_o_n
+        });
 
         // clang-format off
         // permute
@@ -790,12 +797,7 @@ bool run(const ck_tile::ArgParser& arg_parser)
         k_host_refs.push_back(k_host_ref);
         v_host_refs.push_back(v_host_ref);
         o_host_refs.push_back(o_host_ref);
-        p_hp_host_refs.push_back(p_hp_host_ref);
-        p_lp_host_refs.push_back(p_lp_host_ref);
-        if(p_drop > 0)
-        {
-            randval_host_refs.push_back(randval_host_ref);
-        }
+        lse_host_refs.push_back(lse_host_ref);
     }
 
     o_buf.ToDevice(o_host.data());
@@ -824,14 +826,9 @@ bool run(const ck_tile::ArgParser& arg_parser)
         const ck_tile::index_t key_offset   = (mode == mode_enum::batch ? 0 : seqstart_k_host[wb]);
 
         ck_tile::HostTensor<OGradDataType> do_host_ref({nhead, real_seqlen_q, hdim_v}); // do_g_m_o
-        ck_tile::HostTensor<AccDataType> ds_hp_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // ds_g_m_n high precision
-        ck_tile::HostTensor<GemmDataType> ds_lp_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // ds_g_m_n low precision
-        ck_tile::HostTensor<AccDataType> dp_hp_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // dp_g_m_n high precision
         ck_tile::HostTensor<BiasGradDataType> dbias_host_ref(
-            {nhead, real_seqlen_q, real_seqlen_k}); // dbias_g_m_n
+            use_dbias ? std::array<ck_tile::index_t, 3>{nhead, real_seqlen_q, real_seqlen_k}
+                      : std::array<ck_tile::index_t, 3>{1, 1, 1}); // dbias_g_m_n
         ck_tile::HostTensor<QGradDataType> dq_host_ref({nhead, real_seqlen_q, hdim_q}); // dq_g_m_k
         ck_tile::HostTensor<KGradDataType> dk_host_ref({nhead, real_seqlen_k, hdim_q}); // dk_g_n_k
         ck_tile::HostTensor<VGradDataType> dv_host_ref({nhead, real_seqlen_k, hdim_v}); // dv_g_n_o
@@ -841,71 +838,37 @@ bool run(const ck_tile::ArgParser& arg_parser)
         else       do_host_ref.ForEach([&](auto& self, auto i) { self(i) = do_host(b, i[1] + query_offset, i[0], i[2]); });
         // clang-format on
 
-        // dP = dO@V x Z w/  dropout
-        // dP = dO@V     w/o dropout
-        auto v_t_host_ref = v_host_refs[wb].transpose({0, 2, 1}); // v_g_o_n -> v_g_n_o
-        ck_tile::reference_batched_gemm<OGradDataType, VDataType, AccDataType, AccDataType>(
-            do_host_ref, v_t_host_ref, dp_hp_host_ref); // dp_g_m_n = do_g_m_o@v_g_n_o
-
-        if(p_drop > 0)
-        {
-            ck_tile::reference_batched_dropout(
-                dp_hp_host_ref, randval_host_refs[wb], p_undrop_in_uint8_t, rp_undrop);
-        }
-
-        // dS_i_j = P_i_j .* (dP_i_j - dO_i dot O_i)
-        ds_hp_host_ref.ForEach([&](auto& self, auto idx_gmn) {
-            AccDataType do_dot_o = 0;
-            for(int o = 0; o < hdim_v; o++)
-            {
-                auto idx_gmo = idx_gmn;
-                idx_gmo[2]   = o;
-                do_dot_o += ck_tile::type_convert<AccDataType>(do_host_ref(idx_gmo)) *
-                            ck_tile::type_convert<AccDataType>(o_host_refs[wb](idx_gmo));
-            }
-            self(idx_gmn) = ck_tile::type_convert<AccDataType>(
-                p_hp_host_refs[wb](idx_gmn) * (dp_hp_host_ref(idx_gmn) - do_dot_o));
-        });
-
-        if(use_dbias)
-        {
-            ds_hp_host_ref.ForEach([&](auto& self, auto idx) {
-                dbias_host_ref(idx) = ck_tile::type_convert<BiasGradDataType>(self(idx));
+        // dS = P .* (dP - dO dot O), dP = dO@V^T (x Z w/ dropout)
+        // dV = P_drop^T@dO, dQ = scale * dS@K, dK = scale * dS^T@Q
+        const auto v_t_host_ref = v_host_refs[wb].transpose({0, 2, 1}); // v_g_o_n -> v_g_n_o
+
+        with_host_mask(real_seqlen_q, real_seqlen_k, [&](const auto& host_mask) {
+            with_host_dropout(wb, [&](const auto& host_dropout) {
+                ck_tile::reference_fmha_bwd<AccDataType, GemmDataType>(
+                    q_host_refs[wb],
+                    ck_tile::make_reference_fmha_kv_view(k_host_refs[wb]),
+                    ck_tile::make_reference_fmha_kv_view(v_t_host_ref),
+                    o_host_refs[wb],
+                    lse_host_refs[wb],
+                    do_host_ref,
+                    dq_host_ref,
+                    dk_host_ref,
+                    dv_host_ref,
+                    host_mask,
+                    scale,
+                    make_host_bias(wb, real_seqlen_q, real_seqlen_k),
+                    host_dropout,
+                    [&](ck_tile::index_t i_h,
+                        ck_tile::index_t i_r,
+                        ck_tile::index_t i_c,
+                        float ds) {
+                        if(use_dbias)
+                            dbias_host_ref(i_h, i_r, i_c) =
+                                ck_tile::type_convert<BiasGradDataType>(ds);
+                    });
             });
-        }
-
-        ds_hp_host_ref.ForEach([&](auto& self, auto idx) {
-            ds_lp_host_ref(idx) = ck_tile::type_convert<GemmDataType>(self(idx));
         });
 
-        // dV = P_drop^T@dO^T
-        // dV = P^T@dO^T w/o dropout
-        auto p_t_lp_host_ref = p_lp_host_refs[wb].transpose({0, 2, 1}); // p_lp_g_m_n -> p_lp_g_n_m
-        auto do_t_host_ref   = do_host_ref.transpose({0, 2, 1});        // do_g_m_o -> do_g_o_m
-        ck_tile::reference_batched_gemm<GemmDataType, OGradDataType, AccDataType, VGradDataType>(
-            p_t_lp_host_ref, do_t_host_ref, dv_host_ref); // dv_g_n_o = p_lp_g_n_m@do_g_o_m
-
-        // dQ = scale * dS@K^T
-        auto k_t_host_ref = k_host_refs[wb].transpose({0, 2, 1}); // k_g_n_k -> k_g_k_n
-        ck_tile::reference_batched_gemm<GemmDataType, KDataType, AccDataType, QGradDataType>(
-            ds_lp_host_ref,
-            k_t_host_ref,
-            dq_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            ck_tile::scales(scale)); // dq_g_m_k = ds_g_m_n@k_g_k_n
-
-        // dK = scale * dS^T@Q^T
-        auto ds_t_lp_host_ref = ds_lp_host_ref.transpose({0, 2, 1});  // ds_g_m_n -> ds_g_n_m
-        auto q_t_host_ref     = q_host_refs[wb].transpose({0, 2, 1}); // q_g_m_k -> q_g_k_m
-        ck_tile::reference_batched_gemm<GemmDataType, QDataType, AccDataType, KGradDataType>(
-            ds_t_lp_host_ref,
-            q_t_host_ref,
-            dk_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            ck_tile::scales(scale)); // dk_g_n_k = ds_g_n_m@q_g_k_m
-
         ck_tile::HostTensor<QGradDataType> dq_host_result(
             {nhead, real_seqlen_q, hdim_q}); // dq_g_m_k
         ck_tile::HostTensor<KGradDataType> dk_host_result(
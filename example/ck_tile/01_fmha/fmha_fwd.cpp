@@ -8,11 +8,14 @@
 #include "rotary.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <functional>
 #include <numeric>
 #include <ostream>
+#include <random>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -135,6 +138,15 @@ auto create_args(int argc, char* argv[])
                 "# of splits for key/value. 0 to determine actual number by heuristic")
         .insert("page_block_size", "0", "paged-kvcache block size. 0 means not use paged-kvcahe")
         .insert("cache_batch_idx", "0", "whether to use index map to the kvcache")
+        .insert("plan",
+                "0",
+                "1: launch through a cached fmha_fwd_plan instead of resolving the traits per call\n"
+                "2: launch through a fmha_fwd_launcher prepared once, with the device pointers "
+                "patched by set_ptrs()")
+        .insert("bench_host",
+                "0",
+                "if > 0, time resolving the traits and preparing the launch on the host over this "
+                "many iterations")
         .insert("warmup", "5", "number of iterations before benchmark the kernel")
         .insert("repeat", "20", "number of iterations to benchmark the kernel");
 
@@ -176,61 +188,13 @@ auto get_elimit<FmhaFwdFp8>(std::string init_method)
     }
 }
 
-int num_splits_heuristic(int batch_nhead_mblocks, int num_SMs, int num_n_blocks, int max_splits)
-{
-    // If we have enough to almost fill the SMs, then just use 1 split
-    if(batch_nhead_mblocks >= 0.8f * num_SMs)
-    {
-        return 1;
-    }
-    max_splits           = std::min({max_splits, num_SMs, num_n_blocks});
-    float max_efficiency = 0.f;
-    std::vector<float> efficiency;
-    efficiency.reserve(max_splits);
-    auto ceildiv = [](int a, int b) { return (a + b - 1) / b; };
-    // Some splits are not eligible. For example, if we have 64 blocks and choose 11 splits,
-    // we'll have 6 * 10 + 4 blocks. If we choose 12 splits, we'll have 6 * 11 + (-2) blocks
-    // (i.e. it's 11 splits anyway).
-    // So we check if the number of blocks per split is the same as the previous num_splits.
-    auto is_split_eligible = [&ceildiv, &num_n_blocks](int num_splits) {
-        return num_splits == 1 ||
-               ceildiv(num_n_blocks, num_splits) != ceildiv(num_n_blocks, num_splits - 1);
-    };
-    for(int num_splits = 1; num_splits <= max_splits; num_splits++)
-    {
-        if(!is_split_eligible(num_splits))
-        {
-            efficiency.push_back(0.f);
-        }
-        else
-        {
-            float n_waves = float(batch_nhead_mblocks * num_splits) / num_SMs;
-            float eff     = n_waves / ceil(n_waves);
-            // printf("num_splits = %d, eff = %f\n", num_splits, eff);
-            if(eff > max_efficiency)
-            {
-                max_efficiency = eff;
-            }
-            efficiency.push_back(eff);
-        }
-    }
-    for(int num_splits = 1; num_splits <= max_splits; num_splits++)
-    {
-        if(!is_split_eligible(num_splits))
-        {
-            continue;
-        }
-        if(efficiency[num_splits - 1] >= 0.85 * max_efficiency)
-        {
-            // printf("num_splits chosen = %d\n", num_splits);
-            return num_splits;
-        }
-    }
-    return 1;
-}
-
-int override_num_splits_if_necessary(
-    int batch, int nhead, int max_seqlen_q, int hdim_v, float p_drop, int num_splits)
+int override_num_splits_if_necessary(const std::vector<ck_tile::index_t>& seqlen_qs,
+                                     const std::vector<ck_tile::index_t>& seqlen_ks,
+                                     int nhead,
+                                     int hdim_v,
+                                     int page_block_size,
+                                     float p_drop,
+                                     int num_splits)
 {
     int device;
     auto status = hipGetDevice(&device);
@@ -246,22 +210,101 @@ int override_num_splits_if_necessary(
         return num_splits;
     }
 
-    // tile size should match the generate.py
-    const int kM0 = 64;
-    const int kN1 = hdim_v;
-
-    const int num_m_blocks = ck_tile::integer_divide_ceil(max_seqlen_q, kM0);
-    const int num_n_blocks = ck_tile::integer_divide_ceil(hdim_v, kN1);
-
     if(num_splits < 1 && p_drop == 0.0f)
     {
-        return num_splits_heuristic(
-            batch * nhead * num_m_blocks, props.multiProcessorCount * 2, num_n_blocks, 128);
+        ck_tile::FmhaFwdSplitKVPlannerArgs args;
+        args.seqlen_qs    = seqlen_qs;
+        args.seqlen_ks    = seqlen_ks;
+        args.nhead_q      = nhead;
+        args.hdim_v       = hdim_v;
+        args.num_cu       = props.multiProcessorCount;
+        args.block_per_cu = 2;
+        // tile size should match the generate.py
+        args.kM0             = 64;
+        args.kN0             = (hdim_v <= 64 ? 64 : 128);
+        args.kN1             = hdim_v;
+        args.page_block_size = page_block_size;
+        // the split-kv kernel takes one num_splits for all sequences
+        args.uniform_splits = true;
+
+        return ck_tile::make_fmha_fwd_splitkv_plan(args).max_num_splits;
     }
 
     return num_splits;
 }
 
+fmha_fwd_ptrs get_fmha_fwd_ptrs(const fmha_fwd_args& args)
+{
+    return fmha_fwd_ptrs{args.q_ptr,
+                         args.k_ptr,
+                         args.v_ptr,
+                         args.bias_ptr,
+                         args.rand_val_ptr,
+                         args.lse_ptr,
+                         args.o_ptr,
+                         args.seqstart_q_ptr,
+                         args.seqstart_k_ptr,
+                         args.seqlen_k_ptr};
+}
+
+// launches through fmha_fwd_prepare(), the way repeated calls with new buffers would: the launcher
+// is prepared without the data pointers, which set_ptrs() patches in before the launch
+float launch_prepared(const fmha_fwd_traits& traits,
+                      const fmha_fwd_args& args,
+                      const ck_tile::stream_config& stream_config)
+{
+    fmha_fwd_args prepare_args = args;
+    prepare_args.q_ptr         = nullptr;
+    prepare_args.k_ptr         = nullptr;
+    prepare_args.v_ptr         = nullptr;
+    prepare_args.bias_ptr      = nullptr;
+    prepare_args.rand_val_ptr  = nullptr;
+    prepare_args.lse_ptr       = nullptr;
+    prepare_args.o_ptr         = nullptr;
+
+    fmha_fwd_launcher launcher = fmha_fwd_prepare(fmha_fwd_get_plan(traits), prepare_args);
+    if(!launcher)
+    {
+        return -1;
+    }
+    launcher.set_ptrs(get_fmha_fwd_ptrs(args));
+    return launcher(stream_config);
+}
+
+// prints the average host time of resolving the traits into a plan and of preparing a launch
+void bench_host_dispatch(const fmha_fwd_traits& traits, const fmha_fwd_args& args, int niters)
+{
+    const auto time_ns = [&](auto&& f) {
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < niters; ++i)
+        {
+            f();
+        }
+        const auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(stop - start).count() / niters;
+    };
+
+    const fmha_fwd_plan& plan  = fmha_fwd_get_plan(traits);
+    fmha_fwd_launcher launcher = fmha_fwd_prepare(plan, args);
+    const fmha_fwd_ptrs ptrs   = get_fmha_fwd_ptrs(args);
+
+    // keeps the compiler from dropping the timed calls
+    volatile std::size_t sink = 0;
+
+    const double make_plan_ns =
+        time_ns([&] { sink = sink + fmha_fwd_make_plan(traits).candidates.size(); });
+    const double get_plan_ns =
+        time_ns([&] { sink = sink + fmha_fwd_get_plan(traits).candidates.size(); });
+    const double select_ns = time_ns([&] { sink = sink + (plan.select(args) != nullptr); });
+    const double prepare_ns =
+        time_ns([&] { sink = sink + static_cast<bool>(fmha_fwd_prepare(plan, args)); });
+    const double set_ptrs_ns = launcher ? time_ns([&] { launcher.set_ptrs(ptrs); }) : 0;
+
+    std::cout << std::fixed << std::setprecision(1) << ", host ns make_plan:" << make_plan_ns
+              << ", get_plan:" << get_plan_ns << ", select:" << select_ns
+              << ", prepare:" << prepare_ns << ", set_ptrs:" << set_ptrs_ns << std::flush;
+}
+
 template <typename DataTypeConfig>
 bool run(const ck_tile::ArgParser& arg_parser)
 {
@@ -469,6 +512,8 @@ bool run(const ck_tile::ArgParser& arg_parser)
     int stream_warmup = arg_parser.get_int("warmup");
     int stream_repeat = arg_parser.get_int("repeat");
     bool kname        = arg_parser.get_bool("kname");
+    int use_plan      = arg_parser.get_int("plan");
+    int bench_host    = arg_parser.get_int("bench_host");
 
     ck_tile::stream_config stream_config{nullptr,
                                          true,
@@ -557,7 +602,7 @@ bool run(const ck_tile::ArgParser& arg_parser)
     if(num_splits < 1)
     {
         num_splits = override_num_splits_if_necessary(
-            batch, nhead, max_seqlen_q, hdim_v, p_drop, num_splits);
+            seqlen_qs, seqlen_ks, nhead, hdim_v, page_block_size, p_drop, num_splits);
     }
     if(128 < num_splits)
     {
@@ -742,7 +787,39 @@ bool run(const ck_tile::ArgParser& arg_parser)
             }
         }
     }
-    iota_shuffle(block_table_host.begin(), block_table_host.end(), 0);
+    if(0 < page_block_size)
+    {
+        // allocate the pages of the sequences one at a time in random order, like concurrent
+        // requests growing their caches, so the pages of a sequence are not contiguous
+        ck_tile::KVCacheBlockManager block_manager(max_num_page_blocks, page_block_size);
+
+        std::vector<ck_tile::index_t> seq_ids(batch);
+        std::vector<ck_tile::index_t> append_order;
+
+        for(ck_tile::index_t wb = 0; wb < batch; ++wb)
+        {
+            const ck_tile::index_t real_seqlen_k = seqstart_k_host[wb + 1] - seqstart_k_host[wb];
+
+            seq_ids[wb] = block_manager.create_sequence();
+            append_order.insert(append_order.end(),
+                                ck_tile::integer_divide_ceil(real_seqlen_k, page_block_size),
+                                wb);
+        }
+        std::shuffle(append_order.begin(),
+                     append_order.end(),
+                     std::mt19937(seed.has_value() ? *seed : std::random_device{}()));
+
+        for(ck_tile::index_t wb : append_order)
+        {
+            const ck_tile::index_t real_seqlen_k = seqstart_k_host[wb + 1] - seqstart_k_host[wb];
+            const ck_tile::index_t seqlen        = block_manager.get_seqlen(seq_ids[wb]);
+
+            block_manager.append_tokens(seq_ids[wb],
+                                        std::min(page_block_size, real_seqlen_k - seqlen));
+        }
+        block_manager.fill_block_table(
+            seq_ids, block_table_host.data(), max_num_page_blocks / batch);
+    }
     iota_shuffle(cache_batch_idx_host.begin(), cache_batch_idx_host.end(), 0);
 
     ck_tile::DeviceMem q_buf(q_host.get_element_space_size_in_bytes());
@@ -1103,6 +1180,19 @@ bool run(const ck_tile::ArgParser& arg_parser)
         fmha_fwd_args fmha_args;
         init_args(fmha_args);
 
+        if(0 < bench_host)
+        {
+            bench_host_dispatch(fmha_traits, fmha_args, bench_host);
+        }
+
+        if(use_plan == 2)
+        {
+            return launch_prepared(fmha_traits, fmha_args, stream_config);
+        }
+        else if(use_plan == 1)
+        {
+            return fmha_fwd(fmha_fwd_get_plan(fmha_traits), fmha_args, stream_config);
+        }
         return fmha_fwd(fmha_traits, fmha_args, stream_config);
     }();
 
@@ -1222,9 +1312,6 @@ bool run(const ck_tile::ArgParser& arg_parser)
         ck_tile::HostTensor<KDataType> k_host_ref({nhead, real_seqlen_k, hdim_q});
         ck_tile::HostTensor<VDataType> v_host_ref({nhead, hdim_v, real_seqlen_k});
         ck_tile::HostTensor<ODataType> o_host_ref({nhead, real_seqlen_q, hdim_v});
-
-        ck_tile::HostTensor<SMPLComputeDataType> s_host_ref({nhead, real_seqlen_q, real_seqlen_k});
-        ck_tile::HostTensor<PDataType> p_host_ref({nhead, real_seqlen_q, real_seqlen_k});
         ck_tile::HostTensor<SMPLComputeDataType> lse_host_ref({nhead, real_seqlen_q});
 
         ck_tile::index_t nr = nhead / nhead_k;
@@ -1365,145 +1452,204 @@ bool run(const ck_tile::ArgParser& arg_parser)
 #endif
         // clang-format on
 
-        // reference
-        ck_tile::reference_batched_gemm<QDataType, KDataType, SaccDataType, SMPLComputeDataType>(
-            q_host_ref,
-            k_host_ref,
-            s_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            ck_tile::scales(scale_s));
-
-        if(bias.type == bias_enum::elementwise_bias)
-        {
-            // elementwise bias
-            ck_tile::HostTensor<BiasDataType> bias_host_ref({1, real_seqlen_q, real_seqlen_k});
-            // clang-format off
-            if(i_perm)
-                bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, 0, i[1] + query_offset, i[2] + key_offset); });
+        const auto alibi_host = [&]() {
+            if(mask.type != mask_enum::no_mask)
+            {
+                return ck_tile::make_alibi_from_lr_mask<SaccDataType, true>(
+                    0,
+                    mask.left,
+                    mask.right,
+                    real_seqlen_q,
+                    real_seqlen_k,
+                    static_cast<ck_tile::GenericAttentionMaskEnum>(mask.type));
+            }
             else
-                bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, i[1] + query_offset, 0, i[2] + key_offset); });
-            // clang-format on
-
-            // broadcast from [1, real_seqlen_q, real_seqlen_k] to [nhead, real_seqlen_q,
-            // real_seqlen_k]
-            ck_tile::reference_batched_elementwise<SMPLComputeDataType,
-                                                   BiasDataType,
-                                                   SMPLComputeDataType,
-                                                   SMPLComputeDataType>(
-                s_host_ref, bias_host_ref, s_host_ref);
-        }
-        else if(bias.type == bias_enum::alibi)
-        {
-            // alibi construct elementwise bias to verify
-            auto alibi_host = [&]() {
-                if(mask.type != mask_enum::no_mask)
-                {
-                    return ck_tile::make_alibi_from_lr_mask<SaccDataType, true>(
-                        0,
-                        mask.left,
-                        mask.right,
-                        real_seqlen_q,
-                        real_seqlen_k,
-                        static_cast<ck_tile::GenericAttentionMaskEnum>(mask.type));
-                }
-                else
-                {
-                    return ck_tile::Alibi<SaccDataType, true>{
-                        0, real_seqlen_q, real_seqlen_k, ck_tile::AlibiMode::FROM_BOTTOM_RIGHT};
-                }
-            }();
-
-            ck_tile::HostTensor<SaccDataType> alibi_bias_host_ref(
-                {nhead, real_seqlen_q, real_seqlen_k});
-            auto i_b_slope = bias.rank_info == 0 ? 0 : wb;
-            for(auto i_h = 0; i_h < nhead; i_h++)
             {
-                SaccDataType current_slope = alibi_slope_host(i_b_slope, i_h);
-                alibi_host.slope = alibi_host.mode == ck_tile::AlibiMode::VERTICAL ? current_slope
-                                                                                   : -current_slope;
-                for(auto i_r = 0; i_r < real_seqlen_q; i_r++)
-                {
-                    for(auto i_c = 0; i_c < real_seqlen_k; i_c++)
-                    {
-                        SaccDataType pixel = 0;
-                        alibi_host.update(pixel, i_r, i_c);
-                        alibi_bias_host_ref(i_h, i_r, i_c) = pixel;
-                    }
-                }
+                return ck_tile::Alibi<SaccDataType, true>{
+                    0, real_seqlen_q, real_seqlen_k, ck_tile::AlibiMode::FROM_BOTTOM_RIGHT};
             }
-            // [nhead, real_seqlen_q, real_seqlen_k]
-            ck_tile::reference_batched_elementwise<SMPLComputeDataType,
-                                                   SaccDataType,
-                                                   SMPLComputeDataType,
-                                                   SMPLComputeDataType>(
-                s_host_ref, alibi_bias_host_ref, s_host_ref);
-        }
+        }();
 
-        if(mask.type == mask_enum::no_mask)
-        {
-            ck_tile::reference_batched_masking<SaccDataType>(
-                s_host_ref, FmhaMasks::NoMask{real_seqlen_q, real_seqlen_k});
-        }
-        else if(mask.type == mask_enum::window_generic)
-        {
-            ck_tile::reference_batched_masking<SaccDataType>(
-                s_host_ref,
-                ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
+        // alibi of head i_h, slopes are per head (and per batch if rank_info is not 0)
+        const auto get_alibi_head = [&](ck_tile::index_t i_h) {
+            auto alibi_head            = alibi_host;
+            SaccDataType current_slope = alibi_slope_host(bias.rank_info == 0 ? 0 : wb, i_h);
+            alibi_head.slope = alibi_head.mode == ck_tile::AlibiMode::VERTICAL ? current_slope
+                                                                               : -current_slope;
+            return alibi_head;
+        };
+
+        // calls f with the mask of the current batch
+        const auto with_host_mask = [&](auto&& f) {
+            if(mask.type == mask_enum::no_mask)
+            {
+                f(FmhaMasks::NoMask{real_seqlen_q, real_seqlen_k});
+            }
+            else if(mask.type == mask_enum::window_generic)
+            {
+                f(ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
                     mask.left, mask.right, real_seqlen_q, real_seqlen_k));
-        }
-        else
-        {
-            // if left window size is negative, means causal
-            // else means generic (for current batch)
-            if(mask.left < 0)
-                ck_tile::reference_batched_masking<SaccDataType>(
-                    s_host_ref,
-                    ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::CausalMask>(
+            }
+            else
+            {
+                // if left window size is negative, means causal
+                // else means generic (for current batch)
+                if(mask.left < 0)
+                    f(ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::CausalMask>(
                         mask.left,
                         mask.right,
                         real_seqlen_q,
                         real_seqlen_k,
                         mask.type == mask_enum::mask_top_left));
-            else
-                ck_tile::reference_batched_masking<SaccDataType>(
-                    s_host_ref,
-                    ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
+                else
+                    f(ck_tile::make_generic_attention_mask_from_lr_window<FmhaMasks::GenericMask>(
                         mask.left,
                         mask.right,
                         real_seqlen_q,
                         real_seqlen_k,
                         mask.type == mask_enum::mask_top_left));
-        }
-        if(lse)
+            }
+        };
+
+        // Without dropout the tiled online-softmax reference is used: it does not need the
+        // [nhead, seqlen_q, seqlen_k] S/P tensors of the reference chain, so long sequences can
+        // be validated too. fp8 scales P and O, which only the reference chain models.
+        const bool use_tiled_reference =
+            p_drop == 0 && !std::is_same_v<DataTypeConfig, FmhaFwdFp8>;
+
+        // reference
+        if(use_tiled_reference)
         {
-            ck_tile::reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
-                s_host_ref, p_host_ref, p_compute_element_func, lse_host_ref);
+            const auto bias_ref =
+                [&](ck_tile::index_t i_h, ck_tile::index_t i_r, ck_tile::index_t i_c) {
+                    if(bias.type == bias_enum::elementwise_bias)
+                    {
+                        return ck_tile::type_convert<SMPLComputeDataType>(
+                            i_perm ? bias_host(0, 0, i_r + query_offset, i_c + key_offset)
+                                   : bias_host(0, i_r + query_offset, 0, i_c + key_offset));
+                    }
+                    else if(bias.type == bias_enum::alibi)
+                    {
+                        SaccDataType pixel = 0;
+                        get_alibi_head(i_h).update(pixel, i_r, i_c);
+                        return ck_tile::type_convert<SMPLComputeDataType>(pixel);
+                    }
+
+                    return SMPLComputeDataType{0};
+                };
+
+            // v_host_ref is [nhead, hdim_v, seqlen_k], view it as [nhead, seqlen_k, hdim_v]
+            const auto v_host_ref_t = v_host_ref.transpose({0, 2, 1});
+
+            with_host_mask([&](const auto& host_mask) {
+                ck_tile::reference_fmha_fwd<SMPLComputeDataType, PDataType>(
+                    q_host_ref,
+                    ck_tile::make_reference_fmha_kv_view(k_host_ref),
+                    ck_tile::make_reference_fmha_kv_view(v_host_ref_t),
+                    o_host_ref,
+                    host_mask,
+                    static_cast<SMPLComputeDataType>(scale_s),
+                    bias_ref,
+                    lse_host_ref);
+            });
         }
         else
         {
-            ck_tile::reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
-                s_host_ref, p_host_ref, p_compute_element_func);
-        }
-
-        if(p_drop > 0)
-        {
-            ck_tile::HostTensor<RandValOutputDataType> randval_host_ref(
+            ck_tile::HostTensor<SMPLComputeDataType> s_host_ref(
                 {nhead, real_seqlen_q, real_seqlen_k});
-            randval_host_ref.ForEach([&](auto& self, auto idx) {
-                self(idx) = randval_host(b_idx, idx[0], idx[1] + query_offset, idx[2]);
+            ck_tile::HostTensor<PDataType> p_host_ref({nhead, real_seqlen_q, real_seqlen_k});
+
+            ck_tile::reference_batched_gemm<QDataType,
+                                            KDataType,
+                                            SaccDataType,
+                                            SMPLComputeDataType>(q_host_ref,
+                                                                 k_host_ref,
+                                                                 s_host_ref,
+                                                                 ck_tile::identity{},
+                                                                 ck_tile::identity{},
+                                                                 ck_tile::scales(scale_s));
+
+            if(bias.type == bias_enum::elementwise_bias)
+            {
+                // elementwise bias
+                ck_tile::HostTensor<BiasDataType> bias_host_ref({1, real_seqlen_q, real_seqlen_k});
+                // clang-format off
+                if(i_perm)
+                    bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, 0, i[1] + query_offset, i[2] + key_offset); });
+                else
+                    bias_host_ref.ForEach([&](auto& self, auto i) { self(i) = bias_host(0, i[1] + query_offset, 0, i[2] + key_offset); });
+                // clang-format on
+
+                // broadcast from [1, real_seqlen_q, real_seqlen_k] to [nhead, real_seqlen_q,
+                // real_seqlen_k]
+                ck_tile::reference_batched_elementwise<SMPLComputeDataType,
+                                                       BiasDataType,
+                                                       SMPLComputeDataType,
+                                                       SMPLComputeDataType>(
+                    s_host_ref, bias_host_ref, s_host_ref);
+            }
+            else if(bias.type == bias_enum::alibi)
+            {
+                // alibi construct elementwise bias to verify
+                ck_tile::HostTensor<SaccDataType> alibi_bias_host_ref(
+                    {nhead, real_seqlen_q, real_seqlen_k});
+                for(auto i_h = 0; i_h < nhead; i_h++)
+                {
+                    auto alibi_head = get_alibi_head(i_h);
+                    for(auto i_r = 0; i_r < real_seqlen_q; i_r++)
+                    {
+                        for(auto i_c = 0; i_c < real_seqlen_k; i_c++)
+                        {
+                            SaccDataType pixel = 0;
+                            alibi_head.update(pixel, i_r, i_c);
+                            alibi_bias_host_ref(i_h, i_r, i_c) = pixel;
+                        }
+                    }
+                }
+                // [nhead, real_seqlen_q, real_seqlen_k]
+                ck_tile::reference_batched_elementwise<SMPLComputeDataType,
+                                                       SaccDataType,
+                                                       SMPLComputeDataType,
+                                                       SMPLComputeDataType>(
+                    s_host_ref, alibi_bias_host_ref, s_host_ref);
+            }
+
+            with_host_mask([&](const auto& host_mask) {
+                ck_tile::reference_batched_masking<SaccDataType>(s_host_ref, host_mask);
             });
-            ck_tile::reference_batched_dropout(
-                p_host_ref, randval_host_ref, p_undrop_in_uint8_t, rp_undrop);
-        }
 
-        ck_tile::reference_batched_gemm<PDataType, VDataType, OaccDataType, ODataType>(
-            p_host_ref,
-            v_host_ref,
-            o_host_ref,
-            ck_tile::identity{},
-            ck_tile::identity{},
-            oacc_element_func);
+            if(lse)
+            {
+                ck_tile::
+                    reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
+                        s_host_ref, p_host_ref, p_compute_element_func, lse_host_ref);
+            }
+            else
+            {
+                ck_tile::
+                    reference_batched_softmax<SMPLComputeDataType, SMPLComputeDataType, PDataType>(
+                        s_host_ref, p_host_ref, p_compute_element_func);
+            }
+
+            if(p_drop > 0)
+            {
+                ck_tile::HostTensor<RandValOutputDataType> randval_host_ref(
+                    {nhead, real_seqlen_q, real_seqlen_k});
+                randval_host_ref.ForEach([&](auto& self, auto idx) {
+                    self(idx) = randval_host(b_idx, idx[0], idx[1] + query_offset, idx[2]);
+                });
+                ck_tile::reference_batched_dropout(
+                    p_host_ref, randval_host_ref, p_undrop_in_uint8_t, rp_undrop);
+            }
+
+            ck_tile::reference_batched_gemm<PDataType, VDataType, OaccDataType, ODataType>(
+                p_host_ref,
+                v_host_ref,
+                o_host_ref,
+                ck_tile::identity{},
+                ck_tile::identity{},
+                oacc_element_func);
+        }
 
         ck_tile::HostTensor<ODataType> o_host_result({nhead, real_seqlen_q, hdim_v});
         // clang-format off
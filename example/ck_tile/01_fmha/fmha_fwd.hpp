@@ -12,9 +12,13 @@
 #include "mask.hpp"
 #include "rotary.hpp"
 
+#include <iostream>
+#include <memory>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 struct FmhaFwdFp16
 {
@@ -414,6 +418,57 @@ auto fmha_fwd_create_kargs_and_grids(fmha_fwd_args args)
     }
 }
 
+// device pointers of a fmha_fwd() call, see fmha_fwd_launcher
+struct fmha_fwd_ptrs
+{
+    const void* q_ptr;
+    const void* k_ptr;
+    const void* v_ptr;
+    const void* bias_ptr; // bias or alibi_slope pointer
+    void* rand_val_ptr;
+    void* lse_ptr;
+    void* o_ptr;
+
+    const void* seqstart_q_ptr;
+    const void* seqstart_k_ptr;
+    const void* seqlen_k_ptr;
+};
+
+template <typename FmhaKernel>
+void fmha_fwd_set_ptrs(typename FmhaKernel::Kargs& kargs, const fmha_fwd_ptrs& ptrs)
+{
+    kargs.q_ptr = ptrs.q_ptr;
+    kargs.k_ptr = ptrs.k_ptr;
+    kargs.v_ptr = ptrs.v_ptr;
+    kargs.o_ptr = ptrs.o_ptr;
+
+    if constexpr(FmhaKernel::BiasEnum == ck_tile::BlockAttentionBiasEnum::ELEMENTWISE_BIAS)
+    {
+        kargs.bias_ptr = ptrs.bias_ptr;
+    }
+    else if constexpr(FmhaKernel::BiasEnum == ck_tile::BlockAttentionBiasEnum::ALIBI)
+    {
+        kargs.alibi_slope_ptr = ptrs.bias_ptr;
+    }
+    if constexpr(FmhaKernel::kStoreLSE)
+    {
+        kargs.lse_ptr = ptrs.lse_ptr;
+    }
+    if constexpr(FmhaKernel::kHasDropout)
+    {
+        kargs.rand_val_ptr = ptrs.rand_val_ptr;
+    }
+    if constexpr(FmhaKernel::kIsGroupMode)
+    {
+        // the grid layout depends on whether seqlen_k_ptr is set
+        assert((kargs.seqlen_k_ptr != nullptr) == (ptrs.seqlen_k_ptr != nullptr));
+
+        kargs.seqstart_q_ptr = reinterpret_cast<const int32_t*>(ptrs.seqstart_q_ptr);
+        kargs.seqstart_k_ptr = reinterpret_cast<const int32_t*>(ptrs.seqstart_k_ptr);
+        kargs.seqlen_k_ptr   = reinterpret_cast<const int32_t*>(ptrs.seqlen_k_ptr);
+    }
+}
+
 template <typename Kernel>
 auto fmha_fwd_splitkv_create_kargs_and_grids(fmha_fwd_splitkv_args args)
 {
@@ -793,6 +848,113 @@ struct fmha_fwd_traits
 };
 float fmha_fwd(fmha_fwd_traits, fmha_fwd_args, const ck_tile::stream_config&);
 
+// type erased kernel arguments of one kernel instance
+using fmha_fwd_kargs_ptr = std::unique_ptr<void, void (*)(void*)>;
+
+// type erased entry points of one kernel instance
+struct fmha_fwd_kernel
+{
+    std::string (*get_name)();
+    // creates the kernel arguments and launches the kernel, same as fmha_fwd_<>()
+    float (*run)(const ck_tile::stream_config&, fmha_fwd_args);
+    // creates the kernel arguments and grid once, for fmha_fwd_launcher
+    fmha_fwd_kargs_ptr (*make_kargs)(const fmha_fwd_args&, dim3& grids);
+    void (*set_ptrs)(void* kargs, const fmha_fwd_ptrs&);
+    float (*launch)(const ck_tile::stream_config&, const void* kargs, dim3 grids);
+};
+
+template <typename FmhaKernel>
+fmha_fwd_kernel fmha_fwd_make_kernel(float (*run)(const ck_tile::stream_config&, fmha_fwd_args))
+{
+    using Kargs = typename FmhaKernel::Kargs;
+
+    fmha_fwd_kernel kernel;
+    kernel.get_name   = [] { return FmhaKernel::GetName(); };
+    kernel.run        = run;
+    kernel.make_kargs = [](const fmha_fwd_args& args, dim3& grids) {
+        auto [kargs, grids_] = fmha_fwd_create_kargs_and_grids<FmhaKernel>(args);
+        grids                = grids_;
+        return fmha_fwd_kargs_ptr(new Kargs(kargs),
+                                  [](void* p) { delete static_cast<Kargs*>(p); });
+    };
+    kernel.set_ptrs = [](void* kargs, const fmha_fwd_ptrs& ptrs) {
+        fmha_fwd_set_ptrs<FmhaKernel>(*static_cast<Kargs*>(kargs), ptrs);
+    };
+    kernel.launch = [](const ck_tile::stream_config& s, const void* kargs, dim3 grids) {
+        if(s.log_level_ > 0)
+            std::cout << ", " << FmhaKernel::GetName() << std::flush;
+        constexpr dim3 blocks                  = FmhaKernel::BlockSize();
+        constexpr ck_tile::index_t kBlockPerCu = FmhaKernel::kBlockPerCu;
+        return ck_tile::launch_kernel(
+            s,
+            ck_tile::make_kernel<blocks.x, kBlockPerCu>(
+                FmhaKernel{}, grids, blocks, 0, *static_cast<const Kargs*>(kargs)));
+    };
+    return kernel;
+}
+
+template <typename Traits_>
+fmha_fwd_kernel fmha_fwd_get_kernel_();
+
+// The kernels of fmha_fwd() matching a fmha_fwd_traits, in dispatch order. Resolving the traits
+// once saves fmha_fwd() comparing them on every call; only the padding requirements of the
+// kernels depend on the shape of the args and are checked per call.
+struct fmha_fwd_plan
+{
+    struct candidate
+    {
+        bool (*is_supported)(const fmha_fwd_args&);
+        fmha_fwd_kernel kernel;
+    };
+
+    std::vector<candidate> candidates;
+
+    bool empty() const { return candidates.empty(); }
+
+    // the kernel fmha_fwd() launches for args, or nullptr if no kernel supports them
+    const fmha_fwd_kernel* select(const fmha_fwd_args& args) const
+    {
+        for(const auto& c : candidates)
+        {
+            if(c.is_supported(args))
+                return &c.kernel;
+        }
+        return nullptr;
+    }
+};
+
+// this is generated by script, like fmha_fwd()
+fmha_fwd_plan fmha_fwd_make_plan(const fmha_fwd_traits&);
+// fmha_fwd_make_plan() cached for the lifetime of the program, thread safe
+const fmha_fwd_plan& fmha_fwd_get_plan(const fmha_fwd_traits&);
+// returns -1 if no kernel of the plan supports the args, like fmha_fwd()
+float fmha_fwd(const fmha_fwd_plan&, fmha_fwd_args, const ck_tile::stream_config&);
+
+// A launch with the kernel arguments created once. Repeated calls that only change device
+// pointers patch them with set_ptrs(); in group mode the sequence lengths are read from device
+// memory, so one launcher serves all calls with the same batch size and max_seqlen_q. In batch
+// mode the sequence lengths are baked into the strides and grid, so calls with other sequence
+// lengths need a new fmha_fwd_prepare().
+struct fmha_fwd_launcher
+{
+    fmha_fwd_kernel kernel{};
+    fmha_fwd_kargs_ptr kargs{nullptr, [](void*) {}};
+    dim3 grids;
+
+    // false if no kernel supports the args the launcher was prepared for
+    explicit operator bool() const { return kargs != nullptr; }
+
+    void set_ptrs(const fmha_fwd_ptrs& ptrs) { kernel.set_ptrs(kargs.get(), ptrs); }
+
+    // returns -1 if the launcher has no kernel, like fmha_fwd()
+    float operator()(const ck_tile::stream_config& s) const
+    {
+        return *this ? kernel.launch(s, kargs.get(), grids) : -1;
+    }
+};
+
+fmha_fwd_launcher fmha_fwd_prepare(const fmha_fwd_plan&, const fmha_fwd_args&);
+
 struct fmha_fwd_splitkv_traits
 {
     int hdim_q;
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <numeric>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <time.h>
@@ -172,6 +173,7 @@ bool test_moe_sorting(ck_tile::ArgParser args)
         ck_tile::HostTensor<IndexType> sorted_expert_ids_ref({max_output_ids / unit_size}, {1});
 
         int32_t ref_total_tokens_post_pad = 0;
+        const auto ref_start              = std::chrono::steady_clock::now();
         ck_tile::reference_moe_sorting<WeightType, IndexType>(topk_ids_host,
                                                               weights_host,
                                                               sorted_ids_ref,
@@ -180,6 +182,12 @@ bool test_moe_sorting(ck_tile::ArgParser args)
                                                               ref_total_tokens_post_pad,
                                                               num_experts,
                                                               unit_size);
+        const double ref_ms = std::chrono::duration<double, std::milli>(
+                                  std::chrono::steady_clock::now() - ref_start)
+                                  .count();
+        printf("ref_ms:%f (%zu threads), ",
+               ref_ms,
+               ck_tile::host_thread_pool::instance().get_num_threads());
         rtn &= ck_tile::check_err(
             sorted_ids_host, sorted_ids_ref, std::string("OUT Error: Incorrect ids!"), 1e-6, 1e-6);
         rtn &= ck_tile::check_err(sorted_weights_host,
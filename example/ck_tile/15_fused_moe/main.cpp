@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <unordered_set>
 #include <vector>
@@ -420,6 +421,8 @@ bool run(const ck_tile::ArgParser& arg_parser)
                 experts,
                 block_m);
 
+            const auto ref_start = std::chrono::steady_clock::now();
+
             ck_tile::reference_fused_moe<AccDataType, ck_tile::element_wise::Gelu>(
                 a_host,
                 g_host,
@@ -442,6 +445,13 @@ bool run(const ck_tile::ArgParser& arg_parser)
                 topk,
                 gate_only);
 
+            const double ref_ms = std::chrono::duration<double, std::milli>(
+                                      std::chrono::steady_clock::now() - ref_start)
+                                      .count();
+            std::cout << ", ref: " << ref_ms << " ms ("
+                      << ck_tile::host_thread_pool::instance().get_num_threads() << " threads)"
+                      << std::flush;
+
             auto o_dev = o_buf.ToHost<ODataType>();
             // o_dev.savetxt("gpu-out.txt", "float");
             auto [rtol, atol] = get_elimit<ADataType>();
@@ -529,6 +539,8 @@ bool run(const ck_tile::ArgParser& arg_parser)
 
         if(do_validation)
         {
+            const auto ref_start = std::chrono::steady_clock::now();
+
             ck_tile::reference_fused_moe<AccDataType, ck_tile::element_wise::Gelu>(
                 a_host,
                 g_host,
@@ -551,6 +563,13 @@ bool run(const ck_tile::ArgParser& arg_parser)
                 topk,
                 gate_only);
 
+            const double ref_ms = std::chrono::duration<double, std::milli>(
+                                      std::chrono::steady_clock::now() - ref_start)
+                                      .count();
+            std::cout << ", ref: " << ref_ms << " ms ("
+                      << ck_tile::host_thread_pool::instance().get_num_threads() << " threads)"
+                      << std::flush;
+
             auto o_dev = o_buf.ToHost<ODataType>();
             // o_dev.savetxt("gpu-out.txt", "float");
             auto [rtol, atol] = get_elimit<ADataType>();
@@ -10,6 +10,7 @@
 #include "ck/ck.hpp"
 #include "ck/stream_config.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/kernel_launch.hpp"
 #include "ck/utility/flush_icache.hpp"
 namespace ck {
 namespace utility {
@@ -238,7 +239,21 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
 {
 #if CK_TIME_KERNEL
 #define MEDIAN 0
-    if(stream_config.time_kernel_)
+    if(stream_config.time_kernel_ && IsAdaptiveTiming(stream_config))
+    {
+        const float time = launch_and_time_kernel_adaptive(stream_config, [&] {
+            preprocess();
+            kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(gemm_args, args...);
+            hip_check_error(hipGetLastError());
+        });
+
+        // same correction for the time of preprocess as below
+        hipDeviceProp_t deviceProps;
+        hip_check_error(hipGetDeviceProperties(&deviceProps, 0));
+        float preprocess_offset = deviceProps.multiProcessorCount == 80 ? 0.005 : 0.01;
+        return time - preprocess_offset;
+    }
+    else if(stream_config.time_kernel_)
     {
         if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
         {
@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "ck/ck.hpp"
+#include "ck/stream_config.hpp"
+
+// Counterpart of launch_and_time_kernel() for operations that run on the host CPU. The host work
+// is synchronous, so stream_config.stream_id_ is not used. With stream_config.time_kernel_ the
+// work is run cold_niters_ times to warm up and then nrepeat_ times, and the average wall-clock
+// time in ms is returned.
+template <typename F>
+float launch_and_time_host_kernel(const StreamConfig& stream_config, F&& kernel)
+{
+#if CK_TIME_KERNEL
+    if(stream_config.time_kernel_)
+    {
+        if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
+        {
+            printf("%s: warm up %d times\n", __func__, stream_config.cold_niters_);
+        }
+
+        for(int i = 0; i < stream_config.cold_niters_; ++i)
+        {
+            kernel();
+        }
+
+        const int nrepeat = std::max(stream_config.nrepeat_, 1);
+
+        if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
+        {
+            printf("Start running %d times...\n", nrepeat);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        for(int i = 0; i < nrepeat; ++i)
+        {
+            kernel();
+        }
+
+        const std::chrono::duration<float, std::milli> total_time =
+            std::chrono::steady_clock::now() - start;
+
+        return total_time.count() / nrepeat;
+    }
+#else
+    (void)stream_config;
+#endif
+
+    kernel();
+
+    return 0;
+}
@@ -4,10 +4,104 @@
 #pragma once
 
 #include <hip/hip_runtime.h>
+#include <algorithm>
+#include <cmath>
 
 #include "ck/ck.hpp"
 #include "ck/stream_config.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/timing_statistics.hpp"
+
+// Whether a timed launch with stream_config is timed adaptively, either requested by the caller
+// or for the whole process with ck::utility::GetAdaptiveTimingOverride().
+inline bool IsAdaptiveTiming(const StreamConfig& stream_config)
+{
+    return stream_config.adaptive_timing_ || ck::utility::GetAdaptiveTimingOverride().enabled;
+}
+
+// Times launch() in samples of one or more launches with hip events until the confidence interval
+// of the median reaches the target of stream_config, see StreamConfig::adaptive_timing_, and
+// returns the median time of a launch in ms.
+template <typename LaunchFunc>
+float launch_and_time_kernel_adaptive(const StreamConfig& stream_config, LaunchFunc launch)
+{
+    // shorter samples are dominated by the overhead of the events
+    constexpr float min_sample_ms = 0.1f;
+
+    hipEvent_t start, stop;
+
+    hip_check_error(hipEventCreate(&start));
+    hip_check_error(hipEventCreate(&stop));
+
+    const auto time_launches = [&](int nlaunch) {
+        hip_check_error(hipEventRecord(start, stream_config.stream_id_));
+
+        for(int i = 0; i < nlaunch; ++i)
+        {
+            launch();
+        }
+
+        hip_check_error(hipEventRecord(stop, stream_config.stream_id_));
+        hip_check_error(hipEventSynchronize(stop));
+
+        float time = 0;
+
+        hip_check_error(hipEventElapsedTime(&time, start, stop));
+
+        return time;
+    };
+
+    hip_check_error(hipDeviceSynchronize());
+
+    // the warm up estimates how many launches a sample needs
+    const int cold_niters = std::max(stream_config.cold_niters_, 1);
+    const float warmup_ms = time_launches(cold_niters) / cold_niters;
+
+    const int nlaunch_per_sample =
+        warmup_ms > 0 ? std::clamp(static_cast<int>(std::ceil(min_sample_ms / warmup_ms)), 1, 100)
+                      : 100;
+
+    // the settings of the caller take precedence over the process wide ones
+    const auto& global = ck::utility::GetAdaptiveTimingOverride();
+
+    ck::utility::TimingConfig config;
+
+    config.min_samples = stream_config.nrepeat_;
+    config.max_samples =
+        stream_config.adaptive_timing_ ? stream_config.max_nrepeat_ : global.max_samples;
+    config.target_relative_ci = stream_config.adaptive_timing_ ? stream_config.target_relative_ci_
+                                                               : global.target_relative_ci;
+
+    auto summary = ck::utility::RunAdaptiveTiming(
+        config, [&] { return time_launches(nlaunch_per_sample) / nlaunch_per_sample; });
+
+    summary.num_launches *= nlaunch_per_sample;
+
+    hip_check_error(hipEventDestroy(start));
+    hip_check_error(hipEventDestroy(stop));
+
+    if(global.enabled || ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
+    {
+        printf("%d samples of %d launches (%d outliers), median %f ms, p10 %f ms, p90 %f ms, "
+               "CI [%f, %f] ms%s\n",
+               summary.num_samples + summary.num_outliers,
+               nlaunch_per_sample,
+               summary.num_outliers,
+               summary.median,
+               summary.p10,
+               summary.p90,
+               summary.ci_low,
+               summary.ci_high,
+               summary.converged ? "" : ", not converged");
+    }
+
+    if(stream_config.timing_summary_ != nullptr)
+    {
+        *stream_config.timing_summary_ = summary;
+    }
+
+    return summary.median;
+}
 
 template <typename... Args, typename F>
 float launch_and_time_kernel(const StreamConfig& stream_config,
@@ -18,7 +112,14 @@ float launch_and_time_kernel(const StreamConfig& stream_config,
                              Args... args)
 {
 #if CK_TIME_KERNEL
-    if(stream_config.time_kernel_)
+    if(stream_config.time_kernel_ && IsAdaptiveTiming(stream_config))
+    {
+        return launch_and_time_kernel_adaptive(stream_config, [&] {
+            kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+            hip_check_error(hipGetLastError());
+        });
+    }
+    else if(stream_config.time_kernel_)
     {
         if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
         {
@@ -96,7 +197,15 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
                                              Args... args)
 {
 #if CK_TIME_KERNEL
-    if(stream_config.time_kernel_)
+    if(stream_config.time_kernel_ && IsAdaptiveTiming(stream_config))
+    {
+        return launch_and_time_kernel_adaptive(stream_config, [&] {
+            preprocess();
+            kernel<<<grid_dim, block_dim, lds_byte, stream_config.stream_id_>>>(args...);
+            hip_check_error(hipGetLastError());
+        });
+    }
+    else if(stream_config.time_kernel_)
     {
         if(ck::EnvIsEnabled(CK_ENV(CK_LOGGING)))
         {
@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/grid/block_to_ctile_map.hpp"
+#include "ck/library/utility/host_l2_cache_simulator.hpp"
+
+namespace ck {
+namespace utils {
+
+// Schedule of a data-parallel map (BlockToCTileMap_M00_N0_M01Adapt,
+// BlockToCTileMap_N00_M0_N01Adapt, BlockToCTileMap_Grouped_M00_N0_M01Adapt, ...): block i of
+// map.CalculateGridSize(M, N) computes the whole K loop of tile map.CalculateBottomIndex(i).
+// Blocks mapped outside of the C grid get no work, as the kernels skip them. The block tile of
+// problem has to be the one of the map.
+template <typename BlockToCTileMap>
+TileSchedule MakeDataParallelTileSchedule(const BlockToCTileMap& map,
+                                          const TileScheduleProblem& problem)
+{
+    const index_t M0        = math::integer_divide_ceil(problem.M, problem.MPerBlock);
+    const index_t N0        = math::integer_divide_ceil(problem.N, problem.NPerBlock);
+    const index_t num_k_itr = math::integer_divide_ceil(problem.K, problem.KPerBlock);
+
+    const index_t grid_size = map.CalculateGridSize(problem.M, problem.N);
+
+    TileSchedule schedule(grid_size);
+
+    for(index_t block_id = 0; block_id < grid_size; ++block_id)
+    {
+        const auto idx = map.CalculateBottomIndex(make_multi_index(block_id));
+
+        const index_t m_tile = idx[Number<0>{}];
+        const index_t n_tile = idx[Number<1>{}];
+
+        if(m_tile < 0 || m_tile >= M0 || n_tile < 0 || n_tile >= N0)
+            continue;
+
+        schedule[block_id].push_back(TileWorkItem{m_tile, n_tile, 0, num_k_itr});
+    }
+
+    return schedule;
+}
+
+// Schedule of the stream-K maps (BlockToCTileMap_GemmStreamK, BlockToCTileMap_GemmStreamK_v2).
+// Replays on the host what get_block_itr(), get_current_iter_length() and tile_to_spatial() do
+// on the device: every stream-K and data-parallel block walks its K iteration range from the
+// end, one tile segment at a time. The reduction blocks do not read A or B and are left out.
+template <typename StreamKMap>
+TileSchedule MakeStreamKTileSchedule(const StreamKMap& map, const TileScheduleProblem& problem)
+{
+    constexpr std::uint32_t tile_swizzle_sub_m = StreamKMap::tile_swizzle_sub_m;
+
+    const std::uint32_t k_iters_per_tile = map.k_iters_per_tile.get();
+    const std::uint32_t sk_total_iters   = map.get_sk_total_iters();
+    const std::uint32_t m_tiles = math::integer_divide_ceil(problem.M, StreamKMap::MPerBlock);
+    const std::uint32_t n_tiles = math::integer_divide_ceil(problem.N, StreamKMap::NPerBlock);
+
+    // tile_to_spatial()
+    const auto tile_to_spatial = [&](std::uint32_t tile_idx) {
+        const std::uint32_t m_tile_idx = tile_idx / n_tiles;
+        const std::uint32_t n_tile_idx = tile_idx % n_tiles;
+
+        const std::uint32_t sub_m_rem   = m_tiles % tile_swizzle_sub_m;
+        const std::uint32_t sub_m_adapt =
+            m_tile_idx < m_tiles - sub_m_rem ? tile_swizzle_sub_m : sub_m_rem;
+
+        const std::uint32_t tile_idx_local =
+            n_tile_idx + m_tile_idx % tile_swizzle_sub_m * n_tiles;
+
+        return TileWorkItem{tile_idx_local % sub_m_adapt +
+                                m_tile_idx / tile_swizzle_sub_m * tile_swizzle_sub_m,
+                            tile_idx_local / sub_m_adapt,
+                            0,
+                            0};
+    };
+
+    const std::uint32_t grid_size = map.reduction_start_block_idx;
+
+    TileSchedule schedule(grid_size);
+
+    for(std::uint32_t block_idx = 0; block_idx < grid_size; ++block_idx)
+    {
+        // get_block_itr()
+        std::uint32_t iter_start = 0;
+        std::uint32_t iter_end   = 0;
+
+        if(block_idx < map.sk_num_big_blocks)
+        {
+            iter_start = block_idx * map.k_iters_per_big_block;
+            iter_end   = iter_start + map.k_iters_per_big_block;
+        }
+        else if(block_idx < map.sk_num_blocks)
+        {
+            iter_start = map.sk_num_big_blocks * map.k_iters_per_big_block +
+                         (block_idx - map.sk_num_big_blocks) * (map.k_iters_per_big_block - 1);
+            iter_end = iter_start + map.k_iters_per_big_block - 1;
+        }
+        else if(block_idx >= map.dp_start_block_idx)
+        {
+            iter_start = sk_total_iters + (block_idx - map.dp_start_block_idx) * k_iters_per_tile;
+            iter_end   = iter_start + k_iters_per_tile;
+        }
+
+        const std::uint32_t total_iter_length = iter_end - iter_start;
+
+        while(iter_end > iter_start)
+        {
+            // get_current_iter_length()
+            const std::uint32_t iter_length_mod = iter_end % k_iters_per_tile;
+            const std::uint32_t length          = std::min(
+                iter_length_mod == 0 ? iter_end - iter_start : iter_length_mod, total_iter_length);
+
+            const std::uint32_t tile_idx    = (iter_end - 1) / k_iters_per_tile;
+            const std::uint32_t iter_offset = (iter_end - 1) % k_iters_per_tile + 1 - length;
+
+            auto item         = tile_to_spatial(tile_idx);
+            item.k_iter_begin = iter_offset;
+            item.k_iter_end   = iter_offset + length;
+
+            schedule[block_idx].push_back(item);
+
+            iter_end -= length;
+        }
+    }
+
+    return schedule;
+}
+
+struct TileMapSweepResult
+{
+    index_t M01 = 0;
+    CacheSimulationResult result;
+};
+
+// Simulates BlockToCTileMap_M00_N0_M01Adapt for every M01 in m01_candidates and returns the
+// results in the same order.
+template <index_t MPerBlock, index_t NPerBlock>
+std::vector<TileMapSweepResult> SweepM01AdaptTileMap(const TileScheduleProblem& problem,
+                                                     const CacheConfig& cache_config,
+                                                     const std::vector<index_t>& m01_candidates)
+{
+    if(problem.MPerBlock != MPerBlock || problem.NPerBlock != NPerBlock)
+        throw std::invalid_argument("SweepM01AdaptTileMap: block tile differs from the problem");
+
+    std::vector<TileMapSweepResult> results;
+
+    for(const index_t M01 : m01_candidates)
+    {
+        const BlockToCTileMap_M00_N0_M01Adapt<MPerBlock, NPerBlock> map(problem.M, problem.N, M01);
+
+        results.push_back(
+            {M01,
+             SimulateTileScheduleCache(
+                 MakeDataParallelTileSchedule(map, problem), problem, cache_config)});
+    }
+
+    return results;
+}
+
+// Same as SweepM01AdaptTileMap() for BlockToCTileMap_Grouped_M00_N0_M01Adapt<GroupNum, ...>
+template <index_t GroupNum, index_t MPerBlock, index_t NPerBlock>
+std::vector<TileMapSweepResult>
+SweepGroupedM01AdaptTileMap(const TileScheduleProblem& problem,
+                            const CacheConfig& cache_config,
+                            const std::vector<index_t>& m01_candidates)
+{
+    if(problem.MPerBlock != MPerBlock || problem.NPerBlock != NPerBlock)
+        throw std::invalid_argument(
+            "SweepGroupedM01AdaptTileMap: block tile differs from the problem");
+
+    std::vector<TileMapSweepResult> results;
+
+    for(const index_t M01 : m01_candidates)
+    {
+        const BlockToCTileMap_Grouped_M00_N0_M01Adapt<GroupNum, MPerBlock, NPerBlock> map(
+            problem.M, problem.N, M01);
+
+        results.push_back(
+            {M01,
+             SimulateTileScheduleCache(
+                 MakeDataParallelTileSchedule(map, problem), problem, cache_config)});
+    }
+
+    return results;
+}
+
+// The sweep entry with the least DRAM traffic, the first one on ties
+inline const TileMapSweepResult& GetBestTileMapSweepResult(
+    const std::vector<TileMapSweepResult>& results)
+{
+    if(results.empty())
+        throw std::invalid_argument("GetBestTileMapSweepResult: no results");
+
+    const TileMapSweepResult* best = &results.front();
+
+    for(const auto& r : results)
+        if(r.result.GetDramBytes() < best->result.GetDramBytes())
+            best = &r;
+
+    return *best;
+}
+
+} // namespace utils
+} // namespace ck
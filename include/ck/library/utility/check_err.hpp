@@ -4,12 +4,18 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <numeric>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -18,6 +24,8 @@
 #include "ck/utility/type.hpp"
 #include "ck/host_utility/io.hpp"
 
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/utility/host_type_convert.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 namespace ck {
@@ -147,6 +155,440 @@ double get_absolute_threshold(const double max_possible_num, const int number_of
     return std::max(acc_error, midway_error);
 }
 
+struct CheckErrOptions
+{
+    // number of mismatches whose position and values are kept in the report
+    std::size_t max_recorded_errors = 4;
+    // stop comparing once at least this many mismatches were found, 0 compares all elements
+    std::size_t max_errors = 0;
+    // collect max_abs_err, max_rel_err and ulp_histogram, otherwise only the mismatches are
+    // counted and recorded
+    bool statistics = true;
+};
+
+struct CheckErrMismatch
+{
+    std::size_t index;
+    // multi-index of the element, only filled when the compared ranges are tensors
+    std::vector<std::size_t> coord;
+    double out;
+    double ref;
+};
+
+struct CheckErrReport
+{
+    // Bin 0 counts bit-exact elements and bin b counts elements that are [2^(b-1), 2^b) units in
+    // the last place apart. The last bin also counts the elements with non-finite values.
+    static constexpr std::size_t kNumUlpBin = 18;
+
+    bool IsPassed() const { return !size_mismatch && num_error == 0; }
+
+    double GetErrorPercent() const
+    {
+        return num_checked == 0 ? 0 : 100. * static_cast<double>(num_error) / num_checked;
+    }
+
+    // prints the recorded mismatches and a summary, prints nothing for a passed comparison
+    void Print(std::ostream& os, const std::string& msg = "Error: Incorrect results!") const
+    {
+        if(size_mismatch)
+        {
+            os << msg << " out.size() != ref.size(), :" << num_out_element
+               << " != " << num_element << std::endl;
+            return;
+        }
+
+        if(IsPassed())
+            return;
+
+        const auto print_value = [&](double v) {
+            if(integer_values)
+                os << static_cast<int64_t>(v);
+            else
+                os << v;
+        };
+
+        for(const auto& mismatch : mismatches)
+        {
+            os << msg << std::setw(12) << std::setprecision(7) << " out[" << mismatch.index
+               << "] != ref[" << mismatch.index << "]: ";
+            print_value(mismatch.out);
+            os << " != ";
+            print_value(mismatch.ref);
+
+            if(!mismatch.coord.empty())
+            {
+                os << " at (";
+                for(std::size_t d = 0; d < mismatch.coord.size(); ++d)
+                    os << (d == 0 ? "" : ", ") << mismatch.coord[d];
+                os << ")";
+            }
+            os << std::endl;
+        }
+
+        os << "max err: " << max_error_abs_err;
+        os << ", number of errors: " << num_error;
+        os << ", " << GetErrorPercent() << "% wrong values";
+
+        if(early_exit)
+            os << " (stopped after " << num_checked << " of " << num_element << " values)";
+        os << std::endl;
+    }
+
+    bool size_mismatch  = false;
+    bool early_exit     = false;
+    bool integer_values = false;
+
+    std::size_t num_out_element = 0;
+    std::size_t num_element     = 0;
+    std::size_t num_checked     = 0;
+    std::size_t num_error       = 0;
+
+    // largest errors over all compared finite values
+    double max_abs_err = 0;
+    double max_rel_err = 0;
+    // largest absolute error over the mismatches
+    double max_error_abs_err = 0;
+
+    std::array<std::size_t, kNumUlpBin> ulp_histogram{};
+
+    // first mismatches in the order of the compared ranges
+    std::vector<CheckErrMismatch> mismatches;
+};
+
+namespace detail {
+
+// data types compared as integers, the other data types are compared through float/double
+template <typename T>
+constexpr bool IsIntegerCheck()
+{
+    return (std::is_integral_v<T> && !std::is_same_v<T, bhalf_t> && !std::is_same_v<T, f8_t> &&
+            !std::is_same_v<T, bf8_t>)
+#ifdef CK_EXPERIMENTAL_BIT_INT_EXTENSION_INT4
+           || std::is_same_v<T, int4_t>
+#endif
+        ;
+}
+
+template <typename T>
+double ToCheckErrDouble(const T& v)
+{
+    if constexpr(IsIntegerCheck<T>())
+        return static_cast<double>(static_cast<int64_t>(v));
+    else if constexpr(std::is_same_v<T, float> || std::is_same_v<T, double>)
+        return v;
+    else if constexpr(IsFloat8Type<T>())
+        return GetConvertLut<TypeConvertOp, float, T>()[GetConvertLutIndex(v)];
+    else
+        return type_convert<float>(v);
+}
+
+template <typename T>
+uint64_t GetBits(const T& v)
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "unsupported data type");
+
+    uint64_t bits = 0;
+    std::memcpy(&bits, &v, sizeof(T));
+    return bits;
+}
+
+// distance between the representations of two values, negative values are mirrored so that the
+// distance between values of different signs passes through zero
+template <typename T>
+uint64_t GetUlpDistance(const T& o, const T& r)
+{
+    if constexpr(IsIntegerCheck<T>())
+    {
+        const int64_t d = static_cast<int64_t>(o) - static_cast<int64_t>(r);
+        return d < 0 ? -static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
+    }
+    else
+    {
+        const auto to_ordered = [](const T& v) {
+            const uint64_t bits = GetBits(v);
+            const uint64_t sign = uint64_t{1} << (8 * sizeof(T) - 1);
+            const auto mag      = static_cast<int64_t>(bits & (sign - 1));
+
+            return (bits & sign) ? -mag : mag;
+        };
+
+        const int64_t d = to_ordered(o) - to_ordered(r);
+        return d < 0 ? -static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
+    }
+}
+
+inline std::size_t GetUlpBin(uint64_t ulp)
+{
+    const std::size_t bin = ulp == 0 ? 0 : 64 - __builtin_clzll(ulp);
+    return std::min(bin, CheckErrReport::kNumUlpBin - 1);
+}
+
+template <typename Range, typename = void>
+struct HasTensorLayout : std::false_type
+{
+};
+
+template <typename Range>
+struct HasTensorLayout<Range,
+                       std::void_t<decltype(std::declval<const Range&>().GetLengths()),
+                                   decltype(std::declval<const Range&>().GetStrides())>>
+    : std::true_type
+{
+};
+
+// multi-index of the element at an offset into the element space, visits the dimensions from the
+// largest to the smallest stride so the result is exact for non-overlapping layouts
+template <typename Lengths, typename Strides>
+std::vector<std::size_t>
+GetMultiIndexFromOffset(const Lengths& lengths, const Strides& strides, std::size_t offset)
+{
+    const std::size_t rank = std::size(lengths);
+
+    std::vector<std::size_t> order(rank);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return strides[a] > strides[b];
+    });
+
+    std::vector<std::size_t> idx(rank, 0);
+
+    for(std::size_t d : order)
+    {
+        const std::size_t stride = strides[d];
+
+        if(stride == 0 || lengths[d] == 0)
+            continue;
+
+        idx[d] = std::min<std::size_t>(offset / stride, lengths[d] - 1);
+        offset -= idx[d] * stride;
+    }
+
+    return idx;
+}
+
+inline constexpr std::size_t kCheckErrChunkSize = 1 << 16;
+
+// check_err() only prints the first mismatches and the number of mismatches
+inline constexpr CheckErrOptions kCheckErrOptions{4, 0, false};
+
+// Compares out and ref in parallel chunks, is_error(o, r, o_double, r_double, abs_err) decides
+// whether a pair of elements is a mismatch.
+template <typename Range, typename RefRange, typename IsError>
+CheckErrReport CheckErrImpl(const Range& out,
+                            const RefRange& ref,
+                            IsError&& is_error,
+                            const CheckErrOptions& options)
+{
+    using T = ranges::range_value_t<Range>;
+
+    CheckErrReport report;
+    report.integer_values  = IsIntegerCheck<T>();
+    report.num_out_element = out.size();
+    report.num_element     = ref.size();
+
+    if(out.size() != ref.size())
+    {
+        report.size_mismatch = true;
+        return report;
+    }
+
+    const std::size_t n         = ref.size();
+    const std::size_t num_chunk = (n + kCheckErrChunkSize - 1) / kCheckErrChunkSize;
+
+    std::vector<CheckErrReport> partials(num_chunk);
+    std::atomic<std::size_t> num_error{0};
+
+    auto check_chunk = [&](std::size_t chunk) {
+        CheckErrReport& p = partials[chunk];
+
+        if(options.max_errors > 0 &&
+           num_error.load(std::memory_order_relaxed) >= options.max_errors)
+        {
+            p.early_exit = true;
+            return;
+        }
+
+        const std::size_t begin = chunk * kCheckErrChunkSize;
+        const std::size_t end   = std::min(begin + kCheckErrChunkSize, n);
+
+        const auto o_begin = std::next(std::begin(out), begin);
+        const auto r_begin = std::next(std::begin(ref), begin);
+
+        p.num_checked = end - begin;
+
+        // the first pass only counts, the following passes run for chunks with mismatches or,
+        // for the statistics, with elements that are not bit-exact
+        std::size_t num_bad   = 0;
+        std::size_t num_exact = 0;
+        double max_abs_err    = 0;
+        double max_rel_err    = 0;
+
+        auto o_iter = o_begin;
+        auto r_iter = r_begin;
+
+        for(std::size_t i = begin; i < end; ++i, ++o_iter, ++r_iter)
+        {
+            const T o = *o_iter;
+            const T r = *r_iter;
+
+            const double o_double = ToCheckErrDouble(o);
+            const double r_double = ToCheckErrDouble(r);
+            const double err      = std::abs(o_double - r_double);
+
+            num_bad += is_error(o, r, o_double, r_double, err);
+
+            if(!options.statistics)
+                continue;
+
+            num_exact += GetBits(o) == GetBits(r);
+
+            if(std::isfinite(o_double) && std::isfinite(r_double))
+            {
+                max_abs_err = std::max(max_abs_err, err);
+
+                // only divide when the relative error grows
+                if(err > max_rel_err * std::abs(r_double))
+                    max_rel_err = r_double != 0 ? err / std::abs(r_double)
+                                                : std::numeric_limits<double>::infinity();
+            }
+        }
+
+        p.num_error = num_bad;
+        num_error.fetch_add(num_bad, std::memory_order_relaxed);
+
+        if(options.statistics)
+        {
+            p.max_abs_err = max_abs_err;
+            p.max_rel_err = max_rel_err;
+
+            if(num_exact == end - begin)
+            {
+                p.ulp_histogram[0] = num_exact;
+            }
+            else
+            {
+                // counted in a local array that stays in registers or cache
+                std::array<std::size_t, CheckErrReport::kNumUlpBin> ulp_histogram{};
+
+                o_iter = o_begin;
+                r_iter = r_begin;
+
+                for(std::size_t i = begin; i < end; ++i, ++o_iter, ++r_iter)
+                {
+                    const T o = *o_iter;
+                    const T r = *r_iter;
+
+                    const bool finite = std::isfinite(ToCheckErrDouble(o)) &&
+                                        std::isfinite(ToCheckErrDouble(r));
+
+                    ++ulp_histogram[finite ? GetUlpBin(GetUlpDistance(o, r))
+                                           : CheckErrReport::kNumUlpBin - 1];
+                }
+
+                p.ulp_histogram = ulp_histogram;
+            }
+        }
+
+        if(p.num_error == 0)
+            return;
+
+        o_iter = o_begin;
+        r_iter = r_begin;
+
+        for(std::size_t i = begin; i < end; ++i, ++o_iter, ++r_iter)
+        {
+            const T o = *o_iter;
+            const T r = *r_iter;
+
+            const double o_double = ToCheckErrDouble(o);
+            const double r_double = ToCheckErrDouble(r);
+            const double err      = std::abs(o_double - r_double);
+
+            if(is_error(o, r, o_double, r_double, err))
+            {
+                p.max_error_abs_err = err > p.max_error_abs_err ? err : p.max_error_abs_err;
+
+                if(p.mismatches.size() < options.max_recorded_errors)
+                    p.mismatches.push_back({i, {}, o_double, r_double});
+            }
+        }
+    };
+
+    HostThreadPool::Instance().ParallelFor(num_chunk, 0, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t chunk = begin; chunk < end; ++chunk)
+            check_chunk(chunk);
+    });
+
+    // merge in chunk order, so the recorded mismatches are the first ones
+    for(auto& p : partials)
+    {
+        report.early_exit = report.early_exit || p.early_exit;
+        report.num_checked += p.num_checked;
+        report.num_error += p.num_error;
+        report.max_abs_err       = std::max(report.max_abs_err, p.max_abs_err);
+        report.max_rel_err       = std::max(report.max_rel_err, p.max_rel_err);
+        report.max_error_abs_err = std::max(report.max_error_abs_err, p.max_error_abs_err);
+
+        for(std::size_t b = 0; b < CheckErrReport::kNumUlpBin; ++b)
+            report.ulp_histogram[b] += p.ulp_histogram[b];
+
+        for(auto& mismatch : p.mismatches)
+        {
+            if(report.mismatches.size() < options.max_recorded_errors)
+                report.mismatches.push_back(std::move(mismatch));
+        }
+    }
+
+    if constexpr(HasTensorLayout<Range>::value)
+    {
+        for(auto& mismatch : report.mismatches)
+            mismatch.coord =
+                GetMultiIndexFromOffset(out.GetLengths(), out.GetStrides(), mismatch.index);
+    }
+
+    return report;
+}
+
+} // namespace detail
+
+// Compares out with ref using multiple host threads and returns a summary of the errors.
+// Integer data types fail for an absolute difference larger than atol, the other data types fail
+// for an error larger than atol + rtol * |ref| or for non-finite values, like check_err().
+template <typename Range, typename RefRange>
+std::enable_if_t<std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>>,
+                 CheckErrReport>
+check_err_report(const Range& out,
+                 const RefRange& ref,
+                 double rtol                    = 1e-5,
+                 double atol                    = 3e-6,
+                 const CheckErrOptions& options = {})
+{
+    using T = ranges::range_value_t<Range>;
+
+    if constexpr(detail::IsIntegerCheck<T>())
+    {
+        return detail::CheckErrImpl(
+            out,
+            ref,
+            [=](const T& o, const T& r, double, double, double) {
+                const int64_t err = std::abs(static_cast<int64_t>(o) - static_cast<int64_t>(r));
+                return err > atol;
+            },
+            options);
+    }
+    else
+    {
+        return detail::CheckErrImpl(
+            out,
+            ref,
+            [=](const T&, const T&, double o, double r, double err) {
+                return err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r);
+            },
+            options);
+    }
+}
+
 template <typename Range, typename RefRange>
 typename std::enable_if<
     std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
@@ -159,43 +601,10 @@ check_err(const Range& out,
           double rtol            = 1e-5,
           double atol            = 3e-6)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
+    const auto report = check_err_report(out, ref, rtol, atol, detail::kCheckErrOptions);
+    report.Print(std::cerr, msg);
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<double>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = *std::next(std::begin(out), i);
-        const double r = *std::next(std::begin(ref), i);
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return report.IsPassed();
 }
 
 template <typename Range, typename RefRange>
@@ -209,44 +618,10 @@ check_err(const Range& out,
           double rtol            = 1e-1,
           double atol            = 1e-3)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
+    const auto report = check_err_report(out, ref, rtol, atol, detail::kCheckErrOptions);
+    report.Print(std::cerr, msg);
 
-    bool res{true};
-    int err_count = 0;
-    double err    = 0;
-    // TODO: This is a hack. We should have proper specialization for bhalf_t data type.
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return report.IsPassed();
 }
 
 template <typename Range, typename RefRange>
@@ -260,43 +635,10 @@ check_err(const Range& out,
           double rtol            = 1e-3,
           double atol            = 1e-3)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
+    const auto report = check_err_report(out, ref, rtol, atol, detail::kCheckErrOptions);
+    report.Print(std::cerr, msg);
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = NumericLimits<ranges::range_value_t<Range>>::Min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return report.IsPassed();
 }
 
 template <typename Range, typename RefRange>
@@ -316,44 +658,10 @@ check_err(const Range& out,
           double                 = 0,
           double atol            = 0)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
+    const auto report = check_err_report(out, ref, 0, atol, detail::kCheckErrOptions);
+    report.Print(std::cerr, msg);
 
-    bool res{true};
-    int err_count   = 0;
-    int64_t err     = 0;
-    int64_t max_err = std::numeric_limits<int64_t>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const int64_t o = *std::next(std::begin(out), i);
-        const int64_t r = *std::next(std::begin(ref), i);
-        err             = std::abs(o - r);
-
-        if(err > atol)
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << " out[" << i << "] != ref[" << i << "]: " << o << " != " << r
-                          << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return report.IsPassed();
 }
 
 template <typename Range, typename RefRange>
@@ -366,43 +674,10 @@ check_err(const Range& out,
           double rtol            = 1e-3,
           double atol            = 1e-3)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
-
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
+    const auto report = check_err_report(out, ref, rtol, atol, detail::kCheckErrOptions);
+    report.Print(std::cerr, msg);
 
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err
-                  << " number of errors: " << err_count << std::endl;
-    }
-    return res;
+    return report.IsPassed();
 }
 
 template <typename Range, typename RefRange>
@@ -415,39 +690,10 @@ check_err(const Range& out,
           double rtol            = 1e-3,
           double atol            = 1e-3)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
+    const auto report = check_err_report(out, ref, rtol, atol, detail::kCheckErrOptions);
+    report.Print(std::cerr, msg);
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || !std::isfinite(o) || !std::isfinite(r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    return report.IsPassed();
 }
 
 } // namespace utils
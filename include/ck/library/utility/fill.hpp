@@ -5,12 +5,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <random>
 #include <type_traits>
 #include <utility>
 
 #include "ck/utility/data_type.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
 
 namespace ck {
 namespace utils {
@@ -85,6 +87,230 @@ struct FillUniformDistributionIntegerValue
     }
 };
 
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1,
+// 2, 3"). Block k of the stream is computed from (seed, k) alone, so any part of a tensor can be
+// generated independently.
+struct Philox4x32
+{
+    explicit Philox4x32(uint64_t seed)
+        : mKey0(static_cast<uint32_t>(seed)), mKey1(static_cast<uint32_t>(seed >> 32))
+    {
+    }
+
+    // writes the 4 words of each of the blocks [first_block, first_block + num_block) to out
+    void Generate(uint64_t first_block, std::size_t num_block, uint32_t* out) const
+    {
+        // no data dependent branches, the loop over the blocks can be vectorized
+        for(std::size_t b = 0; b < num_block; ++b)
+        {
+            const uint64_t counter = first_block + b;
+
+            uint32_t c0 = static_cast<uint32_t>(counter);
+            uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+            uint32_t c2 = 0;
+            uint32_t c3 = 0;
+            uint32_t k0 = mKey0;
+            uint32_t k1 = mKey1;
+
+            for(int round = 0; round < 10; ++round)
+            {
+                const uint64_t p0 = static_cast<uint64_t>(kMul0) * c0;
+                const uint64_t p1 = static_cast<uint64_t>(kMul1) * c2;
+
+                c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                c1 = static_cast<uint32_t>(p1);
+                c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                c3 = static_cast<uint32_t>(p0);
+
+                k0 += kWeyl0;
+                k1 += kWeyl1;
+            }
+
+            out[4 * b + 0] = c0;
+            out[4 * b + 1] = c1;
+            out[4 * b + 2] = c2;
+            out[4 * b + 3] = c3;
+        }
+    }
+
+    // uniform float in [0, 1) from the upper 24 bits of a word
+    static float ToUniform(uint32_t word) { return static_cast<float>(word >> 8) * 0x1p-24f; }
+
+    private:
+    static constexpr uint32_t kMul0  = 0xD2511F53;
+    static constexpr uint32_t kMul1  = 0xCD9E8D57;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+    uint32_t mKey0;
+    uint32_t mKey1;
+};
+
+// Fills [first, last) on the host thread pool. Element i is g(words) where words points to the
+// NumWord random words that belong to element i only, so the result does not depend on the
+// number of threads.
+template <std::size_t NumWord, typename ForwardIter, typename G>
+void PhiloxFill(ForwardIter first, ForwardIter last, uint64_t seed, G g)
+{
+    static_assert(NumWord == 1 || NumWord == 2 || NumWord == 4, "a block has 4 words");
+
+    constexpr std::size_t kElementPerBlock = 4 / NumWord;
+    constexpr std::size_t kBlockPerBatch   = 256;
+
+    const Philox4x32 philox(seed);
+
+    const auto n              = static_cast<std::size_t>(std::distance(first, last));
+    const std::size_t n_block = (n + kElementPerBlock - 1) / kElementPerBlock;
+    const std::size_t n_batch = (n_block + kBlockPerBatch - 1) / kBlockPerBatch;
+
+    HostThreadPool::Instance().ParallelFor(n_batch, 0, [&](std::size_t begin, std::size_t end) {
+        uint32_t words[4 * kBlockPerBatch];
+
+        for(std::size_t batch = begin; batch < end; ++batch)
+        {
+            const std::size_t block_begin = batch * kBlockPerBatch;
+            const std::size_t block_end   = std::min(block_begin + kBlockPerBatch, n_block);
+
+            philox.Generate(block_begin, block_end - block_begin, words);
+
+            const std::size_t i_begin = block_begin * kElementPerBlock;
+            const std::size_t i_end   = std::min(block_end * kElementPerBlock, n);
+
+            auto iter = std::next(first, i_begin);
+
+            for(std::size_t i = i_begin; i < i_end; ++i, ++iter)
+                *iter = g(words + NumWord * (i - i_begin));
+        }
+    });
+}
+
+// The Philox fills below produce the same values for any number of host threads (see
+// CK_HOST_NUM_THREADS), with a different sequence than the std::mt19937 based fills above.
+template <typename T>
+struct FillUniformDistributionPhilox
+{
+    float a_{-5.f};
+    float b_{5.f};
+    uint64_t seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float a = a_;
+        const float d = b_ - a_;
+
+        PhiloxFill<1>(first, last, seed_, [=](const uint32_t* words) {
+            return ck::type_convert<T>(a + d * Philox4x32::ToUniform(words[0]));
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillUniformDistributionPhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
+template <typename T>
+struct FillUniformDistributionIntegerValuePhilox
+{
+    float a_{-5.f};
+    float b_{5.f};
+    uint64_t seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float a = a_;
+        const float d = b_ - a_;
+
+        PhiloxFill<1>(first, last, seed_, [=](const uint32_t* words) {
+            return ck::type_convert<T>(std::round(a + d * Philox4x32::ToUniform(words[0])));
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillUniformDistributionIntegerValuePhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
+template <typename T>
+struct FillNormalDistributionPhilox
+{
+    float mean_{0.f};
+    float variance_{1.f};
+    uint64_t seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float mean   = mean_;
+        const float stddev = std::sqrt(variance_);
+
+        // Box-Muller transform, 1 - u is in (0, 1] so the logarithm is finite
+        PhiloxFill<2>(first, last, seed_, [=](const uint32_t* words) {
+            const float u0 = 1.f - Philox4x32::ToUniform(words[0]);
+            const float u1 = Philox4x32::ToUniform(words[1]);
+            const float z  = std::sqrt(-2.f * std::log(u0)) * std::cos(6.2831853f * u1);
+
+            return ck::type_convert<T>(mean + stddev * z);
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillNormalDistributionPhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
+// uniform values in [a, b), each element is zero with probability sparsity
+template <typename T>
+struct FillSparseUniformDistributionPhilox
+{
+    float a_{-5.f};
+    float b_{5.f};
+    float sparsity_{0.5f};
+    uint64_t seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float a        = a_;
+        const float d        = b_ - a_;
+        const float sparsity = sparsity_;
+
+        PhiloxFill<2>(first, last, seed_, [=](const uint32_t* words) {
+            const bool zero = Philox4x32::ToUniform(words[1]) < sparsity;
+            return ck::type_convert<T>(zero ? 0.f : a + d * Philox4x32::ToUniform(words[0]));
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillSparseUniformDistributionPhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
 template <typename T>
 struct FillMonotonicSeq
 {
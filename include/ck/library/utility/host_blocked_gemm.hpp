@@ -0,0 +1,577 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// 1: AVX2/AVX-512 micro-kernel enabled by the compile flags
+// 2: x86-64 build without these flags, AVX2 and AVX-512 micro-kernels are compiled with function
+//    target attributes and selected at run time by what the CPU supports
+#if(defined(__AVX2__) || defined(__AVX512F__)) && !defined(__HIP_DEVICE_COMPILE__)
+#include <immintrin.h>
+#define CK_HOST_BLOCKED_GEMM_USE_X86_SIMD 1
+#elif defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(__HIP_DEVICE_COMPILE__)
+#include <immintrin.h>
+#define CK_HOST_BLOCKED_GEMM_USE_X86_SIMD 2
+#else
+#define CK_HOST_BLOCKED_GEMM_USE_X86_SIMD 0
+#endif
+
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace utils {
+
+enum struct HostGemmAccumulation
+{
+    // every C element accumulates its products in ascending k order with a separate multiply
+    // and add, i.e. exactly like the scalar reference loop
+    Sequential,
+    // same order, but multiply-add is fused where the CPU supports it (faster, last-bit
+    // differences compared to the scalar reference loop)
+    Fused,
+};
+
+// Cache-blocked host GEMM engine used by the reference operations.
+//
+//   C(m, n) = sum_k A(m, k) * B(k, n),  accumulated in AccDataType
+//
+// A and B are read through the callables load_a(m, k) and load_b(k, n), which return the
+// element already converted to AccDataType (element-wise operations are applied there, once per
+// element and panel instead of once per multiply). store_c(m, n, acc) receives the final
+// accumulator of every C element exactly once.
+//
+// A is packed into MC x KC panels of MR-row slivers and B into panels of NC columns made of
+// NR-column slivers, both contiguous, and an MR x NR register-blocked micro-kernel (AVX2/AVX-512
+// for float when compiled with the corresponding flags, selected at run time on other x86-64
+// builds) computes the product. Very long K is processed in chunks so that the packed B panel
+// stays bounded. M blocks are distributed over the host thread pool. The k order of every C
+// element is ascending in both accumulation modes, so results do not depend on the blocking or
+// the number of threads.
+template <typename AccDataType>
+struct HostBlockedGemm
+{
+    static_assert(std::is_arithmetic_v<AccDataType>, "AccDataType must be an arithmetic type");
+
+    // the MR x NR accumulator tile has to fit into the vector register file
+    static constexpr std::size_t MR = 4;
+    static constexpr std::size_t NR = (CK_HOST_BLOCKED_GEMM_USE_X86_SIMD ? 32 : 16) /
+                                      (sizeof(AccDataType) == 8 ? 4 : 2);
+    static constexpr std::size_t MC = 64;
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t NC = 512;
+
+    // upper bound for the packed B panel
+    static constexpr std::size_t PackedBBudget = std::size_t{64} << 20;
+
+    template <typename LoadA, typename LoadB, typename StoreC>
+    static void Run(std::size_t M,
+                    std::size_t N,
+                    std::size_t K,
+                    LoadA&& load_a,
+                    LoadB&& load_b,
+                    StoreC&& store_c,
+                    HostGemmAccumulation accumulation = HostGemmAccumulation::Sequential)
+    {
+        auto load_a_sliver =
+            [&](std::size_t m, std::size_t mr, std::size_t k, std::size_t kc, AccDataType* p_a) {
+                for(std::size_t i = 0; i < mr; ++i)
+                    for(std::size_t kk = 0; kk < kc; ++kk)
+                        p_a[kk * MR + i] = load_a(m + i, k + kk);
+            };
+
+        RunWithASlivers(M, N, K, load_a_sliver, load_b, store_c, accumulation);
+    }
+
+    // Same as Run, but A is read a sliver at a time, for callers that can copy it faster than
+    // element by element: load_a_sliver(m, mr, k, kc, p_a) stores A(m + i, k + kk) to
+    // p_a[kk * MR + i] for i < mr <= MR and kk < kc.
+    template <typename LoadASliver, typename LoadB, typename StoreC>
+    static void
+    RunWithASlivers(std::size_t M,
+                    std::size_t N,
+                    std::size_t K,
+                    LoadASliver&& load_a_sliver,
+                    LoadB&& load_b,
+                    StoreC&& store_c,
+                    HostGemmAccumulation accumulation = HostGemmAccumulation::Sequential)
+    {
+        if(M == 0 || N == 0)
+            return;
+
+        if(accumulation == HostGemmAccumulation::Fused)
+            RunImpl<true>(M, N, K, load_a_sliver, load_b, store_c);
+        else
+            RunImpl<false>(M, N, K, load_a_sliver, load_b, store_c);
+    }
+
+    private:
+    static constexpr std::size_t RoundUp(std::size_t x, std::size_t y)
+    {
+        return (x + y - 1) / y * y;
+    }
+
+    // std::fma is only worth it if it maps to an instruction
+    static constexpr bool HasFastFma()
+    {
+#if defined(FP_FAST_FMAF) && defined(FP_FAST_FMA)
+        return std::is_floating_point_v<AccDataType>;
+#else
+        return false;
+#endif
+    }
+
+    template <bool Fused, typename LoadASliver, typename LoadB, typename StoreC>
+    static void RunImpl(std::size_t M,
+                        std::size_t N,
+                        std::size_t K,
+                        LoadASliver& load_a_sliver,
+                        LoadB& load_b,
+                        StoreC& store_c)
+    {
+        auto& pool = ck::HostThreadPool::Instance();
+
+        // shrink the M block for skinny problems so that every thread gets work
+        const std::size_t mc = std::clamp<std::size_t>(
+            RoundUp((M + pool.GetNumThreads() - 1) / pool.GetNumThreads(), MR), MR, MC);
+        const std::size_t num_m_block = (M + mc - 1) / mc;
+        const std::size_t m_padded    = num_m_block * RoundUp(mc, MR);
+
+        // The packed B panel covers KB rows of K. If K is longer than that, the accumulators of
+        // all of M are kept between the K chunks.
+        const std::size_t KB =
+            std::max(KC, PackedBBudget / (NC * sizeof(AccDataType)) / KC * KC);
+        const std::size_t num_k_chunk = std::max<std::size_t>((K + KB - 1) / KB, 1);
+        const std::size_t kb_padded   = std::min(KB, RoundUp(std::max<std::size_t>(K, 1), KC));
+
+        // widest N panel, narrow problems do not need all of NC
+        const std::size_t nc_max = RoundUp(std::min(N, NC), NR);
+
+        std::vector<AccDataType> b_packed(kb_padded * nc_max);
+        std::vector<AccDataType> c_acc(num_k_chunk > 1 ? m_padded * nc_max : 0);
+
+        for(std::size_t jc = 0; jc < N; jc += NC)
+        {
+            const std::size_t nc         = std::min(NC, N - jc);
+            const std::size_t ldc        = RoundUp(nc, NR);
+            const std::size_t num_sliver = ldc / NR;
+
+            for(std::size_t ik = 0; ik < num_k_chunk; ++ik)
+            {
+                const std::size_t kb_begin = ik * KB;
+                const std::size_t kb_end   = std::min(K, kb_begin + KB);
+                const bool first_chunk     = ik == 0;
+                const bool last_chunk      = ik + 1 == num_k_chunk;
+
+                pool.ParallelFor(num_sliver, 0, [&](std::size_t s_begin, std::size_t s_end) {
+                    for(std::size_t s = s_begin; s < s_end; ++s)
+                        PackB(kb_begin, kb_end, kb_padded, jc, nc, s, load_b, b_packed.data());
+                });
+
+                pool.ParallelFor(
+                    num_m_block,
+                    0,
+                    [&](std::size_t ib_begin, std::size_t ib_end) {
+                        std::vector<AccDataType> a_packed(RoundUp(mc, MR) * KC);
+                        std::vector<AccDataType> c_local(num_k_chunk > 1 ? 0
+                                                                         : RoundUp(mc, MR) * ldc);
+
+                        for(std::size_t ib = ib_begin; ib < ib_end; ++ib)
+                        {
+                            const std::size_t ic = ib * mc;
+                            const std::size_t m  = std::min(mc, M - ic);
+
+                            AccDataType* p_c = num_k_chunk > 1 ? c_acc.data() + ic * ldc
+                                                               : c_local.data();
+
+                            if(first_chunk)
+                                std::fill(p_c, p_c + RoundUp(mc, MR) * ldc, AccDataType{0});
+
+                            for(std::size_t pc = kb_begin; pc < kb_end; pc += KC)
+                            {
+                                const std::size_t kc = std::min(KC, kb_end - pc);
+
+                                PackA(ic, m, pc, kc, load_a_sliver, a_packed.data());
+
+                                for(std::size_t jr = 0; jr < nc; jr += NR)
+                                {
+                                    const AccDataType* p_b =
+                                        b_packed.data() + jr * kb_padded + (pc - kb_begin) * NR;
+
+                                    for(std::size_t ir = 0; ir < m; ir += MR)
+                                    {
+                                        MicroKernel<Fused>(kc,
+                                                           a_packed.data() + ir * kc,
+                                                           p_b,
+                                                           p_c + ir * ldc + jr,
+                                                           ldc);
+                                    }
+                                }
+                            }
+
+                            // one NR column sliver at a time, so that the stores to a C with
+                            // strided columns stay within a few pages
+                            if(last_chunk)
+                            {
+                                for(std::size_t jr = 0; jr < nc; jr += NR)
+                                {
+                                    const std::size_t nr = std::min(NR, nc - jr);
+
+                                    for(std::size_t i = 0; i < m; ++i)
+                                        for(std::size_t j = jr; j < jr + nr; ++j)
+                                            store_c(ic + i, jc + j, p_c[i * ldc + j]);
+                                }
+                            }
+                        }
+                    },
+                    1);
+            }
+        }
+    }
+
+    // sliver s of the B panel holding rows [kb_begin, kb_end) of K and the NR columns starting at
+    // jc + s * NR, zero padded
+    template <typename LoadB>
+    static void PackB(std::size_t kb_begin,
+                      std::size_t kb_end,
+                      std::size_t kb_padded,
+                      std::size_t jc,
+                      std::size_t nc,
+                      std::size_t s,
+                      LoadB& load_b,
+                      AccDataType* p_b_packed)
+    {
+        AccDataType* p_sliver = p_b_packed + s * NR * kb_padded;
+        const std::size_t j0  = s * NR;
+        const std::size_t nr  = std::min(NR, nc - j0);
+
+        for(std::size_t k = kb_begin; k < kb_end; ++k)
+        {
+            AccDataType* p_row = p_sliver + (k - kb_begin) * NR;
+
+            for(std::size_t j = 0; j < nr; ++j)
+                p_row[j] = load_b(k, jc + j0 + j);
+
+            for(std::size_t j = nr; j < NR; ++j)
+                p_row[j] = AccDataType{0};
+        }
+    }
+
+    // A block of m rows starting at ic and kc columns starting at pc: MR-row slivers, k-major,
+    // zero padded
+    template <typename LoadASliver>
+    static void PackA(std::size_t ic,
+                      std::size_t m,
+                      std::size_t pc,
+                      std::size_t kc,
+                      LoadASliver& load_a_sliver,
+                      AccDataType* p_a_packed)
+    {
+        for(std::size_t ir = 0; ir < m; ir += MR)
+        {
+            AccDataType* p_sliver = p_a_packed + ir * kc;
+            const std::size_t mr  = std::min(MR, m - ir);
+
+            load_a_sliver(ic + ir, mr, pc, kc, p_sliver);
+
+            for(std::size_t i = mr; i < MR; ++i)
+                for(std::size_t k = 0; k < kc; ++k)
+                    p_sliver[k * MR + i] = AccDataType{0};
+        }
+    }
+
+    // c[MR][NR] (leading dimension ldc) += a[kc][MR] * b[kc][NR]
+    template <bool Fused>
+    static void MicroKernel(std::size_t kc,
+                            const AccDataType* __restrict__ p_a,
+                            const AccDataType* __restrict__ p_b,
+                            AccDataType* __restrict__ p_c,
+                            std::size_t ldc)
+    {
+#if CK_HOST_BLOCKED_GEMM_USE_X86_SIMD == 1
+        if constexpr(std::is_same_v<AccDataType, float>)
+        {
+            MicroKernelF32<Fused>(kc, p_a, p_b, p_c, ldc);
+            return;
+        }
+#elif CK_HOST_BLOCKED_GEMM_USE_X86_SIMD == 2
+        if constexpr(std::is_same_v<AccDataType, float>)
+        {
+            if(CpuSupports().avx512f)
+            {
+                MicroKernelF32Avx512<Fused>(kc, p_a, p_b, p_c, ldc);
+                return;
+            }
+            if(Fused && CpuSupports().fma)
+            {
+                MicroKernelF32Avx2Fma(kc, p_a, p_b, p_c, ldc);
+                return;
+            }
+            if(CpuSupports().avx2)
+            {
+                MicroKernelF32Avx2(kc, p_a, p_b, p_c, ldc);
+                return;
+            }
+        }
+#endif
+        AccDataType acc[MR][NR];
+
+        for(std::size_t i = 0; i < MR; ++i)
+            for(std::size_t j = 0; j < NR; ++j)
+                acc[i][j] = p_c[i * ldc + j];
+
+        for(std::size_t k = 0; k < kc; ++k)
+        {
+            for(std::size_t i = 0; i < MR; ++i)
+            {
+                const AccDataType a = p_a[k * MR + i];
+
+                for(std::size_t j = 0; j < NR; ++j)
+                {
+                    if constexpr(Fused && HasFastFma())
+                        acc[i][j] = std::fma(a, p_b[k * NR + j], acc[i][j]);
+                    else
+                        acc[i][j] += a * p_b[k * NR + j];
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < MR; ++i)
+            for(std::size_t j = 0; j < NR; ++j)
+                p_c[i * ldc + j] = acc[i][j];
+    }
+
+#if CK_HOST_BLOCKED_GEMM_USE_X86_SIMD == 1
+#if defined(__AVX512F__)
+    template <bool Fused>
+    static void MicroKernelF32(std::size_t kc,
+                               const float* __restrict__ p_a,
+                               const float* __restrict__ p_b,
+                               float* __restrict__ p_c,
+                               std::size_t ldc)
+    {
+        static_assert(NR == 16);
+
+        __m512 acc[MR];
+
+        for(std::size_t i = 0; i < MR; ++i)
+            acc[i] = _mm512_loadu_ps(p_c + i * ldc);
+
+        for(std::size_t k = 0; k < kc; ++k)
+        {
+            const __m512 b = _mm512_loadu_ps(p_b + k * NR);
+
+            for(std::size_t i = 0; i < MR; ++i)
+            {
+                const __m512 a = _mm512_set1_ps(p_a[k * MR + i]);
+
+                if constexpr(Fused)
+                    acc[i] = _mm512_fmadd_ps(a, b, acc[i]);
+                else
+                    acc[i] = _mm512_add_ps(acc[i], _mm512_mul_ps(a, b));
+            }
+        }
+
+        for(std::size_t i = 0; i < MR; ++i)
+            _mm512_storeu_ps(p_c + i * ldc, acc[i]);
+    }
+#else
+    template <bool Fused>
+    static void MicroKernelF32(std::size_t kc,
+                               const float* __restrict__ p_a,
+                               const float* __restrict__ p_b,
+                               float* __restrict__ p_c,
+                               std::size_t ldc)
+    {
+        static_assert(NR == 16);
+
+        __m256 acc[MR][2];
+
+        for(std::size_t i = 0; i < MR; ++i)
+        {
+            acc[i][0] = _mm256_loadu_ps(p_c + i * ldc);
+            acc[i][1] = _mm256_loadu_ps(p_c + i * ldc + 8);
+        }
+
+        for(std::size_t k = 0; k < kc; ++k)
+        {
+            const __m256 b0 = _mm256_loadu_ps(p_b + k * NR);
+            const __m256 b1 = _mm256_loadu_ps(p_b + k * NR + 8);
+
+            for(std::size_t i = 0; i < MR; ++i)
+            {
+                const __m256 a = _mm256_broadcast_ss(p_a + k * MR + i);
+
+#if defined(__FMA__)
+                if constexpr(Fused)
+                {
+                    acc[i][0] = _mm256_fmadd_ps(a, b0, acc[i][0]);
+                    acc[i][1] = _mm256_fmadd_ps(a, b1, acc[i][1]);
+                    continue;
+                }
+#endif
+                acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_mul_ps(a, b0));
+                acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_mul_ps(a, b1));
+            }
+        }
+
+        for(std::size_t i = 0; i < MR; ++i)
+        {
+            _mm256_storeu_ps(p_c + i * ldc, acc[i][0]);
+            _mm256_storeu_ps(p_c + i * ldc + 8, acc[i][1]);
+        }
+    }
+#endif
+#elif CK_HOST_BLOCKED_GEMM_USE_X86_SIMD == 2
+    struct CpuFeatures
+    {
+        bool avx2;
+        bool fma;
+        bool avx512f;
+    };
+
+    static const CpuFeatures& CpuSupports()
+    {
+        static const CpuFeatures features = [] {
+            __builtin_cpu_init();
+
+            const bool avx2 = __builtin_cpu_supports("avx2");
+            const bool fma  = avx2 && __builtin_cpu_supports("fma");
+
+            return CpuFeatures{avx2, fma, fma && __builtin_cpu_supports("avx512f")};
+        }();
+
+        return features;
+    }
+
+    // Same as the AVX-512 and AVX2 kernels above. The scalar code of such a build does not fuse,
+    // so neither may the sequential kernels: AVX-512 implies FMA, so the product is passed
+    // through an empty asm statement before it is added; the sequential AVX2 kernel is compiled
+    // without FMA.
+    template <bool Fused>
+    __attribute__((target("avx512f"))) static void
+    MicroKernelF32Avx512(std::size_t kc,
+                         const float* __restrict__ p_a,
+                         const float* __restrict__ p_b,
+                         float* __restrict__ p_c,
+                         std::size_t ldc)
+    {
+        static_assert(NR == 16);
+
+        __m512 acc[MR];
+
+        for(std::size_t i = 0; i < MR; ++i)
+            acc[i] = _mm512_loadu_ps(p_c + i * ldc);
+
+        for(std::size_t k = 0; k < kc; ++k)
+        {
+            const __m512 b = _mm512_loadu_ps(p_b + k * NR);
+
+            for(std::size_t i = 0; i < MR; ++i)
+            {
+                const __m512 a = _mm512_set1_ps(p_a[k * MR + i]);
+
+                if constexpr(Fused)
+                    acc[i] = _mm512_fmadd_ps(a, b, acc[i]);
+                else
+                {
+                    __m512 ab = _mm512_mul_ps(a, b);
+
+                    // the product has to be materialized, which prevents the contraction
+                    asm("" : "+v"(ab));
+
+                    acc[i] = _mm512_add_ps(acc[i], ab);
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < MR; ++i)
+            _mm512_storeu_ps(p_c + i * ldc, acc[i]);
+    }
+
+    __attribute__((target("avx2"))) static void MicroKernelF32Avx2(std::size_t kc,
+                                                                    const float* __restrict__ p_a,
+                                                                    const float* __restrict__ p_b,
+                                                                    float* __restrict__ p_c,
+                                                                    std::size_t ldc)
+    {
+        static_assert(NR == 16);
+
+        __m256 acc[MR][2];
+
+        for(std::size_t i = 0; i < MR; ++i)
+        {
+            acc[i][0] = _mm256_loadu_ps(p_c + i * ldc);
+            acc[i][1] = _mm256_loadu_ps(p_c + i * ldc + 8);
+        }
+
+        for(std::size_t k = 0; k < kc; ++k)
+        {
+            const __m256 b0 = _mm256_loadu_ps(p_b + k * NR);
+            const __m256 b1 = _mm256_loadu_ps(p_b + k * NR + 8);
+
+            for(std::size_t i = 0; i < MR; ++i)
+            {
+                const __m256 a = _mm256_broadcast_ss(p_a + k * MR + i);
+
+                acc[i][0] = _mm256_add_ps(acc[i][0], _mm256_mul_ps(a, b0));
+                acc[i][1] = _mm256_add_ps(acc[i][1], _mm256_mul_ps(a, b1));
+            }
+        }
+
+        for(std::size_t i = 0; i < MR; ++i)
+        {
+            _mm256_storeu_ps(p_c + i * ldc, acc[i][0]);
+            _mm256_storeu_ps(p_c + i * ldc + 8, acc[i][1]);
+        }
+    }
+
+    __attribute__((target("avx2,fma"))) static void
+    MicroKernelF32Avx2Fma(std::size_t kc,
+                          const float* __restrict__ p_a,
+                          const float* __restrict__ p_b,
+                          float* __restrict__ p_c,
+                          std::size_t ldc)
+    {
+        static_assert(NR == 16);
+
+        __m256 acc[MR][2];
+
+        for(std::size_t i = 0; i < MR; ++i)
+        {
+            acc[i][0] = _mm256_loadu_ps(p_c + i * ldc);
+            acc[i][1] = _mm256_loadu_ps(p_c + i * ldc + 8);
+        }
+
+        for(std::size_t k = 0; k < kc; ++k)
+        {
+            const __m256 b0 = _mm256_loadu_ps(p_b + k * NR);
+            const __m256 b1 = _mm256_loadu_ps(p_b + k * NR + 8);
+
+            for(std::size_t i = 0; i < MR; ++i)
+            {
+                const __m256 a = _mm256_broadcast_ss(p_a + k * MR + i);
+
+                acc[i][0] = _mm256_fmadd_ps(a, b0, acc[i][0]);
+                acc[i][1] = _mm256_fmadd_ps(a, b1, acc[i][1]);
+            }
+        }
+
+        for(std::size_t i = 0; i < MR; ++i)
+        {
+            _mm256_storeu_ps(p_c + i * ldc, acc[i][0]);
+            _mm256_storeu_ps(p_c + i * ldc + 8, acc[i][1]);
+        }
+    }
+#endif
+};
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,354 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace ck {
+namespace utils {
+
+// Host model of how the workgroup-to-C-tile order of a GEMM kernel reuses the A/B panels in a
+// shared cache (L2 or MALL).
+//
+// A TileSchedule lists, per workgroup in launch order, the C tiles and K iterations it works
+// on (see block_to_ctile_map_schedule.hpp for schedules of the BlockToCTileMap_* maps).
+// SimulateTileScheduleCache() replays the A and B reads of the schedule through a
+// set-associative LRU cache: workgroups are launched in waves of num_concurrent_blocks, and the
+// workgroups of a wave advance one K iteration at a time in lockstep. Every K iteration reads
+// the MPerBlock x KPerBlock slab of A and the KPerBlock x NPerBlock slab of B of the current
+// tile. C is written once per tile and not cached.
+
+// K iterations [k_iter_begin, k_iter_end) of C tile (m_tile, n_tile)
+struct TileWorkItem
+{
+    std::int64_t m_tile       = 0;
+    std::int64_t n_tile       = 0;
+    std::int64_t k_iter_begin = 0;
+    std::int64_t k_iter_end   = 0;
+};
+
+// work items of every workgroup, indexed by block id, in the order the workgroup runs them
+using TileSchedule = std::vector<std::vector<TileWorkItem>>;
+
+struct CacheConfig
+{
+    std::size_t size_bytes = std::size_t{4} << 20;
+    std::size_t line_bytes = 128;
+    std::size_t num_ways   = 16;
+    // spread line addresses over the sets with a hash, like the address swizzle of GPU L2
+    // channels, instead of taking the low bits; keeps power-of-2 strides from aliasing
+    bool hash_set_index = true;
+};
+
+struct TileScheduleProblem
+{
+    std::int64_t M = 0;
+    std::int64_t N = 0;
+    std::int64_t K = 0;
+
+    std::int64_t MPerBlock = 0;
+    std::int64_t NPerBlock = 0;
+    std::int64_t KPerBlock = 0;
+
+    // A is M x K with K contiguous if a_row_major, B is K x N with N contiguous if b_row_major
+    bool a_row_major = true;
+    bool b_row_major = false;
+
+    std::size_t a_element_bytes = 2;
+    std::size_t b_element_bytes = 2;
+    std::size_t c_element_bytes = 2;
+
+    // workgroups resident at the same time, e.g. number of CUs x occupancy
+    std::size_t num_concurrent_blocks = 304;
+};
+
+struct CacheSimulationResult
+{
+    // cache line reads of A and B
+    std::uint64_t num_a_accesses = 0;
+    std::uint64_t num_b_accesses = 0;
+    std::uint64_t num_a_misses   = 0;
+    std::uint64_t num_b_misses   = 0;
+
+    // bytes of A and B read from DRAM, and of C written to DRAM
+    std::uint64_t a_dram_bytes = 0;
+    std::uint64_t b_dram_bytes = 0;
+    std::uint64_t c_dram_bytes = 0;
+
+    // A + B bytes with an infinite cache, i.e. every line of A and B read once
+    std::uint64_t compulsory_bytes = 0;
+
+    double GetHitRate() const
+    {
+        const auto num_accesses = num_a_accesses + num_b_accesses;
+
+        if(num_accesses == 0)
+            return 0;
+
+        return 1.0 - static_cast<double>(num_a_misses + num_b_misses) / num_accesses;
+    }
+
+    std::uint64_t GetDramBytes() const { return a_dram_bytes + b_dram_bytes + c_dram_bytes; }
+};
+
+// Set-associative cache with LRU replacement. Only tags are tracked.
+class SetAssociativeCache
+{
+    public:
+    explicit SetAssociativeCache(const CacheConfig& config)
+        : mLineBytes{config.line_bytes},
+          mNumWays{config.num_ways},
+          mHashSetIndex{config.hash_set_index}
+    {
+        if(config.line_bytes == 0 || config.num_ways == 0 ||
+           config.size_bytes < config.line_bytes * config.num_ways)
+            throw std::invalid_argument("SetAssociativeCache: invalid cache configuration");
+
+        mNumSets = config.size_bytes / (config.line_bytes * config.num_ways);
+
+        mTags.assign(mNumSets * mNumWays, kInvalidTag);
+        mLastUse.assign(mNumSets * mNumWays, 0);
+    }
+
+    std::size_t GetLineBytes() const { return mLineBytes; }
+
+    // Reads the line with the given line address (byte address / line size). Returns true on a
+    // hit; on a miss the least recently used line of the set is replaced.
+    bool Access(std::uint64_t line)
+    {
+        const std::size_t first = (GetSetIndexKey(line) % mNumSets) * mNumWays;
+
+        ++mTime;
+
+        std::size_t victim = first;
+
+        for(std::size_t way = first; way < first + mNumWays; ++way)
+        {
+            if(mTags[way] == line)
+            {
+                mLastUse[way] = mTime;
+                return true;
+            }
+
+            if(mLastUse[way] < mLastUse[victim])
+                victim = way;
+        }
+
+        mTags[victim]    = line;
+        mLastUse[victim] = mTime;
+
+        return false;
+    }
+
+    private:
+    std::uint64_t GetSetIndexKey(std::uint64_t line) const
+    {
+        if(!mHashSetIndex)
+            return line;
+
+        // splitmix64 finalizer
+        line ^= line >> 30;
+        line *= 0xbf58476d1ce4e5b9ull;
+        line ^= line >> 27;
+        line *= 0x94d049bb133111ebull;
+        line ^= line >> 31;
+
+        return line;
+    }
+
+    static constexpr std::uint64_t kInvalidTag = std::numeric_limits<std::uint64_t>::max();
+
+    std::size_t mLineBytes;
+    std::size_t mNumWays;
+    bool mHashSetIndex;
+    std::size_t mNumSets = 0;
+    std::uint64_t mTime  = 0;
+
+    std::vector<std::uint64_t> mTags;
+    std::vector<std::uint64_t> mLastUse;
+};
+
+namespace detail {
+
+// Calls f(line) for every cache line of the rows [row_begin, row_end) x columns
+// [col_begin, col_end) of a packed matrix whose rows have num_cols elements.
+template <typename F>
+void ForEachTileLine(std::uint64_t base,
+                     std::int64_t num_cols,
+                     std::size_t element_bytes,
+                     std::size_t line_bytes,
+                     std::int64_t row_begin,
+                     std::int64_t row_end,
+                     std::int64_t col_begin,
+                     std::int64_t col_end,
+                     F&& f)
+{
+    if(col_begin >= col_end)
+        return;
+
+    for(std::int64_t row = row_begin; row < row_end; ++row)
+    {
+        const std::uint64_t row_base = base + static_cast<std::uint64_t>(row * num_cols) *
+                                                  static_cast<std::uint64_t>(element_bytes);
+
+        const std::uint64_t first = row_base + col_begin * element_bytes;
+        const std::uint64_t last  = row_base + col_end * element_bytes - 1;
+
+        for(std::uint64_t line = first / line_bytes; line <= last / line_bytes; ++line)
+            f(line);
+    }
+}
+
+inline std::uint64_t CountMatrixLines(std::uint64_t base,
+                                      std::int64_t num_rows,
+                                      std::int64_t num_cols,
+                                      std::size_t element_bytes,
+                                      std::size_t line_bytes)
+{
+    if(num_rows <= 0 || num_cols <= 0)
+        return 0;
+
+    const std::uint64_t first = base;
+    const std::uint64_t last  = base + num_rows * num_cols * element_bytes - 1;
+
+    return last / line_bytes - first / line_bytes + 1;
+}
+
+} // namespace detail
+
+inline CacheSimulationResult SimulateTileScheduleCache(const TileSchedule& schedule,
+                                                       const TileScheduleProblem& problem,
+                                                       const CacheConfig& cache_config)
+{
+    if(problem.MPerBlock <= 0 || problem.NPerBlock <= 0 || problem.KPerBlock <= 0 ||
+       problem.num_concurrent_blocks == 0)
+        throw std::invalid_argument("SimulateTileScheduleCache: invalid problem");
+
+    SetAssociativeCache cache(cache_config);
+
+    const std::size_t line_bytes = cache.GetLineBytes();
+
+    const std::uint64_t a_base  = 0;
+    const std::uint64_t a_bytes = problem.M * problem.K * problem.a_element_bytes;
+    // B starts on the next line after A
+    const std::uint64_t b_base = (a_bytes + line_bytes - 1) / line_bytes * line_bytes;
+
+    CacheSimulationResult result;
+
+    result.compulsory_bytes =
+        (detail::CountMatrixLines(a_base, problem.M, problem.K, problem.a_element_bytes,
+                                  line_bytes) +
+         detail::CountMatrixLines(b_base, problem.K, problem.N, problem.b_element_bytes,
+                                  line_bytes)) *
+        line_bytes;
+
+    const auto read_a = [&](std::int64_t m_tile, std::int64_t k_iter) {
+        const std::int64_t m0 = m_tile * problem.MPerBlock;
+        const std::int64_t m1 = std::min(m0 + problem.MPerBlock, problem.M);
+        const std::int64_t k0 = k_iter * problem.KPerBlock;
+        const std::int64_t k1 = std::min(k0 + problem.KPerBlock, problem.K);
+
+        const auto access = [&](std::uint64_t line) {
+            ++result.num_a_accesses;
+            result.num_a_misses += !cache.Access(line);
+        };
+
+        if(problem.a_row_major)
+            detail::ForEachTileLine(
+                a_base, problem.K, problem.a_element_bytes, line_bytes, m0, m1, k0, k1, access);
+        else
+            detail::ForEachTileLine(
+                a_base, problem.M, problem.a_element_bytes, line_bytes, k0, k1, m0, m1, access);
+    };
+
+    const auto read_b = [&](std::int64_t n_tile, std::int64_t k_iter) {
+        const std::int64_t n0 = n_tile * problem.NPerBlock;
+        const std::int64_t n1 = std::min(n0 + problem.NPerBlock, problem.N);
+        const std::int64_t k0 = k_iter * problem.KPerBlock;
+        const std::int64_t k1 = std::min(k0 + problem.KPerBlock, problem.K);
+
+        const auto access = [&](std::uint64_t line) {
+            ++result.num_b_accesses;
+            result.num_b_misses += !cache.Access(line);
+        };
+
+        if(problem.b_row_major)
+            detail::ForEachTileLine(
+                b_base, problem.N, problem.b_element_bytes, line_bytes, k0, k1, n0, n1, access);
+        else
+            detail::ForEachTileLine(
+                b_base, problem.K, problem.b_element_bytes, line_bytes, n0, n1, k0, k1, access);
+    };
+
+    // position of a workgroup in its work items
+    struct Cursor
+    {
+        std::size_t item     = 0;
+        std::int64_t k_iter  = 0;
+        bool is_started_item = false;
+    };
+
+    for(std::size_t wave_begin = 0; wave_begin < schedule.size();
+        wave_begin += problem.num_concurrent_blocks)
+    {
+        const std::size_t wave_end =
+            std::min(wave_begin + problem.num_concurrent_blocks, schedule.size());
+
+        std::vector<Cursor> cursors(wave_end - wave_begin);
+
+        for(bool is_active = true; is_active;)
+        {
+            is_active = false;
+
+            for(std::size_t block = wave_begin; block < wave_end; ++block)
+            {
+                const auto& items = schedule[block];
+                auto& cursor      = cursors[block - wave_begin];
+
+                // skip empty work items
+                while(cursor.item < items.size() &&
+                      items[cursor.item].k_iter_begin >= items[cursor.item].k_iter_end)
+                    ++cursor.item;
+
+                if(cursor.item == items.size())
+                    continue;
+
+                const auto& item = items[cursor.item];
+
+                if(!cursor.is_started_item)
+                {
+                    cursor.k_iter          = item.k_iter_begin;
+                    cursor.is_started_item = true;
+                }
+
+                read_a(item.m_tile, cursor.k_iter);
+                read_b(item.n_tile, cursor.k_iter);
+
+                if(++cursor.k_iter == item.k_iter_end)
+                {
+                    ++cursor.item;
+                    cursor.is_started_item = false;
+                }
+
+                is_active = true;
+            }
+        }
+    }
+
+    // every C tile is written once
+    result.c_dram_bytes = problem.M * problem.N * problem.c_element_bytes;
+
+    result.a_dram_bytes = result.num_a_misses * line_bytes;
+    result.b_dram_bytes = result.num_b_misses * line_bytes;
+
+    return result;
+}
+
+} // namespace utils
+} // namespace ck
@@ -7,6 +7,7 @@
 #include <cassert>
 #include <iostream>
 #include <numeric>
+#include <stdexcept>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -16,6 +17,9 @@
 #include "ck/utility/type_convert.hpp"
 
 #include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/utility/host_type_convert.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 template <typename Range>
@@ -154,7 +158,7 @@ struct HostTensorDescriptor
         return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
     }
 
-    std::size_t GetOffsetFromMultiIndex(std::vector<std::size_t> iss) const
+    std::size_t GetOffsetFromMultiIndex(const std::vector<std::size_t>& iss) const
     {
         return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
     }
@@ -231,25 +235,17 @@ struct ParallelTensorFunctor
         return indices;
     }
 
+    // num_thread is the maximum number of threads of the host thread pool taking part in the
+    // traversal, the work is distributed in chunks with work stealing
     void operator()(std::size_t num_thread = 1) const
     {
-        std::size_t work_per_thread = (mN1d + num_thread - 1) / num_thread;
-
-        std::vector<joinable_thread> threads(num_thread);
-
-        for(std::size_t it = 0; it < num_thread; ++it)
-        {
-            std::size_t iw_begin = it * work_per_thread;
-            std::size_t iw_end   = std::min((it + 1) * work_per_thread, mN1d);
-
-            auto f = [=] {
+        ck::HostThreadPool::Instance().ParallelFor(
+            mN1d, num_thread, [this](std::size_t iw_begin, std::size_t iw_end) {
                 for(std::size_t iw = iw_begin; iw < iw_end; ++iw)
                 {
                     call_f_unpack_args(mF, GetNdIndices(iw));
                 }
-            };
-            threads[it] = joinable_thread(f);
-        }
+            });
     }
 };
 
@@ -294,8 +290,7 @@ struct Tensor
     {
         Tensor<OutT> ret(mDesc);
 
-        ck::ranges::transform(
-            mData, ret.mData.begin(), [](auto value) { return ck::type_convert<OutT>(value); });
+        ck::utils::type_convert_n(mData.data(), mData.size(), ret.mData.data());
 
         return ret;
     }
@@ -484,12 +479,12 @@ struct Tensor
         return mData[mDesc.GetOffsetFromMultiIndex(is...)];
     }
 
-    T& operator()(std::vector<std::size_t> idx)
+    T& operator()(const std::vector<std::size_t>& idx)
     {
         return mData[mDesc.GetOffsetFromMultiIndex(idx)];
     }
 
-    const T& operator()(std::vector<std::size_t> idx) const
+    const T& operator()(const std::vector<std::size_t>& idx) const
     {
         return mData[mDesc.GetOffsetFromMultiIndex(idx)];
     }
@@ -528,6 +523,36 @@ struct Tensor
         return ck::span<Element>{reinterpret_cast<Element*>(data()), size() * FromSize / ToSize};
     }
 
+    // View of the tensor with compile-time rank, see ck::utils::TensorView. Rank has to be the
+    // number of dimensions of the tensor.
+    template <std::size_t Rank>
+    ck::utils::TensorView<T, Rank> AsView()
+    {
+        return MakeView<T, Rank>(data());
+    }
+
+    template <std::size_t Rank>
+    ck::utils::TensorView<const T, Rank> AsView() const
+    {
+        return MakeView<const T, Rank>(data());
+    }
+
     Descriptor mDesc;
     Data mData;
+
+    private:
+    template <typename U, std::size_t Rank>
+    ck::utils::TensorView<U, Rank> MakeView(U* p_data) const
+    {
+        if(mDesc.GetNumOfDimension() != Rank)
+            throw std::runtime_error("Tensor: view rank differs from the tensor rank");
+
+        std::array<std::size_t, Rank> lengths;
+        std::array<std::size_t, Rank> strides;
+
+        std::copy_n(mDesc.GetLengths().begin(), Rank, lengths.begin());
+        std::copy_n(mDesc.GetStrides().begin(), Rank, strides.begin());
+
+        return ck::utils::TensorView<U, Rank>(p_data, lengths, strides);
+    }
 };
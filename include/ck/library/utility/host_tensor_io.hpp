@@ -0,0 +1,677 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/span.hpp"
+
+#include "ck/library/utility/host_tensor.hpp"
+
+// Binary I/O for host Tensor.
+//
+// Two file formats are supported:
+//  - NumPy .npy (version 1.0 to 3.0), e.g. dumped from torch with
+//        numpy.save("f.npy", t.cpu().numpy())
+//    bf16 and fp8 tensors, which numpy does not know, are stored as raw bits in unsigned
+//    integers of the same size (bhalf_t is uint16 anyway), unsigned integers and void of the
+//    same size are accepted for them:
+//        numpy.save("f.npy", t.cpu().view(torch.int16).numpy().view("u2"))  # bf16
+//        torch.from_numpy(numpy.load("f.npy").view("i2")).view(torch.bfloat16)  # back
+//  - raw: a small binary header (data type, lengths, strides) followed by the element space of
+//    the tensor, so tensors with arbitrary strides round-trip bit-exactly.
+//
+// Load*() copies the data into a new Tensor, Map*() returns a read-only MappedTensor that points
+// into a memory mapping of the file, so pages are only read when they are accessed.
+// Data is stored in the byte order of the host, which must be little-endian.
+namespace ck {
+namespace utils {
+
+// NumPy data type descriptor of T, data types unknown to numpy map to unsigned integers
+template <typename T>
+std::string GetNpyDescr()
+{
+    if constexpr(std::is_same_v<T, float>)
+        return "<f4";
+    else if constexpr(std::is_same_v<T, double>)
+        return "<f8";
+    else if constexpr(std::is_same_v<T, half_t>)
+        return "<f2";
+    else if constexpr(std::is_same_v<T, bool>)
+        return "|b1";
+    else if constexpr(std::is_integral_v<T>)
+        return std::string(sizeof(T) == 1 ? "|" : "<") + (std::is_signed_v<T> ? "i" : "u") +
+               std::to_string(sizeof(T));
+    else
+        return std::string(sizeof(T) == 1 ? "|" : "<") + "u" + std::to_string(sizeof(T));
+}
+
+// data type name stored in raw tensor files
+template <typename T>
+std::string GetTensorDataTypeName()
+{
+    if constexpr(std::is_same_v<T, float>)
+        return "fp32";
+    else if constexpr(std::is_same_v<T, double>)
+        return "fp64";
+    else if constexpr(std::is_same_v<T, half_t>)
+        return "fp16";
+    else if constexpr(std::is_same_v<T, bhalf_t>)
+        return "bf16";
+    else if constexpr(std::is_same_v<T, f8_fnuz_t>)
+        return "fp8_fnuz";
+    else if constexpr(std::is_same_v<T, bf8_fnuz_t>)
+        return "bf8_fnuz";
+    else if constexpr(std::is_same_v<T, f8_ocp_t>)
+        return "fp8_ocp";
+    else if constexpr(std::is_same_v<T, bf8_ocp_t>)
+        return "bf8_ocp";
+    else if constexpr(std::is_same_v<T, int4_t>)
+        return "int4";
+    else if constexpr(std::is_same_v<T, bool>)
+        return "bool";
+    else if constexpr(std::is_integral_v<T>)
+        return (std::is_signed_v<T> ? "int" : "uint") + std::to_string(8 * sizeof(T));
+    else
+        return "raw" + std::to_string(8 * sizeof(T));
+}
+
+// read-only memory mapping of a whole file
+class MappedFile
+{
+    public:
+    explicit MappedFile(const std::string& file_name)
+    {
+#ifdef _WIN32
+        std::ifstream file(file_name, std::ios::binary);
+
+        if(!file.is_open())
+            throw std::runtime_error(std::string("unable to open file:") + file_name);
+
+        mBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        mpData = mBuffer.data();
+        mSize  = mBuffer.size();
+#else
+        const int fd = ::open(file_name.c_str(), O_RDONLY);
+
+        if(fd < 0)
+            throw std::runtime_error(std::string("unable to open file:") + file_name);
+
+        struct stat st;
+
+        if(::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error(std::string("unable to stat file:") + file_name);
+        }
+
+        mSize = static_cast<std::size_t>(st.st_size);
+
+        if(mSize > 0)
+        {
+            void* p = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if(p == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error(std::string("unable to map file:") + file_name);
+            }
+
+            mpData = static_cast<const char*>(p);
+        }
+
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if(mpData != nullptr)
+            ::munmap(const_cast<char*>(mpData), mSize);
+#endif
+    }
+
+    const char* data() const { return mpData; }
+
+    std::size_t size() const { return mSize; }
+
+    private:
+    const char* mpData = nullptr;
+    std::size_t mSize  = 0;
+#ifdef _WIN32
+    std::vector<char> mBuffer;
+#endif
+};
+
+// Tensor-like read-only tensor backed by a mapped file
+template <typename T>
+struct MappedTensor
+{
+    using Descriptor = HostTensorDescriptor;
+
+    MappedTensor(std::shared_ptr<const MappedFile> file, const T* p_data, Descriptor desc)
+        : mDesc(std::move(desc)), mpFile(std::move(file)), mpData(p_data)
+    {
+    }
+
+    decltype(auto) GetLengths() const { return mDesc.GetLengths(); }
+
+    decltype(auto) GetStrides() const { return mDesc.GetStrides(); }
+
+    std::size_t GetNumOfDimension() const { return mDesc.GetNumOfDimension(); }
+
+    std::size_t GetElementSize() const { return mDesc.GetElementSize(); }
+
+    std::size_t GetElementSpaceSize() const
+    {
+        return GetElementSize() == 0 ? 0 : mDesc.GetElementSpaceSize();
+    }
+
+    std::size_t GetElementSpaceSizeInBytes() const { return sizeof(T) * GetElementSpaceSize(); }
+
+    template <typename... Is>
+    const T& operator()(Is... is) const
+    {
+        return mpData[mDesc.GetOffsetFromMultiIndex(is...)];
+    }
+
+    const T& operator()(const std::vector<std::size_t>& idx) const
+    {
+        return mpData[mDesc.GetOffsetFromMultiIndex(idx)];
+    }
+
+    const T* begin() const { return mpData; }
+
+    const T* end() const { return mpData + size(); }
+
+    const T* data() const { return mpData; }
+
+    std::size_t size() const { return GetElementSpaceSize(); }
+
+    template <typename U = T>
+    auto AsSpan() const
+    {
+        using Element = std::add_const_t<std::remove_reference_t<U>>;
+        return ck::span<Element>{reinterpret_cast<Element*>(data()),
+                                 size() * sizeof(T) / sizeof(U)};
+    }
+
+    // copy into a Tensor with the same lengths and strides
+    Tensor<T> ToTensor() const
+    {
+        Tensor<T> ret(mDesc);
+        std::memcpy(ret.data(), mpData, GetElementSpaceSizeInBytes());
+        return ret;
+    }
+
+    Descriptor mDesc;
+
+    private:
+    std::shared_ptr<const MappedFile> mpFile;
+    const T* mpData;
+};
+
+namespace detail {
+
+struct TensorFileHeader
+{
+    std::string dtype;
+    std::size_t element_bytes = 0;
+    std::vector<std::size_t> lengths;
+    std::vector<std::size_t> strides;
+    std::size_t data_offset = 0;
+};
+
+inline constexpr char kNpyMagic[] = "\x93NUMPY";
+inline constexpr char kRawMagic[] = "CKTENSOR";
+
+// npy and raw tensor files align their data to 64 bytes
+inline constexpr std::size_t kTensorFileAlignment = 64;
+
+inline std::vector<std::size_t> GetPackedStrides(const std::vector<std::size_t>& lengths,
+                                                 bool column_major = false)
+{
+    const std::size_t rank = lengths.size();
+
+    std::vector<std::size_t> strides(rank);
+    std::size_t stride = 1;
+
+    for(std::size_t i = 0; i < rank; ++i)
+    {
+        const std::size_t d = column_major ? i : rank - 1 - i;
+
+        strides[d] = stride;
+        stride *= lengths[d];
+    }
+
+    return strides;
+}
+
+// strides of length-1 dimensions do not matter
+inline bool IsPacked(const std::vector<std::size_t>& lengths,
+                     const std::vector<std::size_t>& strides,
+                     bool column_major = false)
+{
+    const auto packed_strides = GetPackedStrides(lengths, column_major);
+
+    for(std::size_t d = 0; d < lengths.size(); ++d)
+    {
+        if(lengths[d] > 1 && strides[d] != packed_strides[d])
+            return false;
+    }
+
+    return true;
+}
+
+// value of key in the python dict literal of a npy header
+inline std::string GetNpyHeaderValue(const std::string& header,
+                                     const std::string& key,
+                                     const std::string& file_name)
+{
+    const auto key_pos = header.find("'" + key + "'");
+
+    if(key_pos == std::string::npos)
+        throw std::runtime_error("npy header of file:" + file_name + " has no " + key);
+
+    auto begin = header.find(':', key_pos);
+
+    if(begin == std::string::npos)
+        throw std::runtime_error("invalid npy header in file:" + file_name);
+
+    begin = header.find_first_not_of(' ', begin + 1);
+
+    const bool is_tuple = begin != std::string::npos && header[begin] == '(';
+    const auto end = is_tuple ? header.find(')', begin) : header.find_first_of(",}", begin);
+
+    if(end == std::string::npos)
+        throw std::runtime_error("invalid npy header in file:" + file_name);
+
+    return header.substr(begin, end - begin + (is_tuple ? 1 : 0));
+}
+
+inline TensorFileHeader ParseNpyHeader(const MappedFile& file, const std::string& file_name)
+{
+    const char* p        = file.data();
+    const std::size_t sz = file.size();
+
+    if(sz < 10 || std::memcmp(p, kNpyMagic, 6) != 0)
+        throw std::runtime_error("file:" + file_name + " is not a npy file");
+
+    const auto major = static_cast<unsigned char>(p[6]);
+
+    std::size_t header_len   = 0;
+    std::size_t header_begin = 0;
+
+    if(major == 1)
+    {
+        header_len   = static_cast<unsigned char>(p[8]) | static_cast<unsigned char>(p[9]) << 8;
+        header_begin = 10;
+    }
+    else if(major == 2 || major == 3)
+    {
+        if(sz < 12)
+            throw std::runtime_error("invalid npy header in file:" + file_name);
+
+        for(int i = 3; i >= 0; --i)
+            header_len = header_len << 8 | static_cast<unsigned char>(p[8 + i]);
+
+        header_begin = 12;
+    }
+    else
+    {
+        throw std::runtime_error("unsupported npy version in file:" + file_name);
+    }
+
+    if(header_begin + header_len > sz)
+        throw std::runtime_error("invalid npy header in file:" + file_name);
+
+    const std::string header(p + header_begin, header_len);
+
+    TensorFileHeader ret;
+    ret.data_offset = header_begin + header_len;
+
+    const auto descr = GetNpyHeaderValue(header, "descr", file_name);
+
+    if(descr.size() < 3 || (descr.front() != '\'' && descr.front() != '"'))
+        throw std::runtime_error("unsupported npy descr " + descr + " in file:" + file_name);
+
+    ret.dtype = descr.substr(1, descr.size() - 2);
+
+    if(ret.dtype[0] == '>')
+        throw std::runtime_error("big-endian npy file:" + file_name + " is not supported");
+
+    const auto size_pos = ret.dtype.find_first_of("0123456789");
+
+    if(size_pos != std::string::npos)
+        ret.element_bytes = std::stoul(ret.dtype.substr(size_pos));
+
+    const bool fortran_order =
+        GetNpyHeaderValue(header, "fortran_order", file_name).compare(0, 4, "True") == 0;
+
+    const auto shape = GetNpyHeaderValue(header, "shape", file_name);
+
+    for(std::size_t i = 1; i < shape.size();)
+    {
+        if(std::isdigit(static_cast<unsigned char>(shape[i])))
+        {
+            std::size_t len = 0;
+
+            while(std::isdigit(static_cast<unsigned char>(shape[i])))
+                len = len * 10 + static_cast<std::size_t>(shape[i++] - '0');
+
+            ret.lengths.push_back(len);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+
+    ret.strides = GetPackedStrides(ret.lengths, fortran_order);
+
+    return ret;
+}
+
+inline std::string MakeNpyHeader(const std::string& descr,
+                                 const std::vector<std::size_t>& lengths,
+                                 bool fortran_order)
+{
+    std::string dict = "{'descr': '" + descr +
+                       "', 'fortran_order': " + (fortran_order ? "True" : "False") +
+                       ", 'shape': (";
+
+    for(const auto len : lengths)
+        dict += std::to_string(len) + ", ";
+
+    // (3, 4) and (5,)
+    if(lengths.size() > 1)
+        dict.resize(dict.size() - 2);
+    else if(lengths.size() == 1)
+        dict.pop_back();
+
+    dict += "), }";
+
+    // the dict is padded with spaces and terminated by a newline so that the data is aligned
+    const bool v1           = dict.size() + kTensorFileAlignment < 65536;
+    const std::size_t begin = v1 ? 10 : 12;
+    const std::size_t total =
+        (begin + dict.size() + 1 + kTensorFileAlignment - 1) / kTensorFileAlignment *
+        kTensorFileAlignment;
+
+    dict.append(total - begin - dict.size() - 1, ' ');
+    dict += '\n';
+
+    std::string header(kNpyMagic, 6);
+    header += static_cast<char>(v1 ? 1 : 2);
+    header += '\0';
+
+    for(std::size_t i = 0; i < begin - 8; ++i)
+        header += static_cast<char>(dict.size() >> (8 * i) & 0xff);
+
+    return header + dict;
+}
+
+// raw header: magic[8], uint32 version, uint32 rank, uint64 data offset, char dtype[16],
+// uint64 element size in bytes, uint64 lengths[rank], uint64 strides[rank]
+inline std::string MakeRawHeader(const std::string& dtype,
+                                 std::size_t element_bytes,
+                                 const std::vector<std::size_t>& lengths,
+                                 const std::vector<std::size_t>& strides)
+{
+    const std::size_t rank = lengths.size();
+    const std::size_t data_offset =
+        (48 + 16 * rank + kTensorFileAlignment - 1) / kTensorFileAlignment *
+        kTensorFileAlignment;
+
+    std::string header(data_offset, '\0');
+    char* p = header.data();
+
+    auto put_u32 = [&](std::size_t pos, std::uint32_t v) { std::memcpy(p + pos, &v, 4); };
+    auto put_u64 = [&](std::size_t pos, std::uint64_t v) { std::memcpy(p + pos, &v, 8); };
+
+    std::memcpy(p, kRawMagic, 8);
+    put_u32(8, 1);
+    put_u32(12, static_cast<std::uint32_t>(rank));
+    put_u64(16, data_offset);
+    std::memcpy(p + 24, dtype.data(), std::min<std::size_t>(dtype.size(), 15));
+    put_u64(40, element_bytes);
+
+    for(std::size_t d = 0; d < rank; ++d)
+    {
+        put_u64(48 + 8 * d, lengths[d]);
+        put_u64(48 + 8 * (rank + d), strides[d]);
+    }
+
+    return header;
+}
+
+inline TensorFileHeader ParseRawHeader(const MappedFile& file, const std::string& file_name)
+{
+    const char* p        = file.data();
+    const std::size_t sz = file.size();
+
+    if(sz < 48 || std::memcmp(p, kRawMagic, 8) != 0)
+        throw std::runtime_error("file:" + file_name + " is not a raw tensor file");
+
+    auto get_u32 = [&](std::size_t pos) {
+        std::uint32_t v;
+        std::memcpy(&v, p + pos, 4);
+        return v;
+    };
+    auto get_u64 = [&](std::size_t pos) {
+        std::uint64_t v;
+        std::memcpy(&v, p + pos, 8);
+        return static_cast<std::size_t>(v);
+    };
+
+    if(get_u32(8) != 1)
+        throw std::runtime_error("unsupported raw tensor file version in file:" + file_name);
+
+    const std::size_t rank = get_u32(12);
+
+    TensorFileHeader ret;
+    ret.data_offset   = get_u64(16);
+    ret.dtype         = std::string(p + 24, std::find(p + 24, p + 40, '\0'));
+    ret.element_bytes = get_u64(40);
+
+    if(48 + 16 * rank > sz || ret.data_offset > sz)
+        throw std::runtime_error("invalid raw tensor header in file:" + file_name);
+
+    for(std::size_t d = 0; d < rank; ++d)
+    {
+        ret.lengths.push_back(get_u64(48 + 8 * d));
+        ret.strides.push_back(get_u64(48 + 8 * (rank + d)));
+    }
+
+    return ret;
+}
+
+// pointer to the data of a tensor file after checking the data type and size
+template <typename T>
+const T* GetTensorFileData(const MappedFile& file,
+                           const TensorFileHeader& header,
+                           const std::string& expected_dtype,
+                           bool npy_raw_bits,
+                           const std::string& file_name)
+{
+    // numpy does not know bf16/fp8, so their raw bits may also come as unsigned integers or
+    // void of the same size, every other data type has to match exactly
+    const bool npy_untyped = npy_raw_bits && header.dtype.size() > 1 &&
+                             (header.dtype[1] == 'u' || header.dtype[1] == 'V');
+
+    const bool dtype_match = header.element_bytes == sizeof(T) &&
+                             (header.dtype == expected_dtype || npy_untyped);
+
+    if(!dtype_match)
+        throw std::runtime_error("data type " + header.dtype + " of file:" + file_name +
+                                 " does not match the tensor data type " + expected_dtype);
+
+    const HostTensorDescriptor desc(header.lengths, header.strides);
+    const std::size_t num_bytes =
+        desc.GetElementSize() == 0 ? 0 : sizeof(T) * desc.GetElementSpaceSize();
+
+    if(header.data_offset + num_bytes > file.size())
+        throw std::runtime_error("file:" + file_name + " is too small for its tensor shape");
+
+    return reinterpret_cast<const T*>(file.data() + header.data_offset);
+}
+
+template <typename T>
+constexpr bool IsRawBitsType()
+{
+    return std::is_same_v<T, bhalf_t> || std::is_same_v<T, f8_fnuz_t> ||
+           std::is_same_v<T, bf8_fnuz_t> || std::is_same_v<T, f8_ocp_t> ||
+           std::is_same_v<T, bf8_ocp_t> || std::is_same_v<T, int4_t>;
+}
+
+template <typename T>
+MappedTensor<T>
+MapTensorFile(const std::string& file_name, bool npy, bool allow_unaligned = false)
+{
+    auto file = std::make_shared<const MappedFile>(file_name);
+
+    const auto header = npy ? ParseNpyHeader(*file, file_name) : ParseRawHeader(*file, file_name);
+
+    const T* p_data =
+        GetTensorFileData<T>(*file,
+                             header,
+                             npy ? GetNpyDescr<T>() : GetTensorDataTypeName<T>(),
+                             npy && IsRawBitsType<T>(),
+                             file_name);
+
+    if(!allow_unaligned && header.data_offset % alignof(T) != 0)
+        throw std::runtime_error("data of file:" + file_name +
+                                 " is not aligned for mapping, use LoadNpy()");
+
+    return MappedTensor<T>(
+        std::move(file), p_data, HostTensorDescriptor(header.lengths, header.strides));
+}
+
+template <typename T>
+void WriteTensorFile(const std::string& file_name,
+                     const std::string& header,
+                     const T* p,
+                     std::size_t n)
+{
+    std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+
+    if(!file.is_open())
+        throw std::runtime_error(std::string("unable to open file:") + file_name);
+
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(p), static_cast<std::streamsize>(sizeof(T) * n));
+
+    if(!file)
+        throw std::runtime_error(std::string("unable to write file:") + file_name);
+}
+
+} // namespace detail
+
+// save a tensor as .npy. Packed row- or column-major tensors are written as they are, other
+// strides are gathered into row-major order.
+template <typename T>
+void SaveNpy(const std::string& file_name, const Tensor<T>& tensor)
+{
+    const auto& lengths = tensor.GetLengths();
+    const auto& strides = tensor.GetStrides();
+
+    const std::size_t num_element = tensor.GetElementSize();
+
+    if(detail::IsPacked(lengths, strides) || detail::IsPacked(lengths, strides, true))
+    {
+        const bool fortran_order = !detail::IsPacked(lengths, strides);
+        const auto header = detail::MakeNpyHeader(GetNpyDescr<T>(), lengths, fortran_order);
+
+        detail::WriteTensorFile(file_name, header, tensor.data(), num_element);
+        return;
+    }
+
+    std::vector<T> packed(num_element);
+    std::vector<std::size_t> idx(lengths.size(), 0);
+
+    for(std::size_t i = 0; i < num_element; ++i)
+    {
+        packed[i] = tensor(idx);
+
+        for(std::size_t d = lengths.size(); d-- > 0;)
+        {
+            if(++idx[d] < lengths[d])
+                break;
+
+            idx[d] = 0;
+        }
+    }
+
+    detail::WriteTensorFile(file_name,
+                            detail::MakeNpyHeader(GetNpyDescr<T>(), lengths, false),
+                            packed.data(),
+                            num_element);
+}
+
+// map a .npy file, column-major (fortran_order) files keep their layout through the strides
+template <typename T>
+MappedTensor<T> MapNpy(const std::string& file_name)
+{
+    return detail::MapTensorFile<T>(file_name, true);
+}
+
+template <typename T>
+Tensor<T> LoadNpy(const std::string& file_name)
+{
+    return detail::MapTensorFile<T>(file_name, true, true).ToTensor();
+}
+
+// save the whole element space of a tensor together with its lengths and strides
+template <typename T>
+void SaveRaw(const std::string& file_name, const Tensor<T>& tensor)
+{
+    detail::WriteTensorFile(file_name,
+                            detail::MakeRawHeader(GetTensorDataTypeName<T>(),
+                                                  sizeof(T),
+                                                  tensor.GetLengths(),
+                                                  tensor.GetStrides()),
+                            tensor.data(),
+                            tensor.GetElementSize() == 0 ? 0 : tensor.size());
+}
+
+template <typename T>
+MappedTensor<T> MapRaw(const std::string& file_name)
+{
+    return detail::MapTensorFile<T>(file_name, false);
+}
+
+template <typename T>
+Tensor<T> LoadRaw(const std::string& file_name)
+{
+    return detail::MapTensorFile<T>(file_name, false, true).ToTensor();
+}
+
+} // namespace utils
+} // namespace ck
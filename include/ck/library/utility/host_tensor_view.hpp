@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ck {
+namespace utils {
+
+// Non-owning view of Rank-dimensional strided host data.
+//
+// Rank is a compile-time constant and lengths/strides are std::arrays, so element access is a
+// fixed-length dot product without allocation, and views are cheap to copy. Slice(), Select(),
+// Permute(), Transpose() and Broadcast() return new views of the same storage in O(Rank)
+// without copying. ForEach() and ForEachRow() iterate with a plain innermost loop the compiler
+// can vectorize when the innermost dimension is contiguous.
+//
+// Views do not keep the storage alive; a view of a Tensor is valid as long as the Tensor is not
+// resized or destroyed. T may be const-qualified for read-only views.
+template <typename T, std::size_t Rank>
+class TensorView
+{
+    static_assert(Rank > 0, "TensorView: rank must be positive");
+
+    public:
+    using value_type = T;
+    using Index      = std::array<std::size_t, Rank>;
+
+    static constexpr std::size_t kRank = Rank;
+
+    TensorView() = default;
+
+    TensorView(T* p_data, const Index& lengths, const Index& strides)
+        : mpData{p_data}, mLengths{lengths}, mStrides{strides}
+    {
+    }
+
+    // packed row-major view
+    TensorView(T* p_data, const Index& lengths) : mpData{p_data}, mLengths{lengths}
+    {
+        std::size_t stride = 1;
+
+        for(std::size_t i = Rank; i-- > 0;)
+        {
+            mStrides[i] = stride;
+            stride *= mLengths[i];
+        }
+    }
+
+    // view of non-const data converts to view of const data
+    template <typename U,
+              typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    TensorView(const TensorView<U, Rank>& other)
+        : mpData{other.data()}, mLengths{other.GetLengths()}, mStrides{other.GetStrides()}
+    {
+    }
+
+    T* data() const { return mpData; }
+
+    const Index& GetLengths() const { return mLengths; }
+    const Index& GetStrides() const { return mStrides; }
+
+    std::size_t GetLength(std::size_t dim) const { return mLengths[dim]; }
+    std::size_t GetStride(std::size_t dim) const { return mStrides[dim]; }
+
+    std::size_t GetElementSize() const
+    {
+        std::size_t size = 1;
+
+        for(std::size_t i = 0; i < Rank; ++i)
+            size *= mLengths[i];
+
+        return size;
+    }
+
+    // whether the innermost dimension has unit stride
+    bool IsInnermostContiguous() const { return mStrides[Rank - 1] == 1; }
+
+    // whether the elements are packed in row-major order without gaps
+    bool IsPacked() const
+    {
+        std::size_t stride = 1;
+
+        for(std::size_t i = Rank; i-- > 0;)
+        {
+            if(mLengths[i] != 1 && mStrides[i] != stride)
+                return false;
+
+            stride *= mLengths[i];
+        }
+
+        return true;
+    }
+
+    template <typename... Is>
+    std::size_t GetOffset(Is... is) const
+    {
+        static_assert(sizeof...(Is) == Rank, "TensorView: wrong number of indices");
+
+        std::size_t offset = 0;
+        std::size_t i      = 0;
+
+        ((offset += static_cast<std::size_t>(is) * mStrides[i++]), ...);
+
+        return offset;
+    }
+
+    std::size_t GetOffset(const Index& idx) const
+    {
+        std::size_t offset = 0;
+
+        for(std::size_t i = 0; i < Rank; ++i)
+            offset += idx[i] * mStrides[i];
+
+        return offset;
+    }
+
+    template <typename... Is>
+    T& operator()(Is... is) const
+    {
+        return mpData[GetOffset(is...)];
+    }
+
+    T& operator()(const Index& idx) const { return mpData[GetOffset(idx)]; }
+
+    // elements [begin, end) of dimension dim
+    TensorView Slice(std::size_t dim, std::size_t begin, std::size_t end) const
+    {
+        if(dim >= Rank || begin > end || end > mLengths[dim])
+            throw std::out_of_range("TensorView: slice out of range");
+
+        TensorView view = *this;
+
+        view.mpData += begin * mStrides[dim];
+        view.mLengths[dim] = end - begin;
+
+        return view;
+    }
+
+    // element i of dimension dim, dropping the dimension
+    template <std::size_t R = Rank, typename = std::enable_if_t<(R > 1)>>
+    TensorView<T, Rank - 1> Select(std::size_t dim, std::size_t i) const
+    {
+        if(dim >= Rank || i >= mLengths[dim])
+            throw std::out_of_range("TensorView: select out of range");
+
+        std::array<std::size_t, Rank - 1> lengths;
+        std::array<std::size_t, Rank - 1> strides;
+
+        for(std::size_t d = 0, j = 0; d < Rank; ++d)
+        {
+            if(d == dim)
+                continue;
+
+            lengths[j] = mLengths[d];
+            strides[j] = mStrides[d];
+            ++j;
+        }
+
+        return TensorView<T, Rank - 1>(mpData + i * mStrides[dim], lengths, strides);
+    }
+
+    // dimension d of the result is dimension new2old[d] of this view
+    TensorView Permute(const Index& new2old) const
+    {
+        TensorView view = *this;
+
+        std::array<bool, Rank> is_used{};
+
+        for(std::size_t d = 0; d < Rank; ++d)
+        {
+            if(new2old[d] >= Rank || is_used[new2old[d]])
+                throw std::invalid_argument("TensorView: invalid permutation");
+
+            is_used[new2old[d]] = true;
+
+            view.mLengths[d] = mLengths[new2old[d]];
+            view.mStrides[d] = mStrides[new2old[d]];
+        }
+
+        return view;
+    }
+
+    TensorView Transpose(std::size_t dim0, std::size_t dim1) const
+    {
+        if(dim0 >= Rank || dim1 >= Rank)
+            throw std::out_of_range("TensorView: transpose out of range");
+
+        TensorView view = *this;
+
+        std::swap(view.mLengths[dim0], view.mLengths[dim1]);
+        std::swap(view.mStrides[dim0], view.mStrides[dim1]);
+
+        return view;
+    }
+
+    // repeats a dimension of length 1 length times, with stride 0
+    TensorView Broadcast(std::size_t dim, std::size_t length) const
+    {
+        if(dim >= Rank || mLengths[dim] != 1)
+            throw std::invalid_argument("TensorView: only dimensions of length 1 broadcast");
+
+        TensorView view = *this;
+
+        view.mLengths[dim] = length;
+        view.mStrides[dim] = 0;
+
+        return view;
+    }
+
+    // Calls f(idx, p, length, stride) for every row along the innermost dimension, where idx is
+    // the index of the first element p of the row, in row-major order.
+    template <typename F>
+    void ForEachRow(F&& f) const
+    {
+        ForEachRowIndex(mLengths, [&](const Index& idx) {
+            f(idx, mpData + GetOffset(idx), mLengths[Rank - 1], mStrides[Rank - 1]);
+        });
+    }
+
+    // Calls f(x) for every element x in row-major order
+    template <typename F>
+    void ForEach(F&& f) const
+    {
+        ForEachRow([&](const Index&, T* p, std::size_t length, std::size_t stride) {
+            if(stride == 1)
+            {
+                for(std::size_t i = 0; i < length; ++i)
+                    f(p[i]);
+            }
+            else
+            {
+                for(std::size_t i = 0; i < length; ++i)
+                    f(p[i * stride]);
+            }
+        });
+    }
+
+    // Calls f(idx) for the index idx of the first element of every innermost row of lengths,
+    // i.e. every index with idx[Rank - 1] == 0, in row-major order
+    template <typename F>
+    static void ForEachRowIndex(const Index& lengths, F&& f)
+    {
+        for(std::size_t i = 0; i < Rank; ++i)
+            if(lengths[i] == 0)
+                return;
+
+        Index idx{};
+
+        while(true)
+        {
+            f(static_cast<const Index&>(idx));
+
+            // advance the outer dimensions like an odometer
+            std::size_t d = Rank - 1;
+
+            while(d-- > 0)
+            {
+                if(++idx[d] < lengths[d])
+                    break;
+
+                idx[d] = 0;
+            }
+
+            if(d == static_cast<std::size_t>(-1))
+                return;
+        }
+    }
+
+    private:
+    T* mpData = nullptr;
+    Index mLengths{};
+    Index mStrides{};
+};
+
+namespace detail {
+
+template <typename F, std::size_t... Rs>
+bool DispatchTensorRankImpl(std::size_t rank, F&& f, std::index_sequence<Rs...>)
+{
+    return ((rank == Rs + 1 ? (f(std::integral_constant<std::size_t, Rs + 1>{}), true) : false) ||
+            ...);
+}
+
+} // namespace detail
+
+// Calls f(std::integral_constant<std::size_t, rank>{}) for a rank known at run time only, so a
+// TensorView of the right rank can be made from a Tensor. Returns false without calling f if
+// rank is 0 or larger than MaxRank.
+template <std::size_t MaxRank = 6, typename F>
+bool DispatchTensorRank(std::size_t rank, F&& f)
+{
+    return detail::DispatchTensorRankImpl(
+        rank, std::forward<F>(f), std::make_index_sequence<MaxRank>{});
+}
+
+} // namespace utils
+} // namespace ck
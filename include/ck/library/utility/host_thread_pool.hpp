@@ -0,0 +1,336 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/utility/env.hpp"
+
+// Number of threads (including the calling thread) used by host reference operations.
+// 0 or unset means std::thread::hardware_concurrency().
+CK_DECLARE_ENV_VAR_UINT64(CK_HOST_NUM_THREADS)
+
+namespace ck {
+
+// Process-wide persistent thread pool used by ParallelTensorFunctor and the host reference
+// operations.
+//
+// ParallelFor(n, max_threads, f) splits [0, n) into one contiguous range per participating
+// thread and every thread claims grain-sized chunks of its own range first. A thread that runs
+// out of work steals chunks from the ranges of the other threads, so uneven per-element cost
+// does not leave threads idle. The calling thread takes part in the work.
+//
+// Calls made from inside a running ParallelFor (nested calls) are executed serially by the
+// calling thread, so reference operations can be composed freely.
+class HostThreadPool
+{
+    public:
+    static HostThreadPool& Instance()
+    {
+        static HostThreadPool pool;
+        return pool;
+    }
+
+    HostThreadPool(const HostThreadPool&) = delete;
+    HostThreadPool& operator=(const HostThreadPool&) = delete;
+
+    ~HostThreadPool() { StopWorkers(); }
+
+    static std::size_t GetDefaultNumThreads()
+    {
+        const std::size_t env_num_thread = EnvValue(CK_ENV(CK_HOST_NUM_THREADS));
+
+        if(env_num_thread > 0)
+            return env_num_thread;
+
+        return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    // number of threads taking part in a ParallelFor, including the calling thread
+    std::size_t GetNumThreads() const { return mNumThread.load(std::memory_order_relaxed); }
+
+    // 0 restores the default (CK_HOST_NUM_THREADS or hardware concurrency)
+    void SetNumThreads(std::size_t num_thread)
+    {
+        if(num_thread == 0)
+            num_thread = GetDefaultNumThreads();
+
+        std::lock_guard<std::mutex> submit_lock(mSubmitMutex);
+
+        if(num_thread == mNumThread.load(std::memory_order_relaxed))
+            return;
+
+        StopWorkers();
+        mNumThread.store(num_thread, std::memory_order_relaxed);
+    }
+
+    // true while the current thread executes work submitted through ParallelFor
+    static bool InParallelRegion() { return InParallelRegionFlag(); }
+
+    // Calls f(begin, end) on disjoint sub-ranges that together cover [0, n).
+    // max_thread limits the number of participating threads (0 means no limit), grain is the
+    // chunk size claimed at a time (0 picks a chunk size that allows for load balancing).
+    template <typename F>
+    void ParallelFor(std::size_t n, std::size_t max_thread, F&& f, std::size_t grain = 0)
+    {
+        if(n == 0)
+            return;
+
+        // Nested calls, and calls made while another thread owns the pool, run serially on the
+        // calling thread. Waiting for the pool instead could deadlock if the owner of the pool
+        // waits for the calling thread.
+        std::unique_lock<std::mutex> submit_lock(mSubmitMutex, std::defer_lock);
+
+        if(InParallelRegion() || !submit_lock.try_lock())
+        {
+            f(std::size_t{0}, n);
+            return;
+        }
+
+        std::size_t num_thread = GetNumThreads();
+
+        if(max_thread > 0)
+            num_thread = std::min(num_thread, max_thread);
+
+        num_thread = std::min(num_thread, n);
+
+        if(num_thread <= 1)
+        {
+            submit_lock.unlock();
+            f(std::size_t{0}, n);
+            return;
+        }
+
+        if(grain == 0)
+            grain = std::max<std::size_t>(n / (num_thread * kChunksPerThread), 1);
+
+        using Func = std::remove_reference_t<F>;
+
+        Job job;
+        job.mNumParticipant = num_thread;
+        job.mGrain          = grain;
+        job.mpFunc          = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+        job.mpInvoke        = [](void* p_func, std::size_t begin, std::size_t end) {
+            (*static_cast<Func*>(p_func))(begin, end);
+        };
+        job.mRanges = std::make_unique<Range[]>(num_thread);
+
+        for(std::size_t i = 0; i < num_thread; ++i)
+        {
+            job.mRanges[i].mNext.store(n * i / num_thread, std::memory_order_relaxed);
+            job.mRanges[i].mEnd = n * (i + 1) / num_thread;
+        }
+
+        StartWorkers();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mpJob       = &job;
+            mNumPending = num_thread - 1;
+            ++mGeneration;
+        }
+        mWorkCv.notify_all();
+
+        // the calling thread is participant 0
+        RunParticipant(job, 0);
+
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mDoneCv.wait(lock, [&] { return mNumPending == 0; });
+            mpJob = nullptr;
+        }
+
+        if(job.mException)
+            std::rethrow_exception(job.mException);
+    }
+
+    private:
+    static constexpr std::size_t kChunksPerThread = 16;
+
+    struct alignas(64) Range
+    {
+        std::atomic<std::size_t> mNext{0};
+        std::size_t mEnd = 0;
+    };
+
+    struct Job
+    {
+        std::size_t mNumParticipant = 0;
+        std::size_t mGrain          = 1;
+        void* mpFunc                = nullptr;
+
+        void (*mpInvoke)(void*, std::size_t, std::size_t) = nullptr;
+        std::unique_ptr<Range[]> mRanges;
+
+        std::mutex mExceptionMutex;
+        std::exception_ptr mException;
+    };
+
+    HostThreadPool() : mNumThread(GetDefaultNumThreads()) {}
+
+    static bool& InParallelRegionFlag()
+    {
+        static thread_local bool in_parallel_region = false;
+        return in_parallel_region;
+    }
+
+    // claim one chunk of range r, returns false once the range is exhausted
+    static bool ClaimChunk(Range& r, std::size_t grain, std::size_t& begin, std::size_t& end)
+    {
+        if(r.mNext.load(std::memory_order_relaxed) >= r.mEnd)
+            return false;
+
+        begin = r.mNext.fetch_add(grain, std::memory_order_relaxed);
+
+        if(begin >= r.mEnd)
+            return false;
+
+        end = std::min(begin + grain, r.mEnd);
+        return true;
+    }
+
+    static void RunParticipant(Job& job, std::size_t participant)
+    {
+        InParallelRegionFlag() = true;
+
+        try
+        {
+            std::size_t begin = 0;
+            std::size_t end   = 0;
+
+            // own range first, then steal from the others in round-robin order
+            for(std::size_t i = 0; i < job.mNumParticipant; ++i)
+            {
+                Range& r = job.mRanges[(participant + i) % job.mNumParticipant];
+
+                while(ClaimChunk(r, job.mGrain, begin, end))
+                {
+                    job.mpInvoke(job.mpFunc, begin, end);
+                }
+            }
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(job.mExceptionMutex);
+
+            if(!job.mException)
+                job.mException = std::current_exception();
+
+            // drain all ranges so that the other participants stop early
+            for(std::size_t i = 0; i < job.mNumParticipant; ++i)
+                job.mRanges[i].mNext.store(job.mRanges[i].mEnd, std::memory_order_relaxed);
+        }
+
+        InParallelRegionFlag() = false;
+    }
+
+    void WorkerLoop(std::size_t participant)
+    {
+        std::size_t seen_generation = 0;
+
+        while(true)
+        {
+            Job* p_job = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWorkCv.wait(lock, [&] { return mStop || mGeneration != seen_generation; });
+
+                if(mStop)
+                    return;
+
+                seen_generation = mGeneration;
+                p_job           = mpJob;
+            }
+
+            if(p_job == nullptr || participant >= p_job->mNumParticipant)
+                continue;
+
+            RunParticipant(*p_job, participant);
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                --mNumPending;
+
+                if(mNumPending != 0)
+                    continue;
+            }
+            mDoneCv.notify_one();
+        }
+    }
+
+    // must be called with mSubmitMutex held
+    void StartWorkers()
+    {
+        const std::size_t num_worker = GetNumThreads() - 1;
+
+        if(mWorkers.size() == num_worker)
+            return;
+
+        StopWorkers();
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop       = false;
+            mGeneration = 0;
+        }
+
+        mWorkers.reserve(num_worker);
+
+        for(std::size_t i = 0; i < num_worker; ++i)
+        {
+            // worker i is participant i + 1
+            mWorkers.emplace_back([this, i] { WorkerLoop(i + 1); });
+        }
+    }
+
+    void StopWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mWorkCv.notify_all();
+
+        for(auto& worker : mWorkers)
+        {
+            if(worker.joinable())
+                worker.join();
+        }
+
+        mWorkers.clear();
+    }
+
+    std::atomic<std::size_t> mNumThread;
+
+    std::mutex mSubmitMutex;
+
+    std::mutex mMutex;
+    std::condition_variable mWorkCv;
+    std::condition_variable mDoneCv;
+    bool mStop               = false;
+    std::size_t mGeneration  = 0;
+    std::size_t mNumPending  = 0;
+    Job* mpJob               = nullptr;
+    std::vector<std::thread> mWorkers;
+};
+
+inline std::size_t GetHostNumThreads() { return HostThreadPool::Instance().GetNumThreads(); }
+
+inline void SetHostNumThreads(std::size_t num_thread)
+{
+    HostThreadPool::Instance().SetNumThreads(num_thread);
+}
+
+} // namespace ck
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+
+#include "ck/library/utility/host_thread_pool.hpp"
+
+namespace ck {
+namespace utils {
+
+// Bulk host type conversion.
+//
+// type_convert_n(), f8_convert_rne_n() and f8_convert_sr_n() convert n elements and give
+// bit-exactly the results of calling type_convert<Y>(), f8_convert_rne<Y>() and
+// f8_convert_sr<Y>() on every element. Buffers are converted in chunks on the host thread pool.
+//
+// Conversions from an fp8/bf8 type (FNUZ or OCP), and deterministic conversions from fp16/bf16 to
+// fp16/bf16/fp8/bf8, read the result from a table that is filled by the scalar conversion
+// on first use. fp16 <-> fp32 uses the F16C instructions if the CPU has them. The remaining
+// conversions call the scalar function for every element.
+
+namespace detail {
+
+inline constexpr std::size_t kTypeConvertChunkSize = 1 << 16;
+
+template <typename T>
+constexpr bool IsFloat8Type()
+{
+    return std::is_same_v<T, f8_fnuz_t> || std::is_same_v<T, bf8_fnuz_t> ||
+           std::is_same_v<T, f8_ocp_t> || std::is_same_v<T, bf8_ocp_t>;
+}
+
+struct TypeConvertOp
+{
+    template <typename Y, typename X>
+    static Y Apply(X x)
+    {
+        return type_convert<Y>(x);
+    }
+
+    // type_convert() to fp8/bf8 rounds stochastically if CK_USE_SR_F8_CONVERSION is set
+    template <typename Y>
+    static constexpr bool IsDeterministic()
+    {
+        return !(CK_USE_SR_F8_CONVERSION && IsFloat8Type<Y>());
+    }
+};
+
+struct F8ConvertRneOp
+{
+    template <typename Y, typename X>
+    static Y Apply(X x)
+    {
+        return f8_convert_rne<Y>(x);
+    }
+
+    template <typename Y>
+    static constexpr bool IsDeterministic()
+    {
+        return true;
+    }
+};
+
+struct F8ConvertSrOp
+{
+    template <typename Y, typename X>
+    static Y Apply(X x)
+    {
+        return f8_convert_sr<Y>(x);
+    }
+
+    template <typename Y>
+    static constexpr bool IsDeterministic()
+    {
+        return false;
+    }
+};
+
+template <typename Op, typename Y, typename X>
+constexpr bool UseConvertLut()
+{
+    if constexpr(!Op::template IsDeterministic<Y>() || std::is_same_v<Y, X>)
+        return false;
+    else if constexpr(IsFloat8Type<X>())
+        return true;
+    else
+        return (std::is_same_v<X, half_t> || std::is_same_v<X, bhalf_t>) &&
+               (std::is_same_v<Y, half_t> || std::is_same_v<Y, bhalf_t> || IsFloat8Type<Y>());
+}
+
+template <typename X>
+using ConvertLutIndex = std::conditional_t<sizeof(X) == 1, uint8_t, uint16_t>;
+
+template <typename X>
+ConvertLutIndex<X> GetConvertLutIndex(const X& x)
+{
+    ConvertLutIndex<X> index;
+    std::memcpy(&index, &x, sizeof(X));
+    return index;
+}
+
+// Op applied to every bit pattern of X, built once per process
+template <typename Op, typename Y, typename X>
+const Y* GetConvertLut()
+{
+    static_assert(sizeof(X) <= 2, "lookup tables are only built for 8-bit and 16-bit sources");
+
+    static const std::vector<Y> lut = [] {
+        constexpr std::size_t lut_size = std::size_t{1} << (8 * sizeof(X));
+
+        std::vector<Y> values(lut_size);
+
+        for(std::size_t i = 0; i < lut_size; ++i)
+        {
+            const auto index = static_cast<ConvertLutIndex<X>>(i);
+
+            X x;
+            std::memcpy(&x, &index, sizeof(X));
+
+            values[i] = Op::template Apply<Y>(x);
+        }
+
+        return values;
+    }();
+
+    return lut.data();
+}
+
+#if defined(__x86_64__) && !defined(__HIP_DEVICE_COMPILE__)
+// The conversions between fp16 and fp32 are exact or round to nearest even, which is what the
+// F16C instructions do, so a plain loop compiled for F16C gives the results of the scalar
+// conversion.
+inline bool HasF16c()
+{
+    static const bool has_f16c = __builtin_cpu_supports("f16c");
+    return has_f16c;
+}
+
+__attribute__((target("f16c"))) inline void
+ConvertF16c(const half_t* p_x, std::size_t n, float* p_y)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        p_y[i] = type_convert<float>(p_x[i]);
+}
+
+__attribute__((target("f16c"))) inline void
+ConvertF16c(const float* p_x, std::size_t n, half_t* p_y)
+{
+    for(std::size_t i = 0; i < n; ++i)
+        p_y[i] = type_convert<half_t>(p_x[i]);
+}
+#endif
+
+template <typename Op, typename Y, typename X>
+void ConvertRange(const X* p_x, std::size_t n, Y* p_y)
+{
+    if constexpr(UseConvertLut<Op, Y, X>())
+    {
+        const Y* p_lut = GetConvertLut<Op, Y, X>();
+
+        for(std::size_t i = 0; i < n; ++i)
+            p_y[i] = p_lut[GetConvertLutIndex(p_x[i])];
+
+        return;
+    }
+
+#if defined(__x86_64__) && !defined(__HIP_DEVICE_COMPILE__)
+    if constexpr(std::is_same_v<Op, TypeConvertOp> &&
+                 ((std::is_same_v<X, half_t> && std::is_same_v<Y, float>) ||
+                  (std::is_same_v<X, float> && std::is_same_v<Y, half_t>)))
+    {
+        if(HasF16c())
+        {
+            ConvertF16c(p_x, n, p_y);
+            return;
+        }
+    }
+#endif
+
+    for(std::size_t i = 0; i < n; ++i)
+        p_y[i] = Op::template Apply<Y>(p_x[i]);
+}
+
+template <typename Op, typename Y, typename X>
+void ParallelConvert(const X* p_x, std::size_t n, Y* p_y)
+{
+    const std::size_t num_chunk = (n + kTypeConvertChunkSize - 1) / kTypeConvertChunkSize;
+
+    HostThreadPool::Instance().ParallelFor(
+        num_chunk, 0, [&](std::size_t chunk_begin, std::size_t chunk_end) {
+            const std::size_t begin = chunk_begin * kTypeConvertChunkSize;
+            const std::size_t end   = std::min(chunk_end * kTypeConvertChunkSize, n);
+
+            ConvertRange<Op>(p_x + begin, end - begin, p_y + begin);
+        });
+}
+
+} // namespace detail
+
+// p_y[i] = type_convert<Y>(p_x[i]) for i in [0, n)
+template <typename Y, typename X>
+void type_convert_n(const X* p_x, std::size_t n, Y* p_y)
+{
+    detail::ParallelConvert<detail::TypeConvertOp>(p_x, n, p_y);
+}
+
+// p_y[i] = f8_convert_rne<Y>(p_x[i]) for i in [0, n)
+template <typename Y, typename X>
+void f8_convert_rne_n(const X* p_x, std::size_t n, Y* p_y)
+{
+    detail::ParallelConvert<detail::F8ConvertRneOp>(p_x, n, p_y);
+}
+
+// p_y[i] = f8_convert_sr<Y>(p_x[i]) for i in [0, n)
+template <typename Y, typename X>
+void f8_convert_sr_n(const X* p_x, std::size_t n, Y* p_y)
+{
+    detail::ParallelConvert<detail::F8ConvertSrOp>(p_x, n, p_y);
+}
+
+} // namespace utils
+} // namespace ck
@@ -6,6 +6,8 @@
 #include <hip/hip_runtime.h>
 #include <hip/hip_fp16.h>
 
+#include "ck/host_utility/timing_statistics.hpp"
+
 struct StreamConfig
 {
     hipStream_t stream_id_ = nullptr;
@@ -16,4 +18,13 @@ struct StreamConfig
 
     bool flush_cache   = false;
     int rotating_count = 1;
+
+    // With adaptive timing, launches are timed in samples until the confidence interval of the
+    // median is within target_relative_ci_ of the median, taking between nrepeat_ and
+    // max_nrepeat_ samples, and the median is returned instead of the mean. The statistics of
+    // the samples are stored to *timing_summary_ if it is set.
+    bool adaptive_timing_                       = false;
+    float target_relative_ci_                   = 0.01f;
+    int max_nrepeat_                            = 1000;
+    ck::utility::TimingSummary* timing_summary_ = nullptr;
 };
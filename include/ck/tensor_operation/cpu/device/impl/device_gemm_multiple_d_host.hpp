@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "ck/utility/common_header.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/device/device_gemm_multiple_d.hpp"
+#include "ck/host_utility/host_kernel_launch.hpp"
+#include "ck/library/utility/host_blocked_gemm.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+
+// DeviceGemmMultipleD that runs on the host CPU.
+//
+// All pointers passed to MakeArgumentPointer() are host pointers. The GEMM runs on the
+// cache-blocked, multi-threaded host GEMM engine (ck::utils::HostBlockedGemm), the element-wise
+// operations are applied like in host::ReferenceGemmMultipleD:
+//   C = a_op(A) * b_op(B), accumulated in AccDataType
+//   E = cde_op(C, D0, D1, ...)
+template <typename ALayout,
+          typename BLayout,
+          typename DsLayout,
+          typename ELayout,
+          typename ADataType,
+          typename BDataType,
+          typename DsDataType,
+          typename EDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CDEElementwiseOperation,
+          typename AccDataType,
+          ck::utils::HostGemmAccumulation Accumulation>
+struct DeviceGemmMultipleD_Host : public DeviceGemmMultipleD<ALayout,
+                                                             BLayout,
+                                                             DsLayout,
+                                                             ELayout,
+                                                             ADataType,
+                                                             BDataType,
+                                                             DsDataType,
+                                                             EDataType,
+                                                             AElementwiseOperation,
+                                                             BElementwiseOperation,
+                                                             CDEElementwiseOperation>
+{
+    using DeviceOp = DeviceGemmMultipleD_Host;
+
+    static constexpr index_t NumDTensor = DsDataType::Size();
+
+    static_assert(DsLayout::Size() == NumDTensor, "wrong! inconsistent NumDTensor");
+
+    template <index_t I>
+    using DDataType = remove_cvref_t<tuple_element_t<I, DsDataType>>;
+
+    template <index_t I>
+    using DLayout = remove_cvref_t<tuple_element_t<I, DsLayout>>;
+
+    template <typename Layout>
+    static constexpr bool IsRowMajor()
+    {
+        return is_same_v<Layout, tensor_layout::gemm::RowMajor>;
+    }
+
+    // offset of element (row, col) of a matrix with the given layout and leading dimension
+    template <typename Layout>
+    static long_index_t GetOffset(index_t row, index_t col, index_t stride)
+    {
+        if constexpr(IsRowMajor<Layout>())
+            return static_cast<long_index_t>(row) * stride + col;
+        else
+            return static_cast<long_index_t>(col) * stride + row;
+    }
+
+    template <typename Layout>
+    static bool IsValidStride(index_t num_row, index_t num_col, index_t stride)
+    {
+        return stride >= (IsRowMajor<Layout>() ? num_col : num_row);
+    }
+
+    // Argument
+    struct Argument : public BaseArgument
+    {
+        Argument(const void* p_a,
+                 const void* p_b,
+                 std::array<const void*, NumDTensor> p_ds,
+                 void* p_e,
+                 index_t M,
+                 index_t N,
+                 index_t K,
+                 index_t StrideA,
+                 index_t StrideB,
+                 std::array<index_t, NumDTensor> StrideDs,
+                 index_t StrideE,
+                 AElementwiseOperation a_element_op,
+                 BElementwiseOperation b_element_op,
+                 CDEElementwiseOperation cde_element_op)
+            : p_a_{static_cast<const ADataType*>(p_a)},
+              p_b_{static_cast<const BDataType*>(p_b)},
+              p_ds_{p_ds},
+              p_e_{static_cast<EDataType*>(p_e)},
+              M_{M},
+              N_{N},
+              K_{K},
+              StrideA_{StrideA},
+              StrideB_{StrideB},
+              StrideDs_{StrideDs},
+              StrideE_{StrideE},
+              a_element_op_{a_element_op},
+              b_element_op_{b_element_op},
+              cde_element_op_{cde_element_op}
+        {
+        }
+
+        template <index_t I>
+        const DDataType<I>& GetD(index_t m, index_t n) const
+        {
+            return static_cast<const DDataType<I>*>(
+                p_ds_[I])[GetOffset<DLayout<I>>(m, n, StrideDs_[I])];
+        }
+
+        const ADataType* p_a_;
+        const BDataType* p_b_;
+        std::array<const void*, NumDTensor> p_ds_;
+        EDataType* p_e_;
+
+        index_t M_;
+        index_t N_;
+        index_t K_;
+
+        index_t StrideA_;
+        index_t StrideB_;
+        std::array<index_t, NumDTensor> StrideDs_;
+        index_t StrideE_;
+
+        AElementwiseOperation a_element_op_;
+        BElementwiseOperation b_element_op_;
+        CDEElementwiseOperation cde_element_op_;
+    };
+
+    // Invoker
+    struct Invoker : public BaseInvoker
+    {
+        template <index_t... Is>
+        static void RunCde(const Argument& arg,
+                           EDataType& e,
+                           const AccDataType& c,
+                           index_t m,
+                           index_t n,
+                           std::integer_sequence<index_t, Is...>)
+        {
+            arg.cde_element_op_(e, c, arg.template GetD<Is>(m, n)...);
+        }
+
+        static void RunGemm(const Argument& arg)
+        {
+            auto load_a = [&](std::size_t m, std::size_t k) {
+                ADataType v_a{0};
+                arg.a_element_op_(v_a, arg.p_a_[GetOffset<ALayout>(m, k, arg.StrideA_)]);
+                return ck::type_convert<AccDataType>(v_a);
+            };
+
+            auto load_b = [&](std::size_t k, std::size_t n) {
+                BDataType v_b{0};
+                arg.b_element_op_(v_b, arg.p_b_[GetOffset<BLayout>(k, n, arg.StrideB_)]);
+                return ck::type_convert<AccDataType>(v_b);
+            };
+
+            auto store_c = [&](std::size_t m, std::size_t n, AccDataType v_acc) {
+                EDataType v_e{0};
+                RunCde(arg, v_e, v_acc, m, n, std::make_integer_sequence<index_t, NumDTensor>{});
+                arg.p_e_[GetOffset<ELayout>(m, n, arg.StrideE_)] = v_e;
+            };
+
+            ck::utils::HostBlockedGemm<AccDataType>::Run(
+                arg.M_, arg.N_, arg.K_, load_a, load_b, store_c, Accumulation);
+        }
+
+        float Run(const Argument& arg, const StreamConfig& stream_config = StreamConfig{})
+        {
+            return launch_and_time_host_kernel(stream_config, [&] { RunGemm(arg); });
+        }
+
+        // polymorphic
+        float Run(const BaseArgument* p_arg,
+                  const StreamConfig& stream_config = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg), stream_config);
+        }
+    };
+
+    static bool IsSupportedArgument(const Argument& arg)
+    {
+        if(arg.M_ <= 0 || arg.N_ <= 0 || arg.K_ < 0)
+            return false;
+
+        if(arg.p_a_ == nullptr || arg.p_b_ == nullptr || arg.p_e_ == nullptr)
+            return false;
+
+        if(!IsValidStride<ALayout>(arg.M_, arg.K_, arg.StrideA_) ||
+           !IsValidStride<BLayout>(arg.K_, arg.N_, arg.StrideB_) ||
+           !IsValidStride<ELayout>(arg.M_, arg.N_, arg.StrideE_))
+            return false;
+
+        bool valid = true;
+
+        static_for<0, NumDTensor, 1>{}([&](auto i) {
+            valid = valid && arg.p_ds_[i] != nullptr &&
+                    IsValidStride<DLayout<i.value>>(arg.M_, arg.N_, arg.StrideDs_[i]);
+        });
+
+        return valid;
+    }
+
+    // polymorphic
+    bool IsSupportedArgument(const BaseArgument* p_arg) override
+    {
+        return IsSupportedArgument(*dynamic_cast<const Argument*>(p_arg));
+    }
+
+    static auto MakeArgument(const void* p_a,
+                             const void* p_b,
+                             std::array<const void*, NumDTensor> p_ds,
+                             void* p_e,
+                             index_t M,
+                             index_t N,
+                             index_t K,
+                             index_t StrideA,
+                             index_t StrideB,
+                             std::array<index_t, NumDTensor> StrideDs,
+                             index_t StrideE,
+                             AElementwiseOperation a_element_op,
+                             BElementwiseOperation b_element_op,
+                             CDEElementwiseOperation cde_element_op)
+    {
+        return Argument{p_a,
+                        p_b,
+                        p_ds,
+                        p_e,
+                        M,
+                        N,
+                        K,
+                        StrideA,
+                        StrideB,
+                        StrideDs,
+                        StrideE,
+                        a_element_op,
+                        b_element_op,
+                        cde_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    // polymorphic
+    std::unique_ptr<BaseArgument>
+    MakeArgumentPointer(const void* p_a,
+                        const void* p_b,
+                        std::array<const void*, NumDTensor> p_ds,
+                        void* p_e,
+                        index_t M,
+                        index_t N,
+                        index_t K,
+                        index_t StrideA,
+                        index_t StrideB,
+                        std::array<index_t, NumDTensor> StrideDs,
+                        index_t StrideE,
+                        AElementwiseOperation a_element_op,
+                        BElementwiseOperation b_element_op,
+                        CDEElementwiseOperation cde_element_op) override
+    {
+        return std::make_unique<Argument>(p_a,
+                                          p_b,
+                                          p_ds,
+                                          p_e,
+                                          M,
+                                          N,
+                                          K,
+                                          StrideA,
+                                          StrideB,
+                                          StrideDs,
+                                          StrideE,
+                                          a_element_op,
+                                          b_element_op,
+                                          cde_element_op);
+    }
+
+    // polymorphic
+    std::unique_ptr<BaseInvoker> MakeInvokerPointer() override
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    // polymorphic
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "DeviceGemmMultipleD_Host"
+            << "<"
+            << (Accumulation == ck::utils::HostGemmAccumulation::Fused ? "Fused" : "Sequential")
+            << ">";
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,519 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "ck/utility/common_header.hpp"
+#include "ck/tensor_operation/gpu/device/device_grouped_conv_fwd_multiple_abd.hpp"
+#include "ck/host_utility/host_kernel_launch.hpp"
+#include "ck/library/utility/host_blocked_gemm.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+
+// DeviceGroupedConvFwdMultipleABD that runs on the host CPU.
+//
+// All pointers passed to MakeArgumentPointer() are host pointers. Every group is lowered to an
+// implicit GEMM (im2col on the fly, like host::ReferenceConvFwd) that runs on the cache-blocked,
+// multi-threaded host GEMM engine:
+//   GEMM M = N * Wo..., GEMM N = K, GEMM K = C * X...
+// The tensors may have any strides, so all layouts are supported. The accumulator is converted
+// to EDataType before cde_op is applied, like in host::ReferenceConvFwd. Multiple A/B tensors
+// are not supported.
+template <index_t NDimSpatial,
+          typename ALayout,
+          typename BLayout,
+          typename DsLayout,
+          typename ELayout,
+          typename ADataType,
+          typename BDataType,
+          typename DsDataType,
+          typename EDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CDEElementwiseOperation,
+          typename AccDataType,
+          ck::utils::HostGemmAccumulation Accumulation,
+          typename AComputeType = ADataType,
+          typename BComputeType = AComputeType>
+struct DeviceGroupedConvFwdMultipleABD_Host
+    : public DeviceGroupedConvFwdMultipleABD<NDimSpatial,
+                                             ALayout,
+                                             BLayout,
+                                             DsLayout,
+                                             ELayout,
+                                             ADataType,
+                                             BDataType,
+                                             DsDataType,
+                                             EDataType,
+                                             AElementwiseOperation,
+                                             BElementwiseOperation,
+                                             CDEElementwiseOperation,
+                                             AComputeType,
+                                             BComputeType>
+{
+    using DeviceOp = DeviceGroupedConvFwdMultipleABD_Host;
+
+    using BaseOp = DeviceGroupedConvFwdMultipleABD<NDimSpatial,
+                                                   ALayout,
+                                                   BLayout,
+                                                   DsLayout,
+                                                   ELayout,
+                                                   ADataType,
+                                                   BDataType,
+                                                   DsDataType,
+                                                   EDataType,
+                                                   AElementwiseOperation,
+                                                   BElementwiseOperation,
+                                                   CDEElementwiseOperation,
+                                                   AComputeType,
+                                                   BComputeType>;
+
+    static_assert(!BaseOp::isMultiA && !BaseOp::isMultiB,
+                  "multiple A/B tensors are not supported on the host");
+
+    static constexpr index_t NumDTensor = DsDataType::Size();
+
+    template <index_t I>
+    using DDataType = remove_cvref_t<tuple_element_t<I, DsDataType>>;
+
+    using Lengths   = std::array<long_index_t, NDimSpatial + 3>;
+    using Strides   = std::array<long_index_t, NDimSpatial + 3>;
+    using ConvParam = std::array<long_index_t, NDimSpatial>;
+
+    template <typename T, std::size_t N>
+    static std::array<long_index_t, N> ToLongIndex(const std::array<T, N>& x)
+    {
+        std::array<long_index_t, N> y;
+
+        for(std::size_t i = 0; i < N; ++i)
+            y[i] = x[i];
+
+        return y;
+    }
+
+    // Argument
+    struct Argument : public BaseArgument
+    {
+        Argument(const void* p_a,
+                 const void* p_b,
+                 const std::array<const void*, NumDTensor>& p_ds,
+                 void* p_e,
+                 const Lengths& a_g_n_c_wis_lengths,
+                 const Strides& a_g_n_c_wis_strides,
+                 const Lengths& b_g_k_c_xs_lengths,
+                 const Strides& b_g_k_c_xs_strides,
+                 const std::array<Lengths, NumDTensor>& ds_g_n_k_wos_lengths,
+                 const std::array<Strides, NumDTensor>& ds_g_n_k_wos_strides,
+                 const Lengths& e_g_n_k_wos_lengths,
+                 const Strides& e_g_n_k_wos_strides,
+                 const ConvParam& conv_filter_strides,
+                 const ConvParam& conv_filter_dilations,
+                 const ConvParam& input_left_pads,
+                 const ConvParam& input_right_pads,
+                 const AElementwiseOperation& a_element_op,
+                 const BElementwiseOperation& b_element_op,
+                 const CDEElementwiseOperation& cde_element_op)
+            : p_a_{static_cast<const ADataType*>(p_a)},
+              p_b_{static_cast<const BDataType*>(p_b)},
+              p_ds_{p_ds},
+              p_e_{static_cast<EDataType*>(p_e)},
+              a_g_n_c_wis_lengths_{a_g_n_c_wis_lengths},
+              a_g_n_c_wis_strides_{a_g_n_c_wis_strides},
+              b_g_k_c_xs_lengths_{b_g_k_c_xs_lengths},
+              b_g_k_c_xs_strides_{b_g_k_c_xs_strides},
+              ds_g_n_k_wos_lengths_{ds_g_n_k_wos_lengths},
+              ds_g_n_k_wos_strides_{ds_g_n_k_wos_strides},
+              e_g_n_k_wos_lengths_{e_g_n_k_wos_lengths},
+              e_g_n_k_wos_strides_{e_g_n_k_wos_strides},
+              conv_filter_strides_{conv_filter_strides},
+              conv_filter_dilations_{conv_filter_dilations},
+              input_left_pads_{input_left_pads},
+              input_right_pads_{input_right_pads},
+              a_element_op_{a_element_op},
+              b_element_op_{b_element_op},
+              cde_element_op_{cde_element_op}
+        {
+        }
+
+        const ADataType* p_a_;
+        const BDataType* p_b_;
+        std::array<const void*, NumDTensor> p_ds_;
+        EDataType* p_e_;
+
+        Lengths a_g_n_c_wis_lengths_;
+        Strides a_g_n_c_wis_strides_;
+        Lengths b_g_k_c_xs_lengths_;
+        Strides b_g_k_c_xs_strides_;
+        std::array<Lengths, NumDTensor> ds_g_n_k_wos_lengths_;
+        std::array<Strides, NumDTensor> ds_g_n_k_wos_strides_;
+        Lengths e_g_n_k_wos_lengths_;
+        Strides e_g_n_k_wos_strides_;
+
+        ConvParam conv_filter_strides_;
+        ConvParam conv_filter_dilations_;
+        ConvParam input_left_pads_;
+        ConvParam input_right_pads_;
+
+        AElementwiseOperation a_element_op_;
+        BElementwiseOperation b_element_op_;
+        CDEElementwiseOperation cde_element_op_;
+    };
+
+    // Invoker
+    struct Invoker : public BaseInvoker
+    {
+        static long_index_t GetOffset(const Strides& strides, const Strides& idx)
+        {
+            long_index_t offset = 0;
+
+            for(index_t i = 0; i < NDimSpatial + 3; ++i)
+                offset += strides[i] * idx[i];
+
+            return offset;
+        }
+
+        template <index_t... Is>
+        static void RunCde(const Argument& arg,
+                           EDataType& e,
+                           const EDataType& c,
+                           const Strides& idx,
+                           std::integer_sequence<index_t, Is...>)
+        {
+            arg.cde_element_op_(
+                e,
+                c,
+                static_cast<const DDataType<Is>*>(
+                    arg.p_ds_[Is])[GetOffset(arg.ds_g_n_k_wos_strides_[Is], idx)]...);
+        }
+
+        static void RunGemm(const Argument& arg)
+        {
+            const auto& a_lengths = arg.a_g_n_c_wis_lengths_;
+            const auto& b_lengths = arg.b_g_k_c_xs_lengths_;
+            const auto& e_lengths = arg.e_g_n_k_wos_lengths_;
+
+            const long_index_t G = e_lengths[0];
+            const long_index_t N = e_lengths[1];
+            const long_index_t K = e_lengths[2];
+            const long_index_t C = b_lengths[2];
+
+            long_index_t gemm_m = N;
+            long_index_t gemm_k = C;
+
+            for(index_t d = 0; d < NDimSpatial; ++d)
+            {
+                gemm_m *= e_lengths[3 + d];
+                gemm_k *= b_lengths[3 + d];
+            }
+
+            // gemm_m -> [g, n, k, wo...] with the given g and k
+            auto decode_m = [&](long_index_t m, long_index_t g, long_index_t k) {
+                Strides idx{g, 0, k};
+
+                for(index_t d = NDimSpatial - 1; d >= 0; --d)
+                {
+                    idx[3 + d] = m % e_lengths[3 + d];
+                    m /= e_lengths[3 + d];
+                }
+                idx[1] = m;
+
+                return idx;
+            };
+
+            // gemm_k -> [g, k, c, x...] with the given g and k
+            auto decode_k = [&](long_index_t kk, long_index_t g, long_index_t k) {
+                Strides idx{g, k, 0};
+
+                for(index_t d = NDimSpatial - 1; d >= 0; --d)
+                {
+                    idx[3 + d] = kk % b_lengths[3 + d];
+                    kk /= b_lengths[3 + d];
+                }
+                idx[2] = kk;
+
+                return idx;
+            };
+
+            for(long_index_t g = 0; g < G; ++g)
+            {
+                auto load_a = [&](std::size_t m, std::size_t kk) {
+                    const Strides e_idx = decode_m(m, g, 0);
+                    const Strides b_idx = decode_k(kk, g, 0);
+
+                    Strides a_idx{g, e_idx[1], b_idx[2]};
+
+                    for(index_t d = 0; d < NDimSpatial; ++d)
+                    {
+                        const long_index_t wi = e_idx[3 + d] * arg.conv_filter_strides_[d] +
+                                                b_idx[3 + d] * arg.conv_filter_dilations_[d] -
+                                                arg.input_left_pads_[d];
+
+                        if(wi < 0 || wi >= a_lengths[3 + d])
+                            return AccDataType{0};
+
+                        a_idx[3 + d] = wi;
+                    }
+
+                    AComputeType v_a{0};
+                    arg.a_element_op_(v_a, arg.p_a_[GetOffset(arg.a_g_n_c_wis_strides_, a_idx)]);
+                    return ck::type_convert<AccDataType>(v_a);
+                };
+
+                auto load_b = [&](std::size_t kk, std::size_t k) {
+                    BComputeType v_b{0};
+                    arg.b_element_op_(
+                        v_b, arg.p_b_[GetOffset(arg.b_g_k_c_xs_strides_, decode_k(kk, g, k))]);
+                    return ck::type_convert<AccDataType>(v_b);
+                };
+
+                auto store_c = [&](std::size_t m, std::size_t k, AccDataType v_acc) {
+                    const Strides e_idx = decode_m(m, g, k);
+
+                    EDataType v_e{0};
+                    RunCde(arg,
+                           v_e,
+                           ck::type_convert<EDataType>(v_acc),
+                           e_idx,
+                           std::make_integer_sequence<index_t, NumDTensor>{});
+                    arg.p_e_[GetOffset(arg.e_g_n_k_wos_strides_, e_idx)] = v_e;
+                };
+
+                ck::utils::HostBlockedGemm<AccDataType>::Run(
+                    gemm_m, K, gemm_k, load_a, load_b, store_c, Accumulation);
+            }
+        }
+
+        float Run(const Argument& arg, const StreamConfig& stream_config = StreamConfig{})
+        {
+            return launch_and_time_host_kernel(stream_config, [&] { RunGemm(arg); });
+        }
+
+        // polymorphic
+        float Run(const BaseArgument* p_arg,
+                  const StreamConfig& stream_config = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg), stream_config);
+        }
+    };
+
+    static bool IsSupportedArgument(const Argument& arg)
+    {
+        const auto& a_lengths = arg.a_g_n_c_wis_lengths_;
+        const auto& b_lengths = arg.b_g_k_c_xs_lengths_;
+        const auto& e_lengths = arg.e_g_n_k_wos_lengths_;
+
+        if(arg.p_a_ == nullptr || arg.p_b_ == nullptr || arg.p_e_ == nullptr)
+            return false;
+
+        // G, N/K and C have to agree between the tensors
+        if(a_lengths[0] != e_lengths[0] || b_lengths[0] != e_lengths[0] ||
+           a_lengths[1] != e_lengths[1] || b_lengths[1] != e_lengths[2] ||
+           a_lengths[2] != b_lengths[2])
+            return false;
+
+        for(index_t i = 0; i < NDimSpatial + 3; ++i)
+        {
+            if(a_lengths[i] <= 0 || b_lengths[i] <= 0 || e_lengths[i] <= 0)
+                return false;
+        }
+
+        // the output size has to follow from the input size, the filter and the padding
+        for(index_t d = 0; d < NDimSpatial; ++d)
+        {
+            const long_index_t x_eff = (b_lengths[3 + d] - 1) * arg.conv_filter_dilations_[d] + 1;
+            const long_index_t wi_padded =
+                a_lengths[3 + d] + arg.input_left_pads_[d] + arg.input_right_pads_[d];
+
+            if(arg.conv_filter_strides_[d] <= 0 || arg.conv_filter_dilations_[d] <= 0 ||
+               wi_padded < x_eff ||
+               e_lengths[3 + d] != (wi_padded - x_eff) / arg.conv_filter_strides_[d] + 1)
+                return false;
+        }
+
+        for(index_t i = 0; i < NumDTensor; ++i)
+        {
+            if(arg.p_ds_[i] == nullptr || arg.ds_g_n_k_wos_lengths_[i] != e_lengths)
+                return false;
+        }
+
+        return true;
+    }
+
+    // polymorphic
+    bool IsSupportedArgument(const BaseArgument* p_arg) override
+    {
+        return IsSupportedArgument(*dynamic_cast<const Argument*>(p_arg));
+    }
+
+    static auto MakeArgument(const void* p_a,
+                             const void* p_b,
+                             const std::array<const void*, NumDTensor>& p_ds,
+                             void* p_e,
+                             const Lengths& a_g_n_c_wis_lengths,
+                             const Strides& a_g_n_c_wis_strides,
+                             const Lengths& b_g_k_c_xs_lengths,
+                             const Strides& b_g_k_c_xs_strides,
+                             const std::array<Lengths, NumDTensor>& ds_g_n_k_wos_lengths,
+                             const std::array<Strides, NumDTensor>& ds_g_n_k_wos_strides,
+                             const Lengths& e_g_n_k_wos_lengths,
+                             const Strides& e_g_n_k_wos_strides,
+                             const ConvParam& conv_filter_strides,
+                             const ConvParam& conv_filter_dilations,
+                             const ConvParam& input_left_pads,
+                             const ConvParam& input_right_pads,
+                             const AElementwiseOperation& a_element_op,
+                             const BElementwiseOperation& b_element_op,
+                             const CDEElementwiseOperation& cde_element_op)
+    {
+        return Argument{p_a,
+                        p_b,
+                        p_ds,
+                        p_e,
+                        a_g_n_c_wis_lengths,
+                        a_g_n_c_wis_strides,
+                        b_g_k_c_xs_lengths,
+                        b_g_k_c_xs_strides,
+                        ds_g_n_k_wos_lengths,
+                        ds_g_n_k_wos_strides,
+                        e_g_n_k_wos_lengths,
+                        e_g_n_k_wos_strides,
+                        conv_filter_strides,
+                        conv_filter_dilations,
+                        input_left_pads,
+                        input_right_pads,
+                        a_element_op,
+                        b_element_op,
+                        cde_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    // polymorphic
+    std::unique_ptr<BaseArgument> MakeArgumentPointer(
+        const void* p_a,
+        const void* p_b,
+        const std::array<const void*, NumDTensor>& p_ds,
+        void* p_e,
+        const std::array<index_t, NDimSpatial + 3>& a_g_n_c_wis_lengths,
+        const std::array<index_t, NDimSpatial + 3>& a_g_n_c_wis_strides,
+        const std::array<index_t, NDimSpatial + 3>& b_g_k_c_xs_lengths,
+        const std::array<index_t, NDimSpatial + 3>& b_g_k_c_xs_strides,
+        const std::array<std::array<index_t, NDimSpatial + 3>, NumDTensor>& ds_g_n_k_wos_lengths,
+        const std::array<std::array<index_t, NDimSpatial + 3>, NumDTensor>& ds_g_n_k_wos_strides,
+        const std::array<index_t, NDimSpatial + 3>& e_g_n_k_wos_lengths,
+        const std::array<index_t, NDimSpatial + 3>& e_g_n_k_wos_strides,
+        const std::array<index_t, NDimSpatial>& conv_filter_strides,
+        const std::array<index_t, NDimSpatial>& conv_filter_dilations,
+        const std::array<index_t, NDimSpatial>& input_left_pads,
+        const std::array<index_t, NDimSpatial>& input_right_pads,
+        const AElementwiseOperation& a_element_op,
+        const BElementwiseOperation& b_element_op,
+        const CDEElementwiseOperation& cde_element_op) override
+    {
+        std::array<Lengths, NumDTensor> ds_lengths;
+        std::array<Strides, NumDTensor> ds_strides;
+
+        for(index_t i = 0; i < NumDTensor; ++i)
+        {
+            ds_lengths[i] = ToLongIndex(ds_g_n_k_wos_lengths[i]);
+            ds_strides[i] = ToLongIndex(ds_g_n_k_wos_strides[i]);
+        }
+
+        return std::make_unique<Argument>(p_a,
+                                          p_b,
+                                          p_ds,
+                                          p_e,
+                                          ToLongIndex(a_g_n_c_wis_lengths),
+                                          ToLongIndex(a_g_n_c_wis_strides),
+                                          ToLongIndex(b_g_k_c_xs_lengths),
+                                          ToLongIndex(b_g_k_c_xs_strides),
+                                          ds_lengths,
+                                          ds_strides,
+                                          ToLongIndex(e_g_n_k_wos_lengths),
+                                          ToLongIndex(e_g_n_k_wos_strides),
+                                          ToLongIndex(conv_filter_strides),
+                                          ToLongIndex(conv_filter_dilations),
+                                          ToLongIndex(input_left_pads),
+                                          ToLongIndex(input_right_pads),
+                                          a_element_op,
+                                          b_element_op,
+                                          cde_element_op);
+    }
+
+    // polymorphic
+    std::unique_ptr<BaseArgument>
+    MakeArgumentPointer(const void* p_a,
+                        const void* p_b,
+                        const std::array<const void*, NumDTensor>& p_ds,
+                        void* p_e,
+                        const Lengths& a_g_n_c_wis_lengths,
+                        const Strides& a_g_n_c_wis_strides,
+                        const Lengths& b_g_k_c_xs_lengths,
+                        const Strides& b_g_k_c_xs_strides,
+                        const std::array<Lengths, NumDTensor>& ds_g_n_k_wos_lengths,
+                        const std::array<Strides, NumDTensor>& ds_g_n_k_wos_strides,
+                        const Lengths& e_g_n_k_wos_lengths,
+                        const Strides& e_g_n_k_wos_strides,
+                        const ConvParam& conv_filter_strides,
+                        const ConvParam& conv_filter_dilations,
+                        const ConvParam& input_left_pads,
+                        const ConvParam& input_right_pads,
+                        const AElementwiseOperation& a_element_op,
+                        const BElementwiseOperation& b_element_op,
+                        const CDEElementwiseOperation& cde_element_op) override
+    {
+        return std::make_unique<Argument>(p_a,
+                                          p_b,
+                                          p_ds,
+                                          p_e,
+                                          a_g_n_c_wis_lengths,
+                                          a_g_n_c_wis_strides,
+                                          b_g_k_c_xs_lengths,
+                                          b_g_k_c_xs_strides,
+                                          ds_g_n_k_wos_lengths,
+                                          ds_g_n_k_wos_strides,
+                                          e_g_n_k_wos_lengths,
+                                          e_g_n_k_wos_strides,
+                                          conv_filter_strides,
+                                          conv_filter_dilations,
+                                          input_left_pads,
+                                          input_right_pads,
+                                          a_element_op,
+                                          b_element_op,
+                                          cde_element_op);
+    }
+
+    // polymorphic
+    std::unique_ptr<BaseInvoker> MakeInvokerPointer() override
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    // polymorphic
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "DeviceGroupedConvFwdMultipleABD_Host"
+            << "<"
+            << NDimSpatial << ", "
+            << (Accumulation == ck::utils::HostGemmAccumulation::Fused ? "Fused" : "Sequential")
+            << ">";
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
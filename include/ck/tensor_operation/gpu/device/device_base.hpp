@@ -9,6 +9,7 @@
 #include <optional>
 
 #include "ck/stream_config.hpp"
+#include "ck/tensor_operation/gpu/device/device_instance_descriptor.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -82,6 +83,12 @@ struct BaseOperator
 
     virtual std::optional<std::string> GetTemplateInfo() const { return std::nullopt; }
 
+    // tuning parameters of the instance, std::nullopt if the operation does not provide them
+    virtual std::optional<DeviceInstanceDescriptor> GetInstanceDescriptor() const
+    {
+        return std::nullopt;
+    }
+
     virtual std::string GetTypeIdHashCode() const
     {
         std::ostringstream oss;
@@ -0,0 +1,207 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <tuple>
+
+#include "ck/tensor_operation/gpu/device/device_instance_descriptor.hpp"
+#include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+
+// Problem parameters that decide whether a GEMM instance can run a problem: sizes, strides and
+// split-K factor, but no pointers. Batch is 1 for non-batched GEMMs, the batch strides are not
+// part of the signature.
+struct GemmProblemSignature
+{
+    static constexpr int kMaxNumDTensor = 4;
+
+    std::int64_t M = 0;
+    std::int64_t N = 0;
+    std::int64_t K = 0;
+
+    std::int64_t StrideA = 0;
+    std::int64_t StrideB = 0;
+    std::int64_t StrideE = 0;
+
+    int NumDTensor = 0;
+    std::array<std::int64_t, kMaxNumDTensor> StrideDs{};
+
+    int KBatch         = 1;
+    std::int64_t Batch = 1;
+
+    friend bool operator==(const GemmProblemSignature& lhs, const GemmProblemSignature& rhs)
+    {
+        return std::tie(lhs.M,
+                        lhs.N,
+                        lhs.K,
+                        lhs.StrideA,
+                        lhs.StrideB,
+                        lhs.StrideE,
+                        lhs.NumDTensor,
+                        lhs.StrideDs,
+                        lhs.KBatch,
+                        lhs.Batch) == std::tie(rhs.M,
+                                               rhs.N,
+                                               rhs.K,
+                                               rhs.StrideA,
+                                               rhs.StrideB,
+                                               rhs.StrideE,
+                                               rhs.NumDTensor,
+                                               rhs.StrideDs,
+                                               rhs.KBatch,
+                                               rhs.Batch);
+    }
+
+    friend bool operator!=(const GemmProblemSignature& lhs, const GemmProblemSignature& rhs)
+    {
+        return !(lhs == rhs);
+    }
+};
+
+struct GemmProblemSignatureHash
+{
+    std::size_t operator()(const GemmProblemSignature& p) const
+    {
+        std::size_t seed = 0;
+
+        const auto combine = [&seed](std::int64_t v) {
+            seed ^= std::hash<std::int64_t>{}(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+
+        combine(p.M);
+        combine(p.N);
+        combine(p.K);
+        combine(p.StrideA);
+        combine(p.StrideB);
+        combine(p.StrideE);
+        combine(p.NumDTensor);
+
+        for(int i = 0; i < p.NumDTensor && i < GemmProblemSignature::kMaxNumDTensor; ++i)
+            combine(p.StrideDs[i]);
+
+        combine(p.KBatch);
+        combine(p.Batch);
+
+        return seed;
+    }
+};
+
+namespace detail {
+
+inline bool IsRowMajorLayoutName(const char* layout_name)
+{
+    return std::strcmp(layout_name, "RowMajor") == 0;
+}
+
+// operation families whose IsSupportedArgument() is GridwiseGemm_xdl_cshuffle_v3::CheckValidity()
+// (or its multiple-D variant) plus the AK1/BK1 check of the device operation
+inline bool IsXdlUniversalGemmDescriptor(const DeviceInstanceDescriptor& desc)
+{
+    return std::strcmp(desc.op_name, "DeviceGemmXdlUniversal") == 0 ||
+           std::strcmp(desc.op_name, "DeviceBatchedGemmXdlUniversal") == 0;
+}
+
+inline bool IsXdlUniversalGemmProblemApplicable(const DeviceInstanceDescriptor& desc,
+                                                const GemmProblemSignature& p)
+{
+    using GS = GemmSpecialization;
+
+    const GS spec = desc.gemm_spec;
+
+    const bool pad_m = spec == GS::MPadding || spec == GS::MNPadding || spec == GS::MKPadding ||
+                       spec == GS::MNKPadding;
+    const bool pad_n = spec == GS::NPadding || spec == GS::MNPadding || spec == GS::NKPadding ||
+                       spec == GS::MNKPadding;
+    const bool pad_k = spec == GS::KPadding || spec == GS::MKPadding || spec == GS::NKPadding ||
+                       spec == GS::MNKPadding;
+
+    const bool a_row = IsRowMajorLayoutName(desc.a_layout);
+    const bool b_row = IsRowMajorLayoutName(desc.b_layout);
+    const bool c_row = IsRowMajorLayoutName(desc.c_layout);
+
+    if(p.KBatch < 1)
+        return false;
+
+    if(!pad_k && (p.K % desc.ak1 != 0 || p.K % desc.bk1 != 0))
+        return false;
+
+    if(!pad_m && !a_row && p.M % desc.m_per_block != 0)
+        return false;
+
+    if(!pad_n && b_row && p.N % desc.n_per_block != 0)
+        return false;
+
+    const std::int64_t k_per_split = std::int64_t{p.KBatch} * desc.k_per_block;
+
+    if(!pad_k)
+    {
+        if(p.K % k_per_split != 0)
+            return false;
+    }
+    else
+    {
+        const std::int64_t k_read_vec  = std::lcm(desc.ak1, desc.bk1);
+        const std::int64_t k_t         = std::int64_t{p.KBatch} * k_read_vec;
+        const std::int64_t k_per_batch = (p.K + k_t - 1) / k_t * k_read_vec;
+
+        if(k_per_batch * (p.KBatch - 1) >= p.K)
+            return false;
+    }
+
+    const auto is_vector_aligned = [](std::int64_t length, int scalar_per_vector) {
+        return scalar_per_vector <= 0 || length % scalar_per_vector == 0;
+    };
+
+    if(!is_vector_aligned(a_row ? p.K : p.M, desc.a_src_scalar_per_vector) ||
+       !is_vector_aligned(b_row ? p.N : p.K, desc.b_src_scalar_per_vector) ||
+       !is_vector_aligned(c_row ? p.N : p.M, desc.c_dst_scalar_per_vector))
+        return false;
+
+    // pipelines other than v1 need more K loops than prefetch stages
+    if(desc.pipeline_version > 1)
+    {
+        const std::int64_t num_k_loop = (p.K + k_per_split - 1) / k_per_split;
+
+        if(num_k_loop <= desc.prefetch_stages)
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace detail
+
+// Whether an instance with descriptor desc can run problem, decided from the descriptor alone
+// without constructing an Argument or allocating. Returns false only if IsSupportedArgument()
+// is known to fail for the problem: for the universal XDL GEMM family the checks mirror its
+// problem-size checks (padding specialization against the block tile, split-K, vector widths
+// along the contiguous dimensions, pipeline prefetch depth). Descriptors of other families
+// always pass. Checks that depend on the device or the data types (XDL support, bf16 atomics)
+// are left to IsSupportedArgument(), so callers still call it for the instances that pass.
+inline bool IsGemmProblemApplicable(const DeviceInstanceDescriptor& desc,
+                                    const GemmProblemSignature& problem)
+{
+    if(!detail::IsXdlUniversalGemmDescriptor(desc))
+        return true;
+
+    // incomplete descriptor
+    if(desc.m_per_block <= 0 || desc.n_per_block <= 0 || desc.k_per_block <= 0 || desc.ak1 <= 0 ||
+       desc.bk1 <= 0)
+        return true;
+
+    return detail::IsXdlUniversalGemmProblemApplicable(desc, problem);
+}
+
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
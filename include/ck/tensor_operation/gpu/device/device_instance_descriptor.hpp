@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+#include "ck/tensor_operation/gpu/device/gemm_specialization.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+
+enum struct MatrixInstruction
+{
+    Unknown,
+    Xdl,
+    Wmma,
+    Dl,
+};
+
+inline std::string getMatrixInstructionString(const MatrixInstruction& s)
+{
+    switch(s)
+    {
+    case MatrixInstruction::Xdl: return "Xdl";
+    case MatrixInstruction::Wmma: return "Wmma";
+    case MatrixInstruction::Dl: return "Dl";
+    default: return "Unknown";
+    }
+}
+
+// Tuning parameters of a device operation instance.
+//
+// Device operations fill this in from their template arguments at compile time and return it
+// from BaseOperator::GetInstanceDescriptor(), so that instance selection and external tools can
+// filter the instances of a factory without parsing GetTypeString(). Fields that do not apply to
+// an operation are left at 0 (or an empty string).
+struct DeviceInstanceDescriptor
+{
+    // family of the device operation, e.g. "DeviceGemmXdlUniversal"
+    const char* op_name = "";
+
+    const char* a_layout = "";
+    const char* b_layout = "";
+    const char* c_layout = "";
+
+    MatrixInstruction instruction = MatrixInstruction::Unknown;
+    GemmSpecialization gemm_spec  = GemmSpecialization::Default;
+
+    int block_size  = 0;
+    int m_per_block = 0;
+    int n_per_block = 0;
+    int k_per_block = 0;
+    int ak1         = 0;
+    int bk1         = 0;
+
+    // shape of one XDL/WMMA instruction and number of instructions per wave
+    int m_per_instr      = 0;
+    int n_per_instr      = 0;
+    int m_instr_per_wave = 0;
+    int n_instr_per_wave = 0;
+
+    // BlockGemmPipelineVersion v1..v5 as 1..5, 0 for operations without a block GEMM pipeline
+    int pipeline_version           = 0;
+    const char* pipeline_scheduler = "";
+    int prefetch_stages            = 0;
+
+    // scalars per vector of the global loads/stores and of the LDS writes
+    int a_src_scalar_per_vector = 0;
+    int b_src_scalar_per_vector = 0;
+    int a_dst_scalar_per_vector = 0;
+    int b_dst_scalar_per_vector = 0;
+    int c_dst_scalar_per_vector = 0;
+
+    std::size_t lds_bytes = 0;
+
+    // single JSON object, keys are the field names
+    std::string ToJson() const
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "{"
+            << "\"op_name\": \"" << op_name << "\", "
+            << "\"a_layout\": \"" << a_layout << "\", "
+            << "\"b_layout\": \"" << b_layout << "\", "
+            << "\"c_layout\": \"" << c_layout << "\", "
+            << "\"instruction\": \"" << getMatrixInstructionString(instruction) << "\", "
+            << "\"gemm_spec\": \"" << getGemmSpecializationString(gemm_spec) << "\", "
+            << "\"block_size\": " << block_size << ", "
+            << "\"m_per_block\": " << m_per_block << ", "
+            << "\"n_per_block\": " << n_per_block << ", "
+            << "\"k_per_block\": " << k_per_block << ", "
+            << "\"ak1\": " << ak1 << ", "
+            << "\"bk1\": " << bk1 << ", "
+            << "\"m_per_instr\": " << m_per_instr << ", "
+            << "\"n_per_instr\": " << n_per_instr << ", "
+            << "\"m_instr_per_wave\": " << m_instr_per_wave << ", "
+            << "\"n_instr_per_wave\": " << n_instr_per_wave << ", "
+            << "\"pipeline_version\": " << pipeline_version << ", "
+            << "\"pipeline_scheduler\": \"" << pipeline_scheduler << "\", "
+            << "\"prefetch_stages\": " << prefetch_stages << ", "
+            << "\"a_src_scalar_per_vector\": " << a_src_scalar_per_vector << ", "
+            << "\"b_src_scalar_per_vector\": " << b_src_scalar_per_vector << ", "
+            << "\"a_dst_scalar_per_vector\": " << a_dst_scalar_per_vector << ", "
+            << "\"b_dst_scalar_per_vector\": " << b_dst_scalar_per_vector << ", "
+            << "\"c_dst_scalar_per_vector\": " << c_dst_scalar_per_vector << ", "
+            << "\"lds_bytes\": " << lds_bytes
+            << "}";
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+namespace detail {
+
+inline std::string EscapeJsonString(const std::string& s)
+{
+    std::string escaped;
+    escaped.reserve(s.size());
+
+    for(const char c : s)
+    {
+        if(c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+        {
+            escaped += ' ';
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+} // namespace detail
+
+// Writes a JSON array with one object per instance: its position in the container, its
+// GetTypeString() and its descriptor (null for operations that do not provide one). Works on any
+// container of pointers to device operations, e.g. the result of
+// DeviceOperationInstanceFactory<...>::GetInstances().
+template <typename InstanceContainer>
+void WriteInstanceDescriptorsJson(std::ostream& os, const InstanceContainer& instances)
+{
+    os << "[";
+
+    std::size_t index = 0;
+
+    for(const auto& p_instance : instances)
+    {
+        const auto descriptor = p_instance->GetInstanceDescriptor();
+
+        os << (index == 0 ? "\n" : ",\n") << "  {\"index\": " << index << ", \"type_string\": \""
+           << detail::EscapeJsonString(p_instance->GetTypeString()) << "\", \"descriptor\": "
+           << (descriptor ? descriptor->ToJson() : std::string("null")) << "}";
+
+        ++index;
+    }
+
+    os << "\n]\n";
+}
+
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
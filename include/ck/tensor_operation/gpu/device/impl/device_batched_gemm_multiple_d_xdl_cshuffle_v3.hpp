@@ -1020,6 +1020,49 @@ struct DeviceBatchedGemmMultiD_Xdl_CShuffle_V3
 
         return str.str();
     }
+
+    static constexpr DeviceInstanceDescriptor MakeInstanceDescriptor()
+    {
+        DeviceInstanceDescriptor desc;
+
+        desc.op_name                 = "DeviceBatchedGemmXdlUniversal";
+        desc.a_layout                = ALayout::name;
+        desc.b_layout                = BLayout::name;
+        desc.c_layout                = CLayout::name;
+        desc.instruction             = MatrixInstruction::Xdl;
+        desc.gemm_spec               = GemmSpec;
+        desc.block_size              = BlockSize;
+        desc.m_per_block             = MPerBlock;
+        desc.n_per_block             = NPerBlock;
+        desc.k_per_block             = KPerBlock;
+        desc.ak1                     = AK1;
+        desc.bk1                     = BK1;
+        desc.m_per_instr             = MPerXDL;
+        desc.n_per_instr             = NPerXDL;
+        desc.m_instr_per_wave        = MXdlPerWave;
+        desc.n_instr_per_wave        = NXdlPerWave;
+        desc.pipeline_version        = static_cast<int>(BlkGemmPipelineVer) + 1;
+        desc.pipeline_scheduler      = BlkGemmPipeSched == BlockGemmPipelineScheduler::Intrawave
+                                           ? "Intrawave"
+                                           : "Interwave";
+        desc.prefetch_stages         = GridwiseGemm::BlockwiseGemmPipe::PrefetchStages;
+        desc.a_src_scalar_per_vector = ABlockTransferSrcScalarPerVector;
+        desc.b_src_scalar_per_vector = BBlockTransferSrcScalarPerVector;
+        desc.a_dst_scalar_per_vector = ABlockTransferDstScalarPerVector_AK1;
+        desc.b_dst_scalar_per_vector = BBlockTransferDstScalarPerVector_BK1;
+        desc.c_dst_scalar_per_vector = GridwiseGemm::CShuffleBlockTransferScalarPerVector_NPerBlock;
+        desc.lds_bytes               = GridwiseGemm::GetSharedMemoryNumberOfByte();
+
+        return desc;
+    }
+
+    static constexpr auto InstanceDescriptor = MakeInstanceDescriptor();
+
+    // polymorphic
+    std::optional<DeviceInstanceDescriptor> GetInstanceDescriptor() const override
+    {
+        return InstanceDescriptor;
+    }
 };
 
 } // namespace device
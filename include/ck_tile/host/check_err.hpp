@@ -4,16 +4,23 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <iterator>
 #include <limits>
+#include <numeric>
+#include <string>
 #include <type_traits>
 #include <vector>
 
 #include "ck_tile/core.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
 #include "ck_tile/host/ranges.hpp"
 
 namespace ck_tile {
@@ -35,130 +42,514 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
     return os << "]";
 }
 
-template <typename Range, typename RefRange>
-typename std::enable_if<
-    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
-        std::is_floating_point_v<ranges::range_value_t<Range>> &&
-        !std::is_same_v<ranges::range_value_t<Range>, half_t>,
-    bool>::type CK_TILE_HOST
-check_err(const Range& out,
-          const RefRange& ref,
-          const std::string& msg  = "Error: Incorrect results!",
-          double rtol             = 1e-5,
-          double atol             = 3e-6,
-          bool allow_infinity_ref = false)
+struct check_err_options
 {
-    if(out.size() != ref.size())
+    // number of mismatches whose position and values are kept in the report
+    std::size_t max_recorded_errors = 4;
+    // stop comparing once at least this many mismatches were found, 0 compares all elements
+    std::size_t max_errors = 0;
+    // collect max_abs_err, max_rel_err and ulp_histogram, otherwise only the mismatches are
+    // counted and recorded
+    bool statistics = true;
+};
+
+struct check_err_mismatch
+{
+    std::size_t index;
+    // multi-index of the element, only filled when the compared ranges are tensors
+    std::vector<std::size_t> coord;
+    double out;
+    double ref;
+};
+
+struct check_err_report
+{
+    // Bin 0 counts bit-exact elements and bin b counts elements that are [2^(b-1), 2^b) units in
+    // the last place apart. The last bin also counts the elements with non-finite values.
+    static constexpr std::size_t kNumUlpBin = 18;
+
+    bool is_passed() const { return !size_mismatch && num_error == 0; }
+
+    double get_error_percent() const
     {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
+        return num_checked == 0 ? 0 : 100. * static_cast<double>(num_error) / num_checked;
     }
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same =
-            std::isinf(o) && std::isinf(r) && (bit_cast<uint64_t>(o) == bit_cast<uint64_t>(r));
+    // prints the recorded mismatches and a summary, prints nothing for a passed comparison
+    void print(std::ostream& os, const std::string& msg = "Error: Incorrect results!") const
+    {
+        if(size_mismatch)
+        {
+            os << msg << " out.size() != ref.size(), :" << num_out_element
+               << " != " << num_element << std::endl;
+            return;
+        }
 
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+        if(is_passed())
+            return;
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<double>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = *std::next(std::begin(out), i);
-        const double r = *std::next(std::begin(ref), i);
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
+        const auto print_value = [&](double v) {
+            if(integer_values)
+                os << static_cast<int64_t>(v);
+            else
+                os << v;
+        };
+
+        for(const auto& mismatch : mismatches)
         {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
+            os << msg << std::setw(12) << std::setprecision(7) << " out[" << mismatch.index
+               << "] != ref[" << mismatch.index << "]: ";
+            print_value(mismatch.out);
+            os << " != ";
+            print_value(mismatch.ref);
+
+            if(!mismatch.coord.empty())
             {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
+                os << " at (";
+                for(std::size_t d = 0; d < mismatch.coord.size(); ++d)
+                    os << (d == 0 ? "" : ", ") << mismatch.coord[d];
+                os << ")";
             }
-            res = false;
+            os << std::endl;
         }
+
+        os << "max err: " << max_error_abs_err;
+        os << ", number of errors: " << num_error;
+        os << ", " << get_error_percent() << "% wrong values";
+
+        if(early_exit)
+            os << " (stopped after " << num_checked << " of " << num_element << " values)";
+        os << std::endl;
+    }
+
+    bool size_mismatch  = false;
+    bool early_exit     = false;
+    bool integer_values = false;
+
+    std::size_t num_out_element = 0;
+    std::size_t num_element     = 0;
+    std::size_t num_checked     = 0;
+    std::size_t num_error       = 0;
+
+    // largest errors over all compared finite values
+    double max_abs_err = 0;
+    double max_rel_err = 0;
+    // largest absolute error over the mismatches
+    double max_error_abs_err = 0;
+
+    std::array<std::size_t, kNumUlpBin> ulp_histogram{};
+
+    // first mismatches in the order of the compared ranges
+    std::vector<check_err_mismatch> mismatches;
+};
+
+namespace detail {
+
+// data types compared as integers, the other data types are compared through float/double
+template <typename T>
+constexpr bool is_integer_check()
+{
+    return (std::is_integral_v<T> && !std::is_same_v<T, bf16_t>)
+#ifdef CK_EXPERIMENTAL_BIT_INT_EXTENSION_INT4
+           || std::is_same_v<T, int4_t>
+#endif
+        ;
+}
+
+template <typename T>
+CK_TILE_HOST double to_check_err_double(const T& v)
+{
+    if constexpr(is_integer_check<T>())
+        return static_cast<double>(static_cast<int64_t>(v));
+    else if constexpr(std::is_same_v<T, float> || std::is_same_v<T, double>)
+        return v;
+    else
+        return type_convert<float>(v);
+}
+
+template <typename T>
+CK_TILE_HOST uint64_t get_bits(const T& v)
+{
+    static_assert(sizeof(T) <= sizeof(uint64_t), "unsupported data type");
+
+    uint64_t bits = 0;
+    std::memcpy(&bits, &v, sizeof(T));
+    return bits;
+}
+
+// distance between the representations of two values, negative values are mirrored so that the
+// distance between values of different signs passes through zero
+template <typename T>
+CK_TILE_HOST uint64_t get_ulp_distance(const T& o, const T& r)
+{
+    if constexpr(is_integer_check<T>())
+    {
+        const int64_t d = static_cast<int64_t>(o) - static_cast<int64_t>(r);
+        return d < 0 ? -static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
     }
-    if(!res)
+    else
     {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
+        const auto to_ordered = [](const T& v) {
+            const uint64_t bits = get_bits(v);
+            const uint64_t sign = uint64_t{1} << (8 * sizeof(T) - 1);
+            const auto mag      = static_cast<int64_t>(bits & (sign - 1));
+
+            return (bits & sign) ? -mag : mag;
+        };
+
+        const int64_t d = to_ordered(o) - to_ordered(r);
+        return d < 0 ? -static_cast<uint64_t>(d) : static_cast<uint64_t>(d);
     }
-    return res;
 }
 
-template <typename Range, typename RefRange>
-typename std::enable_if<
-    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
-        std::is_same_v<ranges::range_value_t<Range>, bf16_t>,
-    bool>::type CK_TILE_HOST
-check_err(const Range& out,
-          const RefRange& ref,
-          const std::string& msg  = "Error: Incorrect results!",
-          double rtol             = 1e-3,
-          double atol             = 1e-3,
-          bool allow_infinity_ref = false)
+CK_TILE_HOST std::size_t get_ulp_bin(uint64_t ulp)
 {
-    if(out.size() != ref.size())
+    const std::size_t bin = ulp == 0 ? 0 : 64 - __builtin_clzll(ulp);
+    return std::min(bin, check_err_report::kNumUlpBin - 1);
+}
+
+template <typename Range, typename = void>
+struct has_tensor_layout : std::false_type
+{
+};
+
+template <typename Range>
+struct has_tensor_layout<Range,
+                       std::void_t<decltype(std::declval<const Range&>().get_lengths()),
+                                   decltype(std::declval<const Range&>().get_strides())>>
+    : std::true_type
+{
+};
+
+// multi-index of the element at an offset into the element space, visits the dimensions from the
+// largest to the smallest stride so the result is exact for non-overlapping layouts
+template <typename Lengths, typename Strides>
+CK_TILE_HOST std::vector<std::size_t>
+get_multi_index_from_offset(const Lengths& lengths, const Strides& strides, std::size_t offset)
+{
+    const std::size_t rank = std::size(lengths);
+
+    std::vector<std::size_t> order(rank);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return strides[a] > strides[b];
+    });
+
+    std::vector<std::size_t> idx(rank, 0);
+
+    for(std::size_t d : order)
     {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
+        const std::size_t stride = strides[d];
+
+        if(stride == 0 || lengths[d] == 0)
+            continue;
+
+        idx[d] = std::min<std::size_t>(offset / stride, lengths[d] - 1);
+        offset -= idx[d] * stride;
     }
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same =
-            std::isinf(o) && std::isinf(r) && (bit_cast<uint64_t>(o) == bit_cast<uint64_t>(r));
+    return idx;
+}
+
+inline constexpr std::size_t check_err_chunk_size = 1 << 16;
 
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+// check_err() only prints the first mismatches and the number of mismatches
+inline constexpr check_err_options check_err_default_options{4, 0, false};
+
+// non-finite values are errors, except for equal infinities when allow_infinity_ref is set
+CK_TILE_HOST bool is_infinity_error(double o, double r, bool allow_infinity_ref)
+{
+    const bool either_not_finite = !std::isfinite(o) || !std::isfinite(r);
+    const bool both_infinite_and_same =
+        std::isinf(o) && std::isinf(r) && (bit_cast<uint64_t>(o) == bit_cast<uint64_t>(r));
 
-    bool res{true};
-    int err_count = 0;
-    double err    = 0;
-    // TODO: This is a hack. We should have proper specialization for bf16_t data type.
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
+    return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
+}
+
+// Compares out and ref in parallel chunks, is_error(o, r, o_double, r_double, abs_err) decides
+// whether a pair of elements is a mismatch.
+template <typename Range, typename RefRange, typename IsError>
+CK_TILE_HOST check_err_report check_err_impl(const Range& out,
+                                             const RefRange& ref,
+                                             IsError&& is_error,
+                                             const check_err_options& options)
+{
+    using T = ranges::range_value_t<Range>;
+
+    check_err_report report;
+    report.integer_values  = is_integer_check<T>();
+    report.num_out_element = out.size();
+    report.num_element     = ref.size();
+
+    if(out.size() != ref.size())
     {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
+        report.size_mismatch = true;
+        return report;
+    }
+
+    const std::size_t n         = ref.size();
+    const std::size_t num_chunk = (n + check_err_chunk_size - 1) / check_err_chunk_size;
+
+    std::vector<check_err_report> partials(num_chunk);
+    std::atomic<std::size_t> num_error{0};
+
+    auto check_chunk = [&](std::size_t chunk) {
+        check_err_report& p = partials[chunk];
+
+        if(options.max_errors > 0 &&
+           num_error.load(std::memory_order_relaxed) >= options.max_errors)
+        {
+            p.early_exit = true;
+            return;
+        }
+
+        const std::size_t begin = chunk * check_err_chunk_size;
+        const std::size_t end   = std::min(begin + check_err_chunk_size, n);
+
+        const auto o_begin = std::next(std::begin(out), begin);
+        const auto r_begin = std::next(std::begin(ref), begin);
+
+        p.num_checked = end - begin;
+
+        // the first pass only counts, the following passes run for chunks with mismatches or,
+        // for the statistics, with elements that are not bit-exact
+        std::size_t num_bad   = 0;
+        std::size_t num_exact = 0;
+        double max_abs_err    = 0;
+        double max_rel_err    = 0;
+
+        auto o_iter = o_begin;
+        auto r_iter = r_begin;
+
+        for(std::size_t i = begin; i < end; ++i, ++o_iter, ++r_iter)
+        {
+            const T o = *o_iter;
+            const T r = *r_iter;
+
+            const double o_double = to_check_err_double(o);
+            const double r_double = to_check_err_double(r);
+            const double err      = std::abs(o_double - r_double);
+
+            num_bad += is_error(o, r, o_double, r_double, err);
+
+            if(!options.statistics)
+                continue;
+
+            num_exact += get_bits(o) == get_bits(r);
+
+            if(std::isfinite(o_double) && std::isfinite(r_double))
+            {
+                max_abs_err = std::max(max_abs_err, err);
+
+                // only divide when the relative error grows
+                if(err > max_rel_err * std::abs(r_double))
+                    max_rel_err = r_double != 0 ? err / std::abs(r_double)
+                                                : std::numeric_limits<double>::infinity();
+            }
+        }
+
+        p.num_error = num_bad;
+        num_error.fetch_add(num_bad, std::memory_order_relaxed);
+
+        if(options.statistics)
+        {
+            p.max_abs_err = max_abs_err;
+            p.max_rel_err = max_rel_err;
+
+            if(num_exact == end - begin)
+            {
+                p.ulp_histogram[0] = num_exact;
+            }
+            else
+            {
+                // counted in a local array that stays in registers or cache
+                std::array<std::size_t, check_err_report::kNumUlpBin> ulp_histogram{};
+
+                o_iter = o_begin;
+                r_iter = r_begin;
+
+                for(std::size_t i = begin; i < end; ++i, ++o_iter, ++r_iter)
+                {
+                    const T o = *o_iter;
+                    const T r = *r_iter;
+
+                    const bool finite = std::isfinite(to_check_err_double(o)) &&
+                                        std::isfinite(to_check_err_double(r));
+
+                    ++ulp_histogram[finite ? get_ulp_bin(get_ulp_distance(o, r))
+                                           : check_err_report::kNumUlpBin - 1];
+                }
+
+                p.ulp_histogram = ulp_histogram;
+            }
+        }
+
+        if(p.num_error == 0)
+            return;
+
+        o_iter = o_begin;
+        r_iter = r_begin;
+
+        for(std::size_t i = begin; i < end; ++i, ++o_iter, ++r_iter)
         {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
+            const T o = *o_iter;
+            const T r = *r_iter;
+
+            const double o_double = to_check_err_double(o);
+            const double r_double = to_check_err_double(r);
+            const double err      = std::abs(o_double - r_double);
+
+            if(is_error(o, r, o_double, r_double, err))
             {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
+                p.max_error_abs_err = err > p.max_error_abs_err ? err : p.max_error_abs_err;
+
+                if(p.mismatches.size() < options.max_recorded_errors)
+                    p.mismatches.push_back({i, {}, o_double, r_double});
             }
-            res = false;
         }
+    };
+
+    host_thread_pool::instance().parallel_for(
+        num_chunk, 0, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t chunk = begin; chunk < end; ++chunk)
+                check_chunk(chunk);
+        });
+
+    // merge in chunk order, so the recorded mismatches are the first ones
+    for(auto& p : partials)
+    {
+        report.early_exit = report.early_exit || p.early_exit;
+        report.num_checked += p.num_checked;
+        report.num_error += p.num_error;
+        report.max_abs_err       = std::max(report.max_abs_err, p.max_abs_err);
+        report.max_rel_err       = std::max(report.max_rel_err, p.max_rel_err);
+        report.max_error_abs_err = std::max(report.max_error_abs_err, p.max_error_abs_err);
+
+        for(std::size_t b = 0; b < check_err_report::kNumUlpBin; ++b)
+            report.ulp_histogram[b] += p.ulp_histogram[b];
+
+        for(auto& mismatch : p.mismatches)
+        {
+            if(report.mismatches.size() < options.max_recorded_errors)
+                report.mismatches.push_back(std::move(mismatch));
+        }
+    }
+
+    if constexpr(has_tensor_layout<Range>::value)
+    {
+        for(auto& mismatch : report.mismatches)
+            mismatch.coord =
+                get_multi_index_from_offset(out.get_lengths(), out.get_strides(), mismatch.index);
+    }
+
+    return report;
+}
+
+} // namespace detail
+
+// Compares out with ref using multiple host threads and returns a summary of the errors.
+// Integer data types fail for an absolute difference larger than atol, the other data types fail
+// for an error larger than atol + rtol * |ref| or for non-finite values, like check_err().
+template <typename Range, typename RefRange>
+std::enable_if_t<std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
+                     !std::is_same_v<ranges::range_value_t<Range>, fp8_t>,
+                 check_err_report>
+    CK_TILE_HOST get_check_err_report(const Range& out,
+                                      const RefRange& ref,
+                                      double rtol                      = 1e-5,
+                                      double atol                      = 3e-6,
+                                      const check_err_options& options = {},
+                                      bool allow_infinity_ref          = false)
+{
+    using T = ranges::range_value_t<Range>;
+
+    if constexpr(detail::is_integer_check<T>())
+    {
+        return detail::check_err_impl(
+            out,
+            ref,
+            [=](const T& o, const T& r, double, double, double) {
+                const int64_t err = std::abs(static_cast<int64_t>(o) - static_cast<int64_t>(r));
+                return err > atol;
+            },
+            options);
     }
-    if(!res)
+    else
     {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
+        return detail::check_err_impl(
+            out,
+            ref,
+            [=](const T&, const T&, double o, double r, double err) {
+                return err > atol + rtol * std::abs(r) ||
+                       detail::is_infinity_error(o, r, allow_infinity_ref);
+            },
+            options);
     }
-    return res;
+}
+
+// fp8 fails for an error larger than atol that is also more than max_rounding_point_distance
+// representable values away from ref, or for non-finite values, like check_err() for fp8_t
+template <typename Range, typename RefRange>
+std::enable_if_t<std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
+                     std::is_same_v<ranges::range_value_t<Range>, fp8_t>,
+                 check_err_report>
+    CK_TILE_HOST get_check_err_report(const Range& out,
+                                      const RefRange& ref,
+                                      unsigned max_rounding_point_distance = 1,
+                                      double atol                          = 1e-1,
+                                      const check_err_options& options     = {},
+                                      bool allow_infinity_ref              = false)
+{
+    static const auto get_rounding_point_distance = [](fp8_t o, fp8_t r) -> unsigned {
+        static const auto get_sign_bit = [](fp8_t v) -> bool {
+            return 0x80 & bit_cast<uint8_t>(v);
+        };
+
+        if(get_sign_bit(o) ^ get_sign_bit(r))
+        {
+            return std::numeric_limits<unsigned>::max();
+        }
+        else
+        {
+            return std::abs(bit_cast<int8_t>(o) - bit_cast<int8_t>(r));
+        }
+    };
+
+    return detail::check_err_impl(
+        out,
+        ref,
+        [=](fp8_t o, fp8_t r, double o_fp64, double r_fp64, double err) {
+            return !(less_equal<double>{}(err, atol) ||
+                     get_rounding_point_distance(o, r) <= max_rounding_point_distance) ||
+                   detail::is_infinity_error(o_fp64, r_fp64, allow_infinity_ref);
+        },
+        options);
 }
 
 template <typename Range, typename RefRange>
 typename std::enable_if<
     std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
-        std::is_same_v<ranges::range_value_t<Range>, half_t>,
+        std::is_floating_point_v<ranges::range_value_t<Range>> &&
+        !std::is_same_v<ranges::range_value_t<Range>, half_t>,
+    bool>::type CK_TILE_HOST
+check_err(const Range& out,
+          const RefRange& ref,
+          const std::string& msg  = "Error: Incorrect results!",
+          double rtol             = 1e-5,
+          double atol             = 3e-6,
+          bool allow_infinity_ref = false)
+{
+    const auto report = get_check_err_report(
+        out, ref, rtol, atol, detail::check_err_default_options, allow_infinity_ref);
+    report.print(std::cerr, msg);
+
+    return report.is_passed();
+}
+
+template <typename Range, typename RefRange>
+typename std::enable_if<
+    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
+        std::is_same_v<ranges::range_value_t<Range>, bf16_t>,
     bool>::type CK_TILE_HOST
 check_err(const Range& out,
           const RefRange& ref,
@@ -167,51 +558,30 @@ check_err(const Range& out,
           double atol             = 1e-3,
           bool allow_infinity_ref = false)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
+    const auto report = get_check_err_report(
+        out, ref, rtol, atol, detail::check_err_default_options, allow_infinity_ref);
+    report.print(std::cerr, msg);
 
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same =
-            std::isinf(o) && std::isinf(r) && (bit_cast<uint64_t>(o) == bit_cast<uint64_t>(r));
+    return report.is_passed();
+}
 
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+template <typename Range, typename RefRange>
+typename std::enable_if<
+    std::is_same_v<ranges::range_value_t<Range>, ranges::range_value_t<RefRange>> &&
+        std::is_same_v<ranges::range_value_t<Range>, half_t>,
+    bool>::type CK_TILE_HOST
+check_err(const Range& out,
+          const RefRange& ref,
+          const std::string& msg  = "Error: Incorrect results!",
+          double rtol             = 1e-3,
+          double atol             = 1e-3,
+          bool allow_infinity_ref = false)
+{
+    const auto report = get_check_err_report(
+        out, ref, rtol, atol, detail::check_err_default_options, allow_infinity_ref);
+    report.print(std::cerr, msg);
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = static_cast<double>(std::numeric_limits<ranges::range_value_t<Range>>::min());
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return report.is_passed();
 }
 
 template <typename Range, typename RefRange>
@@ -229,44 +599,10 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
                            double                 = 0,
                            double atol            = 0)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
-
-    bool res{true};
-    int err_count   = 0;
-    int64_t err     = 0;
-    int64_t max_err = std::numeric_limits<int64_t>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const int64_t o = *std::next(std::begin(out), i);
-        const int64_t r = *std::next(std::begin(ref), i);
-        err             = std::abs(o - r);
+    const auto report = get_check_err_report(out, ref, 0, atol, detail::check_err_default_options);
+    report.print(std::cerr, msg);
 
-        if(err > atol)
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << " out[" << i << "] != ref[" << i << "]: " << o << " != " << r
-                          << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        const float error_percent =
-            static_cast<float>(err_count) / static_cast<float>(out.size()) * 100.f;
-        std::cerr << "max err: " << max_err;
-        std::cerr << ", number of errors: " << err_count;
-        std::cerr << ", " << error_percent << "% wrong values" << std::endl;
-    }
-    return res;
+    return report.is_passed();
 }
 
 template <typename Range, typename RefRange>
@@ -280,66 +616,15 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
                            double atol                          = 1e-1,
                            bool allow_infinity_ref              = false)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
-
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same =
-            std::isinf(o) && std::isinf(r) && (bit_cast<uint64_t>(o) == bit_cast<uint64_t>(r));
-
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
-
-    static const auto get_rounding_point_distance = [](fp8_t o, fp8_t r) -> unsigned {
-        static const auto get_sign_bit = [](fp8_t v) -> bool {
-            return 0x80 & bit_cast<uint8_t>(v);
-        };
-
-        if(get_sign_bit(o) ^ get_sign_bit(r))
-        {
-            return std::numeric_limits<unsigned>::max();
-        }
-        else
-        {
-            return std::abs(bit_cast<int8_t>(o) - bit_cast<int8_t>(r));
-        }
-    };
-
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const fp8_t o_fp8   = *std::next(std::begin(out), i);
-        const fp8_t r_fp8   = *std::next(std::begin(ref), i);
-        const double o_fp64 = type_convert<float>(o_fp8);
-        const double r_fp64 = type_convert<float>(r_fp8);
-        err                 = std::abs(o_fp64 - r_fp64);
-        if(!(less_equal<double>{}(err, atol) ||
-             get_rounding_point_distance(o_fp8, r_fp8) <= max_rounding_point_distance) ||
-           is_infinity_error(o_fp64, r_fp64))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o_fp64 << " != " << r_fp64 << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    const auto report = get_check_err_report(out,
+                                             ref,
+                                             max_rounding_point_distance,
+                                             atol,
+                                             detail::check_err_default_options,
+                                             allow_infinity_ref);
+    report.print(std::cerr, msg);
+
+    return report.is_passed();
 }
 
 template <typename Range, typename RefRange>
@@ -353,47 +638,11 @@ std::enable_if_t<(std::is_same_v<ranges::range_value_t<Range>, ranges::range_val
                            double atol             = 1e-3,
                            bool allow_infinity_ref = false)
 {
-    if(out.size() != ref.size())
-    {
-        std::cerr << msg << " out.size() != ref.size(), :" << out.size() << " != " << ref.size()
-                  << std::endl;
-        return false;
-    }
-
-    const auto is_infinity_error = [=](auto o, auto r) {
-        const bool either_not_finite = !std::isfinite(o) || !std::isfinite(r);
-        const bool both_infinite_and_same =
-            std::isinf(o) && std::isinf(r) && (bit_cast<uint64_t>(o) == bit_cast<uint64_t>(r));
-
-        return either_not_finite && !(allow_infinity_ref && both_infinite_and_same);
-    };
+    const auto report = get_check_err_report(
+        out, ref, rtol, atol, detail::check_err_default_options, allow_infinity_ref);
+    report.print(std::cerr, msg);
 
-    bool res{true};
-    int err_count  = 0;
-    double err     = 0;
-    double max_err = std::numeric_limits<float>::min();
-    for(std::size_t i = 0; i < ref.size(); ++i)
-    {
-        const double o = type_convert<float>(*std::next(std::begin(out), i));
-        const double r = type_convert<float>(*std::next(std::begin(ref), i));
-        err            = std::abs(o - r);
-        if(err > atol + rtol * std::abs(r) || is_infinity_error(o, r))
-        {
-            max_err = err > max_err ? err : max_err;
-            err_count++;
-            if(err_count < 5)
-            {
-                std::cerr << msg << std::setw(12) << std::setprecision(7) << " out[" << i
-                          << "] != ref[" << i << "]: " << o << " != " << r << std::endl;
-            }
-            res = false;
-        }
-    }
-    if(!res)
-    {
-        std::cerr << std::setw(12) << std::setprecision(7) << "max err: " << max_err << std::endl;
-    }
-    return res;
+    return report.is_passed();
 }
 
 } // namespace ck_tile
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iterator>
 #include <optional>
 #include <random>
@@ -13,6 +14,7 @@
 #include <unordered_set>
 
 #include "ck_tile/core.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
 #include "ck_tile/host/joinable_thread.hpp"
 
 namespace ck_tile {
@@ -23,7 +25,8 @@ struct FillUniformDistribution
     float a_{-5.f};
     float b_{5.f};
     std::optional<uint32_t> seed_{11939};
-    // ATTENTION: threaded does not guarantee the distribution between thread
+    // ATTENTION: threaded does not guarantee the distribution between thread, the *Philox fills
+    // below are threaded and reproducible
     bool threaded = false;
 
     template <typename ForwardIter>
@@ -86,6 +89,111 @@ template<> struct RawIntegerType_<8> { using type = uint64_t;};
 
 template <typename T>
 using RawIntegerType = typename RawIntegerType_<sizeof(T)>::type;
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as 1,
+// 2, 3"). Block k of the stream is computed from (seed, k) alone, so any part of a tensor can be
+// generated independently.
+struct philox4x32
+{
+    CK_TILE_HOST explicit philox4x32(uint64_t seed)
+        : key0_(static_cast<uint32_t>(seed)), key1_(static_cast<uint32_t>(seed >> 32))
+    {
+    }
+
+    // writes the 4 words of each of the blocks [first_block, first_block + num_block) to out
+    CK_TILE_HOST void generate(uint64_t first_block, std::size_t num_block, uint32_t* out) const
+    {
+        // no data dependent branches, the loop over the blocks can be vectorized
+        for(std::size_t b = 0; b < num_block; ++b)
+        {
+            const uint64_t counter = first_block + b;
+
+            uint32_t c0 = static_cast<uint32_t>(counter);
+            uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+            uint32_t c2 = 0;
+            uint32_t c3 = 0;
+            uint32_t k0 = key0_;
+            uint32_t k1 = key1_;
+
+            for(int round = 0; round < 10; ++round)
+            {
+                const uint64_t p0 = static_cast<uint64_t>(kMul0) * c0;
+                const uint64_t p1 = static_cast<uint64_t>(kMul1) * c2;
+
+                c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                c1 = static_cast<uint32_t>(p1);
+                c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                c3 = static_cast<uint32_t>(p0);
+
+                k0 += kWeyl0;
+                k1 += kWeyl1;
+            }
+
+            out[4 * b + 0] = c0;
+            out[4 * b + 1] = c1;
+            out[4 * b + 2] = c2;
+            out[4 * b + 3] = c3;
+        }
+    }
+
+    // uniform float in [0, 1) from the upper 24 bits of a word
+    CK_TILE_HOST static float to_uniform(uint32_t word)
+    {
+        return static_cast<float>(word >> 8) * 0x1p-24f;
+    }
+
+    private:
+    static constexpr uint32_t kMul0  = 0xD2511F53;
+    static constexpr uint32_t kMul1  = 0xCD9E8D57;
+    static constexpr uint32_t kWeyl0 = 0x9E3779B9;
+    static constexpr uint32_t kWeyl1 = 0xBB67AE85;
+
+    uint32_t key0_;
+    uint32_t key1_;
+};
+
+// Fills [first, last) on the host thread pool. Element i is g(words) where words points to the
+// NumWord random words that belong to element i only, so the result does not depend on the
+// number of threads.
+template <std::size_t NumWord, typename ForwardIter, typename G>
+CK_TILE_HOST void philox_fill(ForwardIter first, ForwardIter last, uint64_t seed, G g)
+{
+    static_assert(NumWord == 1 || NumWord == 2 || NumWord == 4, "a block has 4 words");
+
+    constexpr std::size_t kElementPerBlock = 4 / NumWord;
+    constexpr std::size_t kBlockPerBatch   = 256;
+
+    const philox4x32 philox(seed);
+
+    const auto n              = static_cast<std::size_t>(std::distance(first, last));
+    const std::size_t n_block = (n + kElementPerBlock - 1) / kElementPerBlock;
+    const std::size_t n_batch = (n_block + kBlockPerBatch - 1) / kBlockPerBatch;
+
+    host_thread_pool::instance().parallel_for(n_batch, 0, [&](std::size_t begin, std::size_t end) {
+        uint32_t words[4 * kBlockPerBatch];
+
+        for(std::size_t batch = begin; batch < end; ++batch)
+        {
+            const std::size_t block_begin = batch * kBlockPerBatch;
+            const std::size_t block_end   = std::min(block_begin + kBlockPerBatch, n_block);
+
+            philox.generate(block_begin, block_end - block_begin, words);
+
+            const std::size_t i_begin = block_begin * kElementPerBlock;
+            const std::size_t i_end   = std::min(block_end * kElementPerBlock, n);
+
+            auto iter = std::next(first, i_begin);
+
+            for(std::size_t i = i_begin; i < i_end; ++i, ++iter)
+                *iter = g(words + NumWord * (i - i_begin));
+        }
+    });
+}
+
+CK_TILE_HOST uint64_t get_philox_seed(const std::optional<uint32_t>& seed)
+{
+    return seed.has_value() ? *seed : std::random_device{}();
+}
 } // namespace impl
 
 // Note: this struct will have no const-ness will generate random
@@ -147,7 +255,8 @@ struct FillNormalDistribution
     float mean_{0.f};
     float variance_{1.f};
     std::optional<uint32_t> seed_{11939};
-    // ATTENTION: threaded does not guarantee the distribution between thread
+    // ATTENTION: threaded does not guarantee the distribution between thread, the *Philox fills
+    // below are threaded and reproducible
     bool threaded = false;
 
     template <typename ForwardIter>
@@ -198,6 +307,135 @@ struct FillNormalDistribution
     }
 };
 
+// The Philox fills below produce the same values for any number of host threads (see
+// CK_TILE_HOST_NUM_THREADS), with a different sequence than the std::mt19937 based fills above.
+template <typename T>
+struct FillUniformDistributionPhilox
+{
+    float a_{-5.f};
+    float b_{5.f};
+    std::optional<uint32_t> seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float a = a_;
+        const float d = b_ - a_;
+
+        impl::philox_fill<1>(first, last, impl::get_philox_seed(seed_), [=](const uint32_t* words) {
+            return ck_tile::type_convert<T>(a + d * impl::philox4x32::to_uniform(words[0]));
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillUniformDistributionPhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
+template <typename T>
+struct FillUniformDistributionIntegerValuePhilox
+{
+    float a_{-5.f};
+    float b_{5.f};
+    std::optional<uint32_t> seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float a = a_;
+        const float d = b_ - a_;
+
+        impl::philox_fill<1>(first, last, impl::get_philox_seed(seed_), [=](const uint32_t* words) {
+            const float v = a + d * impl::philox4x32::to_uniform(words[0]);
+            return ck_tile::type_convert<T>(std::round(v));
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillUniformDistributionIntegerValuePhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
+template <typename T>
+struct FillNormalDistributionPhilox
+{
+    float mean_{0.f};
+    float variance_{1.f};
+    std::optional<uint32_t> seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float mean   = mean_;
+        const float stddev = std::sqrt(variance_);
+
+        // Box-Muller transform, 1 - u is in (0, 1] so the logarithm is finite
+        impl::philox_fill<2>(first, last, impl::get_philox_seed(seed_), [=](const uint32_t* words) {
+            const float u0 = 1.f - impl::philox4x32::to_uniform(words[0]);
+            const float u1 = impl::philox4x32::to_uniform(words[1]);
+            const float z  = std::sqrt(-2.f * std::log(u0)) * std::cos(6.2831853f * u1);
+
+            return ck_tile::type_convert<T>(mean + stddev * z);
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillNormalDistributionPhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
+// uniform values in [a, b), each element is zero with probability sparsity
+template <typename T>
+struct FillSparseUniformDistributionPhilox
+{
+    float a_{-5.f};
+    float b_{5.f};
+    float sparsity_{0.5f};
+    std::optional<uint32_t> seed_{11939};
+
+    template <typename ForwardIter>
+    void operator()(ForwardIter first, ForwardIter last) const
+    {
+        const float a        = a_;
+        const float d        = b_ - a_;
+        const float sparsity = sparsity_;
+
+        impl::philox_fill<2>(first, last, impl::get_philox_seed(seed_), [=](const uint32_t* words) {
+            const bool zero = impl::philox4x32::to_uniform(words[1]) < sparsity;
+            const float v   = a + d * impl::philox4x32::to_uniform(words[0]);
+            return ck_tile::type_convert<T>(zero ? 0.f : v);
+        });
+    }
+
+    template <typename ForwardRange>
+    auto operator()(ForwardRange&& range) const
+        -> std::void_t<decltype(std::declval<const FillSparseUniformDistributionPhilox&>()(
+            std::begin(std::forward<ForwardRange>(range)),
+            std::end(std::forward<ForwardRange>(range))))>
+    {
+        (*this)(std::begin(std::forward<ForwardRange>(range)),
+                std::end(std::forward<ForwardRange>(range)));
+    }
+};
+
 // Normally FillUniformDistributionIntegerValue should use std::uniform_int_distribution as below.
 // However this produces segfaults in std::mt19937 which look like inifite loop.
 //      template <typename T>
@@ -14,6 +14,7 @@
 #include <fstream>
 
 #include "ck_tile/core.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
 #include "ck_tile/host/joinable_thread.hpp"
 #include "ck_tile/host/ranges.hpp"
 
@@ -173,7 +174,7 @@ struct HostTensorDescriptor
         return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
     }
 
-    std::size_t GetOffsetFromMultiIndex(std::vector<std::size_t> iss) const
+    std::size_t GetOffsetFromMultiIndex(const std::vector<std::size_t>& iss) const
     {
         return std::inner_product(iss.begin(), iss.end(), mStrides.begin(), std::size_t{0});
     }
@@ -246,25 +247,17 @@ struct ParallelTensorFunctor
         return indices;
     }
 
+    // num_thread is the maximum number of threads of the host thread pool taking part in the
+    // traversal, the work is distributed in chunks with work stealing
     void operator()(std::size_t num_thread = 1) const
     {
-        std::size_t work_per_thread = (mN1d + num_thread - 1) / num_thread;
-
-        std::vector<joinable_thread> threads(num_thread);
-
-        for(std::size_t it = 0; it < num_thread; ++it)
-        {
-            std::size_t iw_begin = it * work_per_thread;
-            std::size_t iw_end   = std::min((it + 1) * work_per_thread, mN1d);
-
-            auto f = [this, iw_begin, iw_end] {
+        host_thread_pool::instance().parallel_for(
+            mN1d, num_thread, [this](std::size_t iw_begin, std::size_t iw_end) {
                 for(std::size_t iw = iw_begin; iw < iw_end; ++iw)
                 {
                     call_f_unpack_args(this->mF, this->GetNdIndices(iw));
                 }
-            };
-            threads[it] = joinable_thread(f);
-        }
+            });
     }
 };
 
@@ -478,12 +471,12 @@ struct HostTensor
         return mData[mDesc.GetOffsetFromMultiIndex(is...)];
     }
 
-    T& operator()(std::vector<std::size_t> idx)
+    T& operator()(const std::vector<std::size_t>& idx)
     {
         return mData[mDesc.GetOffsetFromMultiIndex(idx)];
     }
 
-    const T& operator()(std::vector<std::size_t> idx) const
+    const T& operator()(const std::vector<std::size_t>& idx) const
     {
         return mData[mDesc.GetOffsetFromMultiIndex(idx)];
     }
@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+#include <string>
+
+#include "ck_tile/core/config.hpp"
+
+namespace ck_tile {
+
+// Process-wide persistent thread pool used by ParallelTensorFunctor and the host reference
+// functions.
+//
+// parallel_for(n, max_threads, f) splits [0, n) into one contiguous range per participating
+// thread and every thread claims grain-sized chunks of its own range first. A thread that runs
+// out of work steals chunks from the ranges of the other threads, so uneven per-element cost
+// does not leave threads idle. The calling thread takes part in the work.
+//
+// Calls made from inside a running parallel_for (nested calls) are executed serially by the
+// calling thread, so reference functions can be composed freely.
+class host_thread_pool
+{
+    public:
+    static host_thread_pool& instance()
+    {
+        static host_thread_pool pool;
+        return pool;
+    }
+
+    host_thread_pool(const host_thread_pool&) = delete;
+    host_thread_pool& operator=(const host_thread_pool&) = delete;
+
+    ~host_thread_pool() { stop_workers(); }
+
+    static std::size_t get_default_num_threads()
+    {
+        // number of threads (including the calling thread), 0 or unset means hardware concurrency
+        // NOLINTNEXTLINE (concurrency-mt-unsafe)
+        if(const char* env = std::getenv("CK_TILE_HOST_NUM_THREADS"); env != nullptr)
+        {
+            const std::size_t env_num_thread = std::strtoull(env, nullptr, 0);
+
+            if(env_num_thread > 0)
+                return env_num_thread;
+        }
+
+        return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+
+    // number of threads taking part in a parallel_for, including the calling thread
+    std::size_t get_num_threads() const { return num_thread_.load(std::memory_order_relaxed); }
+
+    // 0 restores the default (CK_TILE_HOST_NUM_THREADS or hardware concurrency)
+    void set_num_threads(std::size_t num_thread)
+    {
+        if(num_thread == 0)
+            num_thread = get_default_num_threads();
+
+        std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+        if(num_thread == num_thread_.load(std::memory_order_relaxed))
+            return;
+
+        stop_workers();
+        num_thread_.store(num_thread, std::memory_order_relaxed);
+    }
+
+    // true while the current thread executes work submitted through parallel_for
+    static bool in_parallel_region() { return in_parallel_region_flag(); }
+
+    // Calls f(begin, end) on disjoint sub-ranges that together cover [0, n).
+    // max_thread limits the number of participating threads (0 means no limit), grain is the
+    // chunk size claimed at a time (0 picks a chunk size that allows for load balancing).
+    template <typename F>
+    void parallel_for(std::size_t n, std::size_t max_thread, F&& f, std::size_t grain = 0)
+    {
+        if(n == 0)
+            return;
+
+        // Nested calls, and calls made while another thread owns the pool, run serially on the
+        // calling thread. Waiting for the pool instead could deadlock if the owner of the pool
+        // waits for the calling thread.
+        std::unique_lock<std::mutex> submit_lock(submit_mutex_, std::defer_lock);
+
+        if(in_parallel_region() || !submit_lock.try_lock())
+        {
+            f(std::size_t{0}, n);
+            return;
+        }
+
+        std::size_t num_thread = get_num_threads();
+
+        if(max_thread > 0)
+            num_thread = std::min(num_thread, max_thread);
+
+        num_thread = std::min(num_thread, n);
+
+        if(num_thread <= 1)
+        {
+            submit_lock.unlock();
+            f(std::size_t{0}, n);
+            return;
+        }
+
+        if(grain == 0)
+            grain = std::max<std::size_t>(n / (num_thread * chunks_per_thread), 1);
+
+        using Func = std::remove_reference_t<F>;
+
+        job_t job;
+        job.num_participant_ = num_thread;
+        job.grain_           = grain;
+        job.p_func_          = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+        job.p_invoke_        = [](void* p_func, std::size_t begin, std::size_t end) {
+            (*static_cast<Func*>(p_func))(begin, end);
+        };
+        job.ranges_ = std::make_unique<range[]>(num_thread);
+
+        for(std::size_t i = 0; i < num_thread; ++i)
+        {
+            job.ranges_[i].next_.store(n * i / num_thread, std::memory_order_relaxed);
+            job.ranges_[i].end_ = n * (i + 1) / num_thread;
+        }
+
+        start_workers();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            p_job_       = &job;
+            num_pending_ = num_thread - 1;
+            ++generation_;
+        }
+        work_cv_.notify_all();
+
+        // the calling thread is participant 0
+        run_participant(job, 0);
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_cv_.wait(lock, [&] { return num_pending_ == 0; });
+            p_job_ = nullptr;
+        }
+
+        if(job.exception_)
+            std::rethrow_exception(job.exception_);
+    }
+
+    private:
+    static constexpr std::size_t chunks_per_thread = 16;
+
+    struct alignas(64) range
+    {
+        std::atomic<std::size_t> next_{0};
+        std::size_t end_ = 0;
+    };
+
+    struct job_t
+    {
+        std::size_t num_participant_ = 0;
+        std::size_t grain_           = 1;
+        void* p_func_                = nullptr;
+
+        void (*p_invoke_)(void*, std::size_t, std::size_t) = nullptr;
+        std::unique_ptr<range[]> ranges_;
+
+        std::mutex exception_mutex_;
+        std::exception_ptr exception_;
+    };
+
+    host_thread_pool() : num_thread_(get_default_num_threads()) {}
+
+    static bool& in_parallel_region_flag()
+    {
+        static thread_local bool in_parallel_region = false;
+        return in_parallel_region;
+    }
+
+    // claim one chunk of range r, returns false once the range is exhausted
+    static bool claim_chunk(range& r, std::size_t grain, std::size_t& begin, std::size_t& end)
+    {
+        if(r.next_.load(std::memory_order_relaxed) >= r.end_)
+            return false;
+
+        begin = r.next_.fetch_add(grain, std::memory_order_relaxed);
+
+        if(begin >= r.end_)
+            return false;
+
+        end = std::min(begin + grain, r.end_);
+        return true;
+    }
+
+    static void run_participant(job_t& job, std::size_t participant)
+    {
+        in_parallel_region_flag() = true;
+
+        try
+        {
+            std::size_t begin = 0;
+            std::size_t end   = 0;
+
+            // own range first, then steal from the others in round-robin order
+            for(std::size_t i = 0; i < job.num_participant_; ++i)
+            {
+                range& r = job.ranges_[(participant + i) % job.num_participant_];
+
+                while(claim_chunk(r, job.grain_, begin, end))
+                {
+                    job.p_invoke_(job.p_func_, begin, end);
+                }
+            }
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(job.exception_mutex_);
+
+            if(!job.exception_)
+                job.exception_ = std::current_exception();
+
+            // drain all ranges so that the other participants stop early
+            for(std::size_t i = 0; i < job.num_participant_; ++i)
+                job.ranges_[i].next_.store(job.ranges_[i].end_, std::memory_order_relaxed);
+        }
+
+        in_parallel_region_flag() = false;
+    }
+
+    void worker_loop(std::size_t participant)
+    {
+        std::size_t seen_generation = 0;
+
+        while(true)
+        {
+            job_t* p_job = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+
+                if(stop_)
+                    return;
+
+                seen_generation = generation_;
+                p_job           = p_job_;
+            }
+
+            if(p_job == nullptr || participant >= p_job->num_participant_)
+                continue;
+
+            run_participant(*p_job, participant);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --num_pending_;
+
+                if(num_pending_ != 0)
+                    continue;
+            }
+            done_cv_.notify_one();
+        }
+    }
+
+    // must be called with submit_mutex_ held
+    void start_workers()
+    {
+        const std::size_t num_worker = get_num_threads() - 1;
+
+        if(workers_.size() == num_worker)
+            return;
+
+        stop_workers();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_       = false;
+            generation_ = 0;
+        }
+
+        workers_.reserve(num_worker);
+
+        for(std::size_t i = 0; i < num_worker; ++i)
+        {
+            // worker i is participant i + 1
+            workers_.emplace_back([this, i] { worker_loop(i + 1); });
+        }
+    }
+
+    void stop_workers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+
+        for(auto& worker : workers_)
+        {
+            if(worker.joinable())
+                worker.join();
+        }
+
+        workers_.clear();
+    }
+
+    std::atomic<std::size_t> num_thread_;
+
+    std::mutex submit_mutex_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    bool stop_               = false;
+    std::size_t generation_  = 0;
+    std::size_t num_pending_ = 0;
+    job_t* p_job_            = nullptr;
+    std::vector<std::thread> workers_;
+};
+
+CK_TILE_HOST std::size_t get_host_num_threads()
+{
+    return host_thread_pool::instance().get_num_threads();
+}
+
+CK_TILE_HOST void set_host_num_threads(std::size_t num_thread)
+{
+    host_thread_pool::instance().set_num_threads(num_thread);
+}
+
+} // namespace ck_tile
@@ -7,8 +7,12 @@
 #include "ck_tile/host/stream_config.hpp"
 #include "ck_tile/host/hip_check_error.hpp"
 #include "ck_tile/host/timer.hpp"
+#include "ck_tile/host/timing_statistics.hpp"
 #include <hip/hip_runtime.h>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdio>
 
 namespace ck_tile {
 template <int MaxThreadPerBlock, int MinBlockPerCu, typename Kernel, typename... Args>
@@ -68,6 +72,71 @@ make_kernel(KernelImpl /*f*/, dim3 grid_dim, dim3 block_dim, std::size_t lds_byt
  *                       ...);
  **/
 // clang-format on
+
+// Times the callables in samples of one or more launches until the confidence interval of the
+// median reaches the target of s, see stream_config::adaptive_timing_, and returns the median
+// time of a launch in ms.
+template <typename Timer, typename... Callables>
+CK_TILE_HOST float launch_kernel_adaptive(const stream_config& s, Callables... callables)
+{
+    // shorter samples are dominated by the overhead of the timer
+    constexpr float min_sample_ms = 0.1f;
+
+    Timer timer{};
+
+    const auto time_launches = [&](int nlaunch) {
+        timer.start(s.stream_id_);
+        for(int i = 0; i < nlaunch; i++)
+        {
+            (callables(s), ...);
+        }
+        HIP_CHECK_ERROR(hipGetLastError());
+        timer.stop(s.stream_id_);
+        return timer.duration();
+    };
+
+    // the warm up estimates how many launches a sample needs
+    const int cold_niters = std::max(s.cold_niters_, 1);
+    const float warmup_ms = time_launches(cold_niters) / cold_niters;
+
+    const int nlaunch_per_sample =
+        warmup_ms > 0 ? std::clamp(static_cast<int>(std::ceil(min_sample_ms / warmup_ms)), 1, 100)
+                      : 100;
+
+    timing_config config;
+
+    config.min_samples        = s.nrepeat_;
+    config.max_samples        = s.max_nrepeat_;
+    config.target_relative_ci = s.target_relative_ci_;
+
+    auto summary = run_adaptive_timing(
+        config, [&] { return time_launches(nlaunch_per_sample) / nlaunch_per_sample; });
+
+    summary.num_launches *= nlaunch_per_sample;
+
+    if(s.log_level_ > 0)
+    {
+        printf("%d samples of %d launches (%d outliers), median %f ms, p10 %f ms, p90 %f ms, "
+               "CI [%f, %f] ms%s\n",
+               summary.num_samples + summary.num_outliers,
+               nlaunch_per_sample,
+               summary.num_outliers,
+               summary.median,
+               summary.p10,
+               summary.p90,
+               summary.ci_low,
+               summary.ci_high,
+               summary.converged ? "" : ", not converged");
+    }
+
+    if(s.timing_summary_ != nullptr)
+    {
+        *s.timing_summary_ = summary;
+    }
+
+    return summary.median;
+}
+
 template <typename... Callables>
 CK_TILE_HOST float launch_kernel(const stream_config& s, Callables... callables)
 {
@@ -76,6 +145,10 @@ CK_TILE_HOST float launch_kernel(const stream_config& s, Callables... callables)
         (callables(s),...); HIP_CHECK_ERROR(hipGetLastError());
         return 0;
     }
+    if(s.adaptive_timing_) {
+        if(s.is_gpu_timer_) return launch_kernel_adaptive<gpu_timer>(s, callables...);
+        else                return launch_kernel_adaptive<cpu_timer>(s, callables...);
+    }
     if(s.is_gpu_timer_) {
         gpu_timer timer {};
 
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ck_tile/core.hpp"
+
+namespace ck_tile {
+
+// copy of the first num_tokens tokens of the K/V page src_block to the page dst_block
+struct KVCacheBlockCopy
+{
+    index_t src_block;
+    index_t dst_block;
+    index_t num_tokens;
+};
+
+// Host-side manager of a fixed pool of paged KV cache blocks (pages of page_block_size tokens).
+//
+// Each sequence owns a list of blocks, its row of the block_table consumed by the paged split-kv
+// and appendkv kernels. Blocks are reference counted so sequences can share a prefix: a forked
+// sequence shares the blocks of its parent and the shared last block is copied on the first
+// append to it (copy-on-write). The block copies, and the block moves of compact(), are not
+// performed by the manager; they are queued and must be applied by the caller, in order, before
+// the next kernel reads or writes the cache (see take_block_copies()).
+//
+// Allocating and freeing a block is O(1). Sequence ids are reused after free_sequence() and are
+// the rows of the cache when the sequences index a contiguous cache through cache_batch_idx.
+class KVCacheBlockManager
+{
+    public:
+    // max_num_blocks_per_seq of 0 does not limit the length of the sequences
+    KVCacheBlockManager(index_t num_blocks,
+                        index_t page_block_size,
+                        index_t max_num_blocks_per_seq = 0)
+        : page_block_size_(page_block_size),
+          max_num_blocks_per_seq_(max_num_blocks_per_seq),
+          ref_counts_(std::max(num_blocks, 0), 0)
+    {
+        if(num_blocks < 0 || page_block_size <= 0 || max_num_blocks_per_seq < 0)
+            throw std::runtime_error("wrong! invalid kv cache block manager configuration");
+
+        reset_free_blocks(0);
+    }
+
+    index_t get_num_blocks() const { return static_cast<index_t>(ref_counts_.size()); }
+    index_t get_page_block_size() const { return page_block_size_; }
+    index_t get_num_free_blocks() const { return static_cast<index_t>(free_blocks_.size()); }
+    index_t get_num_used_blocks() const { return get_num_blocks() - get_num_free_blocks(); }
+    index_t get_ref_count(index_t block) const { return ref_counts_.at(block); }
+
+    // creates an empty sequence and returns its id
+    index_t create_sequence()
+    {
+        if(free_seq_ids_.empty())
+        {
+            seqs_.emplace_back();
+            seqs_.back().active = true;
+            return static_cast<index_t>(seqs_.size()) - 1;
+        }
+
+        const index_t seq_id = free_seq_ids_.back();
+        free_seq_ids_.pop_back();
+        seqs_[seq_id].active = true;
+
+        return seq_id;
+    }
+
+    // Creates a sequence sharing the first num_tokens tokens of seq_id, all of them if negative.
+    // No blocks are allocated, the shared blocks are copied when the sequences diverge.
+    index_t fork_sequence(index_t seq_id, index_t num_tokens = -1)
+    {
+        const Sequence& parent = get_sequence(seq_id);
+
+        if(num_tokens < 0 || parent.seqlen < num_tokens)
+            num_tokens = parent.seqlen;
+
+        const index_t num_shared = integer_divide_ceil(num_tokens, page_block_size_);
+        const index_t child_id   = create_sequence();
+        // create_sequence() may have reallocated seqs_
+        Sequence& child = seqs_[child_id];
+
+        child.blocks.assign(seqs_[seq_id].blocks.begin(),
+                            seqs_[seq_id].blocks.begin() + num_shared);
+        child.seqlen = num_tokens;
+
+        for(index_t block : child.blocks)
+            ++ref_counts_[block];
+
+        return child_id;
+    }
+
+    // releases the blocks of the sequence, the id may be returned by a later create_sequence()
+    void free_sequence(index_t seq_id)
+    {
+        Sequence& seq = get_sequence(seq_id);
+
+        for(index_t block : seq.blocks)
+            release_block(block);
+
+        seq.blocks.clear();
+        seq.seqlen = 0;
+        seq.active = false;
+        free_seq_ids_.push_back(seq_id);
+    }
+
+    // number of blocks append_tokens(seq_id, num_tokens) allocates
+    index_t get_num_blocks_to_append(index_t seq_id, index_t num_tokens) const
+    {
+        const Sequence& seq = get_sequence(seq_id);
+
+        const index_t num_blocks = integer_divide_ceil(seq.seqlen + num_tokens, page_block_size_) -
+                                   static_cast<index_t>(seq.blocks.size());
+
+        return num_blocks + (0 < num_tokens && needs_copy_on_write(seq) ? 1 : 0);
+    }
+
+    // Grows the sequence by num_tokens tokens, to be written by the caller (e.g. the appendkv
+    // kernel at seqlen_k = get_seqlen(seq_id) before the call). Returns false and leaves the
+    // sequence unchanged if the pool does not have enough free blocks.
+    bool append_tokens(index_t seq_id, index_t num_tokens)
+    {
+        if(num_tokens < 0)
+            throw std::runtime_error("wrong! negative number of tokens to append");
+
+        const index_t num_new_blocks = get_num_blocks_to_append(seq_id, num_tokens);
+        Sequence& seq                = seqs_[seq_id];
+
+        if(0 < max_num_blocks_per_seq_ &&
+           max_num_blocks_per_seq_ < integer_divide_ceil(seq.seqlen + num_tokens, page_block_size_))
+            throw std::runtime_error("wrong! sequence " + std::to_string(seq_id) +
+                                     " exceeds max_num_blocks_per_seq");
+
+        if(get_num_free_blocks() < num_new_blocks)
+            return false;
+
+        if(0 < num_tokens && needs_copy_on_write(seq))
+        {
+            const index_t shared_block = seq.blocks.back();
+            const index_t block        = allocate_block();
+
+            copies_.push_back({shared_block, block, seq.seqlen % page_block_size_});
+            release_block(shared_block);
+            seq.blocks.back() = block;
+        }
+
+        seq.seqlen += num_tokens;
+
+        while(static_cast<index_t>(seq.blocks.size()) * page_block_size_ < seq.seqlen)
+            seq.blocks.push_back(allocate_block());
+
+        return true;
+    }
+
+    index_t get_seqlen(index_t seq_id) const { return get_sequence(seq_id).seqlen; }
+
+    const std::vector<index_t>& get_blocks(index_t seq_id) const
+    {
+        return get_sequence(seq_id).blocks;
+    }
+
+    // returns and clears the queue of block copies to apply before the next kernel launch
+    std::vector<KVCacheBlockCopy> take_block_copies()
+    {
+        std::vector<KVCacheBlockCopy> copies;
+        copies.swap(copies_);
+        return copies;
+    }
+
+    // Moves the used blocks to the lowest block indices so the used part of the pool is
+    // contiguous, e.g. before shrinking the cache. The moves are queued as block copies.
+    void compact()
+    {
+        const index_t num_used = get_num_used_blocks();
+
+        // block indices >= num_used in use are moved to the free indices < num_used
+        std::vector<index_t> remap(get_num_blocks());
+        index_t dst_block = 0;
+
+        for(index_t block = 0; block < get_num_blocks(); ++block)
+        {
+            remap[block] = block;
+
+            if(ref_counts_[block] == 0 || block < num_used)
+                continue;
+
+            while(ref_counts_[dst_block] != 0)
+                ++dst_block;
+
+            remap[block]           = dst_block;
+            ref_counts_[dst_block] = ref_counts_[block];
+            ref_counts_[block]     = 0;
+            copies_.push_back({block, dst_block, page_block_size_});
+        }
+
+        for(Sequence& seq : seqs_)
+            for(index_t& block : seq.blocks)
+                block = remap[block];
+
+        reset_free_blocks(num_used);
+    }
+
+    // largest number of blocks of the sequences, the minimum batch stride of the block table
+    index_t get_max_num_blocks(const std::vector<index_t>& seq_ids) const
+    {
+        index_t max_num_blocks = 0;
+
+        for(index_t seq_id : seq_ids)
+            max_num_blocks =
+                std::max(max_num_blocks, static_cast<index_t>(get_blocks(seq_id).size()));
+
+        return max_num_blocks;
+    }
+
+    // Writes the [batch, batch_stride_block_table] block table of the batch of sequences, row i
+    // holds the blocks of seq_ids[i]. The unused entries of a row are set to 0 so the kernels
+    // never see an invalid block index.
+    void fill_block_table(const std::vector<index_t>& seq_ids,
+                          int32_t* block_table,
+                          index_t batch_stride_block_table) const
+    {
+        if(batch_stride_block_table < get_max_num_blocks(seq_ids))
+            throw std::runtime_error("wrong! batch_stride_block_table is too small");
+
+        for(std::size_t i_batch = 0; i_batch < seq_ids.size(); ++i_batch)
+        {
+            const auto& blocks = get_blocks(seq_ids[i_batch]);
+            int32_t* row       = block_table + i_batch * batch_stride_block_table;
+
+            std::copy(blocks.begin(), blocks.end(), row);
+            std::fill(row + blocks.size(), row + batch_stride_block_table, 0);
+        }
+    }
+
+    // Writes the cache_batch_idx of the batch of sequences: the row of the contiguous cache of
+    // [num_seqs, max_seqlen_k] tokens each sequence is stored in, its sequence id.
+    void fill_cache_batch_idx(const std::vector<index_t>& seq_ids, int32_t* cache_batch_idx) const
+    {
+        for(std::size_t i_batch = 0; i_batch < seq_ids.size(); ++i_batch)
+        {
+            get_sequence(seq_ids[i_batch]);
+            cache_batch_idx[i_batch] = seq_ids[i_batch];
+        }
+    }
+
+    // writes the number of cached tokens of the batch of sequences (seqlen_k)
+    void fill_seqlen_k(const std::vector<index_t>& seq_ids, int32_t* seqlen_k) const
+    {
+        for(std::size_t i_batch = 0; i_batch < seq_ids.size(); ++i_batch)
+            seqlen_k[i_batch] = get_seqlen(seq_ids[i_batch]);
+    }
+
+    private:
+    struct Sequence
+    {
+        std::vector<index_t> blocks;
+        index_t seqlen = 0;
+        bool active    = false;
+    };
+
+    const Sequence& get_sequence(index_t seq_id) const
+    {
+        if(seq_id < 0 || static_cast<index_t>(seqs_.size()) <= seq_id || !seqs_[seq_id].active)
+            throw std::runtime_error("wrong! invalid sequence id " + std::to_string(seq_id));
+
+        return seqs_[seq_id];
+    }
+
+    Sequence& get_sequence(index_t seq_id)
+    {
+        return const_cast<Sequence&>(std::as_const(*this).get_sequence(seq_id));
+    }
+
+    // the next token is written to a partially filled block shared with another sequence
+    bool needs_copy_on_write(const Sequence& seq) const
+    {
+        return seq.seqlen % page_block_size_ != 0 && 1 < ref_counts_[seq.blocks.back()];
+    }
+
+    index_t allocate_block()
+    {
+        const index_t block = free_blocks_.back();
+
+        free_blocks_.pop_back();
+        ref_counts_[block] = 1;
+
+        return block;
+    }
+
+    void release_block(index_t block)
+    {
+        if(--ref_counts_[block] == 0)
+            free_blocks_.push_back(block);
+    }
+
+    // frees the blocks [first_free_block, num_blocks), the lowest one is allocated first
+    void reset_free_blocks(index_t first_free_block)
+    {
+        free_blocks_.clear();
+
+        for(index_t block = get_num_blocks() - 1; block >= first_free_block; --block)
+            free_blocks_.push_back(block);
+    }
+
+    index_t page_block_size_;
+    index_t max_num_blocks_per_seq_;
+    std::vector<index_t> ref_counts_;
+    std::vector<index_t> free_blocks_;
+    std::vector<Sequence> seqs_;
+    std::vector<index_t> free_seq_ids_;
+    std::vector<KVCacheBlockCopy> copies_;
+};
+
+} // namespace ck_tile
@@ -0,0 +1,327 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ck_tile {
+
+struct reference_fmha_no_dbias
+{
+    CK_TILE_HOST void operator()(index_t, index_t, index_t, float) const {}
+};
+
+// Attention backward of one batch, the counterpart of reference_fmha_fwd:
+//   P  = exp(scale_s * Q K^T + bias - LSE), masked
+//   dV = dropout(P)^T dO
+//   dP = dropout(dO V^T)
+//   dS = P * (dP - rowsum(dO * O))
+//   dQ = scale_s * dS K,  dK = scale_s * dS^T Q
+// q/o/do are [nhead, seqlen_q, hdim], lse_h_m is the [nhead, seqlen_q] lse of the forward pass
+// and k/v view the K/V of the batch. dq_h_m_k is [nhead, seqlen_q, hdim_q], dk_h_n_k and dv_h_n_o
+// are [nhead, seqlen_k, hdim] per query head, i.e. the MQA/GQA reduction over the heads sharing
+// one K/V head is left to the caller as it is for the device kernel. P and dS are rounded to
+// GemmDataType before they enter a GEMM. dbias(i_head, i_m, i_n, ds) is called once for every
+// element of S (with 0 for masked elements) if the bias gradient is wanted.
+//
+// Like the device kernel, P and dP are recomputed tile by tile from Q/K/V/dO and the lse instead
+// of being stored: memory stays O(nhead * seqlen_q + tile * hdim). dK/dV are computed by
+// (head, 64 K/V-rows) work items and dQ by a second sweep over (head, 16 q-rows) work items, so
+// every output element is accumulated by a single thread in a fixed order and the result does
+// not depend on the number of host threads.
+template <typename AccDataType,
+          typename GemmDataType,
+          typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename ODataType,
+          typename LSEDataType,
+          typename OGradDataType,
+          typename QGradDataType,
+          typename KGradDataType,
+          typename VGradDataType,
+          typename MaskType,
+          typename BiasType    = reference_fmha_no_bias,
+          typename DropoutType = reference_fmha_no_dropout,
+          typename DBiasType   = reference_fmha_no_dbias>
+CK_TILE_HOST void reference_fmha_bwd(const HostTensor<QDataType>& q_h_m_k,
+                                     const reference_fmha_kv_view<KDataType>& k,
+                                     const reference_fmha_kv_view<VDataType>& v,
+                                     const HostTensor<ODataType>& o_h_m_o,
+                                     const HostTensor<LSEDataType>& lse_h_m,
+                                     const HostTensor<OGradDataType>& do_h_m_o,
+                                     HostTensor<QGradDataType>& dq_h_m_k,
+                                     HostTensor<KGradDataType>& dk_h_n_k,
+                                     HostTensor<VGradDataType>& dv_h_n_o,
+                                     const MaskType& mask,
+                                     AccDataType scale_s,
+                                     const BiasType& bias       = {},
+                                     const DropoutType& dropout = {},
+                                     const DBiasType& dbias     = {})
+{
+    constexpr index_t kTileM = 16;
+    constexpr index_t kTileN = 64;
+
+    constexpr bool kHasBias    = !std::is_same_v<BiasType, reference_fmha_no_bias>;
+    constexpr bool kHasDropout = !std::is_same_v<DropoutType, reference_fmha_no_dropout>;
+    constexpr bool kHasDBias   = !std::is_same_v<DBiasType, reference_fmha_no_dbias>;
+
+    const index_t nhead    = q_h_m_k.get_lengths()[0];
+    const index_t seqlen_q = q_h_m_k.get_lengths()[1];
+    const index_t seqlen_k = k.seqlen;
+    const index_t hdim_q   = k.hdim;
+    const index_t hdim_v   = v.hdim;
+
+    if(k.nhead <= 0 || nhead % k.nhead != 0 || v.nhead != k.nhead || v.seqlen != k.seqlen ||
+       q_h_m_k.get_lengths()[2] != static_cast<std::size_t>(hdim_q) ||
+       do_h_m_o.get_lengths()[2] != static_cast<std::size_t>(hdim_v) ||
+       dk_h_n_k.get_lengths()[1] != static_cast<std::size_t>(seqlen_k) ||
+       dv_h_n_o.get_lengths()[1] != static_cast<std::size_t>(seqlen_k))
+        throw std::runtime_error("reference_fmha_bwd: inconsistent q/k/v/do/dk/dv shapes");
+
+    const index_t nhead_ratio = nhead / k.nhead;
+
+    const AccDataType rp_undrop = [&]() {
+        if constexpr(kHasDropout)
+            return type_convert<AccDataType>(dropout.rp_undrop);
+        else
+            return AccDataType{1};
+    }();
+
+    // D = rowsum(dO * O) and the lse, both [nhead, seqlen_q]
+    std::vector<AccDataType> d(nhead * seqlen_q);
+    std::vector<AccDataType> lse(nhead * seqlen_q);
+
+    host_thread_pool::instance().parallel_for(
+        d.size(), 0, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+            {
+                const index_t i_head = i / seqlen_q;
+                const index_t i_m    = i % seqlen_q;
+
+                AccDataType acc = 0;
+                for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                    acc += type_convert<AccDataType>(do_h_m_o(i_head, i_m, i_o)) *
+                           type_convert<AccDataType>(o_h_m_o(i_head, i_m, i_o));
+
+                d[i]   = acc;
+                lse[i] = type_convert<AccDataType>(lse_h_m(i_head, i_m));
+            }
+        });
+
+    const auto round = [](AccDataType x) {
+        return type_convert<AccDataType>(type_convert<GemmDataType>(x));
+    };
+
+    const auto dot = [](const AccDataType* x, const AccDataType* y, index_t n) {
+        AccDataType acc = 0;
+        for(index_t i = 0; i < n; ++i)
+            acc += x[i] * y[i];
+        return acc;
+    };
+
+    // P (before dropout), dropout(P) and dS of one element, false if it is masked
+    const auto compute_p_ds = [&](index_t i_head,
+                                  index_t i_m,
+                                  index_t i_n,
+                                  const AccDataType* q_row,
+                                  const AccDataType* do_row,
+                                  const AccDataType* k_row,
+                                  const AccDataType* v_row,
+                                  AccDataType& p_dropped,
+                                  AccDataType& ds) {
+        if(mask.IsOutOfBound(i_m, i_n))
+            return false;
+
+        AccDataType s = dot(q_row, k_row, hdim_q) * scale_s;
+
+        if constexpr(kHasBias)
+            s += type_convert<AccDataType>(bias(i_head, i_m, i_n));
+
+        const AccDataType p = ck_tile::exp(s - lse[i_head * seqlen_q + i_m]);
+
+        AccDataType dp = dot(do_row, v_row, hdim_v);
+
+        p_dropped = p;
+
+        if constexpr(kHasDropout)
+        {
+            const bool is_kept = dropout.is_kept(i_head, i_m, i_n);
+
+            p_dropped = is_kept ? p * rp_undrop : AccDataType{0};
+            dp        = is_kept ? dp * rp_undrop : AccDataType{0};
+        }
+
+        ds = p * (dp - d[i_head * seqlen_q + i_m]);
+
+        return true;
+    };
+
+    // converts the rows [i_begin, i_end) returned by get(i_row, i_d) to AccDataType
+    const auto load_rows = [](const auto& get,
+                              index_t i_begin,
+                              index_t i_end,
+                              index_t hdim,
+                              std::vector<AccDataType>& rows) {
+        rows.resize((i_end - i_begin) * hdim);
+        for(index_t r = 0; r < i_end - i_begin; ++r)
+            for(index_t i_d = 0; i_d < hdim; ++i_d)
+                rows[r * hdim + i_d] = type_convert<AccDataType>(get(i_begin + r, i_d));
+    };
+
+    const auto get_q_row = [&](index_t i_head) {
+        return [&, i_head](index_t i_m, index_t i_d) { return q_h_m_k(i_head, i_m, i_d); };
+    };
+    const auto get_do_row = [&](index_t i_head) {
+        return [&, i_head](index_t i_m, index_t i_d) { return do_h_m_o(i_head, i_m, i_d); };
+    };
+    const auto get_k_row = [&](index_t i_head_k) {
+        return [&, i_head_k](index_t i_n, index_t i_d) {
+            return k.get_row(i_head_k, i_n)[i_d * k.stride_hdim];
+        };
+    };
+    const auto get_v_row = [&](index_t i_head_k) {
+        return [&, i_head_k](index_t i_n, index_t i_d) {
+            return v.get_row(i_head_k, i_n)[i_d * v.stride_hdim];
+        };
+    };
+
+    // dK, dV: one work item per (head, kTileN K/V-rows), sweeping over all the q-rows
+    const index_t num_tile_n = integer_divide_ceil(seqlen_k, kTileN);
+
+    host_thread_pool::instance().parallel_for(
+        static_cast<std::size_t>(nhead) * num_tile_n, 0, [&](std::size_t begin, std::size_t end) {
+            std::vector<AccDataType> k_tile, v_tile, q_row, do_row, dk, dv;
+
+            for(std::size_t i_item = begin; i_item < end; ++i_item)
+            {
+                const index_t i_head    = i_item / num_tile_n;
+                const index_t i_head_k  = i_head / nhead_ratio;
+                const index_t i_n_begin = (i_item % num_tile_n) * kTileN;
+                const index_t i_n_end   = std::min(i_n_begin + kTileN, seqlen_k);
+                const index_t num_col   = i_n_end - i_n_begin;
+
+                load_rows(get_k_row(i_head_k), i_n_begin, i_n_end, hdim_q, k_tile);
+                load_rows(get_v_row(i_head_k), i_n_begin, i_n_end, hdim_v, v_tile);
+
+                dk.assign(num_col * hdim_q, 0);
+                dv.assign(num_col * hdim_v, 0);
+
+                for(index_t i_m = 0; i_m < seqlen_q; ++i_m)
+                {
+                    load_rows(get_q_row(i_head), i_m, i_m + 1, hdim_q, q_row);
+                    load_rows(get_do_row(i_head), i_m, i_m + 1, hdim_v, do_row);
+
+                    for(index_t c = 0; c < num_col; ++c)
+                    {
+                        const index_t i_n = i_n_begin + c;
+
+                        AccDataType p_dropped = 0;
+                        AccDataType ds        = 0;
+
+                        const bool is_valid = compute_p_ds(i_head,
+                                                           i_m,
+                                                           i_n,
+                                                           q_row.data(),
+                                                           do_row.data(),
+                                                           k_tile.data() + c * hdim_q,
+                                                           v_tile.data() + c * hdim_v,
+                                                           p_dropped,
+                                                           ds);
+
+                        if constexpr(kHasDBias)
+                            dbias(i_head, i_m, i_n, ds);
+
+                        if(!is_valid)
+                            continue;
+
+                        const AccDataType p_rounded  = round(p_dropped);
+                        const AccDataType ds_rounded = round(ds);
+
+                        for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                            dv[c * hdim_v + i_o] += p_rounded * do_row[i_o];
+
+                        for(index_t i_k = 0; i_k < hdim_q; ++i_k)
+                            dk[c * hdim_q + i_k] += ds_rounded * q_row[i_k];
+                    }
+                }
+
+                for(index_t c = 0; c < num_col; ++c)
+                {
+                    for(index_t i_k = 0; i_k < hdim_q; ++i_k)
+                        dk_h_n_k(i_head, i_n_begin + c, i_k) =
+                            type_convert<KGradDataType>(scale_s * dk[c * hdim_q + i_k]);
+
+                    for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                        dv_h_n_o(i_head, i_n_begin + c, i_o) =
+                            type_convert<VGradDataType>(dv[c * hdim_v + i_o]);
+                }
+            }
+        });
+
+    // dQ: one work item per (head, kTileM q-rows), sweeping over all the K/V-rows
+    const index_t num_tile_m = integer_divide_ceil(seqlen_q, kTileM);
+
+    host_thread_pool::instance().parallel_for(
+        static_cast<std::size_t>(nhead) * num_tile_m, 0, [&](std::size_t begin, std::size_t end) {
+            std::vector<AccDataType> q_tile, do_tile, k_row, v_row, dq;
+
+            for(std::size_t i_item = begin; i_item < end; ++i_item)
+            {
+                const index_t i_head    = i_item / num_tile_m;
+                const index_t i_head_k  = i_head / nhead_ratio;
+                const index_t i_m_begin = (i_item % num_tile_m) * kTileM;
+                const index_t i_m_end   = std::min(i_m_begin + kTileM, seqlen_q);
+                const index_t num_row   = i_m_end - i_m_begin;
+
+                load_rows(get_q_row(i_head), i_m_begin, i_m_end, hdim_q, q_tile);
+                load_rows(get_do_row(i_head), i_m_begin, i_m_end, hdim_v, do_tile);
+
+                dq.assign(num_row * hdim_q, 0);
+
+                for(index_t i_n = 0; i_n < seqlen_k; ++i_n)
+                {
+                    load_rows(get_k_row(i_head_k), i_n, i_n + 1, hdim_q, k_row);
+                    load_rows(get_v_row(i_head_k), i_n, i_n + 1, hdim_v, v_row);
+
+                    for(index_t r = 0; r < num_row; ++r)
+                    {
+                        AccDataType p_dropped = 0;
+                        AccDataType ds        = 0;
+
+                        if(!compute_p_ds(i_head,
+                                         i_m_begin + r,
+                                         i_n,
+                                         q_tile.data() + r * hdim_q,
+                                         do_tile.data() + r * hdim_v,
+                                         k_row.data(),
+                                         v_row.data(),
+                                         p_dropped,
+                                         ds))
+                            continue;
+
+                        const AccDataType ds_rounded = round(ds);
+
+                        for(index_t i_k = 0; i_k < hdim_q; ++i_k)
+                            dq[r * hdim_q + i_k] += ds_rounded * k_row[i_k];
+                    }
+                }
+
+                for(index_t r = 0; r < num_row; ++r)
+                    for(index_t i_k = 0; i_k < hdim_q; ++i_k)
+                        dq_h_m_k(i_head, i_m_begin + r, i_k) =
+                            type_convert<QGradDataType>(scale_s * dq[r * hdim_q + i_k]);
+            }
+        });
+}
+
+} // namespace ck_tile
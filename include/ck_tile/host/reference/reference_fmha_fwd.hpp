@@ -0,0 +1,557 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ck_tile {
+
+// Read-only view of the K or V cache of one batch. Row (i_head, i_seqlen) holds hdim elements
+// spaced stride_hdim apart. With a block table (paged KV cache) row i_seqlen is stored at row
+// i_seqlen % page_block_size of page p_block_table[i_seqlen / page_block_size].
+template <typename DataType>
+struct reference_fmha_kv_view
+{
+    const DataType* p_data = nullptr;
+
+    index_t nhead  = 0;
+    index_t seqlen = 0;
+    index_t hdim   = 0;
+
+    long_index_t stride_head   = 0;
+    long_index_t stride_seqlen = 0;
+    long_index_t stride_hdim   = 1;
+
+    const index_t* p_block_table = nullptr;
+    index_t page_block_size      = 0;
+    long_index_t stride_page     = 0;
+
+    CK_TILE_HOST const DataType* get_row(index_t i_head, index_t i_seqlen) const
+    {
+        if(p_block_table == nullptr)
+            return p_data + i_head * stride_head + i_seqlen * stride_seqlen;
+
+        return p_data + p_block_table[i_seqlen / page_block_size] * stride_page +
+               i_head * stride_head + (i_seqlen % page_block_size) * stride_seqlen;
+    }
+};
+
+// t_h_s_d: [nhead, seqlen, hdim]
+template <typename DataType>
+CK_TILE_HOST auto make_reference_fmha_kv_view(const HostTensor<DataType>& t_h_s_d)
+{
+    const auto& lens    = t_h_s_d.get_lengths();
+    const auto& strides = t_h_s_d.get_strides();
+
+    reference_fmha_kv_view<DataType> view;
+
+    view.p_data        = t_h_s_d.data();
+    view.nhead         = lens[0];
+    view.seqlen        = lens[1];
+    view.hdim          = lens[2];
+    view.stride_head   = strides[0];
+    view.stride_seqlen = strides[1];
+    view.stride_hdim   = strides[2];
+
+    return view;
+}
+
+// Batch i_batch of t, which is [batch, nhead, seqlen, hdim] if i_perm else
+// [batch, seqlen, nhead, hdim], i.e. the layouts used by the fmha examples.
+template <typename DataType>
+CK_TILE_HOST auto
+make_reference_fmha_kv_view(const HostTensor<DataType>& t, index_t i_batch, bool i_perm)
+{
+    const auto& lens    = t.get_lengths();
+    const auto& strides = t.get_strides();
+
+    const index_t i_head_dim   = i_perm ? 1 : 2;
+    const index_t i_seqlen_dim = i_perm ? 2 : 1;
+
+    reference_fmha_kv_view<DataType> view;
+
+    view.p_data        = t.data() + i_batch * strides[0];
+    view.nhead         = lens[i_head_dim];
+    view.seqlen        = lens[i_seqlen_dim];
+    view.hdim          = lens[3];
+    view.stride_head   = strides[i_head_dim];
+    view.stride_seqlen = strides[i_seqlen_dim];
+    view.stride_hdim   = strides[3];
+
+    return view;
+}
+
+// Paged cache t, which is [num_pages, nhead, page_block_size, hdim] if i_perm else
+// [num_pages, page_block_size, nhead, hdim]. p_block_table lists the pages of one batch, which
+// holds seqlen rows.
+template <typename DataType>
+CK_TILE_HOST auto make_reference_fmha_paged_kv_view(const HostTensor<DataType>& t,
+                                                    const index_t* p_block_table,
+                                                    index_t seqlen,
+                                                    bool i_perm)
+{
+    auto view = make_reference_fmha_kv_view(t, 0, i_perm);
+
+    view.seqlen          = seqlen;
+    view.p_block_table   = p_block_table;
+    view.page_block_size = t.get_lengths()[i_perm ? 2 : 1];
+    view.stride_page     = t.get_strides()[0];
+
+    return view;
+}
+
+struct reference_fmha_no_bias
+{
+    CK_TILE_HOST float operator()(index_t, index_t, index_t) const { return 0.f; }
+};
+
+struct reference_fmha_no_dropout
+{
+};
+
+// The 8-bit random values of the dropout of the fmha kernels, regenerated from the seed and
+// offset of the kernel args, see BlockDropout and BlockDropoutBwd. The [seqlen_q, seqlen_k] matrix
+// of head i_head is cut into 32x32 tiles. Tile (i_m / 32, i_n / 32) takes 16 bytes from each of
+// the 64 philox streams offset + (i_batch * nhead + i_head) * 64 + lane, laid out like the C tile
+// of the 32x32 SwizzleA warp gemm: byte k of lane l is row (k / 8) * 16 + (l / 32) * 8 + k % 8
+// and column l % 32 of the tile. In group mode i_batch is the index of the sequence.
+struct reference_fmha_philox_randval
+{
+    unsigned long long seed;
+    unsigned long long offset;
+    index_t i_batch;
+    index_t nhead;
+
+    CK_TILE_HOST uint8_t operator()(index_t i_head, index_t i_m, index_t i_n) const
+    {
+        const index_t row  = i_m % 32;
+        const index_t lane = (row / 8 % 2) * 32 + i_n % 32;
+        const index_t byte = row / 16 * 8 + row % 8;
+
+        const philox ph(seed,
+                        offset + (static_cast<unsigned long long>(i_batch) * nhead + i_head) * 64 +
+                            lane);
+
+        // the tile row in the low and the tile column in the high 32 bits
+        const unsigned long long subsequence =
+            static_cast<unsigned long long>(i_m / 32) |
+            (static_cast<unsigned long long>(i_n / 32) << 32);
+
+        uint8_t random[16];
+        ph.get_random_16x8(random, subsequence);
+
+        return random[byte];
+    }
+};
+
+// Dropout driven by one 8-bit random value per element, as in reference_batched_dropout: P(i_m,
+// i_n) of head i_head is kept and scaled by rp_undrop if randval(i_head, i_m, i_n) <=
+// p_undrop_in_uint8_t, and zeroed otherwise. randval is reference_fmha_philox_randval to match
+// the kernels; other callables, e.g. reading a randval tensor a kernel stored, help debugging.
+template <typename RandValFunc>
+struct reference_fmha_dropout
+{
+    RandValFunc randval;
+    uint8_t p_undrop_in_uint8_t;
+    float rp_undrop;
+
+    CK_TILE_HOST bool is_kept(index_t i_head, index_t i_m, index_t i_n) const
+    {
+        return randval(i_head, i_m, i_n) <= p_undrop_in_uint8_t;
+    }
+};
+
+template <typename RandValFunc>
+CK_TILE_HOST auto
+make_reference_fmha_dropout(RandValFunc randval, uint8_t p_undrop_in_uint8_t, float rp_undrop)
+{
+    return reference_fmha_dropout<RandValFunc>{randval, p_undrop_in_uint8_t, rp_undrop};
+}
+
+// the dropout of batch i_batch of a fmha kernel launched with seed and offset
+CK_TILE_HOST auto make_reference_fmha_philox_dropout(unsigned long long seed,
+                                                     unsigned long long offset,
+                                                     index_t i_batch,
+                                                     index_t nhead,
+                                                     uint8_t p_undrop_in_uint8_t,
+                                                     float rp_undrop)
+{
+    return make_reference_fmha_dropout(
+        reference_fmha_philox_randval{seed, offset, i_batch, nhead}, p_undrop_in_uint8_t, rp_undrop);
+}
+
+namespace detail {
+
+// Attention forward of the q-rows [i_m_begin, i_m_end) of head i_head with an online softmax:
+// the K/V rows are visited kTileN at a time and the running row max, row sum and unnormalized
+// output are rescaled whenever the max grows, so the S and P matrices never exist in full.
+//
+// The keys are cut into num_split ranges of split_size rows. Each range gets its own softmax,
+// written to o_acc/lse_acc if present, and the ranges are then merged like the splitkv combine
+// kernel does. With a single range the merge is exact.
+template <typename AccDataType,
+          typename PDataType,
+          typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename ODataType,
+          typename MaskType,
+          typename BiasType,
+          typename DropoutType>
+CK_TILE_HOST void reference_fmha_fwd_rows(const HostTensor<QDataType>& q_h_m_k,
+                                          const reference_fmha_kv_view<KDataType>& k,
+                                          const reference_fmha_kv_view<VDataType>& v,
+                                          HostTensor<ODataType>& o_h_m_o,
+                                          const MaskType& mask,
+                                          AccDataType scale_s,
+                                          const BiasType& bias,
+                                          const DropoutType& dropout,
+                                          HostTensor<AccDataType>* p_lse_h_m,
+                                          index_t num_split,
+                                          index_t split_size,
+                                          HostTensor<AccDataType>* p_o_acc_s_h_m_o,
+                                          HostTensor<AccDataType>* p_lse_acc_s_h_m,
+                                          index_t i_head,
+                                          index_t i_m_begin,
+                                          index_t i_m_end)
+{
+    constexpr index_t kTileN = 64;
+
+    const AccDataType neg_inf = -numeric<AccDataType>::infinity();
+
+    const index_t hdim_q  = k.hdim;
+    const index_t hdim_v  = v.hdim;
+    const index_t seqlen  = k.seqlen;
+    const index_t num_row = i_m_end - i_m_begin;
+
+    // MQA/GQA: consecutive groups of query heads share one K/V head
+    const index_t i_head_k = i_head / (q_h_m_k.get_lengths()[0] / k.nhead);
+
+    std::vector<AccDataType> q(num_row * hdim_q);
+    std::vector<AccDataType> s(kTileN);
+    std::vector<AccDataType> row_max(num_row);
+    std::vector<AccDataType> row_sum(num_row);
+    std::vector<AccDataType> o(num_row * hdim_v);
+    std::vector<AccDataType> lse(num_row, neg_inf);
+    std::vector<AccDataType> o_merged(num_row * hdim_v, 0);
+
+    for(index_t r = 0; r < num_row; ++r)
+        for(index_t i_k = 0; i_k < hdim_q; ++i_k)
+            q[r * hdim_q + i_k] = type_convert<AccDataType>(q_h_m_k(i_head, i_m_begin + r, i_k));
+
+    for(index_t i_split = 0; i_split < num_split; ++i_split)
+    {
+        const index_t i_n_begin = std::min(i_split * split_size, seqlen);
+        const index_t i_n_end   = std::min(i_n_begin + split_size, seqlen);
+
+        std::fill(row_max.begin(), row_max.end(), neg_inf);
+        std::fill(row_sum.begin(), row_sum.end(), AccDataType{0});
+        std::fill(o.begin(), o.end(), AccDataType{0});
+
+        for(index_t i_n0 = i_n_begin; i_n0 < i_n_end; i_n0 += kTileN)
+        {
+            const index_t num_col = std::min(kTileN, i_n_end - i_n0);
+
+            // the rows of the K/V tile stay in cache while all the q-rows consume them
+            for(index_t r = 0; r < num_row; ++r)
+            {
+                const index_t i_m        = i_m_begin + r;
+                const AccDataType* q_row = q.data() + r * hdim_q;
+
+                AccDataType tile_max = neg_inf;
+
+                for(index_t c = 0; c < num_col; ++c)
+                {
+                    const index_t i_n = i_n0 + c;
+
+                    if(mask.IsOutOfBound(i_m, i_n))
+                    {
+                        s[c] = neg_inf;
+                        continue;
+                    }
+
+                    const KDataType* k_row = k.get_row(i_head_k, i_n);
+
+                    AccDataType acc = 0;
+                    for(index_t i_k = 0; i_k < hdim_q; ++i_k)
+                        acc += q_row[i_k] * type_convert<AccDataType>(k_row[i_k * k.stride_hdim]);
+
+                    acc *= scale_s;
+
+                    if constexpr(!std::is_same_v<BiasType, reference_fmha_no_bias>)
+                        acc += type_convert<AccDataType>(bias(i_head, i_m, i_n));
+
+                    s[c]     = acc;
+                    tile_max = std::max(tile_max, acc);
+                }
+
+                // every column of the tile is masked, nothing to accumulate
+                if(tile_max == neg_inf)
+                    continue;
+
+                const AccDataType new_max = std::max(row_max[r], tile_max);
+                const AccDataType rescale = ck_tile::exp(row_max[r] - new_max);
+
+                AccDataType* o_row = o.data() + r * hdim_v;
+
+                if(rescale != AccDataType{1})
+                {
+                    row_sum[r] *= rescale;
+                    for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                        o_row[i_o] *= rescale;
+                }
+
+                row_max[r] = new_max;
+
+                for(index_t c = 0; c < num_col; ++c)
+                {
+                    if(s[c] == neg_inf)
+                        continue;
+
+                    const AccDataType p = ck_tile::exp(s[c] - new_max);
+
+                    row_sum[r] += p;
+
+                    AccDataType p_dropped = p;
+
+                    if constexpr(!std::is_same_v<DropoutType, reference_fmha_no_dropout>)
+                        p_dropped = dropout.is_kept(i_head, i_m, i_n0 + c)
+                                        ? p * type_convert<AccDataType>(dropout.rp_undrop)
+                                        : AccDataType{0};
+
+                    // P is rounded to PDataType before the second GEMM, as on the device
+                    const AccDataType p_rounded =
+                        type_convert<AccDataType>(type_convert<PDataType>(p_dropped));
+                    const VDataType* v_row = v.get_row(i_head_k, i_n0 + c);
+
+                    for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                        o_row[i_o] +=
+                            p_rounded * type_convert<AccDataType>(v_row[i_o * v.stride_hdim]);
+                }
+            }
+        }
+
+        for(index_t r = 0; r < num_row; ++r)
+        {
+            const index_t i_m  = i_m_begin + r;
+            AccDataType* o_row = o.data() + r * hdim_v;
+
+            // a row without unmasked keys gives a zero output and an lse of -inf
+            const AccDataType split_lse =
+                row_sum[r] == 0 ? neg_inf : row_max[r] + ck_tile::log(row_sum[r]);
+            const AccDataType inv_sum = row_sum[r] == 0 ? 0 : AccDataType{1} / row_sum[r];
+
+            for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                o_row[i_o] *= inv_sum;
+
+            if(p_o_acc_s_h_m_o != nullptr)
+            {
+                for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                    (*p_o_acc_s_h_m_o)(i_split, i_head, i_m, i_o) = o_row[i_o];
+
+                (*p_lse_acc_s_h_m)(i_split, i_head, i_m) = split_lse;
+            }
+
+            if(split_lse == neg_inf)
+                continue;
+
+            // merge with the ranges before, as the splitkv combine kernel does
+            const AccDataType max_lse = std::max(lse[r], split_lse);
+            const AccDataType new_lse =
+                max_lse + ck_tile::log(ck_tile::exp(lse[r] - max_lse) +
+                                       ck_tile::exp(split_lse - max_lse));
+
+            const AccDataType old_scale   = ck_tile::exp(lse[r] - new_lse);
+            const AccDataType split_scale = ck_tile::exp(split_lse - new_lse);
+
+            AccDataType* o_merged_row = o_merged.data() + r * hdim_v;
+
+            for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+                o_merged_row[i_o] = o_merged_row[i_o] * old_scale + o_row[i_o] * split_scale;
+
+            lse[r] = new_lse;
+        }
+    }
+
+    for(index_t r = 0; r < num_row; ++r)
+    {
+        for(index_t i_o = 0; i_o < hdim_v; ++i_o)
+            o_h_m_o(i_head, i_m_begin + r, i_o) =
+                type_convert<ODataType>(o_merged[r * hdim_v + i_o]);
+
+        if(p_lse_h_m != nullptr)
+            (*p_lse_h_m)(i_head, i_m_begin + r) = lse[r];
+    }
+}
+
+template <typename AccDataType,
+          typename PDataType,
+          typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename ODataType,
+          typename MaskType,
+          typename BiasType,
+          typename DropoutType>
+CK_TILE_HOST void reference_fmha_fwd_impl(const HostTensor<QDataType>& q_h_m_k,
+                                          const reference_fmha_kv_view<KDataType>& k,
+                                          const reference_fmha_kv_view<VDataType>& v,
+                                          HostTensor<ODataType>& o_h_m_o,
+                                          const MaskType& mask,
+                                          AccDataType scale_s,
+                                          const BiasType& bias,
+                                          const DropoutType& dropout,
+                                          HostTensor<AccDataType>* p_lse_h_m,
+                                          index_t num_split,
+                                          HostTensor<AccDataType>* p_o_acc_s_h_m_o,
+                                          HostTensor<AccDataType>* p_lse_acc_s_h_m)
+{
+    constexpr index_t kTileM = 16;
+
+    const index_t nhead  = q_h_m_k.get_lengths()[0];
+    const index_t seqlen = q_h_m_k.get_lengths()[1];
+
+    if(k.nhead <= 0 || nhead % k.nhead != 0 || v.nhead != k.nhead || v.seqlen != k.seqlen ||
+       q_h_m_k.get_lengths()[2] != static_cast<std::size_t>(k.hdim) ||
+       o_h_m_o.get_lengths()[0] != static_cast<std::size_t>(nhead) ||
+       o_h_m_o.get_lengths()[1] != static_cast<std::size_t>(seqlen) ||
+       o_h_m_o.get_lengths()[2] != static_cast<std::size_t>(v.hdim))
+        throw std::runtime_error("reference_fmha_fwd: inconsistent q/k/v/o shapes");
+
+    const index_t split_size   = std::max(integer_divide_ceil(k.seqlen, num_split), 1);
+    const index_t num_tile_m   = integer_divide_ceil(seqlen, kTileM);
+    const std::size_t num_item = static_cast<std::size_t>(nhead) * num_tile_m;
+
+    // work items are (head, kTileM q-rows) pairs, each needs O(kTileM * hdim) scratch only
+    host_thread_pool::instance().parallel_for(
+        num_item, 0, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i_item = begin; i_item < end; ++i_item)
+            {
+                const index_t i_head    = i_item / num_tile_m;
+                const index_t i_m_begin = (i_item % num_tile_m) * kTileM;
+                const index_t i_m_end   = std::min(i_m_begin + kTileM, seqlen);
+
+                reference_fmha_fwd_rows<AccDataType, PDataType>(q_h_m_k,
+                                                                k,
+                                                                v,
+                                                                o_h_m_o,
+                                                                mask,
+                                                                scale_s,
+                                                                bias,
+                                                                dropout,
+                                                                p_lse_h_m,
+                                                                num_split,
+                                                                split_size,
+                                                                p_o_acc_s_h_m_o,
+                                                                p_lse_acc_s_h_m,
+                                                                i_head,
+                                                                i_m_begin,
+                                                                i_m_end);
+            }
+        });
+}
+
+} // namespace detail
+
+// Attention forward of one batch:
+//   O = softmax(scale_s * Q K^T + bias, masked) V
+// q_h_m_k is [nhead, seqlen_q, hdim_q], o_h_m_o is [nhead, seqlen_q, hdim_v] and k/v view the
+// K/V cache of the batch (contiguous or paged). nhead must be a multiple of k.nhead (MQA/GQA).
+// mask.IsOutOfBound(i_m, i_n) removes keys, e.g. a GenericAttentionMask for causal or sliding
+// window attention. bias(i_head, i_m, i_n) is added after scaling, which covers elementwise bias
+// tensors as well as ALiBi. dropout (see reference_fmha_dropout) applies to P after the softmax;
+// the lse is the one of the undropped softmax.
+//
+// Unlike the batched_gemm -> softmax -> batched_gemm reference chain this needs no
+// [nhead, seqlen_q, seqlen_k] intermediates: memory stays O(seqlen_q * hdim) and K/V are read
+// once per 16 q-rows. P is rounded to PDataType before it is multiplied with V, but it is not
+// normalized yet at that point, so expect differences within the usual fp16/bf16 tolerance.
+template <typename AccDataType,
+          typename PDataType,
+          typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename ODataType,
+          typename MaskType,
+          typename BiasType    = reference_fmha_no_bias,
+          typename DropoutType = reference_fmha_no_dropout>
+CK_TILE_HOST void reference_fmha_fwd(
+    const HostTensor<QDataType>& q_h_m_k,
+    const reference_fmha_kv_view<KDataType>& k,
+    const reference_fmha_kv_view<VDataType>& v,
+    HostTensor<ODataType>& o_h_m_o,
+    const MaskType& mask,
+    AccDataType scale_s,
+    const BiasType& bias                                                   = {},
+    std::optional<std::reference_wrapper<HostTensor<AccDataType>>> lse_h_m = std::nullopt,
+    const DropoutType& dropout                                             = {})
+{
+    detail::reference_fmha_fwd_impl<AccDataType, PDataType>(q_h_m_k,
+                                                            k,
+                                                            v,
+                                                            o_h_m_o,
+                                                            mask,
+                                                            scale_s,
+                                                            bias,
+                                                            dropout,
+                                                            lse_h_m ? &lse_h_m->get() : nullptr,
+                                                            1,
+                                                            nullptr,
+                                                            nullptr);
+}
+
+// Split-KV variant: the keys are cut into num_split ranges of ceil(seqlen_k / num_split) rows,
+// the normalized output and lse of every range are written to o_acc_s_h_m_o
+// [num_split, nhead, seqlen_q, hdim_v] and lse_acc_s_h_m [num_split, nhead, seqlen_q], and their
+// combination to o_h_m_o / lse_h_m. Ranges without unmasked keys have a zero output and an lse
+// of -inf.
+template <typename AccDataType,
+          typename PDataType,
+          typename QDataType,
+          typename KDataType,
+          typename VDataType,
+          typename ODataType,
+          typename MaskType,
+          typename BiasType = reference_fmha_no_bias>
+CK_TILE_HOST void reference_fmha_fwd_splitkv(
+    const HostTensor<QDataType>& q_h_m_k,
+    const reference_fmha_kv_view<KDataType>& k,
+    const reference_fmha_kv_view<VDataType>& v,
+    index_t num_split,
+    HostTensor<AccDataType>& o_acc_s_h_m_o,
+    HostTensor<AccDataType>& lse_acc_s_h_m,
+    HostTensor<ODataType>& o_h_m_o,
+    const MaskType& mask,
+    AccDataType scale_s,
+    const BiasType& bias                                                   = {},
+    std::optional<std::reference_wrapper<HostTensor<AccDataType>>> lse_h_m = std::nullopt)
+{
+    if(num_split < 1)
+        throw std::runtime_error("reference_fmha_fwd_splitkv: num_split must be positive");
+
+    detail::reference_fmha_fwd_impl<AccDataType, PDataType>(q_h_m_k,
+                                                            k,
+                                                            v,
+                                                            o_h_m_o,
+                                                            mask,
+                                                            scale_s,
+                                                            bias,
+                                                            reference_fmha_no_dropout{},
+                                                            lse_h_m ? &lse_h_m->get() : nullptr,
+                                                            num_split,
+                                                            &o_acc_s_h_m_o,
+                                                            &lse_acc_s_h_m);
+}
+
+} // namespace ck_tile
@@ -5,6 +5,13 @@
 
 #include "ck_tile/core.hpp"
 #include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace ck_tile {
 // [indexing implementation-1]
@@ -39,6 +46,100 @@ namespace ck_tile {
 // num_tokens_post_padded_ptr : [28]
 // num_sorted_tiles_ptr : [7]
 
+namespace detail {
+
+// Register-blocked C = A * B^T on AccDataType buffers for the fused-moe reference.
+//
+// a holds num_row rows of k_len elements spaced lda apart. b_packed is a panel of num_col rows
+// of B (i.e. columns of C) stored as kNR-column slivers, each of them k-major:
+// b_packed[(sliver * k_len + i_k) * kNR + j] = B(sliver * kNR + j, i_k), zero padded to whole
+// slivers. Every C element accumulates its products in ascending k order like the scalar loop.
+template <typename AccDataType>
+struct fused_moe_gemm
+{
+    static constexpr index_t kMR = 4;
+    static constexpr index_t kNR = 16;
+
+    template <typename LoadB>
+    CK_TILE_HOST static void pack_b(std::vector<AccDataType>& b_packed,
+                                    index_t num_col,
+                                    index_t k_len,
+                                    const LoadB& load_b)
+    {
+        const index_t num_sliver = integer_divide_ceil(num_col, kNR);
+
+        b_packed.assign(static_cast<std::size_t>(num_sliver) * k_len * kNR, AccDataType{0});
+
+        for(index_t i_n = 0; i_n < num_col; ++i_n)
+        {
+            AccDataType* sliver = b_packed.data() + (i_n / kNR) * k_len * kNR + i_n % kNR;
+
+            for(index_t i_k = 0; i_k < k_len; ++i_k)
+                sliver[i_k * kNR] = load_b(i_n, i_k);
+        }
+    }
+
+    // store_c(i_row, i_col, acc) receives every element of the [num_row, num_col] product once
+    template <typename StoreC>
+    CK_TILE_HOST static void run(const AccDataType* a,
+                                 index_t lda,
+                                 index_t num_row,
+                                 const std::vector<AccDataType>& b_packed,
+                                 index_t num_col,
+                                 index_t k_len,
+                                 const StoreC& store_c)
+    {
+        for(index_t i_n0 = 0; i_n0 < num_col; i_n0 += kNR)
+        {
+            const AccDataType* b = b_packed.data() + (i_n0 / kNR) * k_len * kNR;
+            const index_t n_len  = std::min(kNR, num_col - i_n0);
+
+            for(index_t i_m0 = 0; i_m0 < num_row; i_m0 += kMR)
+            {
+                const index_t m_len = std::min(kMR, num_row - i_m0);
+
+                // rows past num_row repeat the last row, their results are discarded
+                const AccDataType* a_rows[kMR];
+                for(index_t i = 0; i < kMR; ++i)
+                    a_rows[i] = a + static_cast<std::size_t>(i_m0 + std::min(i, m_len - 1)) * lda;
+
+                AccDataType acc[kMR][kNR] = {};
+
+                for(index_t i_k = 0; i_k < k_len; ++i_k)
+                {
+                    const AccDataType* b_k = b + i_k * kNR;
+
+                    for(index_t i = 0; i < kMR; ++i)
+                    {
+                        const AccDataType a_ik = a_rows[i][i_k];
+
+                        for(index_t j = 0; j < kNR; ++j)
+                            acc[i][j] += a_ik * b_k[j];
+                    }
+                }
+
+                for(index_t i = 0; i < m_len; ++i)
+                    for(index_t j = 0; j < n_len; ++j)
+                        store_c(i_m0 + i, i_n0 + j, acc[i][j]);
+            }
+        }
+    }
+};
+
+} // namespace detail
+
+// The rows of the sorted token ids are grouped by expert over all block_m tiles of the expert,
+// and each expert runs as two blocked GEMMs:
+//   Y = act(A_e G_gate^T) * (A_e G_up^T)   (or act(A_e G^T) if gate_only)
+//   O_topk = weight * (Y D^T)
+// where A_e gathers the token rows of the expert. Every column panel of G/D is converted to
+// AccDataType and packed once per expert instead of once per token, the panels are distributed
+// over the host thread pool and each chunk of panels reuses its own packing scratch. The
+// (token, expert) -> topk inverse map is built once from token_ids_host.
+//
+// Every output element accumulates its products in the same order as the former row-by-row
+// loop, so the result does not depend on the blocking or the number of threads. The scale
+// tensors are not used (yet).
 template <typename AccDataType, // you only need to explcitly set this one
           typename Activation,  // ck_tile::element_wise::Gelu
           typename ADataType,
@@ -77,6 +178,11 @@ void reference_fused_moe(
     ck_tile::index_t topk,
     ck_tile::index_t gate_only)
 {
+    // columns of G (per gate and up) and D converted and packed at a time
+    constexpr ck_tile::index_t kPanelN = 64;
+
+    using gemm = detail::fused_moe_gemm<AccDataType>;
+
     assert(sorted_token_ids_host.get_num_of_dimension() == 1);
     assert(sorted_weight_host.get_num_of_dimension() == 1);
     assert(sorted_expert_ids_host.get_num_of_dimension() == 1);
@@ -85,93 +191,197 @@ void reference_fused_moe(
     ck_tile::index_t intermediate_size_0 = intermediate_size;
     ck_tile::index_t intermediate_size_1 = intermediate_size / (gate_only ? 1 : 2);
 
-    // TODO: better remove this in the future, or modify the token_id value
+    if(intermediate_size_1 * (gate_only ? 1 : 2) != intermediate_size_0)
+        throw std::runtime_error(
+            "intermediate_size not correct, 0:" + std::to_string(intermediate_size_0) +
+            ", 1:" + std::to_string(intermediate_size_1));
+
+    // tokens of every expert in ascending order with their topk index, i.e. the inverse of
+    // token_ids_host as a [experts, ...] CSR map
+    std::vector<ck_tile::index_t> expert_token_offsets(experts + 1, 0);
+    std::vector<ck_tile::index_t> expert_tokens(tokens * topk);
+    std::vector<ck_tile::index_t> expert_topk_ids(tokens * topk);
+
+    for(ck_tile::index_t i_token = 0; i_token < tokens; i_token++)
+        for(ck_tile::index_t i_topk = 0; i_topk < topk; i_topk++)
+            expert_token_offsets[token_ids_host(i_token, i_topk) + 1]++;
+
+    std::partial_sum(
+        expert_token_offsets.begin(), expert_token_offsets.end(), expert_token_offsets.begin());
+
+    {
+        std::vector<ck_tile::index_t> next(expert_token_offsets.begin(),
+                                           expert_token_offsets.end() - 1);
+
+        for(ck_tile::index_t i_token = 0; i_token < tokens; i_token++)
+            for(ck_tile::index_t i_topk = 0; i_topk < topk; i_topk++)
+            {
+                const ck_tile::index_t pos = next[token_ids_host(i_token, i_topk)]++;
+
+                expert_tokens[pos]   = i_token;
+                expert_topk_ids[pos] = i_topk;
+            }
+    }
+
     auto get_topk_id = [&](ck_tile::index_t token_id_, ck_tile::index_t expert_id_) {
-        for(ck_tile::index_t i_ = 0; i_ < topk; i_++)
-        {
-            if(token_ids_host(token_id_, i_) == expert_id_)
-                return i_;
-        }
-        throw std::runtime_error("not correct token/expert pair\n");
-        return -1; // TODO: not correct!!
+        const auto first = expert_tokens.begin() + expert_token_offsets[expert_id_];
+        const auto last  = expert_tokens.begin() + expert_token_offsets[expert_id_ + 1];
+        const auto it    = std::lower_bound(first, last, token_id_);
+
+        if(it == last || *it != token_id_)
+            throw std::runtime_error("not correct token/expert pair\n");
+
+        return expert_topk_ids[it - expert_tokens.begin()];
     };
 
+    // the valid sorted rows of every expert, from all of its tiles
+    const ck_tile::index_t max_num_tokens_padded = topk * tokens + experts * block_m - topk;
+    const ck_tile::index_t num_sorted_rows =
+        std::min(max_num_tokens_padded, num_sorted_tiles * block_m);
+
+    std::vector<std::vector<ck_tile::index_t>> expert_rows(experts);
+
+    for(ck_tile::index_t i_flatten = 0; i_flatten < num_sorted_rows; i_flatten++)
+    {
+        const ck_tile::index_t i_expert = sorted_expert_ids_host.mData[i_flatten / block_m];
+        const ck_tile::index_t i_token  = sorted_token_ids_host.mData[i_flatten];
+
+        if(i_token < tokens)
+            expert_rows[i_expert].push_back(i_flatten);
+    }
+
     ck_tile::HostTensor<AccDataType> out_topk_tokens({tokens, topk, hidden_size});
 
-    int max_num_tokens_padded = topk * tokens + experts * block_m - topk;
-    // assert();
-    auto f = [&](auto i_flatten) {
-        ck_tile::index_t i_tile = i_flatten / block_m;
-        if(i_tile >= num_sorted_tiles)
-            return;
-        ck_tile::index_t i_expert = sorted_expert_ids_host.mData[i_tile];
-        ck_tile::index_t i_token  = sorted_token_ids_host.mData[i_flatten];
-        if(i_token >= tokens)
-            return;
-        ck_tile::index_t i_topk = get_topk_id(i_token, i_expert); // TODO: ugly
-        auto weight             = sorted_weight_host.mData[i_flatten];
-
-        ck_tile::HostTensor<AccDataType> acc_0({1, intermediate_size_0});
-        // first gemm
-        for(ck_tile::index_t i_n = 0; i_n < intermediate_size_0; i_n++)
+    auto& pool = host_thread_pool::instance();
+
+    std::vector<AccDataType> a;
+    std::vector<AccDataType> y;
+    std::vector<ck_tile::index_t> row_tokens;
+    std::vector<ck_tile::index_t> row_topk_ids;
+
+    for(ck_tile::index_t i_expert = 0; i_expert < experts; i_expert++)
+    {
+        const auto& rows               = expert_rows[i_expert];
+        const ck_tile::index_t num_row = rows.size();
+
+        if(num_row == 0)
+            continue;
+
+        a.resize(static_cast<std::size_t>(num_row) * hidden_size);
+        y.resize(static_cast<std::size_t>(num_row) * intermediate_size_1);
+        row_tokens.resize(num_row);
+        row_topk_ids.resize(num_row);
+
+        for(ck_tile::index_t r = 0; r < num_row; r++)
         {
-            AccDataType acc = static_cast<AccDataType>(0);
+            const ck_tile::index_t i_token = sorted_token_ids_host.mData[rows[r]];
+
+            row_tokens[r]   = i_token;
+            row_topk_ids[r] = get_topk_id(i_token, i_expert);
+
             for(ck_tile::index_t i_k = 0; i_k < hidden_size; i_k++)
-            {
-                acc += type_convert<AccDataType>(a_host(i_token, i_k)) *
-                       type_convert<AccDataType>(g_host(i_expert, i_n, i_k));
-            }
-            acc_0(0, i_n) = acc;
-            // printf("ie:%2d, it:%3d, in:%d, %f\n", i_expert, i_token, i_n, acc);
+                a[r * hidden_size + i_k] = type_convert<AccDataType>(a_host(i_token, i_k));
         }
 
-        ck_tile::HostTensor<AccDataType> y({1, intermediate_size_1});
-        if(gate_only)
-        {
-            if(intermediate_size_1 != intermediate_size_0)
-                throw std::runtime_error(
-                    "intermediate_size not correct, 0:" + std::to_string(intermediate_size_0) +
-                    ", 1:" + std::to_string(intermediate_size_1));
-            for(ck_tile::index_t i_n = 0; i_n < intermediate_size_1; i_n++)
-            {
-                Activation{}(y(0, i_n), acc_0(0, i_n));
-                // printf("ie:%2d, it:%3d, in:%d, %f\n", i_expert, i_token, i_n, y(0, i_n));
-            }
-        }
-        else
-        {
-            if(intermediate_size_1 * 2 != intermediate_size_0)
-                throw std::runtime_error(
-                    "intermediate_size not correct, 0:" + std::to_string(intermediate_size_0) +
-                    ", 1:" + std::to_string(intermediate_size_1));
-            for(ck_tile::index_t i_n = 0; i_n < intermediate_size_1; i_n++)
-            {
-                AccDataType tmp;
-                Activation{}(tmp, acc_0(0, i_n));
-                y(0, i_n) = tmp * acc_0(0, i_n + intermediate_size_1); // TODO: elementwise mul
-            }
-        }
+        // first gemm and activation, gate and up columns of a panel are packed together
+        pool.parallel_for(
+            integer_divide_ceil(intermediate_size_1, kPanelN),
+            0,
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<AccDataType> g_packed;
 
-        // second gemm, loop along gemm-n
-        ck_tile::HostTensor<AccDataType> acc_1({1, hidden_size});
-        for(ck_tile::index_t i_n = 0; i_n < hidden_size; i_n++)
-        {
-            AccDataType acc = static_cast<AccDataType>(0);
-            for(ck_tile::index_t i_k = 0; i_k < intermediate_size_1; i_k++)
-            {
-                acc += y(0, i_k) * type_convert<AccDataType>(d_host(i_expert, i_n, i_k));
-            }
-            acc_1(0, i_n) = acc * weight; // multiple weight here
-        }
+                for(std::size_t i_panel = begin; i_panel < end; i_panel++)
+                {
+                    const ck_tile::index_t i_n0  = i_panel * kPanelN;
+                    const ck_tile::index_t n_len = std::min(kPanelN, intermediate_size_1 - i_n0);
+                    const ck_tile::index_t n_pad =
+                        integer_divide_ceil(n_len, gemm::kNR) * gemm::kNR;
 
-        for(ck_tile::index_t i_n = 0; i_n < hidden_size; i_n++)
-        {
-            out_topk_tokens(i_token, i_topk, i_n) = acc_1(0, i_n);
-        }
-    };
+                    // gate columns [0, n_len), up columns [n_pad, n_pad + n_len)
+                    gemm::pack_b(g_packed,
+                                 gate_only ? n_len : n_pad + n_len,
+                                 hidden_size,
+                                 [&](ck_tile::index_t i_n, ck_tile::index_t i_k) {
+                                     if(i_n < n_len)
+                                         return type_convert<AccDataType>(
+                                             g_host(i_expert, i_n0 + i_n, i_k));
+                                     if(i_n < n_pad)
+                                         return AccDataType{0};
+                                     return type_convert<AccDataType>(g_host(
+                                         i_expert, intermediate_size_1 + i_n0 + i_n - n_pad, i_k));
+                                 });
+
+                    if(gate_only)
+                    {
+                        gemm::run(a.data(),
+                                  hidden_size,
+                                  num_row,
+                                  g_packed,
+                                  n_len,
+                                  hidden_size,
+                                  [&](ck_tile::index_t r, ck_tile::index_t i_n, AccDataType acc) {
+                                      Activation{}(y[r * intermediate_size_1 + i_n0 + i_n], acc);
+                                  });
+                        continue;
+                    }
+
+                    // act(gate) first, then multiplied by up
+                    gemm::run(a.data(),
+                              hidden_size,
+                              num_row,
+                              g_packed,
+                              n_pad + n_len,
+                              hidden_size,
+                              [&](ck_tile::index_t r, ck_tile::index_t i_n, AccDataType acc) {
+                                  if(i_n < n_len)
+                                  {
+                                      Activation{}(y[r * intermediate_size_1 + i_n0 + i_n], acc);
+                                  }
+                                  else if(i_n >= n_pad)
+                                  {
+                                      y[r * intermediate_size_1 + i_n0 + i_n - n_pad] *= acc;
+                                  }
+                              });
+                }
+            },
+            1);
+
+        // second gemm, weighted by the topk weight of the row
+        pool.parallel_for(
+            integer_divide_ceil(hidden_size, kPanelN),
+            0,
+            [&](std::size_t begin, std::size_t end) {
+                std::vector<AccDataType> d_packed;
+
+                for(std::size_t i_panel = begin; i_panel < end; i_panel++)
+                {
+                    const ck_tile::index_t i_n0  = i_panel * kPanelN;
+                    const ck_tile::index_t n_len = std::min(kPanelN, hidden_size - i_n0);
+
+                    gemm::pack_b(d_packed,
+                                 n_len,
+                                 intermediate_size_1,
+                                 [&](ck_tile::index_t i_n, ck_tile::index_t i_k) {
+                                     return type_convert<AccDataType>(
+                                         d_host(i_expert, i_n0 + i_n, i_k));
+                                 });
+
+                    gemm::run(y.data(),
+                              intermediate_size_1,
+                              num_row,
+                              d_packed,
+                              n_len,
+                              intermediate_size_1,
+                              [&](ck_tile::index_t r, ck_tile::index_t i_n, AccDataType acc) {
+                                  const auto weight = sorted_weight_host.mData[rows[r]];
 
-    // make_ParallelTensorFunctor(f, max_num_tokens_padded)(std::thread::hardware_concurrency());
-    make_ParallelTensorFunctor(f, max_num_tokens_padded)(1);
+                                  out_topk_tokens(row_tokens[r], row_topk_ids[r], i_n0 + i_n) =
+                                      acc * weight;
+                              });
+                }
+            },
+            1);
+    }
 
     // reduce
     auto r = [&](auto i_token) {
@@ -5,91 +5,177 @@
 
 #include "ck_tile/core.hpp"
 #include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
 
 namespace ck_tile {
 
 #define MOE_SORTING_MOCK_ID(token_id_, topk_id_) \
     static_cast<uint32_t>(((token_id_)&0x00ffffff) | (((topk_id_)&0xff) << 24))
 
+// MoE sorting of the [num_token, topk] expert ids and weights on the host, usable as a CPU
+// routing path. The (token, topk) pairs of every expert are stored in token order in whole units
+// of unit_size ids, padded with the id num_token and the weight 0. Every expert has at least one
+// unit, sorted_expert_ids holds the expert of every unit. Row t of the inputs starts at element
+// t * stride_token, the topk dimension is contiguous. Returns the number of units.
+//
+// This is a counting sort: the tokens are split into chunks, the experts of each chunk are
+// counted in parallel, a prefix sum over (expert, chunk) gives every chunk its output positions
+// and the chunks scatter their ids in parallel. The order within an expert is the token order
+// regardless of the number of threads.
 template <typename WeightType, typename IndexType = index_t>
-CK_TILE_HOST void reference_moe_sorting(const HostTensor<IndexType>& topk_ids,
-                                        const HostTensor<WeightType>& weights,
-                                        HostTensor<IndexType>& p_sorted_token_ids,
-                                        HostTensor<WeightType>& sorted_weight,
-                                        HostTensor<IndexType>& sorted_expert_ids,
-                                        index_t& unit_cnt,
-                                        const index_t experts,
-                                        const index_t unit_size)
+CK_TILE_HOST index_t moe_sorting_host(const IndexType* topk_ids,
+                                      const WeightType* weights,
+                                      IndexType* sorted_token_ids,
+                                      WeightType* sorted_weight,
+                                      IndexType* sorted_expert_ids,
+                                      const index_t num_token,
+                                      const index_t topk,
+                                      const index_t stride_token,
+                                      const index_t experts,
+                                      const index_t unit_size,
+                                      const std::size_t max_thread = 0)
 {
-    const index_t num_token = topk_ids.mDesc.get_lengths()[0];
-    const index_t topk      = topk_ids.mDesc.get_lengths()[1];
-    // allocate a temp buffer, and fill the value with [number_token|topk]
-    std::vector<std::vector<IndexType>> expert_tokens(
-        experts,
+    constexpr index_t kMinTokensPerChunk = 1024;
+
+    auto& pool = host_thread_pool::instance();
+
+    const std::size_t num_thread =
+        max_thread > 0 ? std::min(max_thread, pool.get_num_threads()) : pool.get_num_threads();
+
+    // a few chunks per thread for load balancing, but enough tokens per chunk to amortize the
+    // [num_chunk, experts] counts
+    const index_t max_chunk = static_cast<index_t>(num_thread * 4);
+    const index_t num_chunk =
+        std::clamp<index_t>(integer_divide_ceil(num_token, kMinTokensPerChunk), 1, max_chunk);
+    const index_t tokens_per_chunk = integer_divide_ceil(num_token, num_chunk);
+
+    // [num_chunk, experts] counts, then the output position of the next id of the chunk
+    std::vector<index_t> chunk_offsets(static_cast<std::size_t>(num_chunk) * experts, 0);
+
+    pool.parallel_for(
+        num_chunk,
+        max_thread,
+        [&](std::size_t begin, std::size_t end) {
+            for(std::size_t c = begin; c < end; ++c)
+            {
+                index_t* counts       = chunk_offsets.data() + c * experts;
+                const index_t t_begin = static_cast<index_t>(c) * tokens_per_chunk;
+                const index_t t_end   = std::min(t_begin + tokens_per_chunk, num_token);
+
+                for(index_t t = t_begin; t < t_end; ++t)
+                    for(index_t k = 0; k < topk; ++k)
+                        ++counts[topk_ids[t * stride_token + k]];
+            }
+        },
+        1);
+
+    // the first unit and the number of ids of every expert
+    std::vector<index_t> expert_units(experts + 1, 0);
+    std::vector<index_t> expert_counts(experts, 0);
+
+    for(index_t e = 0; e < experts; ++e)
+    {
+        index_t offset = expert_units[e] * unit_size;
+
+        for(index_t c = 0; c < num_chunk; ++c)
+        {
+            const index_t count = chunk_offsets[c * experts + e];
+
+            chunk_offsets[c * experts + e] = offset;
+            offset += count;
+            expert_counts[e] += count;
+        }
+
+        expert_units[e + 1] =
+            expert_units[e] + std::max(integer_divide_ceil(expert_counts[e], unit_size), 1);
+    }
+
+    // padding and expert ids of the units
+    pool.parallel_for(experts, max_thread, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t e = begin; e < end; ++e)
+        {
 #if CK_TILE_REFERENCE_MOE_SORTING_MOCK_ID
-        std::vector<IndexType>(unit_size, MOE_SORTING_MOCK_ID(num_token, topk)));
+            const IndexType padding_id = MOE_SORTING_MOCK_ID(num_token, topk);
 #else
-        std::vector<IndexType>(unit_size, num_token));
+            const IndexType padding_id = num_token;
 #endif
-    std::vector<std::vector<WeightType>> expert_token_weights(
-        experts, std::vector<WeightType>(unit_size, 0));
-    std::vector<IndexType> expert_slices(experts, 1);
-    std::vector<IndexType> expert_slice_idxs(experts, 0);
+            const index_t pad_begin = expert_units[e] * unit_size + expert_counts[e];
+            const index_t pad_end   = expert_units[e + 1] * unit_size;
 
-    for(index_t t = 0; t < num_token; t++)
-    {
-        for(index_t k = 0; k < topk; k++)
-        {
-            IndexType e  = topk_ids(t, k);
-            WeightType w = weights(t, k);
-            index_t idx  = expert_slice_idxs[e];
-            if(idx > expert_slices[e] * unit_size - 1)
+            std::fill(sorted_token_ids + pad_begin, sorted_token_ids + pad_end, padding_id);
+            std::fill(sorted_weight + pad_begin, sorted_weight + pad_end, WeightType(0));
+            std::fill(sorted_expert_ids + expert_units[e],
+                      sorted_expert_ids + expert_units[e + 1],
+                      static_cast<IndexType>(e));
+        }
+    });
+
+    pool.parallel_for(
+        num_chunk,
+        max_thread,
+        [&](std::size_t begin, std::size_t end) {
+            for(std::size_t c = begin; c < end; ++c)
             {
-                expert_slices[e]++;
-                index_t new_size = expert_slices[e] * unit_size;
-                expert_tokens[e].resize(new_size);
-                expert_token_weights[e].resize(new_size);
-                for(index_t i = (expert_slices[e] - 1) * unit_size; i < new_size; i++)
+                index_t* offsets      = chunk_offsets.data() + c * experts;
+                const index_t t_begin = static_cast<index_t>(c) * tokens_per_chunk;
+                const index_t t_end   = std::min(t_begin + tokens_per_chunk, num_token);
+
+                for(index_t t = t_begin; t < t_end; ++t)
                 {
+                    for(index_t k = 0; k < topk; ++k)
+                    {
+                        const index_t pos = offsets[topk_ids[t * stride_token + k]]++;
+
 #if CK_TILE_REFERENCE_MOE_SORTING_MOCK_ID
-                    expert_tokens[e][i] = MOE_SORTING_MOCK_ID(num_token, topk);
+                        sorted_token_ids[pos] = MOE_SORTING_MOCK_ID(t, k);
 #else
-                    expert_tokens[e][i] = num_token;
+                        sorted_token_ids[pos] = t;
 #endif
-                    expert_token_weights[e][i] = 0;
+                        sorted_weight[pos] = weights[t * stride_token + k];
+                    }
                 }
             }
-#if CK_TILE_REFERENCE_MOE_SORTING_MOCK_ID
-            expert_tokens[e][idx] = MOE_SORTING_MOCK_ID(t, k);
-#else
-            expert_tokens[e][idx] = t;
-#endif
-            expert_token_weights[e][idx] = w;
-            expert_slice_idxs[e]++;
-        }
-    }
+        },
+        1);
 
-    IndexType* out_tokens    = p_sorted_token_ids.data();
-    WeightType* out_weights  = sorted_weight.data();
-    IndexType* out_expert_id = sorted_expert_ids.data();
-    for(index_t e = 0; e < experts; e++)
-    {
-        memcpy(out_tokens, expert_tokens[e].data(), sizeof(index_t) * expert_slices[e] * unit_size);
-        out_tokens += expert_slices[e] * unit_size;
-        memcpy(out_weights,
-               expert_token_weights[e].data(),
-               sizeof(WeightType) * expert_slices[e] * unit_size);
-        out_weights += expert_slices[e] * unit_size;
-
-        for(index_t s = 0; s < expert_slices[e]; s++)
-        {
-            out_expert_id[s] = e;
-            unit_cnt++;
-        }
-        out_expert_id += expert_slices[e];
-    }
+    return expert_units[experts];
+}
+
+// unit_cnt is incremented by the number of units and then multiplied by unit_size, i.e. it
+// returns the number of sorted ids including the padding if it is 0 on entry
+template <typename WeightType, typename IndexType = index_t>
+CK_TILE_HOST void reference_moe_sorting(const HostTensor<IndexType>& topk_ids,
+                                        const HostTensor<WeightType>& weights,
+                                        HostTensor<IndexType>& p_sorted_token_ids,
+                                        HostTensor<WeightType>& sorted_weight,
+                                        HostTensor<IndexType>& sorted_expert_ids,
+                                        index_t& unit_cnt,
+                                        const index_t experts,
+                                        const index_t unit_size)
+{
+    const index_t num_token = topk_ids.mDesc.get_lengths()[0];
+    const index_t topk      = topk_ids.mDesc.get_lengths()[1];
+
+    if(topk_ids.mDesc.get_strides() != weights.mDesc.get_strides() ||
+       (topk > 1 && topk_ids.mDesc.get_strides()[1] != 1))
+        throw std::runtime_error("wrong! topk_ids and weights must have the same row-major layout");
+
+    unit_cnt += moe_sorting_host(topk_ids.data(),
+                                 weights.data(),
+                                 p_sorted_token_ids.data(),
+                                 sorted_weight.data(),
+                                 sorted_expert_ids.data(),
+                                 num_token,
+                                 topk,
+                                 static_cast<index_t>(topk_ids.mDesc.get_strides()[0]),
+                                 experts,
+                                 unit_size);
     unit_cnt *= unit_size;
-    return;
 }
 
 #undef MOE_SORTING_MOCK_ID
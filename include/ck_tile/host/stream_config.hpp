@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "ck_tile/host/timing_statistics.hpp"
 #include <hip/hip_runtime.h>
 
 namespace ck_tile {
@@ -20,6 +21,10 @@ namespace ck_tile {
  *
  *   // create stream config with _some_stream_id_, and benchmark using cpu timer
  *   stream_config s = stream_config{_some_stream_id_, true, 0, 3, 10, false};
+ *
+ *   // create stream config with _some_stream_id_, and benchmark until the 95% confidence interval
+ *   // of the median is within 2% of the median
+ *   stream_config s = stream_config{_some_stream_id_, true, 0, 3, 10, true, true, 0.02f};
  **/
 
 struct stream_config
@@ -30,5 +35,14 @@ struct stream_config
     int cold_niters_       = 3;
     int nrepeat_           = 10;
     bool is_gpu_timer_     = true; // keep compatible
+
+    // With adaptive timing, launches are timed in samples until the confidence interval of the
+    // median is within target_relative_ci_ of the median, taking between nrepeat_ and
+    // max_nrepeat_ samples, and the median is returned instead of the mean. The statistics of
+    // the samples are stored to *timing_summary_ if it is set.
+    bool adaptive_timing_           = false;
+    float target_relative_ci_       = 0.01f;
+    int max_nrepeat_                = 1000;
+    timing_summary* timing_summary_ = nullptr;
 };
 } // namespace ck_tile
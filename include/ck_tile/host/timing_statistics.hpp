@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core/config.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ck_tile {
+
+// Settings of adaptive timing. Samples are taken until the confidence interval of the median is
+// within target_relative_ci of the median, but at least min_samples and at most max_samples.
+struct timing_config
+{
+    int min_samples = 10;
+    int max_samples = 1000;
+    // the confidence interval is re-evaluated every check_interval samples
+    int check_interval       = 10;
+    float target_relative_ci = 0.01f;
+    // z value of the confidence level, 1.96 for 95 %
+    float confidence_z = 1.96f;
+    // samples with a modified z-score above this are outliers
+    float outlier_threshold = 3.5f;
+};
+
+// Statistics of the samples of a timing, all times in ms. The percentiles and the confidence
+// interval are computed after rejecting outliers.
+struct timing_summary
+{
+    float mean    = 0;
+    float median  = 0;
+    float p10     = 0;
+    float p90     = 0;
+    float min     = 0;
+    float max     = 0;
+    float ci_low  = 0;
+    float ci_high = 0;
+
+    int num_samples  = 0;
+    int num_outliers = 0;
+    // number of timed launches, run_adaptive_timing counts one per sample
+    int num_launches = 0;
+    bool converged   = false;
+
+    // half the width of the confidence interval relative to the median
+    CK_TILE_HOST float get_relative_ci() const
+    {
+        return median > 0 ? (ci_high - ci_low) / (2 * median) : 0;
+    }
+};
+
+// linearly interpolated percentile p in [0, 1] of sorted samples
+CK_TILE_HOST float get_percentile(const std::vector<float>& sorted, float p)
+{
+    if(sorted.empty())
+        return 0;
+
+    const float pos  = p * (sorted.size() - 1);
+    const auto lower = static_cast<std::size_t>(pos);
+    const auto upper = std::min(lower + 1, sorted.size() - 1);
+
+    return sorted[lower] + (pos - lower) * (sorted[upper] - sorted[lower]);
+}
+
+// Rejects outliers and summarizes the remaining samples, the same statistics as
+// ck::utility::SummarizeTimings: outliers have a modified z-score 0.6745 * |x - median| / MAD
+// above the threshold, and the order statistics at ranks n / 2 -+ z * sqrt(n) / 2 bound the
+// median with the given confidence.
+CK_TILE_HOST timing_summary summarize_timings(std::vector<float> samples,
+                                              const timing_config& config)
+{
+    timing_summary summary;
+
+    if(samples.empty())
+        return summary;
+
+    std::sort(samples.begin(), samples.end());
+
+    const float median = get_percentile(samples, 0.5f);
+
+    std::vector<float> deviations(samples.size());
+
+    std::transform(samples.begin(), samples.end(), deviations.begin(), [&](float x) {
+        return std::abs(x - median);
+    });
+    std::sort(deviations.begin(), deviations.end());
+
+    const float mad = get_percentile(deviations, 0.5f);
+
+    if(mad > 0)
+    {
+        const auto is_outlier = [&](float x) {
+            return 0.6745f * std::abs(x - median) / mad > config.outlier_threshold;
+        };
+
+        const auto num_samples = samples.size();
+
+        samples.erase(std::remove_if(samples.begin(), samples.end(), is_outlier), samples.end());
+
+        summary.num_outliers = static_cast<int>(num_samples - samples.size());
+    }
+
+    const auto n = samples.size();
+
+    summary.num_samples = static_cast<int>(n);
+    summary.median      = get_percentile(samples, 0.5f);
+    summary.p10         = get_percentile(samples, 0.1f);
+    summary.p90         = get_percentile(samples, 0.9f);
+    summary.min         = samples.front();
+    summary.max         = samples.back();
+
+    double sum = 0;
+
+    for(float x : samples)
+        sum += x;
+
+    summary.mean = static_cast<float>(sum / n);
+
+    const double half_width = config.confidence_z * std::sqrt(static_cast<double>(n)) / 2;
+    const double low_rank   = std::floor(n / 2.0 - half_width);
+    const double high_rank  = std::ceil(n / 2.0 + half_width);
+
+    summary.ci_low  = samples[static_cast<std::size_t>(std::max(low_rank, 0.0))];
+    summary.ci_high = samples[static_cast<std::size_t>(std::min(high_rank, n - 1.0))];
+
+    // with too few samples the ranks are clamped and the interval has a lower confidence
+    summary.converged = low_rank >= 0 && high_rank <= n - 1.0 &&
+                        summary.get_relative_ci() <= config.target_relative_ci;
+
+    return summary;
+}
+
+// Calls sample() for samples in ms until the confidence interval of the median reaches the
+// target of config or max_samples are taken, and returns the summary of the samples.
+template <typename SampleFunc>
+CK_TILE_HOST timing_summary run_adaptive_timing(const timing_config& config, SampleFunc&& sample)
+{
+    const int min_samples    = std::max(config.min_samples, 1);
+    const int max_samples    = std::max(config.max_samples, min_samples);
+    const int check_interval = std::max(config.check_interval, 1);
+
+    std::vector<float> samples;
+
+    samples.reserve(max_samples);
+
+    while(static_cast<int>(samples.size()) < max_samples)
+    {
+        samples.push_back(sample());
+
+        const int num_samples = static_cast<int>(samples.size());
+
+        if(num_samples >= min_samples && (num_samples - min_samples) % check_interval == 0 &&
+           summarize_timings(samples, config).converged)
+            break;
+    }
+
+    auto summary         = summarize_timings(samples, config);
+    summary.num_launches = static_cast<int>(samples.size());
+
+    return summary;
+}
+
+} // namespace ck_tile
@@ -0,0 +1,355 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include "ck_tile/core.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <vector>
+
+// Host planner for the number of key/value splits of the split-KV forward attention.
+//
+// The split kernel launches one workgroup per (sequence, query tile, head, hdim_v tile, split),
+// the combine kernel one per (sequence, query tile, head, hdim_v tile) to merge the splits. In
+// group (varlen) mode a single split count does not fit sequences of very different seqlen_k: the
+// long sequences decide the kernel time while the short ones pay for combining splits they do not
+// need. The planner picks the split count of every sequence from a cost model, in units of the
+// time one workgroup spends on one kN0 key tile:
+//
+//   split workgroup      workgroup_overhead + number of key tiles of the split
+//   combine workgroup    combine_cost_per_split * number of splits
+//
+// Workgroups are dispatched in order to the next free slot of num_cu * block_per_cu slots, so a
+// kernel takes about total_cost / slots plus the tail of its longest workgroup. The planner
+// minimizes this estimate for the split plus the combine kernel over the maximum split length.
+namespace ck_tile {
+
+struct FmhaFwdSplitKVPlannerArgs
+{
+    std::vector<index_t> seqlen_qs; // per sequence
+    std::vector<index_t> seqlen_ks; // per sequence
+
+    index_t nhead_q;
+    index_t hdim_v;
+
+    index_t num_cu;
+    index_t block_per_cu = 1; // workgroups one CU runs concurrently
+
+    // tile sizes of the split kernel
+    index_t kM0;
+    index_t kN0;
+    index_t kN1;
+
+    // splits start at multiples of the page size of a paged kv-cache, 0 if not paged
+    index_t page_block_size = 0;
+    index_t max_splits      = 128;
+
+    float workgroup_overhead     = 1.f;
+    float combine_cost_per_split = 0.25f;
+
+    // use the same number of splits for all sequences, as kargs.num_splits of the current
+    // split-KV kernel does
+    bool uniform_splits = false;
+};
+
+// A split of the key range of one query tile. The split kernel runs it for every head and hdim_v
+// tile.
+struct FmhaFwdSplitKVWorkItem
+{
+    index_t i_batch;
+    index_t i_tile_m;
+    index_t i_split;
+    index_t seqlen_k_start;
+    index_t seqlen_k_end;
+    float cost;
+};
+
+struct FmhaFwdSplitKVPlan
+{
+    std::vector<index_t> num_splits; // per sequence
+    index_t max_num_splits = 1;
+
+    // work items of the split kernel, longest first
+    std::vector<FmhaFwdSplitKVWorkItem> work;
+
+    // estimated time of the split plus the combine kernel the plan was chosen by
+    float estimated_time = 0;
+};
+
+struct FmhaFwdSplitKVSimulation
+{
+    index_t num_workgroups = 0;
+    float split_time       = 0;
+    float combine_time     = 0;
+    // busy time of the slots over their time to finish the split kernel
+    float wave_efficiency = 0;
+    // key tiles of the unsplit problem over the time of the slots to finish the split and the
+    // combine kernel
+    float efficiency = 0;
+};
+
+namespace detail {
+
+// keys per split granule: whole key tiles that do not straddle a page. The current kernel splits
+// the keys evenly with a granule of 1
+CK_TILE_HOST index_t splitkv_granule(const FmhaFwdSplitKVPlannerArgs& args)
+{
+    if(args.uniform_splits)
+        return 1;
+
+    return args.page_block_size > 0 ? std::lcm(args.kN0, args.page_block_size) : args.kN0;
+}
+
+// splits the keys of a sequence into num_splits granule aligned ranges of equal length, the last
+// ones may be empty
+template <typename F>
+CK_TILE_HOST void for_each_splitkv_range(index_t seqlen_k, index_t num_splits, index_t granule, F f)
+{
+    const index_t num_granules = integer_divide_ceil(seqlen_k, granule);
+    const index_t keys_per_split =
+        integer_divide_ceil(std::max(num_granules, index_t{1}), num_splits) * granule;
+
+    for(index_t i_split = 0; i_split < num_splits; ++i_split)
+    {
+        const index_t start = std::min(i_split * keys_per_split, seqlen_k);
+        const index_t end   = std::min(start + keys_per_split, seqlen_k);
+
+        f(i_split, start, end);
+    }
+}
+
+CK_TILE_HOST float splitkv_workgroup_cost(const FmhaFwdSplitKVPlannerArgs& args,
+                                          index_t seqlen_k_start,
+                                          index_t seqlen_k_end)
+{
+    return args.workgroup_overhead +
+           static_cast<float>(integer_divide_ceil(seqlen_k_end - seqlen_k_start, args.kN0));
+}
+
+// total time of num_workgroups workgroups of cost at most max_cost on the slots, see above
+CK_TILE_HOST float
+estimate_kernel_time(double total_cost, float max_cost, const FmhaFwdSplitKVPlannerArgs& args)
+{
+    const index_t num_slots = args.num_cu * args.block_per_cu;
+
+    return static_cast<float>(total_cost / num_slots) + max_cost * (1.f - 1.f / num_slots);
+}
+
+} // namespace detail
+
+// returns the split kernel work items of num_splits splits per sequence, longest first
+CK_TILE_HOST std::vector<FmhaFwdSplitKVWorkItem>
+make_fmha_fwd_splitkv_work(const FmhaFwdSplitKVPlannerArgs& args,
+                           const std::vector<index_t>& num_splits)
+{
+    const index_t granule = detail::splitkv_granule(args);
+
+    std::vector<FmhaFwdSplitKVWorkItem> work;
+
+    for(index_t i_batch = 0; i_batch < static_cast<index_t>(args.seqlen_qs.size()); ++i_batch)
+    {
+        const index_t num_tile_m = integer_divide_ceil(args.seqlen_qs[i_batch], args.kM0);
+
+        for(index_t i_tile_m = 0; i_tile_m < num_tile_m; ++i_tile_m)
+        {
+            detail::for_each_splitkv_range(
+                args.seqlen_ks[i_batch],
+                num_splits[i_batch],
+                granule,
+                [&](index_t i_split, index_t start, index_t end) {
+                    work.push_back({i_batch,
+                                    i_tile_m,
+                                    i_split,
+                                    start,
+                                    end,
+                                    detail::splitkv_workgroup_cost(args, start, end)});
+                });
+        }
+    }
+
+    std::stable_sort(work.begin(), work.end(), [](const auto& x, const auto& y) {
+        return x.cost > y.cost;
+    });
+
+    return work;
+}
+
+// Picks the number of splits of every sequence, see the cost model above. Every split is at most
+// L granules long for the L minimizing the estimated time; with uniform_splits the number of
+// splits of the longest sequence is used for all of them.
+CK_TILE_HOST FmhaFwdSplitKVPlan make_fmha_fwd_splitkv_plan(const FmhaFwdSplitKVPlannerArgs& args)
+{
+    const index_t batch   = static_cast<index_t>(args.seqlen_qs.size());
+    const index_t granule = detail::splitkv_granule(args);
+    // the split kernel runs each work item for every head and hdim_v tile
+    const double copies =
+        static_cast<double>(args.nhead_q) * integer_divide_ceil(args.hdim_v, args.kN1);
+
+    std::vector<index_t> num_granules(batch);
+    std::vector<index_t> num_tile_m(batch);
+
+    for(index_t i_batch = 0; i_batch < batch; ++i_batch)
+    {
+        num_granules[i_batch] =
+            std::max(integer_divide_ceil(args.seqlen_ks[i_batch], granule), index_t{1});
+        num_tile_m[i_batch] = integer_divide_ceil(args.seqlen_qs[i_batch], args.kM0);
+    }
+
+    const index_t max_num_granules =
+        batch > 0 ? *std::max_element(num_granules.begin(), num_granules.end()) : 1;
+
+    FmhaFwdSplitKVPlan best;
+    std::vector<index_t> num_splits(batch);
+
+    // candidate maximum split lengths in granules, from long to short so that ties keep the
+    // fewest splits
+    std::vector<index_t> split_lengths;
+
+    for(index_t split_length = max_num_granules; split_length > 0; --split_length)
+    {
+        if(args.uniform_splits)
+        {
+            // only the number of splits of the longest sequence matters
+            const index_t splits = integer_divide_ceil(max_num_granules, split_length);
+
+            if(splits > args.max_splits)
+                break;
+
+            split_length = integer_divide_ceil(max_num_granules, splits);
+        }
+        split_lengths.push_back(split_length);
+    }
+
+    for(index_t split_length : split_lengths)
+    {
+        const index_t uniform_splits = std::min(
+            integer_divide_ceil(max_num_granules, split_length), args.max_splits);
+
+        double split_work   = 0;
+        double combine_work = 0;
+        float max_split     = 0;
+        float max_combine   = 0;
+
+        for(index_t i_batch = 0; i_batch < batch; ++i_batch)
+        {
+            num_splits[i_batch] =
+                args.uniform_splits
+                    ? uniform_splits
+                    : std::min(integer_divide_ceil(num_granules[i_batch], split_length),
+                               args.max_splits);
+
+            detail::for_each_splitkv_range(
+                args.seqlen_ks[i_batch],
+                num_splits[i_batch],
+                granule,
+                [&](index_t, index_t start, index_t end) {
+                    const float cost = detail::splitkv_workgroup_cost(args, start, end);
+
+                    split_work += cost * num_tile_m[i_batch] * copies;
+                    max_split = std::max(max_split, num_tile_m[i_batch] > 0 ? cost : 0.f);
+                });
+
+            if(num_splits[i_batch] > 1 || (args.uniform_splits && uniform_splits > 1))
+            {
+                const float cost = args.combine_cost_per_split * num_splits[i_batch];
+
+                combine_work += cost * num_tile_m[i_batch] * copies;
+                max_combine = std::max(max_combine, cost);
+            }
+        }
+
+        const float time = detail::estimate_kernel_time(split_work, max_split, args) +
+                           (combine_work > 0
+                                ? detail::estimate_kernel_time(combine_work, max_combine, args)
+                                : 0.f);
+
+        if(best.num_splits.empty() || time < best.estimated_time)
+        {
+            best.num_splits     = num_splits;
+            best.estimated_time = time;
+        }
+    }
+
+    best.max_num_splits =
+        batch > 0 ? *std::max_element(best.num_splits.begin(), best.num_splits.end()) : 1;
+    best.work = make_fmha_fwd_splitkv_work(args, best.num_splits);
+
+    return best;
+}
+
+// Dispatches the workgroups of the plan in order to the next free slot and returns the time of
+// the split and the combine kernel in the units of the cost model.
+CK_TILE_HOST FmhaFwdSplitKVSimulation
+simulate_fmha_fwd_splitkv(const FmhaFwdSplitKVPlan& plan, const FmhaFwdSplitKVPlannerArgs& args)
+{
+    const index_t num_slots = args.num_cu * args.block_per_cu;
+    const index_t copies    = args.nhead_q * integer_divide_ceil(args.hdim_v, args.kN1);
+
+    // returns the time the last slot finishes
+    const auto schedule = [&](const auto& costs) {
+        std::priority_queue<float, std::vector<float>, std::greater<float>> slots;
+
+        for(index_t i = 0; i < num_slots; ++i)
+            slots.push(0.f);
+
+        float time = 0;
+
+        for(float cost : costs)
+        {
+            for(index_t i = 0; i < copies; ++i)
+            {
+                const float finish = slots.top() + cost;
+
+                slots.pop();
+                slots.push(finish);
+                time = std::max(time, finish);
+            }
+        }
+        return time;
+    };
+
+    FmhaFwdSplitKVSimulation result;
+
+    std::vector<float> split_costs;
+    std::vector<float> combine_costs;
+    double split_work = 0;
+    double key_tiles  = 0;
+
+    for(index_t i_batch = 0; i_batch < static_cast<index_t>(args.seqlen_qs.size()); ++i_batch)
+    {
+        key_tiles += static_cast<double>(integer_divide_ceil(args.seqlen_qs[i_batch], args.kM0)) *
+                     integer_divide_ceil(args.seqlen_ks[i_batch], args.kN0) * copies;
+    }
+
+    for(const auto& item : plan.work)
+    {
+        split_costs.push_back(item.cost);
+        split_work += static_cast<double>(item.cost) * copies;
+
+        if(item.i_split == 0 && plan.max_num_splits > 1 &&
+           (plan.num_splits[item.i_batch] > 1 || args.uniform_splits))
+        {
+            combine_costs.push_back(args.combine_cost_per_split * plan.num_splits[item.i_batch]);
+        }
+    }
+
+    std::stable_sort(combine_costs.begin(), combine_costs.end(), std::greater<float>{});
+
+    result.num_workgroups  = static_cast<index_t>(plan.work.size()) * copies;
+    result.split_time      = schedule(split_costs);
+    result.combine_time    = schedule(combine_costs);
+
+    if(result.split_time > 0)
+    {
+        result.wave_efficiency = split_work / (num_slots * result.split_time);
+        result.efficiency = key_tiles / (num_slots * (result.split_time + result.combine_time));
+    }
+
+    return result;
+}
+
+} // namespace ck_tile
@@ -56,8 +56,12 @@ struct ReferenceBatchedGemm : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
+            const auto a_g_m_k = arg.a_g_m_k_.template AsView<3>();
+            const auto b_g_k_n = arg.b_g_k_n_.template AsView<3>();
+            const auto c_g_m_n = arg.c_g_m_n_.template AsView<3>();
+
             auto f_gmk_gkn_gmn = [&](auto g, auto m, auto n) {
-                const int K = arg.a_g_m_k_.mDesc.GetLengths()[2];
+                const int K = a_g_m_k.GetLength(2);
 
                 AccDataType v_acc = 0;
 
@@ -66,8 +70,8 @@ struct ReferenceBatchedGemm : public device::BaseOperator
                     ADataType v_a;
                     BDataType v_b;
 
-                    arg.a_element_op_(v_a, arg.a_g_m_k_(g, m, k));
-                    arg.b_element_op_(v_b, arg.b_g_k_n_(g, k, n));
+                    arg.a_element_op_(v_a, a_g_m_k(g, m, k));
+                    arg.b_element_op_(v_b, b_g_k_n(g, k, n));
 
                     v_acc +=
                         ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
@@ -77,7 +81,7 @@ struct ReferenceBatchedGemm : public device::BaseOperator
 
                 arg.c_element_op_(v_c, v_acc);
 
-                arg.c_g_m_n_(g, m, n) = ck::type_convert<CDataType>(v_c);
+                c_g_m_n(g, m, n) = ck::type_convert<CDataType>(v_c);
             };
 
             make_ParallelTensorFunctor(f_gmk_gkn_gmn,
@@ -176,8 +180,12 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
+            const auto a_g0_g1_m_k = arg.a_g0_g1_m_k_.template AsView<4>();
+            const auto b_g0_1_k_n  = arg.b_g0_1_k_n_.template AsView<4>();
+            const auto c_g0_g1_m_n = arg.c_g0_g1_m_n_.template AsView<4>();
+
             auto f_g0g1mk_g01kn_g0g1mn = [&](auto g0, auto g1, auto m, auto n) {
-                const int K = arg.a_g0_g1_m_k_.mDesc.GetLengths()[3];
+                const int K = a_g0_g1_m_k.GetLength(3);
 
                 AccDataType v_acc = 0;
 
@@ -186,8 +194,8 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
                     ADataType v_a;
                     BDataType v_b;
 
-                    arg.a_element_op_(v_a, arg.a_g0_g1_m_k_(g0, g1, m, k));
-                    arg.b_element_op_(v_b, arg.b_g0_1_k_n_(g0, 0, k, n));
+                    arg.a_element_op_(v_a, a_g0_g1_m_k(g0, g1, m, k));
+                    arg.b_element_op_(v_b, b_g0_1_k_n(g0, 0, k, n));
 
                     v_acc +=
                         ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
@@ -197,7 +205,7 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
 
                 arg.c_element_op_(v_c, v_acc);
 
-                arg.c_g0_g1_m_n_(g0, g1, m, n) = ck::type_convert<CDataType>(v_c);
+                c_g0_g1_m_n(g0, g1, m, n) = ck::type_convert<CDataType>(v_c);
             };
 
             make_ParallelTensorFunctor(f_g0g1mk_g01kn_g0g1mn,
@@ -299,9 +307,13 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
+            const auto a_g0_g1_m_k = arg.a_g0_g1_m_k_.template AsView<4>();
+            const auto b_g0_gq_k_n = arg.b_g0_gq_k_n_.template AsView<4>();
+            const auto c_g0_g1_m_n = arg.c_g0_g1_m_n_.template AsView<4>();
+
             auto f_g0g1mk_g0gqkn_g0g1mn = [&](auto g0, auto g1, auto m, auto n) {
-                const int G1 = arg.a_g0_g1_m_k_.mDesc.GetLengths()[1];
-                const int K  = arg.a_g0_g1_m_k_.mDesc.GetLengths()[3];
+                const int G1 = a_g0_g1_m_k.GetLength(1);
+                const int K  = a_g0_g1_m_k.GetLength(3);
 
                 AccDataType v_acc = 0;
 
@@ -310,8 +322,8 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
                     ADataType v_a;
                     BDataType v_b;
 
-                    arg.a_element_op_(v_a, arg.a_g0_g1_m_k_(g0, g1, m, k));
-                    arg.b_element_op_(v_b, arg.b_g0_gq_k_n_(g0, g1 * QueryGroupNumber / G1, k, n));
+                    arg.a_element_op_(v_a, a_g0_g1_m_k(g0, g1, m, k));
+                    arg.b_element_op_(v_b, b_g0_gq_k_n(g0, g1 * QueryGroupNumber / G1, k, n));
 
                     v_acc +=
                         ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
@@ -321,7 +333,7 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
 
                 arg.c_element_op_(v_c, v_acc);
 
-                arg.c_g0_g1_m_n_(g0, g1, m, n) = ck::type_convert<CDataType>(v_c);
+                c_g0_g1_m_n(g0, g1, m, n) = ck::type_convert<CDataType>(v_c);
             };
 
             make_ParallelTensorFunctor(f_g0g1mk_g0gqkn_g0g1mn,
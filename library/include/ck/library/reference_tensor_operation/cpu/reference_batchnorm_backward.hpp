@@ -11,6 +11,7 @@
 #include "ck/utility/math_v2.hpp"
 #include "ck/utility/ignore.hpp"
 #include "ck/library/utility/host_common_util.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
 #include "ck/tensor_operation/gpu/device/device_batchnorm_backward.hpp"
 
 namespace ck {
@@ -309,27 +310,15 @@ struct ReferenceBatchNormBwd : public device::DeviceBatchNormBwd<XDataType,
                 };
             };
 
-            std::size_t num_thread = std::thread::hardware_concurrency();
-            std::size_t work_per_thread =
-                (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-            std::vector<joinable_thread> threads(num_thread);
-
-            for(std::size_t it = 0; it < num_thread; ++it)
-            {
-                std::size_t i_begin = it * work_per_thread;
-                std::size_t i_end   = std::min(static_cast<size_t>((it + 1) * work_per_thread),
-                                             arg.invariant_index_set_.size());
-
-                auto f = [=] {
+            ck::HostThreadPool::Instance().ParallelFor(
+                arg.invariant_index_set_.size(),
+                ck::GetHostNumThreads(),
+                [&](std::size_t i_begin, std::size_t i_end) {
                     for(std::size_t i = i_begin; i < i_end; ++i)
                     {
                         thread_reduce_func(arg.invariant_index_set_[i]);
                     }
-                };
-
-                threads[it] = joinable_thread(f);
-            }
+                });
 
             return (0.0f);
         };
@@ -3,17 +3,38 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <sstream>
+#include <tuple>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
+#include "ck/library/utility/host_blocked_gemm.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 
+enum struct ReferenceConvBwdDataAlgorithm
+{
+    // for every input element, scan the filter window and test which output elements it feeds
+    Naive,
+    // Split the input positions into stride phases ((hi + pad) mod stride in every spatial
+    // dimension). All positions of a phase receive contributions from the same filter taps, so
+    // per group and phase the problem is a dense GEMM with M = N * (positions in the phase),
+    // N = C and K = (filter taps of the phase) * K.
+    PhaseGemm,
+};
+
+// The stride-phase GEMM algorithm accumulates in the same order as the naive one (filter taps in
+// ascending order, then k). Taps that fall outside of the output contribute explicit zero
+// products, so results only differ from the naive algorithm if a weight is Inf or NaN.
+// Convolutions with a single input channel per group (depthwise) always use the naive algorithm.
+//
 // input descriptor in [G, N, C, Do, Ho, Wo] order
 // weight descriptor in [G, K, C, Z, Y, X] order
 // output descriptor in [G, N, K, Di, Hi, Wi] order
@@ -47,7 +68,8 @@ struct ReferenceConvBwdData : public device::BaseOperator
             OutElementwiseOperation out_element_op,
             const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors,
             const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors,
-            const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors)
+            const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors,
+            ReferenceConvBwdDataAlgorithm algorithm = ReferenceConvBwdDataAlgorithm::PhaseGemm)
             : input_{input},
               weight_{weight},
               output_{output},
@@ -60,7 +82,8 @@ struct ReferenceConvBwdData : public device::BaseOperator
               in_right_pads_{input_right_pads},
               in_element_op_{in_element_op},
               wei_element_op_{wei_element_op},
-              out_element_op_{out_element_op}
+              out_element_op_{out_element_op},
+              algorithm_{algorithm}
         {
         }
 
@@ -80,6 +103,8 @@ struct ReferenceConvBwdData : public device::BaseOperator
         InElementwiseOperation in_element_op_;
         WeiElementwiseOperation wei_element_op_;
         OutElementwiseOperation out_element_op_;
+
+        ReferenceConvBwdDataAlgorithm algorithm_;
     };
 
     // Invoker
@@ -96,6 +121,13 @@ struct ReferenceConvBwdData : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
+            if(arg.algorithm_ == ReferenceConvBwdDataAlgorithm::PhaseGemm &&
+               arg.weight_.GetLengths()[2] > 1)
+            {
+                RunPhaseGemm(arg);
+                return 0;
+            }
+
             if constexpr(NDimSpatial == 1)
             {
                 auto f_ncw = [&](auto g, auto n, auto c, auto wi) {
@@ -403,6 +435,331 @@ struct ReferenceConvBwdData : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        static void RunPhaseGemm(const Argument& arg)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const std::size_t G = in_lengths[0];
+            const std::size_t N = in_lengths[1];
+            const std::size_t C = in_lengths[2];
+            const std::size_t K = wei_lengths[1];
+
+            std::size_t num_phase = 1;
+
+            for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                num_phase *= arg.conv_strides_[d];
+
+            for(std::size_t phase = 0; phase < num_phase; ++phase)
+            {
+                // input positions and filter taps of the phase in every spatial dimension
+                std::array<std::vector<std::size_t>, NDimSpatial> in_pos, taps;
+
+                std::size_t gemm_m = N;
+                std::size_t gemm_k = K;
+
+                std::size_t p = phase;
+
+                for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                {
+                    const auto stride  = arg.conv_strides_[d];
+                    const auto residue = static_cast<ck::long_index_t>(p % stride);
+                    p /= stride;
+
+                    for(std::size_t i = 0; i < in_lengths[3 + d]; ++i)
+                    {
+                        if((static_cast<ck::long_index_t>(i) + arg.in_left_pads_[d]) % stride ==
+                           residue)
+                            in_pos[d].push_back(i);
+                    }
+
+                    for(std::size_t x = 0; x < wei_lengths[3 + d]; ++x)
+                    {
+                        if(static_cast<ck::long_index_t>(x) * arg.conv_dilations_[d] % stride ==
+                           residue)
+                            taps[d].push_back(x);
+                    }
+
+                    gemm_m *= in_pos[d].size();
+                    gemm_k *= taps[d].size();
+                }
+
+                // The output position fed by input position i through filter tap x is
+                // (i + pad - x * dilation) / stride. Both i + pad and x * dilation leave the
+                // residue of the phase, so it splits into a row and a column term that are
+                // computed once: m -> (n, input spatial index, (i + pad) / stride) and
+                // gemm_k -> (k, filter spatial index, x * dilation / stride).
+                std::vector<std::array<std::size_t, NDimSpatial + 1>> m_idx(gemm_m);
+                std::vector<std::array<ck::long_index_t, NDimSpatial>> m_out_base(gemm_m);
+                std::vector<std::array<std::size_t, NDimSpatial + 1>> k_idx(gemm_k);
+                std::vector<std::array<ck::long_index_t, NDimSpatial>> k_out_offset(gemm_k);
+
+                for(std::size_t m = 0; m < gemm_m; ++m)
+                {
+                    std::size_t r = m;
+
+                    for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                    {
+                        const std::size_t i = in_pos[d][r % in_pos[d].size()];
+                        r /= in_pos[d].size();
+
+                        m_idx[m][1 + d]  = i;
+                        m_out_base[m][d] =
+                            (static_cast<ck::long_index_t>(i) + arg.in_left_pads_[d]) /
+                            arg.conv_strides_[d];
+                    }
+                    m_idx[m][0] = r;
+                }
+
+                for(std::size_t kk = 0; kk < gemm_k; ++kk)
+                {
+                    std::size_t r = kk / K;
+
+                    for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                    {
+                        const std::size_t x = taps[d][r % taps[d].size()];
+                        r /= taps[d].size();
+
+                        k_idx[kk][1 + d]    = x;
+                        k_out_offset[kk][d] = static_cast<ck::long_index_t>(x) *
+                                              arg.conv_dilations_[d] / arg.conv_strides_[d];
+                    }
+                    k_idx[kk][0] = kk % K;
+                }
+
+                // The output of every group is converted (element-wise operation applied) once into
+                // a zero padded copy that covers every position m_out_base - k_out_offset of the
+                // phase, so A is read with one addition of a row and a column offset and without
+                // bounds checks. Out of range positions read the padding, which is the 0 that the
+                // naive loop skips.
+                std::array<std::size_t, NDimSpatial> pad_lo{}, pad_len{};
+
+                std::size_t pad_size = N * K;
+
+                for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                {
+                    const auto out_len = static_cast<ck::long_index_t>(out_lengths[3 + d]);
+
+                    ck::long_index_t o_min = 0, o_max = out_len - 1;
+
+                    if(gemm_m > 0 && gemm_k > 0)
+                    {
+                        const auto [m_min, m_max] = std::minmax_element(
+                            m_out_base.begin(), m_out_base.end(), [&](auto& x, auto& y) {
+                                return x[d] < y[d];
+                            });
+                        const auto [k_min, k_max] = std::minmax_element(
+                            k_out_offset.begin(), k_out_offset.end(), [&](auto& x, auto& y) {
+                                return x[d] < y[d];
+                            });
+
+                        o_min = std::min(o_min, (*m_min)[d] - (*k_max)[d]);
+                        o_max = std::max(o_max, (*m_max)[d] - (*k_min)[d]);
+                    }
+
+                    pad_lo[d]  = static_cast<std::size_t>(-o_min);
+                    pad_len[d] = static_cast<std::size_t>(o_max - o_min + 1);
+                    pad_size *= pad_len[d];
+                }
+
+                // packed (n, k, spatial) strides of the padded copy
+                std::array<std::size_t, NDimSpatial + 2> pad_strides;
+
+                pad_strides[NDimSpatial + 1] = 1;
+
+                for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                    pad_strides[1 + d] = pad_strides[2 + d] * pad_len[d];
+
+                pad_strides[0] = pad_strides[1] * K;
+
+                std::vector<ck::long_index_t> m_pad_offset(gemm_m), k_pad_offset(gemm_k);
+
+                for(std::size_t m = 0; m < gemm_m; ++m)
+                {
+                    std::size_t offset = m_idx[m][0] * pad_strides[0];
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                        offset += (m_out_base[m][d] + pad_lo[d]) * pad_strides[2 + d];
+
+                    m_pad_offset[m] = static_cast<ck::long_index_t>(offset);
+                }
+
+                for(std::size_t kk = 0; kk < gemm_k; ++kk)
+                {
+                    auto offset = static_cast<ck::long_index_t>(k_idx[kk][0] * pad_strides[1]);
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                        offset -= k_out_offset[kk][d] *
+                                  static_cast<ck::long_index_t>(pad_strides[2 + d]);
+
+                    k_pad_offset[kk] = offset;
+                }
+
+                // element offsets of the input rows, the column c adds c times the C stride
+                const auto& in_strides  = arg.input_.GetStrides();
+                const auto& out_strides = arg.output_.GetStrides();
+
+                std::vector<std::size_t> m_in_offset(gemm_m);
+
+                for(std::size_t m = 0; m < gemm_m; ++m)
+                {
+                    m_in_offset[m] = m_idx[m][0] * in_strides[1];
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                        m_in_offset[m] += m_idx[m][1 + d] * in_strides[3 + d];
+                }
+
+                const std::size_t out_len_x    = out_lengths[NDimSpatial + 2];
+                const std::size_t out_stride_x = out_strides[NDimSpatial + 2];
+
+                std::size_t num_out_line = 1;
+
+                for(ck::index_t d = 0; d < NDimSpatial - 1; ++d)
+                    num_out_line *= out_lengths[3 + d];
+
+                // a phase without filter taps has K = 0, never reads A and stores zeros
+                std::vector<float> out_pad(gemm_k > 0 ? pad_size : 0);
+
+                for(std::size_t g = 0; g < G; ++g)
+                {
+                    std::fill(out_pad.begin(), out_pad.end(), 0.f);
+
+                    ck::HostThreadPool::Instance().ParallelFor(
+                        out_pad.empty() ? 0 : N * K,
+                        ck::GetHostNumThreads(),
+                        [&](std::size_t nk_begin, std::size_t nk_end) {
+                            std::array<std::size_t, NDimSpatial + 3> out_idx{g};
+
+                            for(std::size_t nk = nk_begin; nk < nk_end; ++nk)
+                            {
+                                out_idx[1] = nk / K;
+                                out_idx[2] = nk % K;
+
+                                // lines along the innermost spatial dimension
+                                for(std::size_t line = 0; line < num_out_line; ++line)
+                                {
+                                    std::size_t r          = line;
+                                    std::size_t pad_offset = nk * pad_strides[1];
+                                    std::size_t out_offset = g * out_strides[0] +
+                                                             out_idx[1] * out_strides[1] +
+                                                             out_idx[2] * out_strides[2];
+
+                                    for(ck::index_t d = NDimSpatial - 2; d >= 0; --d)
+                                    {
+                                        out_idx[3 + d] = r % out_lengths[3 + d];
+                                        r /= out_lengths[3 + d];
+
+                                        pad_offset +=
+                                            (out_idx[3 + d] + pad_lo[d]) * pad_strides[2 + d];
+                                        out_offset += out_idx[3 + d] * out_strides[3 + d];
+                                    }
+
+                                    pad_offset += pad_lo[NDimSpatial - 1];
+
+                                    for(std::size_t x = 0; x < out_len_x; ++x)
+                                    {
+                                        out_idx[NDimSpatial + 2] = x;
+
+                                        OutDataType v_out;
+
+                                        std::apply(
+                                            [&](auto... is) {
+                                                ExecuteElementwiseOp(
+                                                    arg.out_element_op_,
+                                                    arg.elementwise_a_tensors_,
+                                                    Number<NumAElementwiseTensor>{},
+                                                    v_out,
+                                                    arg.output_.mData[out_offset +
+                                                                      x * out_stride_x],
+                                                    is...);
+                                            },
+                                            out_idx);
+
+                                        out_pad[pad_offset + x] = ck::type_convert<float>(v_out);
+                                    }
+                                }
+                            }
+                        });
+
+                    // The rows of a sliver are usually adjacent positions of the innermost spatial
+                    // dimension, then every column of the sliver is a contiguous copy.
+                    auto load_a_sliver = [&](std::size_t m,
+                                             std::size_t mr,
+                                             std::size_t kk,
+                                             std::size_t kc,
+                                             float* p_a) {
+                        constexpr std::size_t MR = ck::utils::HostBlockedGemm<float>::MR;
+
+                        if(mr == MR && m_pad_offset[m + MR - 1] - m_pad_offset[m] ==
+                                           static_cast<ck::long_index_t>(MR - 1))
+                        {
+                            const float* p_row = out_pad.data() + m_pad_offset[m];
+
+                            for(std::size_t j = 0; j < kc; ++j)
+                                for(std::size_t i = 0; i < MR; ++i)
+                                    p_a[j * MR + i] = p_row[k_pad_offset[kk + j] + i];
+
+                            return;
+                        }
+
+                        for(std::size_t i = 0; i < mr; ++i)
+                            for(std::size_t j = 0; j < kc; ++j)
+                                p_a[j * MR + i] =
+                                    out_pad[m_pad_offset[m + i] + k_pad_offset[kk + j]];
+                    };
+
+                    auto load_b = [&](std::size_t kk, std::size_t c) {
+                        std::array<std::size_t, NDimSpatial + 3> wei_idx{g, k_idx[kk][0], c};
+
+                        for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                            wei_idx[3 + d] = k_idx[kk][1 + d];
+
+                        WeiDataType v_wei;
+
+                        std::apply(
+                            [&](auto... is) {
+                                ExecuteElementwiseOp(arg.wei_element_op_,
+                                                     arg.elementwise_b_tensors_,
+                                                     Number<NumBElementwiseTensor>{},
+                                                     v_wei,
+                                                     arg.weight_(is...),
+                                                     is...);
+                            },
+                            wei_idx);
+
+                        return ck::type_convert<float>(v_wei);
+                    };
+
+                    auto store_c = [&](std::size_t m, std::size_t c, float v_acc) {
+                        std::array<std::size_t, NDimSpatial + 3> i_idx{g, m_idx[m][0], c};
+
+                        for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                            i_idx[3 + d] = m_idx[m][1 + d];
+
+                        InDataType v_acc_converted = ck::type_convert<InDataType>(v_acc);
+
+                        InDataType& v_in = arg.input_.mData[g * in_strides[0] + m_in_offset[m] +
+                                                            c * in_strides[2]];
+
+                        std::apply(
+                            [&](auto... is) {
+                                ExecuteElementwiseOp(arg.in_element_op_,
+                                                     arg.elementwise_d_tensors_,
+                                                     Number<NumDElementwiseTensor>{},
+                                                     v_in,
+                                                     v_acc_converted,
+                                                     is...);
+                            },
+                            i_idx);
+                    };
+
+                    ck::utils::HostBlockedGemm<float>::RunWithASlivers(
+                        gemm_m, C, gemm_k, load_a_sliver, load_b, store_c);
+                }
+            }
+        }
     };
 
     template <typename... Args,
@@ -456,7 +813,8 @@ struct ReferenceConvBwdData : public device::BaseOperator
         OutElementwiseOperation out_element_op,
         const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors  = {},
         const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors = {},
-        const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {})
+        const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {},
+        ReferenceConvBwdDataAlgorithm algorithm = ReferenceConvBwdDataAlgorithm::PhaseGemm)
     {
         return Argument{input,
                         weight,
@@ -470,7 +828,8 @@ struct ReferenceConvBwdData : public device::BaseOperator
                         out_element_op,
                         elementwise_a_tensors,
                         elementwise_b_tensors,
-                        elementwise_d_tensors};
+                        elementwise_d_tensors,
+                        algorithm};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
@@ -3,17 +3,35 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <sstream>
+#include <tuple>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
+#include "ck/library/utility/host_blocked_gemm.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 
+enum struct ReferenceConvBwdWeightAlgorithm
+{
+    // for every weight element, loop over N and the output window
+    Naive,
+    // per group, lower the convolution to a GEMM with M = C * Z * Y * X, N = K and
+    // K = N * Do * Ho * Wo (the transposed im2col matrix of the input times the output gradient)
+    Im2colGemm,
+};
+
+// The im2col + blocked GEMM algorithm accumulates in the same order as the naive one (n, then the
+// output spatial index). Padding contributes explicit zero products, so results only differ from
+// the naive algorithm if an output gradient is Inf or NaN. Convolutions with a single output
+// channel per group (depthwise) always use the naive algorithm.
+//
 // input descriptor in [G, N, C, Do, Ho, Wo] order
 // weight descriptor in [G, K, C, Z, Y, X] order
 // output descriptor in [G, N, K, Di, Hi, Wi] order
@@ -49,7 +67,8 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
             OutElementwiseOperation out_element_op,
             const std::array<Tensor<OutDataType>, NumAElementwiseTensor>& elementwise_a_tensors,
             const std::array<Tensor<InDataType>, NumBElementwiseTensor>& elementwise_b_tensors,
-            const std::array<Tensor<WeiDataType>, NumDElementwiseTensor>& elementwise_d_tensors)
+            const std::array<Tensor<WeiDataType>, NumDElementwiseTensor>& elementwise_d_tensors,
+            ReferenceConvBwdWeightAlgorithm algorithm = ReferenceConvBwdWeightAlgorithm::Im2colGemm)
             : input_{in_n_c_hi_wi},
               weight_{wei_k_c_y_x},
               output_{out_n_k_ho_wo},
@@ -62,7 +81,8 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
               in_right_pads_{input_right_pads},
               in_element_op_{in_element_op},
               wei_element_op_{wei_element_op},
-              out_element_op_{out_element_op}
+              out_element_op_{out_element_op},
+              algorithm_{algorithm}
         {
         }
 
@@ -82,6 +102,8 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
         InElementwiseOperation in_element_op_;
         WeiElementwiseOperation wei_element_op_;
         OutElementwiseOperation out_element_op_;
+
+        ReferenceConvBwdWeightAlgorithm algorithm_;
     };
 
     // Invoker
@@ -98,6 +120,13 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
+            if(arg.algorithm_ == ReferenceConvBwdWeightAlgorithm::Im2colGemm &&
+               arg.weight_.GetLengths()[1] > 1)
+            {
+                RunIm2colGemm(arg);
+                return 0;
+            }
+
             if constexpr(NDimSpatial == 1)
             {
                 auto f_kcx = [&](auto g, auto k, auto c, auto x) {
@@ -357,6 +386,143 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        static void RunIm2colGemm(const Argument& arg)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const std::size_t G = wei_lengths[0];
+            const std::size_t K = wei_lengths[1];
+            const std::size_t C = wei_lengths[2];
+            const std::size_t N = out_lengths[1];
+
+            std::size_t gemm_m = C;
+            std::size_t gemm_k = N;
+
+            for(ck::index_t d = 0; d < NDimSpatial; ++d)
+            {
+                gemm_m *= wei_lengths[3 + d];
+                gemm_k *= out_lengths[3 + d];
+            }
+
+            // The input position read by output position o through filter tap x is
+            // o * stride + x * dilation - pad, split into a row and a column term that are computed
+            // once: m -> (c, filter spatial index, x * dilation - pad) and
+            // gemm_k -> (n, output spatial index, o * stride).
+            std::vector<std::array<std::size_t, NDimSpatial + 1>> m_idx(gemm_m);
+            std::vector<std::array<ck::long_index_t, NDimSpatial>> m_in_offset(gemm_m);
+            std::vector<std::array<std::size_t, NDimSpatial + 1>> k_idx(gemm_k);
+            std::vector<std::array<ck::long_index_t, NDimSpatial>> k_in_base(gemm_k);
+
+            for(std::size_t m = 0; m < gemm_m; ++m)
+            {
+                std::size_t r = m;
+
+                for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                {
+                    const std::size_t x = r % wei_lengths[3 + d];
+                    r /= wei_lengths[3 + d];
+
+                    m_idx[m][1 + d]   = x;
+                    m_in_offset[m][d] = static_cast<ck::long_index_t>(x) * arg.conv_dilations_[d] -
+                                        arg.in_left_pads_[d];
+                }
+                m_idx[m][0] = r;
+            }
+
+            for(std::size_t kk = 0; kk < gemm_k; ++kk)
+            {
+                std::size_t r = kk;
+
+                for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                {
+                    const std::size_t o = r % out_lengths[3 + d];
+                    r /= out_lengths[3 + d];
+
+                    k_idx[kk][1 + d] = o;
+                    k_in_base[kk][d] = static_cast<ck::long_index_t>(o) * arg.conv_strides_[d];
+                }
+                k_idx[kk][0] = r;
+            }
+
+            for(std::size_t g = 0; g < G; ++g)
+            {
+                auto load_a = [&](std::size_t m, std::size_t kk) {
+                    std::array<std::size_t, NDimSpatial + 3> in_idx{g, k_idx[kk][0], m_idx[m][0]};
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                    {
+                        const auto i = k_in_base[kk][d] + m_in_offset[m][d];
+
+                        if(i < 0 || ck::type_convert<std::size_t>(i) >= in_lengths[3 + d])
+                            return 0.f;
+
+                        in_idx[3 + d] = static_cast<std::size_t>(i);
+                    }
+
+                    ComputeTypeB v_in;
+
+                    std::apply(
+                        [&](auto... is) {
+                            ExecuteElementwiseOp(arg.in_element_op_,
+                                                 arg.elementwise_b_tensors_,
+                                                 Number<NumBElementwiseTensor>{},
+                                                 v_in,
+                                                 ck::type_convert<float>(arg.input_(is...)),
+                                                 is...);
+                        },
+                        in_idx);
+
+                    return type_convert<float>(v_in);
+                };
+
+                auto load_b = [&](std::size_t kk, std::size_t k) {
+                    std::array<std::size_t, NDimSpatial + 3> out_idx{g, k_idx[kk][0], k};
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                        out_idx[3 + d] = k_idx[kk][1 + d];
+
+                    ComputeTypeA v_out;
+
+                    std::apply(
+                        [&](auto... is) {
+                            ExecuteElementwiseOp(arg.out_element_op_,
+                                                 arg.elementwise_a_tensors_,
+                                                 Number<NumAElementwiseTensor>{},
+                                                 v_out,
+                                                 ck::type_convert<float>(arg.output_(is...)),
+                                                 is...);
+                        },
+                        out_idx);
+
+                    return type_convert<float>(v_out);
+                };
+
+                auto store_c = [&](std::size_t m, std::size_t k, float v_acc) {
+                    std::array<std::size_t, NDimSpatial + 3> wei_idx{g, k, m_idx[m][0]};
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                        wei_idx[3 + d] = m_idx[m][1 + d];
+
+                    WeiDataType v_acc_converted = ck::type_convert<WeiDataType>(v_acc);
+
+                    std::apply(
+                        [&](auto... is) {
+                            ExecuteElementwiseOp(arg.wei_element_op_,
+                                                 arg.elementwise_d_tensors_,
+                                                 Number<NumDElementwiseTensor>{},
+                                                 arg.weight_(is...),
+                                                 v_acc_converted,
+                                                 is...);
+                        },
+                        wei_idx);
+                };
+
+                ck::utils::HostBlockedGemm<float>::Run(gemm_m, K, gemm_k, load_a, load_b, store_c);
+            }
+        }
     };
 
     template <typename... Args,
@@ -411,7 +577,8 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
         OutElementwiseOperation out_element_op,
         const std::array<Tensor<OutDataType>, NumAElementwiseTensor>& elementwise_a_tensors = {},
         const std::array<Tensor<InDataType>, NumBElementwiseTensor>& elementwise_b_tensors  = {},
-        const std::array<Tensor<WeiDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {})
+        const std::array<Tensor<WeiDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {},
+        ReferenceConvBwdWeightAlgorithm algorithm = ReferenceConvBwdWeightAlgorithm::Im2colGemm)
     {
         return Argument{in_n_c_hi_wi,
                         wei_k_c_y_x,
@@ -425,7 +592,8 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
                         out_element_op,
                         elementwise_a_tensors,
                         elementwise_b_tensors,
-                        elementwise_d_tensors};
+                        elementwise_d_tensors,
+                        algorithm};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
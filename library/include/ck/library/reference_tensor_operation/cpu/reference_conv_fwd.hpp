@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <numeric>
+#include <tuple>
 #include <type_traits>
 #include <vector>
 
@@ -17,6 +19,7 @@
 #include "ck/library/utility/algorithm.hpp"
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_blocked_gemm.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
@@ -25,6 +28,16 @@ namespace ck {
 namespace tensor_operation {
 namespace host {
 
+enum struct ReferenceConvFwdAlgorithm
+{
+    // direct loop over C and the filter window for every output element
+    Naive,
+    // per group, lower the convolution to a GEMM with M = N * Do * Ho * Wo, N = K and
+    // K = C * Z * Y * X; tiles of the im2col matrix are formed while packing GEMM panels, so the
+    // element-wise operations run once per packed input/weight value
+    Im2colGemm,
+};
+
 //
 // @brief      Reference implementation for forward convolution.
 //
@@ -45,6 +58,11 @@ namespace host {
 // @tparam     NumBElementwiseTensor  Number of B elementwise tensors.
 // @tparam     NumDElementwiseTensor  Number of D elementwise tensors.
 //
+// The im2col + blocked GEMM algorithm accumulates in the same order as the naive one. Padding
+// contributes explicit zero products, so results only differ from the naive algorithm if a
+// weight is Inf or NaN. Convolutions with a single output channel per group (depthwise) always
+// use the naive algorithm.
+//
 // input descriptor in [G, N, C, Do, Ho, Wo] order
 // weight descriptor in [G, K, C, Z, Y, X] order
 // output descriptor in [G, N, K, Di, Hi, Wi] order
@@ -78,7 +96,8 @@ struct ReferenceConvFwd : public device::BaseOperator
             OutElementwiseOperation out_element_op,
             const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors,
             const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors,
-            const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors)
+            const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors,
+            ReferenceConvFwdAlgorithm algorithm = ReferenceConvFwdAlgorithm::Im2colGemm)
             : input_{input},
               weight_{weight},
               output_{output},
@@ -91,7 +110,8 @@ struct ReferenceConvFwd : public device::BaseOperator
               in_right_pads_{input_right_pads},
               in_element_op_{in_element_op},
               wei_element_op_{wei_element_op},
-              out_element_op_{out_element_op}
+              out_element_op_{out_element_op},
+              algorithm_{algorithm}
         {
         }
 
@@ -111,6 +131,8 @@ struct ReferenceConvFwd : public device::BaseOperator
         InElementwiseOperation in_element_op_;
         WeiElementwiseOperation wei_element_op_;
         OutElementwiseOperation out_element_op_;
+
+        ReferenceConvFwdAlgorithm algorithm_;
     };
 
     struct Invoker : public device::BaseInvoker
@@ -126,6 +148,13 @@ struct ReferenceConvFwd : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
+            if(arg.algorithm_ == ReferenceConvFwdAlgorithm::Im2colGemm &&
+               arg.weight_.GetLengths()[1] > 1)
+            {
+                RunIm2colGemm(arg);
+                return 0;
+            }
+
             if constexpr(NDimSpatial == 1)
             {
                 auto func = [&](auto g, auto n, auto k, auto wo) {
@@ -369,6 +398,146 @@ struct ReferenceConvFwd : public device::BaseOperator
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        static void RunIm2colGemm(const Argument& arg)
+        {
+            const auto& in_lengths  = arg.input_.GetLengths();
+            const auto& wei_lengths = arg.weight_.GetLengths();
+            const auto& out_lengths = arg.output_.GetLengths();
+
+            const std::size_t G = out_lengths[0];
+            const std::size_t N = out_lengths[1];
+            const std::size_t K = out_lengths[2];
+            const std::size_t C = wei_lengths[2];
+
+            std::size_t gemm_m = N;
+            std::size_t gemm_k = C;
+
+            for(ck::index_t d = 0; d < NDimSpatial; ++d)
+            {
+                gemm_m *= out_lengths[3 + d];
+                gemm_k *= wei_lengths[3 + d];
+            }
+
+            // gemm_m -> n, output spatial index
+            auto decode_m = [&](std::size_t m,
+                                std::size_t& n,
+                                std::array<std::size_t, NDimSpatial>& out_idx) {
+                for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                {
+                    out_idx[d] = m % out_lengths[3 + d];
+                    m /= out_lengths[3 + d];
+                }
+                n = m;
+            };
+
+            // gemm_k -> c, filter spatial index
+            auto decode_k = [&](std::size_t kk,
+                                std::size_t& c,
+                                std::array<std::size_t, NDimSpatial>& filter_idx) {
+                for(ck::index_t d = NDimSpatial - 1; d >= 0; --d)
+                {
+                    filter_idx[d] = kk % wei_lengths[3 + d];
+                    kk /= wei_lengths[3 + d];
+                }
+                c = kk;
+            };
+
+            for(std::size_t g = 0; g < G; ++g)
+            {
+                auto load_a = [&](std::size_t m, std::size_t kk) {
+                    std::size_t n, c;
+                    std::array<std::size_t, NDimSpatial> out_idx, filter_idx;
+
+                    decode_m(m, n, out_idx);
+                    decode_k(kk, c, filter_idx);
+
+                    std::array<std::size_t, NDimSpatial + 3> in_idx{g, n, c};
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                    {
+                        const auto i =
+                            static_cast<ck::long_index_t>(out_idx[d] * arg.conv_strides_[d]) +
+                            static_cast<ck::long_index_t>(filter_idx[d] * arg.conv_dilations_[d]) -
+                            static_cast<ck::long_index_t>(arg.in_left_pads_[d]);
+
+                        if(i < 0 || ck::type_convert<std::size_t>(i) >= in_lengths[3 + d])
+                            return 0.f;
+
+                        in_idx[3 + d] = static_cast<std::size_t>(i);
+                    }
+
+                    InDataType v_in;
+
+                    std::apply(
+                        [&](auto... is) {
+                            ExecuteElementwiseOp(arg.in_element_op_,
+                                                 arg.elementwise_a_tensors_,
+                                                 Number<NumAElementwiseTensor>{},
+                                                 v_in,
+                                                 arg.input_(is...),
+                                                 is...);
+                        },
+                        in_idx);
+
+                    return ck::type_convert<float>(v_in);
+                };
+
+                auto load_b = [&](std::size_t kk, std::size_t k) {
+                    std::size_t c;
+                    std::array<std::size_t, NDimSpatial> filter_idx;
+
+                    decode_k(kk, c, filter_idx);
+
+                    std::array<std::size_t, NDimSpatial + 3> wei_idx{g, k, c};
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                        wei_idx[3 + d] = filter_idx[d];
+
+                    WeiDataType v_wei;
+
+                    std::apply(
+                        [&](auto... is) {
+                            ExecuteElementwiseOp(arg.wei_element_op_,
+                                                 arg.elementwise_b_tensors_,
+                                                 Number<NumBElementwiseTensor>{},
+                                                 v_wei,
+                                                 arg.weight_(is...),
+                                                 is...);
+                        },
+                        wei_idx);
+
+                    return ck::type_convert<float>(v_wei);
+                };
+
+                auto store_c = [&](std::size_t m, std::size_t k, float v_acc) {
+                    std::size_t n;
+                    std::array<std::size_t, NDimSpatial> out_idx;
+
+                    decode_m(m, n, out_idx);
+
+                    std::array<std::size_t, NDimSpatial + 3> o_idx{g, n, k};
+
+                    for(ck::index_t d = 0; d < NDimSpatial; ++d)
+                        o_idx[3 + d] = out_idx[d];
+
+                    OutDataType v_acc_converted = ck::type_convert<OutDataType>(v_acc);
+
+                    std::apply(
+                        [&](auto... is) {
+                            ExecuteElementwiseOp(arg.out_element_op_,
+                                                 arg.elementwise_d_tensors_,
+                                                 Number<NumDElementwiseTensor>{},
+                                                 arg.output_(is...),
+                                                 v_acc_converted,
+                                                 is...);
+                        },
+                        o_idx);
+                };
+
+                ck::utils::HostBlockedGemm<float>::Run(gemm_m, K, gemm_k, load_a, load_b, store_c);
+            }
+        }
     };
 
     template <typename... Args,
@@ -425,7 +594,8 @@ struct ReferenceConvFwd : public device::BaseOperator
         OutElementwiseOperation out_element_op,
         const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors  = {},
         const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors = {},
-        const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {})
+        const std::array<Tensor<OutDataType>, NumDElementwiseTensor>& elementwise_d_tensors = {},
+        ReferenceConvFwdAlgorithm algorithm = ReferenceConvFwdAlgorithm::Im2colGemm)
     {
         return Argument{input,
                         weight,
@@ -439,7 +609,8 @@ struct ReferenceConvFwd : public device::BaseOperator
                         out_element_op,
                         elementwise_a_tensors,
                         elementwise_b_tensors,
-                        elementwise_d_tensors};
+                        elementwise_d_tensors,
+                        algorithm};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
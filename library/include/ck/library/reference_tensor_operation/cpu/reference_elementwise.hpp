@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <sstream>
 
@@ -37,8 +39,74 @@ struct ReferenceElementwise : public device::BaseOperator
     {
         using Argument = ReferenceElementwise::Argument;
 
+        template <std::size_t Rank>
+        static void RunWithRank(const Argument& arg)
+        {
+            const auto b = arg.b_tensor_.template AsView<Rank>();
+
+            std::array<ck::utils::TensorView<const ADataType, Rank>, NumATensors> as;
+
+            for(index_t i = 0; i < NumATensors; ++i)
+                as[i] = arg.a_tensors_[i].template AsView<Rank>();
+
+            b.ForEachRow([&](const auto& idx, BDataType* p_b, std::size_t length, std::size_t) {
+                std::array<const ADataType*, NumATensors> p_as;
+                std::array<std::size_t, NumATensors> a_strides;
+
+                for(index_t i = 0; i < NumATensors; ++i)
+                {
+                    p_as[i]      = &as[i](idx);
+                    a_strides[i] = as[i].GetStride(Rank - 1);
+                }
+
+                // a_offset(j) is the offset of the element of A tensor j in its row
+                const auto apply = [&](std::size_t b_offset, auto a_offset) {
+                    if constexpr(NumATensors == 1)
+                    {
+                        arg.element_op_(p_b[b_offset], p_as[0][a_offset(0)]);
+                    }
+                    else if constexpr(NumATensors == 2)
+                    {
+                        arg.element_op_(
+                            p_b[b_offset], p_as[0][a_offset(0)], p_as[1][a_offset(1)]);
+                    }
+                    else if constexpr(NumATensors == 3)
+                    {
+                        arg.element_op_(p_b[b_offset],
+                                        p_as[0][a_offset(0)],
+                                        p_as[1][a_offset(1)],
+                                        p_as[2][a_offset(2)]);
+                    }
+                };
+
+                const std::size_t b_stride = b.GetStride(Rank - 1);
+
+                const bool is_contiguous =
+                    b_stride == 1 && std::all_of(a_strides.begin(),
+                                                 a_strides.end(),
+                                                 [](std::size_t stride) { return stride == 1; });
+
+                if(is_contiguous)
+                {
+                    for(std::size_t i = 0; i < length; ++i)
+                        apply(i, [i](index_t) { return i; });
+                }
+                else
+                {
+                    for(std::size_t i = 0; i < length; ++i)
+                        apply(i * b_stride, [&](index_t j) { return i * a_strides[j]; });
+                }
+            });
+        }
+
         float Run(const Argument& arg)
         {
+            // tensors of rank up to 6 are iterated through views with compile-time rank
+            const auto run_with_rank = [&](auto rank) { RunWithRank<decltype(rank)::value>(arg); };
+
+            if(ck::utils::DispatchTensorRank(arg.b_tensor_.GetNumOfDimension(), run_with_rank))
+                return 0;
+
             if constexpr(NumATensors == 1)
             {
                 arg.b_tensor_.ForEach([&](auto& self, auto idx) {
@@ -8,12 +8,23 @@
 
 #include "ck/tensor_operation/gpu/element/unary_element_wise_operation.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_blocked_gemm.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 
+enum struct ReferenceGemmAlgorithm
+{
+    // scalar dot product per C element
+    Naive,
+    // packed, cache-blocked and vectorized, same accumulation order as Naive
+    Blocked,
+    // like Blocked, but allowed to use fused multiply-add
+    BlockedFused,
+};
+
 template <typename ADataType,
           typename BDataType,
           typename CDataType,
@@ -33,13 +44,15 @@ struct ReferenceGemm : public device::BaseOperator
                  Tensor<CDataType>& c_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
-                 CElementwiseOperation c_element_op)
+                 CElementwiseOperation c_element_op,
+                 ReferenceGemmAlgorithm algorithm = ReferenceGemmAlgorithm::Blocked)
             : a_m_k_{a_m_k},
               b_k_n_{b_k_n},
               c_m_n_{c_m_n},
               a_element_op_{a_element_op},
               b_element_op_{b_element_op},
-              c_element_op_{c_element_op}
+              c_element_op_{c_element_op},
+              algorithm_{algorithm}
         {
         }
 
@@ -50,6 +63,8 @@ struct ReferenceGemm : public device::BaseOperator
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
         CElementwiseOperation c_element_op_;
+
+        ReferenceGemmAlgorithm algorithm_;
     };
 
     // Invoker
@@ -57,8 +72,86 @@ struct ReferenceGemm : public device::BaseOperator
     {
         using Argument = ReferenceGemm::Argument;
 
+        // A/B element-wise operations used for the reference calculation
+        template <typename ElementwiseOperation>
+        using RefElementwiseOperation =
+            std::conditional_t<is_same_v<ElementwiseOperation,
+                                         ck::tensor_operation::element_wise::ConvertBF16RTN>,
+                               ck::tensor_operation::element_wise::PassThrough,
+                               ElementwiseOperation>;
+
+        static constexpr bool IsBlockedSupported = std::is_same_v<AccDataType, float> ||
+                                                   std::is_same_v<AccDataType, double> ||
+                                                   std::is_same_v<AccDataType, int32_t>;
+
+        // Every A and B element is converted to AccDataType once while packing, the products are
+        // accumulated in the same k order as the naive loop below.
+        static void RunBlocked(const Argument& arg)
+        {
+            const std::size_t M = arg.c_m_n_.mDesc.GetLengths()[0];
+            const std::size_t N = arg.c_m_n_.mDesc.GetLengths()[1];
+            const std::size_t K = arg.a_m_k_.mDesc.GetLengths()[1];
+
+            const auto& a_strides = arg.a_m_k_.mDesc.GetStrides();
+            const auto& b_strides = arg.b_k_n_.mDesc.GetStrides();
+            const auto& c_strides = arg.c_m_n_.mDesc.GetStrides();
+
+            const auto a_element_op = [&]() {
+                if constexpr(is_same_v<AElementwiseOperation,
+                                       RefElementwiseOperation<AElementwiseOperation>>)
+                    return arg.a_element_op_;
+                else
+                    return RefElementwiseOperation<AElementwiseOperation>{};
+            }();
+            const auto b_element_op = [&]() {
+                if constexpr(is_same_v<BElementwiseOperation,
+                                       RefElementwiseOperation<BElementwiseOperation>>)
+                    return arg.b_element_op_;
+                else
+                    return RefElementwiseOperation<BElementwiseOperation>{};
+            }();
+
+            auto load_a = [&](std::size_t m, std::size_t k) {
+                ComputeTypeA v_a{0};
+                a_element_op(v_a, arg.a_m_k_.mData[m * a_strides[0] + k * a_strides[1]]);
+                return ck::type_convert<AccDataType>(v_a);
+            };
+
+            auto load_b = [&](std::size_t k, std::size_t n) {
+                ComputeTypeB v_b{0};
+                b_element_op(v_b, arg.b_k_n_.mData[k * b_strides[0] + n * b_strides[1]]);
+                return ck::type_convert<AccDataType>(v_b);
+            };
+
+            auto store_c = [&](std::size_t m, std::size_t n, AccDataType v_acc) {
+                CDataType v_c{0};
+                arg.c_element_op_(v_c, v_acc);
+                arg.c_m_n_.mData[m * c_strides[0] + n * c_strides[1]] = v_c;
+            };
+
+            ck::utils::HostBlockedGemm<AccDataType>::Run(
+                M,
+                N,
+                K,
+                load_a,
+                load_b,
+                store_c,
+                arg.algorithm_ == ReferenceGemmAlgorithm::BlockedFused
+                    ? ck::utils::HostGemmAccumulation::Fused
+                    : ck::utils::HostGemmAccumulation::Sequential);
+        }
+
         float Run(const Argument& arg)
         {
+            if constexpr(IsBlockedSupported)
+            {
+                if(arg.algorithm_ != ReferenceGemmAlgorithm::Naive)
+                {
+                    RunBlocked(arg);
+                    return 0;
+                }
+            }
+
             auto f_mk_kn_mn = [&](auto m, auto n) {
                 const int K = arg.a_m_k_.mDesc.GetLengths()[1];
 
@@ -127,9 +220,10 @@ struct ReferenceGemm : public device::BaseOperator
                              Tensor<CDataType>& c_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
-                             CElementwiseOperation c_element_op)
+                             CElementwiseOperation c_element_op,
+                             ReferenceGemmAlgorithm algorithm = ReferenceGemmAlgorithm::Blocked)
     {
-        return Argument{a_m_k, b_k_n, c_m_n, a_element_op, b_element_op, c_element_op};
+        return Argument{a_m_k, b_k_n, c_m_n, a_element_op, b_element_op, c_element_op, algorithm};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
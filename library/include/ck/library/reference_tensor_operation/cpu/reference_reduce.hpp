@@ -13,6 +13,7 @@
 #include "ck/utility/reduction_common.hpp"
 #include "ck/utility/reduction_functions_accumulate.hpp"
 #include "ck/library/utility/host_common_util.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/tensor_operation/gpu/device/device_reduce.hpp"
 
@@ -247,28 +248,15 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
                         arg.out_index_host_[dst_offset] = accuIndex;
                     };
 
-                    std::size_t num_thread = std::thread::hardware_concurrency();
-
-                    std::size_t work_per_thread =
-                        (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-                    std::vector<joinable_thread> threads(num_thread);
-
-                    for(std::size_t it = 0; it < num_thread; ++it)
-                    {
-                        std::size_t i_begin = it * work_per_thread;
-                        std::size_t i_end =
-                            std::min((it + 1) * work_per_thread, arg.invariant_index_set_.size());
-
-                        auto f = [=] {
-                            for(std::size_t i = i_begin; i < i_end; i++)
+                    ck::HostThreadPool::Instance().ParallelFor(
+                        arg.invariant_index_set_.size(),
+                        ck::GetHostNumThreads(),
+                        [&](std::size_t i_begin, std::size_t i_end) {
+                            for(std::size_t i = i_begin; i < i_end; ++i)
                             {
                                 thread_reduce_func(arg.invariant_index_set_[i]);
                             }
-                        };
-
-                        threads[it] = joinable_thread(f);
-                    }
+                        });
                 };
             }
             else
@@ -340,28 +328,15 @@ struct ReferenceReduce : public device::DeviceReduce<InDataType,
                         arg.out_host_[dst_offset] = type_convert<OutDataType>(accuVal);
                     };
 
-                    std::size_t num_thread = std::thread::hardware_concurrency();
-
-                    std::size_t work_per_thread =
-                        (arg.invariant_index_set_.size() + num_thread - 1) / num_thread;
-
-                    std::vector<joinable_thread> threads(num_thread);
-
-                    for(std::size_t it = 0; it < num_thread; ++it)
-                    {
-                        std::size_t i_begin = it * work_per_thread;
-                        std::size_t i_end =
-                            std::min((it + 1) * work_per_thread, arg.invariant_index_set_.size());
-
-                        auto f = [=] {
-                            for(std::size_t i = i_begin; i < i_end; i++)
+                    ck::HostThreadPool::Instance().ParallelFor(
+                        arg.invariant_index_set_.size(),
+                        ck::GetHostNumThreads(),
+                        [&](std::size_t i_begin, std::size_t i_end) {
+                            for(std::size_t i = i_begin; i < i_end; ++i)
                             {
                                 thread_reduce_func(arg.invariant_index_set_[i]);
                             }
-                        };
-
-                        threads[it] = joinable_thread(f);
-                    }
+                        });
                 };
             };
 
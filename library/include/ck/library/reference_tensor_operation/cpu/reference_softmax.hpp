@@ -7,6 +7,8 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <limits>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
@@ -56,8 +58,101 @@ struct ReferenceSoftmax : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
+        // Same steps and summation order as the generic path in Run(), with views of
+        // compile-time rank. The max and sum buffers are viewed with the lengths of the input and
+        // stride 0 along the reduced dimensions, so every input element addresses its reduction
+        // result directly.
+        template <std::size_t Rank>
+        static void RunWithRank(const Argument& arg)
+        {
+            using Index = std::array<std::size_t, Rank>;
+
+            const auto in  = arg.in_.template AsView<Rank>();
+            const auto out = arg.out_.template AsView<Rank>();
+
+            Index reduce_strides{};
+            std::size_t reduce_size = 1;
+
+            for(std::size_t d = Rank; d-- > 0;)
+            {
+                if(std::find(arg.sm_scalar_dims_.begin(),
+                             arg.sm_scalar_dims_.end(),
+                             static_cast<index_t>(d)) != arg.sm_scalar_dims_.end())
+                {
+                    reduce_strides[d] = reduce_size;
+                    reduce_size *= in.GetLength(d);
+                }
+            }
+
+            std::vector<AccDataType> max_data(reduce_size,
+                                              std::numeric_limits<AccDataType>::lowest());
+            std::vector<AccDataType> sum_data(reduce_size, 0);
+
+            const ck::utils::TensorView<AccDataType, Rank> reduce_max(
+                max_data.data(), in.GetLengths(), reduce_strides);
+            const ck::utils::TensorView<AccDataType, Rank> reduce_sum(
+                sum_data.data(), in.GetLengths(), reduce_strides);
+
+            Tensor<AccDataType> in_stable_tensor(arg.in_.mDesc);
+
+            const auto in_stable = in_stable_tensor.template AsView<Rank>();
+
+            const std::size_t reduce_stride = reduce_strides[Rank - 1];
+            const std::size_t in_stride     = in.GetStride(Rank - 1);
+            const std::size_t stable_stride = in_stable.GetStride(Rank - 1);
+            const std::size_t out_stride    = out.GetStride(Rank - 1);
+
+            in.ForEachRow([&](const Index& idx, const InDataType* p_in, std::size_t length, auto) {
+                AccDataType* p_max = &reduce_max(idx);
+
+                for(std::size_t i = 0; i < length; ++i)
+                    p_max[i * reduce_stride] =
+                        std::max(p_max[i * reduce_stride],
+                                 ck::type_convert<AccDataType>(p_in[i * in_stride]));
+            });
+
+            in.ForEachRow([&](const Index& idx, const InDataType* p_in, std::size_t length, auto) {
+                // numerator = exp(x - max(x))
+                const AccDataType* p_max = &reduce_max(idx);
+                AccDataType* p_stable    = &in_stable(idx);
+
+                for(std::size_t i = 0; i < length; ++i)
+                    p_stable[i * stable_stride] =
+                        std::exp(ck::type_convert<AccDataType>(p_in[i * in_stride]) -
+                                 p_max[i * reduce_stride]);
+            });
+
+            in_stable.ForEachRow(
+                [&](const Index& idx, const AccDataType* p_stable, std::size_t length, auto) {
+                    // denominator = sum(exp(x - max(x)))
+                    AccDataType* p_sum = &reduce_sum(idx);
+
+                    for(std::size_t i = 0; i < length; ++i)
+                        p_sum[i * reduce_stride] += p_stable[i * stable_stride];
+                });
+
+            out.ForEachRow([&](const Index& idx, OutDataType* p_out, std::size_t length, auto) {
+                const AccDataType* p_stable = &in_stable(idx);
+                const AccDataType* p_sum    = &reduce_sum(idx);
+
+                for(std::size_t i = 0; i < length; ++i)
+                {
+                    AccDataType temp_result =
+                        arg.alpha_ * p_stable[i * stable_stride] / p_sum[i * reduce_stride] +
+                        arg.beta_ * ck::type_convert<AccDataType>(p_out[i * out_stride]);
+                    p_out[i * out_stride] = ck::type_convert<OutDataType>(temp_result);
+                }
+            });
+        }
+
         float Run(const Argument& arg)
         {
+            // tensors of rank up to 6 are iterated through views with compile-time rank
+            const auto run_with_rank = [&](auto rank) { RunWithRank<decltype(rank)::value>(arg); };
+
+            if(ck::utils::DispatchTensorRank(arg.in_.GetNumOfDimension(), run_with_rank))
+                return 0;
+
             std::vector<size_t> scalar_lengths;
             for(index_t dim : arg.sm_scalar_dims_)
             {
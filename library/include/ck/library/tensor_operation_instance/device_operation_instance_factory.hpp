@@ -148,6 +148,12 @@ using Add_Mul2_Activation_Mul_Clamp =
 template <typename DeviceOp, typename Tag = void>
 struct DeviceOperationInstanceFactory;
 
+// Tag of the DeviceOperationInstanceFactory specializations that provide instances running on the
+// host CPU (see tensor_operation_instance/host/). Their arguments take host pointers.
+struct HostInstanceTag
+{
+};
+
 } // namespace instance
 } // namespace device
 } // namespace tensor_operation
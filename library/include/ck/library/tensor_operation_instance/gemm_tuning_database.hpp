@@ -0,0 +1,487 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// Host-only instance selection for the GEMM instance factories.
+//
+// GemmTuningDatabase remembers the best instance (by GetTypeString()) and split-K factor per
+// problem, so that callers of DeviceOperationInstanceFactory<...>::GetInstances() do not have to
+// time every instance for a shape that has been tuned before. For unseen shapes the database
+// falls back to the nearest tuned shape of the same operation, and RankGemmInstanceCandidates()
+// orders the remaining instances by an analytical tile-efficiency model. Nothing in this file
+// touches the device.
+
+struct GemmTuningKey
+{
+    // identifies the operation, e.g. "gemm_universal_f16_f16_f16_RRR"
+    std::string op_name;
+
+    std::int64_t M = 0;
+    std::int64_t N = 0;
+    std::int64_t K = 0;
+
+    friend bool operator<(const GemmTuningKey& lhs, const GemmTuningKey& rhs)
+    {
+        return std::tie(lhs.op_name, lhs.M, lhs.N, lhs.K) <
+               std::tie(rhs.op_name, rhs.M, rhs.N, rhs.K);
+    }
+
+    friend bool operator==(const GemmTuningKey& lhs, const GemmTuningKey& rhs)
+    {
+        return std::tie(lhs.op_name, lhs.M, lhs.N, lhs.K) ==
+               std::tie(rhs.op_name, rhs.M, rhs.N, rhs.K);
+    }
+};
+
+struct GemmTuningEntry
+{
+    // GetTypeString() of the selected instance
+    std::string instance_name;
+
+    int kbatch     = 1;
+    float ave_time = 0; // ms
+};
+
+class GemmTuningDatabase
+{
+    public:
+    static constexpr const char* kFileHeader = "# ck gemm tuning database v1";
+
+    GemmTuningDatabase() = default;
+
+    explicit GemmTuningDatabase(const std::string& file_name) { Load(file_name); }
+
+    std::size_t GetNumEntries() const { return mEntries.size(); }
+
+    // Keeps the faster of the stored and the given entry. Returns true if entry was stored.
+    bool Store(const GemmTuningKey& key, const GemmTuningEntry& entry)
+    {
+        if(entry.instance_name.find_first_of("\t\n") != std::string::npos)
+            throw std::runtime_error("GemmTuningDatabase: instance name contains tab or newline");
+
+        auto [iter, inserted] = mEntries.emplace(key, entry);
+
+        if(inserted)
+            return true;
+
+        if(entry.ave_time < iter->second.ave_time)
+        {
+            iter->second = entry;
+            return true;
+        }
+
+        return false;
+    }
+
+    std::optional<GemmTuningEntry> Find(const GemmTuningKey& key) const
+    {
+        const auto iter = mEntries.find(key);
+
+        if(iter == mEntries.end())
+            return std::nullopt;
+
+        return iter->second;
+    }
+
+    // Entry of the same operation whose problem size is closest to key, measured as the sum of
+    // |log2(a / b)| over M, N and K. The entry of key itself (see Find) and entries further away
+    // than max_distance are ignored.
+    std::optional<std::pair<GemmTuningKey, GemmTuningEntry>>
+    FindNearest(const GemmTuningKey& key, double max_distance = 3.0) const
+    {
+        std::optional<std::pair<GemmTuningKey, GemmTuningEntry>> nearest;
+
+        double min_distance = max_distance;
+
+        const GemmTuningKey first{key.op_name,
+                                  std::numeric_limits<std::int64_t>::min(),
+                                  std::numeric_limits<std::int64_t>::min(),
+                                  std::numeric_limits<std::int64_t>::min()};
+
+        for(auto iter = mEntries.lower_bound(first);
+            iter != mEntries.end() && iter->first.op_name == key.op_name;
+            ++iter)
+        {
+            if(iter->first == key)
+                continue;
+
+            const double distance = GetDistance(key, iter->first);
+
+            if(distance <= min_distance)
+            {
+                min_distance = distance;
+                nearest      = *iter;
+            }
+        }
+
+        return nearest;
+    }
+
+    // Merges the entries of file_name into the database.
+    void Load(const std::string& file_name)
+    {
+        std::ifstream file(file_name);
+
+        if(!file)
+            throw std::runtime_error("GemmTuningDatabase: cannot open " + file_name);
+
+        std::string line;
+
+        if(!std::getline(file, line) || line != kFileHeader)
+            throw std::runtime_error("GemmTuningDatabase: " + file_name +
+                                     " is not a gemm tuning database");
+
+        std::size_t line_number = 1;
+
+        while(std::getline(file, line))
+        {
+            ++line_number;
+
+            if(line.empty() || line[0] == '#')
+                continue;
+
+            GemmTuningKey key;
+            GemmTuningEntry entry;
+
+            if(!ParseLine(line, key, entry))
+                throw std::runtime_error("GemmTuningDatabase: malformed entry in " + file_name +
+                                         ":" + std::to_string(line_number));
+
+            Store(key, entry);
+        }
+    }
+
+    // One tab-separated line per entry: op_name M N K kbatch ave_time instance_name
+    void Save(const std::string& file_name) const
+    {
+        std::ofstream file(file_name);
+
+        if(!file)
+            throw std::runtime_error("GemmTuningDatabase: cannot open " + file_name);
+
+        file << kFileHeader << '\n';
+        file << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+        for(const auto& [key, entry] : mEntries)
+        {
+            file << key.op_name << '\t' << key.M << '\t' << key.N << '\t' << key.K << '\t'
+                 << entry.kbatch << '\t' << entry.ave_time << '\t' << entry.instance_name << '\n';
+        }
+
+        if(!file)
+            throw std::runtime_error("GemmTuningDatabase: failed to write " + file_name);
+    }
+
+    private:
+    static double GetDistance(const GemmTuningKey& lhs, const GemmTuningKey& rhs)
+    {
+        const auto log_ratio = [](std::int64_t a, std::int64_t b) {
+            return std::abs(std::log2(static_cast<double>(std::max<std::int64_t>(a, 1)) /
+                                      static_cast<double>(std::max<std::int64_t>(b, 1))));
+        };
+
+        return log_ratio(lhs.M, rhs.M) + log_ratio(lhs.N, rhs.N) + log_ratio(lhs.K, rhs.K);
+    }
+
+    static bool ParseLine(const std::string& line, GemmTuningKey& key, GemmTuningEntry& entry)
+    {
+        std::istringstream is(line);
+        std::string field;
+
+        const auto next_field = [&]() { return static_cast<bool>(std::getline(is, field, '\t')); };
+
+        const auto parse_number = [&](auto& value) {
+            if(!next_field())
+                return false;
+
+            std::istringstream field_is(field);
+            field_is >> value;
+
+            return !field_is.fail() && field_is.eof();
+        };
+
+        if(!next_field() || field.empty())
+            return false;
+
+        key.op_name = field;
+
+        if(!parse_number(key.M) || !parse_number(key.N) || !parse_number(key.K) ||
+           !parse_number(entry.kbatch) || !parse_number(entry.ave_time))
+            return false;
+
+        // the instance name is the remainder of the line
+        if(!std::getline(is, entry.instance_name) || entry.instance_name.empty())
+            return false;
+
+        return entry.kbatch > 0;
+    }
+
+    std::map<GemmTuningKey, GemmTuningEntry> mEntries;
+};
+
+struct GemmTileConfig
+{
+    int block_size  = 0;
+    int m_per_block = 0;
+    int n_per_block = 0;
+    int k_per_block = 0;
+};
+
+// Extracts the block tile from the GetTypeString() of the universal GEMM instances
+// ("... BlkSize: 256, BlkTile: 128x128x64, ...").
+inline std::optional<GemmTileConfig> ParseGemmTileConfig(const std::string& type_string)
+{
+    const auto block_size_pos = type_string.find("BlkSize:");
+    const auto block_tile_pos = type_string.find("BlkTile:");
+
+    if(block_size_pos == std::string::npos || block_tile_pos == std::string::npos)
+        return std::nullopt;
+
+    GemmTileConfig config;
+    char x0 = 0;
+    char x1 = 0;
+
+    std::istringstream block_size_is(type_string.substr(block_size_pos + 8));
+    std::istringstream block_tile_is(type_string.substr(block_tile_pos + 8));
+
+    block_size_is >> config.block_size;
+    block_tile_is >> config.m_per_block >> x0 >> config.n_per_block >> x1 >> config.k_per_block;
+
+    if(block_size_is.fail() || block_tile_is.fail() || x0 != 'x' || x1 != 'x')
+        return std::nullopt;
+
+    if(config.block_size <= 0 || config.m_per_block <= 0 || config.n_per_block <= 0 ||
+       config.k_per_block <= 0)
+        return std::nullopt;
+
+    return config;
+}
+
+namespace detail {
+
+template <typename Instance, typename = void>
+struct HasInstanceDescriptor : std::false_type
+{
+};
+
+template <typename Instance>
+struct HasInstanceDescriptor<Instance,
+                             std::void_t<decltype(std::declval<const Instance&>()
+                                                      .GetInstanceDescriptor())>>
+    : std::true_type
+{
+};
+
+} // namespace detail
+
+// Block tile of an instance, taken from its GetInstanceDescriptor() where available and parsed
+// from its type string otherwise.
+template <typename Instance>
+std::optional<GemmTileConfig> GetGemmTileConfig(const Instance& instance,
+                                                const std::string& type_string)
+{
+    if constexpr(detail::HasInstanceDescriptor<Instance>::value)
+    {
+        if(const auto desc = instance.GetInstanceDescriptor())
+        {
+            if(desc->block_size > 0 && desc->m_per_block > 0 && desc->n_per_block > 0 &&
+               desc->k_per_block > 0)
+                return GemmTileConfig{
+                    desc->block_size, desc->m_per_block, desc->n_per_block, desc->k_per_block};
+        }
+    }
+
+    return ParseGemmTileConfig(type_string);
+}
+
+struct GemmTileEfficiency
+{
+    int kbatch = 1;
+
+    // useful fraction of the padded M x N x K iteration space
+    double padding = 0;
+    // fraction of the CUs busy, averaged over all waves of workgroups
+    double wave = 0;
+    // A/B data reuse of the block tile relative to a 256x256 tile, capped at 1
+    double reuse = 0;
+    // fraction of the workgroup memory traffic spent on loading A/B rather than storing C
+    double store = 0;
+
+    double GetScore() const { return padding * wave * reuse * store; }
+};
+
+// Analytical efficiency of running an M x N x K GEMM with the given block tile and split-K
+// factor on num_cu compute units.
+inline GemmTileEfficiency EstimateGemmTileEfficiency(const GemmTileConfig& tile,
+                                                     std::int64_t M,
+                                                     std::int64_t N,
+                                                     std::int64_t K,
+                                                     int kbatch,
+                                                     int num_cu)
+{
+    const auto integer_divide_ceil = [](std::int64_t a, std::int64_t b) { return (a + b - 1) / b; };
+
+    GemmTileEfficiency eff;
+    eff.kbatch = kbatch;
+
+    if(M <= 0 || N <= 0 || K <= 0 || kbatch <= 0 || num_cu <= 0)
+        return eff;
+
+    const std::int64_t k_per_split = std::int64_t{tile.k_per_block} * kbatch;
+
+    const std::int64_t m_tiles  = integer_divide_ceil(M, tile.m_per_block);
+    const std::int64_t n_tiles  = integer_divide_ceil(N, tile.n_per_block);
+    const std::int64_t k_per_wg = integer_divide_ceil(K, k_per_split) * tile.k_per_block;
+    const std::int64_t num_wg   = m_tiles * n_tiles * kbatch;
+    const std::int64_t num_wave = integer_divide_ceil(num_wg, num_cu);
+
+    const double padded_m = static_cast<double>(m_tiles * tile.m_per_block);
+    const double padded_n = static_cast<double>(n_tiles * tile.n_per_block);
+    const double padded_k = static_cast<double>(k_per_wg * kbatch);
+
+    eff.padding = static_cast<double>(M) * static_cast<double>(N) * static_cast<double>(K) /
+                  (padded_m * padded_n * padded_k);
+
+    eff.wave = static_cast<double>(num_wg) / static_cast<double>(num_wave * num_cu);
+
+    const double tile_m = tile.m_per_block;
+    const double tile_n = tile.n_per_block;
+
+    eff.reuse = std::min(tile_m * tile_n / (tile_m + tile_n) / 128.0, 1.0);
+
+    const double load_elements  = static_cast<double>(k_per_wg) * (tile_m + tile_n);
+    const double store_elements = tile_m * tile_n;
+
+    eff.store = load_elements / (load_elements + store_elements);
+
+    return eff;
+}
+
+// Best split-K factor (at most max_kbatch) for the tile; every split keeps at least one
+// KPerBlock iteration.
+inline GemmTileEfficiency SelectGemmKBatch(const GemmTileConfig& tile,
+                                           std::int64_t M,
+                                           std::int64_t N,
+                                           std::int64_t K,
+                                           int num_cu,
+                                           int max_kbatch = 32)
+{
+    GemmTileEfficiency best = EstimateGemmTileEfficiency(tile, M, N, K, 1, num_cu);
+
+    for(int kbatch = 2; kbatch <= max_kbatch; kbatch *= 2)
+    {
+        if(K < std::int64_t{tile.k_per_block} * kbatch)
+            break;
+
+        const auto eff = EstimateGemmTileEfficiency(tile, M, N, K, kbatch, num_cu);
+
+        if(eff.GetScore() > best.GetScore())
+            best = eff;
+    }
+
+    return best;
+}
+
+struct GemmInstanceCandidate
+{
+    // position in the instance list passed to RankGemmInstanceCandidates
+    std::size_t index = 0;
+
+    int kbatch   = 1;
+    double score = 0;
+};
+
+// Orders the instances returned by an instance factory for problem key: the tuned instance of
+// key first, then the tuned instance of the nearest shape, then all other instances by
+// decreasing analytical score. Instances without a known block tile come last. Callers pick the
+// first candidate whose IsSupportedArgument() holds. Works on any container of pointers to
+// objects with GetTypeString() (and optionally GetInstanceDescriptor()).
+template <typename InstanceContainer>
+std::vector<GemmInstanceCandidate> RankGemmInstanceCandidates(const GemmTuningDatabase& db,
+                                                              const GemmTuningKey& key,
+                                                              const InstanceContainer& instances,
+                                                              int num_cu,
+                                                              int max_kbatch = 32)
+{
+    std::vector<std::string> type_strings;
+    type_strings.reserve(instances.size());
+
+    for(const auto& p_instance : instances)
+        type_strings.push_back(p_instance->GetTypeString());
+
+    std::vector<GemmInstanceCandidate> candidates;
+    std::vector<bool> is_ranked(type_strings.size(), false);
+
+    const auto add_tuned = [&](const GemmTuningEntry& entry) {
+        for(std::size_t i = 0; i < type_strings.size(); ++i)
+        {
+            if(!is_ranked[i] && type_strings[i] == entry.instance_name)
+            {
+                is_ranked[i] = true;
+                candidates.push_back({i, entry.kbatch, std::numeric_limits<double>::infinity()});
+                return;
+            }
+        }
+    };
+
+    if(const auto exact = db.Find(key))
+        add_tuned(*exact);
+
+    if(const auto nearest = db.FindNearest(key))
+        add_tuned(nearest->second);
+
+    const std::size_t num_tuned = candidates.size();
+
+    std::vector<GemmInstanceCandidate> unparsed;
+
+    for(std::size_t i = 0; i < type_strings.size(); ++i)
+    {
+        if(is_ranked[i])
+            continue;
+
+        if(const auto tile = GetGemmTileConfig(*instances[i], type_strings[i]))
+        {
+            const auto eff = SelectGemmKBatch(*tile, key.M, key.N, key.K, num_cu, max_kbatch);
+            candidates.push_back({i, eff.kbatch, eff.GetScore()});
+        }
+        else
+        {
+            unparsed.push_back({i, 1, 0});
+        }
+    }
+
+    std::stable_sort(candidates.begin() + num_tuned,
+                     candidates.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.score > rhs.score; });
+
+    candidates.insert(candidates.end(), unparsed.begin(), unparsed.end());
+
+    return candidates;
+}
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
@@ -12,6 +12,10 @@
 
 #include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
 
+#ifdef CK_USE_INSTANCE_PLUGINS
+#include "ck/library/tensor_operation_instance/instance_plugin.hpp"
+#endif
+
 namespace ck {
 namespace tensor_operation {
 namespace device {
@@ -541,6 +545,9 @@ struct DeviceOperationInstanceFactory<
 
     static auto GetInstances()
     {
+#if defined(CK_USE_INSTANCE_PLUGINS) && !defined(CK_INSTANCE_PLUGIN_BUILD)
+        return GetPluginInstances<DeviceOp>("gemm_universal");
+#else
         std::vector<std::unique_ptr<DeviceOp>> op_ptrs;
 
 #ifdef CK_ENABLE_FP16
@@ -811,6 +818,7 @@ struct DeviceOperationInstanceFactory<
         }
 #endif
         return op_ptrs;
+#endif
     }
 };
 
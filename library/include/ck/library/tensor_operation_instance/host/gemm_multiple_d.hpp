@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/device_gemm_multiple_d.hpp"
+#include "ck/tensor_operation/cpu/device/impl/device_gemm_multiple_d_host.hpp"
+#include "ck/library/tensor_operation_instance/host/host_instance_common.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// Host instances of DeviceGemmMultipleD for any layouts, data types and element-wise
+// operations: DeviceOperationInstanceFactory<DeviceOp, HostInstanceTag>::GetInstances()
+template <typename ALayout,
+          typename BLayout,
+          typename DsLayout,
+          typename ELayout,
+          typename ADataType,
+          typename BDataType,
+          typename DsDataType,
+          typename EDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CDEElementwiseOperation>
+struct DeviceOperationInstanceFactory<
+    ck::tensor_operation::device::DeviceGemmMultipleD<ALayout,
+                                                      BLayout,
+                                                      DsLayout,
+                                                      ELayout,
+                                                      ADataType,
+                                                      BDataType,
+                                                      DsDataType,
+                                                      EDataType,
+                                                      AElementwiseOperation,
+                                                      BElementwiseOperation,
+                                                      CDEElementwiseOperation>,
+    HostInstanceTag>
+{
+    using DeviceOp = DeviceGemmMultipleD<ALayout,
+                                         BLayout,
+                                         DsLayout,
+                                         ELayout,
+                                         ADataType,
+                                         BDataType,
+                                         DsDataType,
+                                         EDataType,
+                                         AElementwiseOperation,
+                                         BElementwiseOperation,
+                                         CDEElementwiseOperation>;
+
+    using AccDataType = HostAccDataType<ADataType>;
+
+    template <ck::utils::HostGemmAccumulation Accumulation>
+    using Instance = DeviceGemmMultipleD_Host<ALayout,
+                                              BLayout,
+                                              DsLayout,
+                                              ELayout,
+                                              ADataType,
+                                              BDataType,
+                                              DsDataType,
+                                              EDataType,
+                                              AElementwiseOperation,
+                                              BElementwiseOperation,
+                                              CDEElementwiseOperation,
+                                              AccDataType,
+                                              Accumulation>;
+
+    static auto GetInstances()
+    {
+        std::vector<std::unique_ptr<DeviceOp>> op_ptrs;
+
+        op_ptrs.push_back(
+            std::make_unique<Instance<ck::utils::HostGemmAccumulation::Sequential>>());
+
+        if constexpr(HasFusedHostInstance<AccDataType>())
+        {
+            op_ptrs.push_back(
+                std::make_unique<Instance<ck::utils::HostGemmAccumulation::Fused>>());
+        }
+
+        return op_ptrs;
+    }
+};
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/device_grouped_conv_fwd_multiple_abd.hpp"
+#include "ck/tensor_operation/cpu/device/impl/device_grouped_conv_fwd_multiple_abd_host.hpp"
+#include "ck/library/tensor_operation_instance/host/host_instance_common.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// Host instances of DeviceGroupedConvFwdMultipleABD for any layouts, data types and element-wise
+// operations with a single A and B tensor:
+// DeviceOperationInstanceFactory<DeviceOp, HostInstanceTag>::GetInstances()
+template <ck::index_t NumDimSpatial,
+          typename ALayout,
+          typename BLayout,
+          typename DsLayout,
+          typename ELayout,
+          typename ADataType,
+          typename BDataType,
+          typename DsDataType,
+          typename EDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CDEElementwiseOperation,
+          typename AComputeType,
+          typename BComputeType>
+struct DeviceOperationInstanceFactory<
+    ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD<NumDimSpatial,
+                                                                  ALayout,
+                                                                  BLayout,
+                                                                  DsLayout,
+                                                                  ELayout,
+                                                                  ADataType,
+                                                                  BDataType,
+                                                                  DsDataType,
+                                                                  EDataType,
+                                                                  AElementwiseOperation,
+                                                                  BElementwiseOperation,
+                                                                  CDEElementwiseOperation,
+                                                                  AComputeType,
+                                                                  BComputeType>,
+    HostInstanceTag>
+{
+    using DeviceOp = DeviceGroupedConvFwdMultipleABD<NumDimSpatial,
+                                                     ALayout,
+                                                     BLayout,
+                                                     DsLayout,
+                                                     ELayout,
+                                                     ADataType,
+                                                     BDataType,
+                                                     DsDataType,
+                                                     EDataType,
+                                                     AElementwiseOperation,
+                                                     BElementwiseOperation,
+                                                     CDEElementwiseOperation,
+                                                     AComputeType,
+                                                     BComputeType>;
+
+    using AccDataType = HostAccDataType<AComputeType>;
+
+    template <ck::utils::HostGemmAccumulation Accumulation>
+    using Instance = DeviceGroupedConvFwdMultipleABD_Host<NumDimSpatial,
+                                                          ALayout,
+                                                          BLayout,
+                                                          DsLayout,
+                                                          ELayout,
+                                                          ADataType,
+                                                          BDataType,
+                                                          DsDataType,
+                                                          EDataType,
+                                                          AElementwiseOperation,
+                                                          BElementwiseOperation,
+                                                          CDEElementwiseOperation,
+                                                          AccDataType,
+                                                          Accumulation,
+                                                          AComputeType,
+                                                          BComputeType>;
+
+    static auto GetInstances()
+    {
+        std::vector<std::unique_ptr<DeviceOp>> op_ptrs;
+
+        if constexpr(!DeviceOp::isMultiA && !DeviceOp::isMultiB)
+        {
+            op_ptrs.push_back(
+                std::make_unique<Instance<ck::utils::HostGemmAccumulation::Sequential>>());
+
+            if constexpr(HasFusedHostInstance<AccDataType>())
+            {
+                op_ptrs.push_back(
+                    std::make_unique<Instance<ck::utils::HostGemmAccumulation::Fused>>());
+            }
+        }
+
+        return op_ptrs;
+    }
+};
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+#include "ck/library/utility/host_blocked_gemm.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// accumulator of the host instances: int32 for int8 inputs, double for double inputs, float
+// otherwise
+template <typename ADataType>
+using HostAccDataType =
+    std::conditional_t<is_same_v<ADataType, int8_t>,
+                       int32_t,
+                       std::conditional_t<is_same_v<ADataType, double>, double, float>>;
+
+// Fused multiply-add only makes a difference for floating point accumulators, so integer
+// accumulators get a single instance.
+template <typename AccDataType>
+constexpr bool HasFusedHostInstance()
+{
+    return std::is_floating_point_v<AccDataType>;
+}
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
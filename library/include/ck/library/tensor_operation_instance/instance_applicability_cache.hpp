@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ck/tensor_operation/gpu/device/device_instance_descriptor.hpp"
+#include "ck/tensor_operation/gpu/device/device_gemm_applicability.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+struct GemmApplicabilityCacheStats
+{
+    // Find() calls answered from the memo
+    std::size_t num_hits = 0;
+    // Find() calls that had to check the instances
+    std::size_t num_misses = 0;
+    // instances ruled out by IsGemmProblemApplicable() on a miss
+    std::size_t num_prefiltered = 0;
+    // instances passed to the full check on a miss
+    std::size_t num_checked = 0;
+};
+
+// Memo of the instances of one instance list that support a GEMM problem.
+//
+// Picking an instance for a new shape otherwise means calling MakeArgumentPointer() and
+// IsSupportedArgument() on every instance of the list. On the first request for a problem
+// signature, Find() drops the instances that IsGemmProblemApplicable() rules out from their
+// descriptor, runs the caller's full check on the rest and remembers the indices of the
+// instances that passed, so a repeated shape costs one hash lookup. Safe to use from several
+// threads.
+class GemmApplicabilityCache
+{
+    public:
+    // Ascending indices into instances of the instances that support problem.
+    // is_supported(index) is the full check (typically MakeArgumentPointer() +
+    // IsSupportedArgument()); it is called on a miss only, and only for instances that pass the
+    // pre-filter. All calls have to pass the same instance list in the same order. The returned
+    // reference stays valid until Clear().
+    template <typename InstanceContainer, typename IsSupported>
+    const std::vector<std::size_t>& Find(const InstanceContainer& instances,
+                                         const GemmProblemSignature& problem,
+                                         IsSupported&& is_supported)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+
+            InitDescriptors(instances);
+
+            if(const auto iter = mEntries.find(problem); iter != mEntries.end())
+            {
+                ++mStats.num_hits;
+                return iter->second;
+            }
+        }
+
+        // check outside of the lock, a concurrent miss of the same problem computes the same
+        std::vector<std::size_t> supported;
+        std::size_t num_prefiltered = 0;
+
+        for(std::size_t i = 0; i < mDescriptors.size(); ++i)
+        {
+            if(mDescriptors[i] && !IsGemmProblemApplicable(*mDescriptors[i], problem))
+            {
+                ++num_prefiltered;
+                continue;
+            }
+
+            if(is_supported(i))
+                supported.push_back(i);
+        }
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        ++mStats.num_misses;
+        mStats.num_prefiltered += num_prefiltered;
+        mStats.num_checked += mDescriptors.size() - num_prefiltered;
+
+        return mEntries.emplace(problem, std::move(supported)).first->second;
+    }
+
+    std::size_t GetNumEntries() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mEntries.size();
+    }
+
+    GemmApplicabilityCacheStats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mStats;
+    }
+
+    // Forgets all problems and the instance list. Must not run concurrently with Find().
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        mDescriptors.clear();
+        mEntries.clear();
+        mStats = {};
+        mIsInitialized = false;
+    }
+
+    private:
+    // called with mMutex held
+    template <typename InstanceContainer>
+    void InitDescriptors(const InstanceContainer& instances)
+    {
+        if(mIsInitialized)
+        {
+            if(instances.size() != mDescriptors.size())
+                throw std::runtime_error(
+                    "GemmApplicabilityCache: called with a different instance list");
+
+            return;
+        }
+
+        mDescriptors.reserve(instances.size());
+
+        for(const auto& p_instance : instances)
+            mDescriptors.push_back(p_instance->GetInstanceDescriptor());
+
+        mIsInitialized = true;
+    }
+
+    mutable std::mutex mMutex;
+
+    bool mIsInitialized = false;
+    std::vector<std::optional<DeviceInstanceDescriptor>> mDescriptors;
+    std::unordered_map<GemmProblemSignature, std::vector<std::size_t>, GemmProblemSignatureHash>
+        mEntries;
+    GemmApplicabilityCacheStats mStats;
+};
+
+// The process-wide cache of an instance list, e.g.
+// GetGemmApplicabilityCache<DeviceOperationInstanceFactory<DeviceOp>>() for the instances of
+// DeviceOperationInstanceFactory<DeviceOp>::GetInstances().
+template <typename InstanceList>
+GemmApplicabilityCache& GetGemmApplicabilityCache()
+{
+    static GemmApplicabilityCache cache;
+    return cache;
+}
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
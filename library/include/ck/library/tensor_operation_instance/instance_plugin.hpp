@@ -0,0 +1,354 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include "ck/utility/env.hpp"
+
+// Path of the instance plugin manifest, read on the first request for plugin instances.
+CK_DECLARE_ENV_VAR_STR(CK_INSTANCE_PLUGIN_MANIFEST)
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+// Instance plugins.
+//
+// With CK_INSTANCE_PLUGINS=ON the instances of an instance directory ("bucket", e.g.
+// "gemm_universal") are additionally linked into a shared object that is only loaded when an
+// instance factory of that bucket is first asked for its instances. A process that only needs a
+// few op families therefore does not pay for loading the code objects of all the others.
+//
+// The manifest lists one bucket per line as "<bucket> <library path>"; relative paths are
+// resolved against the directory of the manifest, lines starting with '#' are ignored. The build
+// writes lib/ck_instance_plugins.manifest.
+//
+// A plugin exports two C functions, defined by CK_INSTANCE_PLUGIN (see below):
+//   int ck_instance_plugin_abi_version();
+//   int ck_instance_plugin_get_instances(const char* device_op_name, void* p_instances);
+// The second one appends the instances of the DeviceOp whose typeid name is device_op_name to
+// the std::vector<std::unique_ptr<DeviceOp>> at p_instances and returns 1, or returns 0 if the
+// plugin does not provide that DeviceOp. Plugins are never unloaded, since the returned
+// instances refer to their code.
+
+inline constexpr int kInstancePluginAbiVersion = 1;
+
+struct InstancePluginStats
+{
+    std::string bucket;
+    std::string library_path;
+
+    bool loaded         = false;
+    double load_time_ms = 0;
+
+    // growth of the resident set size of the process while the plugin was loaded
+    std::int64_t rss_delta_bytes = 0;
+
+    // number of GetInstances() calls served and of instances returned by them
+    std::size_t num_get_instances = 0;
+    std::size_t num_instances     = 0;
+};
+
+using InstancePluginStatsCallback = std::function<void(const InstancePluginStats&)>;
+
+namespace detail {
+
+inline std::int64_t GetResidentSetBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+
+    std::int64_t num_page_total    = 0;
+    std::int64_t num_page_resident = 0;
+
+    if(!(statm >> num_page_total >> num_page_resident))
+        return 0;
+
+    return num_page_resident * static_cast<std::int64_t>(sysconf(_SC_PAGESIZE));
+}
+
+} // namespace detail
+
+class InstancePluginRegistry
+{
+    public:
+    static InstancePluginRegistry& Instance()
+    {
+        static InstancePluginRegistry registry;
+        return registry;
+    }
+
+    InstancePluginRegistry(const InstancePluginRegistry&) = delete;
+    InstancePluginRegistry& operator=(const InstancePluginRegistry&) = delete;
+
+    // Adds the buckets of the manifest. Buckets that are already known keep their library.
+    void LoadManifest(const std::string& file_name)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        LoadManifestLocked(file_name);
+    }
+
+    // Registers a single bucket, e.g. for plugins outside of the manifest.
+    void AddBucket(const std::string& bucket, const std::string& library_path)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        AddBucketLocked(bucket, library_path);
+    }
+
+    bool HasBucket(const std::string& bucket)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        LoadDefaultManifest();
+
+        return mBuckets.count(bucket) != 0;
+    }
+
+    // Instances of DeviceOp provided by the plugin of bucket, loading the plugin on first use.
+    // Returns no instances if the plugin does not provide DeviceOp.
+    template <typename DeviceOp>
+    std::vector<std::unique_ptr<DeviceOp>> GetInstances(const std::string& bucket)
+    {
+        std::vector<std::unique_ptr<DeviceOp>> instances;
+
+        Bucket& b = GetLoadedBucket(bucket);
+
+        b.p_get_instances(typeid(DeviceOp).name(), &instances);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        b.stats.num_get_instances += 1;
+        b.stats.num_instances += instances.size();
+
+        return instances;
+    }
+
+    std::vector<InstancePluginStats> GetStats()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        LoadDefaultManifest();
+
+        std::vector<InstancePluginStats> stats;
+        stats.reserve(mBuckets.size());
+
+        for(const auto& [name, b] : mBuckets)
+            stats.push_back(b.stats);
+
+        return stats;
+    }
+
+    // Called once for every plugin after it has been loaded.
+    void SetStatsCallback(InstancePluginStatsCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStatsCallback = std::move(callback);
+    }
+
+    private:
+    using GetInstancesFunc = int (*)(const char*, void*);
+    using AbiVersionFunc   = int (*)();
+
+    struct Bucket
+    {
+        InstancePluginStats stats;
+
+        void* p_handle                   = nullptr;
+        GetInstancesFunc p_get_instances = nullptr;
+    };
+
+    InstancePluginRegistry() = default;
+
+    // must be called with mMutex held
+    void LoadManifestLocked(const std::string& file_name)
+    {
+        std::ifstream file(file_name);
+
+        if(!file)
+            throw std::runtime_error("InstancePluginRegistry: cannot open " + file_name);
+
+        const auto slash_pos       = file_name.find_last_of('/');
+        const std::string dir_name =
+            slash_pos == std::string::npos ? std::string() : file_name.substr(0, slash_pos + 1);
+
+        std::string line;
+
+        while(std::getline(file, line))
+        {
+            std::istringstream is(line);
+            std::string bucket;
+            std::string library_path;
+
+            if(!(is >> bucket) || bucket[0] == '#')
+                continue;
+
+            if(!(is >> library_path))
+                throw std::runtime_error("InstancePluginRegistry: no library for bucket " +
+                                         bucket + " in " + file_name);
+
+            if(library_path[0] != '/')
+                library_path = dir_name + library_path;
+
+            AddBucketLocked(bucket, library_path);
+        }
+    }
+
+    // must be called with mMutex held
+    void AddBucketLocked(const std::string& bucket, const std::string& library_path)
+    {
+        auto [iter, inserted] = mBuckets.try_emplace(bucket);
+
+        if(inserted)
+        {
+            iter->second.stats.bucket       = bucket;
+            iter->second.stats.library_path = library_path;
+        }
+    }
+
+    // must be called with mMutex held
+    void LoadDefaultManifest()
+    {
+        if(mIsManifestLoaded)
+            return;
+
+        mIsManifestLoaded = true;
+
+        const std::string& file_name = EnvGetString(CK_ENV(CK_INSTANCE_PLUGIN_MANIFEST));
+
+        if(!file_name.empty())
+            LoadManifestLocked(file_name);
+    }
+
+    Bucket& GetLoadedBucket(const std::string& bucket)
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        LoadDefaultManifest();
+
+        const auto iter = mBuckets.find(bucket);
+
+        if(iter == mBuckets.end())
+            throw std::runtime_error("InstancePluginRegistry: unknown instance bucket " + bucket +
+                                     ", set CK_INSTANCE_PLUGIN_MANIFEST");
+
+        Bucket& b = iter->second;
+
+        if(b.stats.loaded)
+            return b;
+
+        const auto start_time = std::chrono::steady_clock::now();
+        const auto start_rss  = detail::GetResidentSetBytes();
+
+        void* p_handle = dlopen(b.stats.library_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+
+        if(p_handle == nullptr)
+            throw std::runtime_error("InstancePluginRegistry: cannot load " +
+                                     b.stats.library_path + ": " + dlerror());
+
+        const auto p_abi_version =
+            reinterpret_cast<AbiVersionFunc>(dlsym(p_handle, "ck_instance_plugin_abi_version"));
+        const auto p_get_instances = reinterpret_cast<GetInstancesFunc>(
+            dlsym(p_handle, "ck_instance_plugin_get_instances"));
+
+        if(p_abi_version == nullptr || p_get_instances == nullptr ||
+           p_abi_version() != kInstancePluginAbiVersion)
+        {
+            dlclose(p_handle);
+            throw std::runtime_error("InstancePluginRegistry: " + b.stats.library_path +
+                                     " is not a compatible instance plugin");
+        }
+
+        const std::chrono::duration<double, std::milli> load_time =
+            std::chrono::steady_clock::now() - start_time;
+
+        b.p_handle              = p_handle;
+        b.p_get_instances       = p_get_instances;
+        b.stats.loaded          = true;
+        b.stats.load_time_ms    = load_time.count();
+        b.stats.rss_delta_bytes = detail::GetResidentSetBytes() - start_rss;
+
+        const auto callback = mStatsCallback;
+        const auto stats    = b.stats;
+
+        lock.unlock();
+
+        if(callback)
+            callback(stats);
+
+        return b;
+    }
+
+    std::mutex mMutex;
+    bool mIsManifestLoaded = false;
+    std::map<std::string, Bucket> mBuckets;
+    InstancePluginStatsCallback mStatsCallback;
+};
+
+template <typename DeviceOp>
+std::vector<std::unique_ptr<DeviceOp>> GetPluginInstances(const std::string& bucket)
+{
+    return InstancePluginRegistry::Instance().GetInstances<DeviceOp>(bucket);
+}
+
+namespace detail {
+
+template <template <typename...> class Factory, typename DeviceOp>
+bool AddPluginInstances(const char* device_op_name, void* p_instances)
+{
+    if(std::strcmp(device_op_name, typeid(DeviceOp).name()) != 0)
+        return false;
+
+    auto& instances = *static_cast<std::vector<std::unique_ptr<DeviceOp>>*>(p_instances);
+
+    for(auto& p_instance : Factory<DeviceOp>::GetInstances())
+        instances.push_back(std::move(p_instance));
+
+    return true;
+}
+
+template <template <typename...> class Factory, typename... DeviceOps>
+int GetPluginInstances(const char* device_op_name, void* p_instances, std::tuple<DeviceOps...>*)
+{
+    return (AddPluginInstances<Factory, DeviceOps>(device_op_name, p_instances) || ...) ? 1 : 0;
+}
+
+} // namespace detail
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+
+#define CK_INSTANCE_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+
+// Defines the entry points of an instance plugin. DeviceOps is a std::tuple of the device
+// operation types the plugin serves, Factory the template providing their GetInstances()
+// (normally DeviceOperationInstanceFactory). Must be used once per plugin in the global
+// namespace.
+#define CK_INSTANCE_PLUGIN(Factory, DeviceOps)                                       \
+    CK_INSTANCE_PLUGIN_EXPORT int ck_instance_plugin_abi_version()                   \
+    {                                                                                \
+        return ::ck::tensor_operation::device::instance::kInstancePluginAbiVersion;  \
+    }                                                                                \
+    CK_INSTANCE_PLUGIN_EXPORT int ck_instance_plugin_get_instances(                  \
+        const char* device_op_name, void* p_instances)                               \
+    {                                                                                \
+        return ::ck::tensor_operation::device::instance::detail::GetPluginInstances< \
+            Factory>(device_op_name, p_instances, static_cast<DeviceOps*>(nullptr)); \
+    }
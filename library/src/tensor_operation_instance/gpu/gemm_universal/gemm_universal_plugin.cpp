@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <tuple>
+#include <utility>
+
+#include "ck/library/tensor_operation_instance/gpu/gemm_universal.hpp"
+#include "ck/library/tensor_operation_instance/instance_plugin.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+namespace {
+
+template <typename ALayout,
+          typename BLayout,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType>
+using DeviceGemmUniversal = DeviceGemmV2<ALayout,
+                                         BLayout,
+                                         Row,
+                                         ADataType,
+                                         BDataType,
+                                         CDataType,
+                                         element_wise::PassThrough,
+                                         element_wise::PassThrough,
+                                         element_wise::PassThrough>;
+
+#ifdef CK_ENABLE_FP16
+using F16DeviceOps = std::tuple<DeviceGemmUniversal<Row, Row, F16, F16, F16>,
+                                DeviceGemmUniversal<Row, Col, F16, F16, F16>>;
+#else
+using F16DeviceOps = std::tuple<>;
+#endif
+
+#ifdef CK_ENABLE_BF16
+using BF16DeviceOps = std::tuple<DeviceGemmUniversal<Row, Row, BF16, BF16, BF16>,
+                                 DeviceGemmUniversal<Row, Col, BF16, BF16, BF16>,
+                                 DeviceGemmUniversal<Col, Row, BF16, BF16, BF16>,
+                                 DeviceGemmUniversal<Col, Col, BF16, BF16, BF16>>;
+#else
+using BF16DeviceOps = std::tuple<>;
+#endif
+
+// the fp8 instances are only built for the targets that support them
+#if defined(CK_ENABLE_FP16) && defined(CK_ENABLE_FP8) && \
+    (defined(CK_USE_FP8_ON_UNSUPPORTED_ARCH) || defined(CK_USE_GFX94))
+using F16F8DeviceOps = std::tuple<DeviceGemmUniversal<Row, Row, F16, F8, F16>,
+                                  DeviceGemmUniversal<Row, Col, F16, F8, F16>,
+                                  DeviceGemmUniversal<Row, Row, F8, F16, F16>,
+                                  DeviceGemmUniversal<Row, Col, F8, F16, F16>>;
+#else
+using F16F8DeviceOps = std::tuple<>;
+#endif
+
+#if defined(CK_ENABLE_BF16) && defined(CK_ENABLE_FP8) && \
+    (defined(CK_USE_FP8_ON_UNSUPPORTED_ARCH) || defined(CK_USE_GFX94))
+using F8BF16DeviceOps = std::tuple<DeviceGemmUniversal<Row, Row, F8, F8, BF16>,
+                                   DeviceGemmUniversal<Row, Col, F8, F8, BF16>>;
+#else
+using F8BF16DeviceOps = std::tuple<>;
+#endif
+
+using GemmUniversalDeviceOps = decltype(std::tuple_cat(std::declval<F16DeviceOps>(),
+                                                       std::declval<BF16DeviceOps>(),
+                                                       std::declval<F16F8DeviceOps>(),
+                                                       std::declval<F8BF16DeviceOps>()));
+
+} // namespace
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+
+CK_INSTANCE_PLUGIN(ck::tensor_operation::device::instance::DeviceOperationInstanceFactory,
+                   ck::tensor_operation::device::instance::GemmUniversalDeviceOps)
@@ -9,6 +9,7 @@
 
 #include "ck/ck.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/device/device_gemm_applicability.hpp"
 #include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle_v3.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 
@@ -164,6 +165,24 @@ bool profile_gemm_universal_impl(int do_verification,
         {
             auto kbatch_curr = kbatch_list[i];
 
+            ck::tensor_operation::device::GemmProblemSignature problem;
+            problem.M       = M;
+            problem.N       = N;
+            problem.K       = K;
+            problem.StrideA = StrideA;
+            problem.StrideB = StrideB;
+            problem.StrideE = StrideC;
+            problem.KBatch  = kbatch_curr;
+
+            // skip instances that cannot run the problem without constructing an argument
+            if(const auto desc = op_ptr->GetInstanceDescriptor();
+               desc && !ck::tensor_operation::device::IsGemmProblemApplicable(*desc, problem))
+            {
+                std::cout << op_ptr->GetTypeString() << " does not support this problem"
+                          << std::endl;
+                continue;
+            }
+
             auto argument_ptr =
                 op_ptr->MakeArgumentPointer(static_cast<ADataType*>(a_device_buf.GetDeviceBuffer()),
                                             static_cast<BDataType*>(b_device_buf.GetDeviceBuffer()),
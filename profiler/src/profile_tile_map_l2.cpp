@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ck/library/utility/block_to_ctile_map_schedule.hpp"
+#include "profiler_operation_registry.hpp"
+
+namespace {
+
+enum struct BlockTile
+{
+    M128_N128, // 0
+    M256_N128, // 1
+    M128_N256, // 2
+    M256_N256  // 3
+};
+
+#define OP_NAME "tile_map_l2"
+#define OP_DESC "Host L2 reuse simulation of GEMM tile maps"
+
+static void print_helper_msg()
+{
+    std::cout
+        // clang-format off
+        << "arg1: tensor operation (" OP_NAME ": " OP_DESC ")\n"
+        << "arg2: block tile (0: 128x128, 1: 256x128, 2: 128x256, 3: 256x256; KPerBlock 64)\n"
+        << "arg3: matrix layout (0: A[m, k] * B[k, n] = C[m, n];\n"
+        << "                     1: A[m, k] * B[n, k] = C[m, n];\n"
+        << "                     2: A[k, m] * B[k, n] = C[m, n];\n"
+        << "                     3: A[k, m] * B[n, k] = C[m, n])\n"
+        << "arg4: element size of A and B in bytes\n"
+        << "arg5 to 7: M, N, K\n"
+        << "arg8: concurrent workgroups (CUs x occupancy)\n"
+        << "arg9: cache size in KiB\n"
+        << "arg10: cache line size in bytes\n"
+        << "arg11: cache ways\n" << std::endl;
+    // clang-format on
+}
+
+void print_result(const std::string& map_name, const ck::utils::CacheSimulationResult& result)
+{
+    std::cout << std::left << std::setw(40) << map_name << std::right << " hit rate "
+              << std::setw(7) << std::fixed << std::setprecision(4) << result.GetHitRate()
+              << ", DRAM " << std::setw(10) << std::setprecision(2)
+              << result.GetDramBytes() / 1.E6 << " MB (A " << result.a_dram_bytes / 1.E6
+              << ", B " << result.b_dram_bytes / 1.E6 << ", C " << result.c_dram_bytes / 1.E6
+              << ", compulsory A+B " << result.compulsory_bytes / 1.E6 << ")" << std::endl;
+}
+
+} // namespace
+
+int profile_tile_map_l2(int argc, char* argv[])
+{
+    if(argc != 12)
+    {
+        print_helper_msg();
+        exit(1);
+    }
+
+    const auto block_tile = static_cast<BlockTile>(std::stoi(argv[2]));
+    const int layout      = std::stoi(argv[3]);
+
+    ck::utils::TileScheduleProblem problem;
+
+    problem.a_row_major           = layout == 0 || layout == 1;
+    problem.b_row_major           = layout == 0 || layout == 2;
+    problem.a_element_bytes       = std::stoi(argv[4]);
+    problem.b_element_bytes       = std::stoi(argv[4]);
+    problem.M                     = std::stoi(argv[5]);
+    problem.N                     = std::stoi(argv[6]);
+    problem.K                     = std::stoi(argv[7]);
+    problem.KPerBlock             = 64;
+    problem.num_concurrent_blocks = std::stoi(argv[8]);
+
+    ck::utils::CacheConfig cache_config;
+
+    cache_config.size_bytes = std::stoull(argv[9]) * 1024;
+    cache_config.line_bytes = std::stoi(argv[10]);
+    cache_config.num_ways   = std::stoi(argv[11]);
+
+    const std::vector<ck::index_t> m01_candidates{1, 2, 4, 8, 16, 32};
+
+    auto profile = [&](auto m_per_block, auto n_per_block) {
+        constexpr ck::index_t MPerBlock = m_per_block.value;
+        constexpr ck::index_t NPerBlock = n_per_block.value;
+
+        problem.MPerBlock = MPerBlock;
+        problem.NPerBlock = NPerBlock;
+
+        const auto print_sweep = [](const std::string& map_name, const auto& results) {
+            for(const auto& r : results)
+                print_result(map_name + ", M01 " + std::to_string(r.M01), r.result);
+
+            std::cout << "best M01 for " << map_name << ": "
+                      << ck::utils::GetBestTileMapSweepResult(results).M01 << std::endl;
+        };
+
+        print_sweep("M00_N0_M01Adapt",
+                    ck::utils::SweepM01AdaptTileMap<MPerBlock, NPerBlock>(
+                        problem, cache_config, m01_candidates));
+
+        print_sweep("Grouped_M00_N0_M01Adapt<8>",
+                    ck::utils::SweepGroupedM01AdaptTileMap<8, MPerBlock, NPerBlock>(
+                        problem, cache_config, m01_candidates));
+
+        const ck::BlockToCTileMap_GemmStreamK<MPerBlock, NPerBlock, 64> streamk_map(
+            problem.M, problem.N, problem.K, problem.num_concurrent_blocks, 1);
+
+        print_result("GemmStreamK",
+                     ck::utils::SimulateTileScheduleCache(
+                         ck::utils::MakeStreamKTileSchedule(streamk_map, problem),
+                         problem,
+                         cache_config));
+
+        return 0;
+    };
+
+    if(block_tile == BlockTile::M128_N128)
+    {
+        return profile(ck::Number<128>{}, ck::Number<128>{});
+    }
+    else if(block_tile == BlockTile::M256_N128)
+    {
+        return profile(ck::Number<256>{}, ck::Number<128>{});
+    }
+    else if(block_tile == BlockTile::M128_N256)
+    {
+        return profile(ck::Number<128>{}, ck::Number<256>{});
+    }
+    else if(block_tile == BlockTile::M256_N256)
+    {
+        return profile(ck::Number<256>{}, ck::Number<256>{});
+    }
+    else
+    {
+        std::cout << "this block tile is not implemented" << std::endl;
+
+        return 1;
+    }
+}
+
+REGISTER_PROFILER_OPERATION(OP_NAME, OP_DESC, profile_tile_map_l2);
@@ -2,29 +2,78 @@
 // Copyright (c) 2018-2023, Advanced Micro Devices, Inc. All rights reserved.
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
+#include "ck/host_utility/timing_statistics.hpp"
 #include "profiler_operation_registry.hpp"
 
 static void print_helper_message()
 {
-    std::cout << "arg1: tensor operation " << ProfilerOperationRegistry::GetInstance() << std::endl;
+    std::cout << "options: --adaptive-timing[=<target relative CI, default 0.01>] times every "
+                 "kernel until the confidence interval of the median is within the target, and "
+                 "prints its median, p10, p90 and CI\n"
+              << "arg1: tensor operation " << ProfilerOperationRegistry::GetInstance() << std::endl;
+}
+
+// Parses the options in front of the tensor operation and removes them from argv, returns false
+// on an unknown option.
+static bool parse_options(std::vector<char*>& args)
+{
+    const std::string adaptive_timing = "--adaptive-timing";
+
+    while(args.size() > 1 && std::strncmp(args[1], "--", 2) == 0)
+    {
+        const std::string option = args[1];
+
+        if(option.compare(0, adaptive_timing.size(), adaptive_timing) != 0)
+        {
+            std::cerr << "unknown option: " << option << std::endl;
+            return false;
+        }
+
+        auto& timing   = ck::utility::GetAdaptiveTimingOverride();
+        timing.enabled = true;
+
+        if(option.size() > adaptive_timing.size())
+        {
+            if(option[adaptive_timing.size()] != '=')
+            {
+                std::cerr << "unknown option: " << option << std::endl;
+                return false;
+            }
+            timing.target_relative_ci = std::stof(option.substr(adaptive_timing.size() + 1));
+        }
+
+        args.erase(args.begin() + 1);
+    }
+
+    return true;
 }
 
 int main(int argc, char* argv[])
 {
-    if(argc == 1)
+    std::vector<char*> args(argv, argv + argc);
+
+    if(!parse_options(args))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if(args.size() == 1)
     {
         print_helper_message();
     }
-    else if(const auto operation = ProfilerOperationRegistry::GetInstance().Get(argv[1]);
+    else if(const auto operation = ProfilerOperationRegistry::GetInstance().Get(args[1]);
             operation.has_value())
     {
-        return (*operation)(argc, argv);
+        return (*operation)(static_cast<int>(args.size()), args.data());
     }
     else
     {
-        std::cerr << "cannot find operation: " << argv[1] << std::endl;
+        std::cerr << "cannot find operation: " << args[1] << std::endl;
         return EXIT_FAILURE;
     }
 }
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+using ck::utils::check_err;
+using ck::utils::check_err_report;
+using ck::utils::CheckErrOptions;
+
+class TestCheckErr : public ::testing::TestWithParam<std::size_t>
+{
+    protected:
+    void SetUp() override { ck::SetHostNumThreads(GetParam()); }
+
+    void TearDown() override { ck::SetHostNumThreads(0); }
+};
+
+TEST_P(TestCheckErr, FloatToleranceAndNonFinite)
+{
+    std::vector<float> ref(300000);
+
+    for(std::size_t i = 0; i < ref.size(); ++i)
+        ref[i] = static_cast<float>(i % 1000) * 0.25f;
+
+    std::vector<float> out = ref;
+
+    EXPECT_TRUE(check_err(out, ref));
+
+    out[7]      = std::nextafter(out[7], 1e9f);
+    out[200001] = ref[200001] + 1.f;
+    out[299999] = std::numeric_limits<float>::quiet_NaN();
+
+    const auto report = check_err_report(out, ref);
+
+    EXPECT_FALSE(report.IsPassed());
+    EXPECT_EQ(report.num_checked, ref.size());
+    EXPECT_EQ(report.num_error, 2);
+    EXPECT_DOUBLE_EQ(report.max_error_abs_err, 1.);
+    EXPECT_DOUBLE_EQ(report.max_abs_err, 1.);
+    ASSERT_EQ(report.mismatches.size(), 2);
+    EXPECT_EQ(report.mismatches[0].index, 200001);
+    EXPECT_EQ(report.mismatches[1].index, 299999);
+
+    EXPECT_EQ(report.ulp_histogram[0], ref.size() - 3);
+    EXPECT_EQ(report.ulp_histogram[1], 1);
+    EXPECT_EQ(report.ulp_histogram.back(), 2);
+
+    EXPECT_FALSE(check_err(out, ref));
+}
+
+TEST_P(TestCheckErr, IntegerUsesAbsoluteTolerance)
+{
+    std::vector<int32_t> ref(100000, 3);
+    std::vector<int32_t> out = ref;
+
+    out[99998] = 5;
+
+    EXPECT_FALSE(check_err(out, ref));
+    EXPECT_TRUE(check_err(out, ref, "", 0, 2));
+
+    const auto report = check_err_report(out, ref, 0, 0);
+
+    EXPECT_EQ(report.num_error, 1);
+    EXPECT_EQ(report.ulp_histogram[2], 1);
+}
+
+TEST_P(TestCheckErr, HalfAndBHalf)
+{
+    std::vector<ck::half_t> ref_f16(1000, ck::type_convert<ck::half_t>(1.f));
+    std::vector<ck::half_t> out_f16 = ref_f16;
+
+    EXPECT_TRUE(check_err(out_f16, ref_f16));
+
+    out_f16[3] = ck::type_convert<ck::half_t>(1.5f);
+    EXPECT_FALSE(check_err(out_f16, ref_f16));
+
+    std::vector<ck::bhalf_t> ref_bf16(1000, ck::type_convert<ck::bhalf_t>(1.f));
+    std::vector<ck::bhalf_t> out_bf16 = ref_bf16;
+
+    out_bf16[5] = ck::type_convert<ck::bhalf_t>(1.0078125f);
+    EXPECT_TRUE(check_err(out_bf16, ref_bf16));
+
+    out_bf16[5] = ck::type_convert<ck::bhalf_t>(2.f);
+    EXPECT_FALSE(check_err(out_bf16, ref_bf16));
+}
+
+TEST_P(TestCheckErr, EarlyExit)
+{
+    std::vector<float> ref(1 << 20, 1.f);
+    std::vector<float> out(ref.size(), 2.f);
+
+    CheckErrOptions options;
+    options.max_errors = 1;
+
+    const auto report = check_err_report(out, ref, 1e-5, 3e-6, options);
+
+    EXPECT_FALSE(report.IsPassed());
+    EXPECT_TRUE(report.early_exit || report.num_checked == ref.size());
+    EXPECT_EQ(report.num_error, report.num_checked);
+    EXPECT_EQ(report.mismatches.size(), options.max_recorded_errors);
+}
+
+TEST_P(TestCheckErr, TensorCoordinates)
+{
+    Tensor<float> ref(HostTensorDescriptor({4, 8, 16}, {1, 4, 32}));
+    ref.GenerateTensorValue([](auto...) { return 1.f; });
+
+    Tensor<float> out = ref;
+    out(3, 5, 11)     = 3.f;
+
+    const auto report = check_err_report(out, ref);
+
+    ASSERT_EQ(report.mismatches.size(), 1);
+    EXPECT_EQ(report.mismatches[0].index, ref.mDesc.GetOffsetFromMultiIndex(3, 5, 11));
+    EXPECT_EQ(report.mismatches[0].coord, (std::vector<std::size_t>{3, 5, 11}));
+}
+
+TEST_P(TestCheckErr, SizeMismatch)
+{
+    std::vector<float> ref(10);
+    std::vector<float> out(11);
+
+    EXPECT_FALSE(check_err(out, ref));
+    EXPECT_TRUE(check_err_report(out, ref).size_mismatch);
+}
+
+INSTANTIATE_TEST_SUITE_P(HostThreads, TestCheckErr, ::testing::Values(1, 4));
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/check_err.hpp"
+
+using ck_tile::fp8_t;
+
+TEST(TestCkTileCheckErr, Fp8ReportMatchesCheckErr)
+{
+    // out[17] is the next representable value after ref[17], and more than atol away from it
+    std::vector<fp8_t> ref(64, ck_tile::bit_cast<fp8_t>(uint8_t{0x50}));
+    std::vector<fp8_t> out = ref;
+
+    out[17] = ck_tile::bit_cast<fp8_t>(uint8_t{0x51});
+
+    // one rounding point is accepted by default
+    EXPECT_TRUE(ck_tile::get_check_err_report(out, ref).is_passed());
+    EXPECT_TRUE(ck_tile::check_err(out, ref));
+
+    for(unsigned max_rounding_point_distance : {0u, 1u})
+    {
+        const auto report =
+            ck_tile::get_check_err_report(out, ref, max_rounding_point_distance, 1e-1);
+
+        EXPECT_EQ(report.is_passed(),
+                  ck_tile::check_err(out, ref, "fp8", max_rounding_point_distance, 1e-1));
+        EXPECT_EQ(report.num_error, max_rounding_point_distance == 0 ? 1 : 0);
+
+        if(max_rounding_point_distance == 0)
+        {
+            ASSERT_EQ(report.mismatches.size(), 1);
+            EXPECT_EQ(report.mismatches[0].index, 17);
+        }
+    }
+}
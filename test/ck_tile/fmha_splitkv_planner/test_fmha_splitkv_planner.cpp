@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/ops/fmha/kernel/fmha_fwd_splitkv_planner.hpp"
+
+using ck_tile::FmhaFwdSplitKVPlannerArgs;
+using ck_tile::index_t;
+
+namespace {
+
+// decoding on 304 CUs with the hdim 128 tiles of the split-kv kernel
+FmhaFwdSplitKVPlannerArgs MakeDecodeArgs(const std::vector<index_t>& seqlen_ks)
+{
+    FmhaFwdSplitKVPlannerArgs args;
+
+    args.seqlen_qs       = std::vector<index_t>(seqlen_ks.size(), 1);
+    args.seqlen_ks       = seqlen_ks;
+    args.nhead_q         = 8;
+    args.hdim_v          = 128;
+    args.num_cu          = 304;
+    args.block_per_cu    = 2;
+    args.kM0             = 64;
+    args.kN0             = 128;
+    args.kN1             = 128;
+    args.page_block_size = 256;
+
+    return args;
+}
+
+float PredictEfficiency(const FmhaFwdSplitKVPlannerArgs& args)
+{
+    const auto plan       = ck_tile::make_fmha_fwd_splitkv_plan(args);
+    const auto simulation = ck_tile::simulate_fmha_fwd_splitkv(plan, args);
+
+    return simulation.efficiency;
+}
+
+} // namespace
+
+TEST(TestFmhaFwdSplitKVPlanner, WorkCoversKeys)
+{
+    auto args      = MakeDecodeArgs({1000, 70000, 1, 0, 4096});
+    args.seqlen_qs = {130, 1, 1, 1, 64};
+
+    const auto plan = ck_tile::make_fmha_fwd_splitkv_plan(args);
+
+    ASSERT_EQ(plan.num_splits.size(), 5);
+    EXPECT_EQ(plan.max_num_splits,
+              *std::max_element(plan.num_splits.begin(), plan.num_splits.end()));
+    EXPECT_TRUE(std::is_sorted(plan.work.begin(), plan.work.end(), [](auto& x, auto& y) {
+        return x.cost > y.cost;
+    }));
+
+    for(index_t i_batch = 0; i_batch < 5; ++i_batch)
+    {
+        const index_t num_tile_m = ck_tile::integer_divide_ceil(args.seqlen_qs[i_batch], args.kM0);
+
+        for(index_t i_tile_m = 0; i_tile_m < num_tile_m; ++i_tile_m)
+        {
+            std::vector<ck_tile::FmhaFwdSplitKVWorkItem> splits;
+
+            std::copy_if(plan.work.begin(),
+                         plan.work.end(),
+                         std::back_inserter(splits),
+                         [&](auto& item) {
+                             return item.i_batch == i_batch && item.i_tile_m == i_tile_m;
+                         });
+            std::sort(splits.begin(), splits.end(), [](auto& x, auto& y) {
+                return x.i_split < y.i_split;
+            });
+
+            // the splits partition the keys at page boundaries
+            ASSERT_EQ(splits.size(), plan.num_splits[i_batch]);
+
+            index_t seqlen_k_end = 0;
+
+            for(const auto& split : splits)
+            {
+                EXPECT_EQ(split.seqlen_k_start, seqlen_k_end);
+                EXPECT_LE(split.seqlen_k_start, split.seqlen_k_end);
+                EXPECT_TRUE(split.seqlen_k_start % args.page_block_size == 0 ||
+                            split.seqlen_k_start == args.seqlen_ks[i_batch]);
+
+                seqlen_k_end = split.seqlen_k_end;
+            }
+            EXPECT_EQ(seqlen_k_end, args.seqlen_ks[i_batch]);
+        }
+    }
+
+    // nothing to split
+    EXPECT_EQ(plan.num_splits[2], 1);
+    EXPECT_EQ(plan.num_splits[3], 1);
+}
+
+TEST(TestFmhaFwdSplitKVPlanner, FullGpuIsNotSplit)
+{
+    // prefill fills the GPU without splits
+    auto args      = MakeDecodeArgs(std::vector<index_t>(16, 8192));
+    args.seqlen_qs = std::vector<index_t>(16, 8192);
+
+    const auto plan = ck_tile::make_fmha_fwd_splitkv_plan(args);
+
+    EXPECT_EQ(plan.max_num_splits, 1);
+    EXPECT_GT(PredictEfficiency(args), 0.9f);
+}
+
+TEST(TestFmhaFwdSplitKVPlanner, LongDecode)
+{
+    // a single long sequence has 8 workgroups for 608 slots without splits
+    auto args = MakeDecodeArgs({65536});
+
+    const auto plan = ck_tile::make_fmha_fwd_splitkv_plan(args);
+
+    EXPECT_GT(plan.num_splits[0], 16);
+    EXPECT_LE(plan.num_splits[0], args.max_splits);
+
+    args.max_splits = 1;
+    const float unsplit_efficiency = PredictEfficiency(args);
+
+    args.max_splits = 128;
+    EXPECT_GT(PredictEfficiency(args), 8 * unsplit_efficiency);
+}
+
+TEST(TestFmhaFwdSplitKVPlanner, MixedDecode)
+{
+    // one 100k token sequence among 100 token ones
+    std::vector<index_t> seqlen_ks(32, 100);
+
+    for(index_t i = 0; i < 32; i += 8)
+        seqlen_ks[i] = 100000;
+
+    auto args = MakeDecodeArgs(seqlen_ks);
+
+    const auto plan = ck_tile::make_fmha_fwd_splitkv_plan(args);
+
+    // only the long sequences are split
+    for(index_t i = 0; i < 32; ++i)
+    {
+        if(seqlen_ks[i] == 100)
+            EXPECT_EQ(plan.num_splits[i], 1);
+        else
+            EXPECT_GT(plan.num_splits[i], 16);
+    }
+
+    const float per_sequence_efficiency = PredictEfficiency(args);
+
+    args.uniform_splits            = true;
+    const float uniform_efficiency = PredictEfficiency(args);
+    const auto uniform_plan        = ck_tile::make_fmha_fwd_splitkv_plan(args);
+
+    args.max_splits                = 1;
+    const float unsplit_efficiency = PredictEfficiency(args);
+
+    RecordProperty("per_sequence_efficiency", std::to_string(per_sequence_efficiency));
+    RecordProperty("uniform_efficiency", std::to_string(uniform_efficiency));
+    RecordProperty("unsplit_efficiency", std::to_string(unsplit_efficiency));
+    std::cout << "predicted efficiency per sequence splits: " << per_sequence_efficiency
+              << ", uniform splits: " << uniform_efficiency
+              << ", no splits: " << unsplit_efficiency << std::endl;
+
+    EXPECT_TRUE(std::all_of(uniform_plan.num_splits.begin(),
+                            uniform_plan.num_splits.end(),
+                            [&](index_t n) { return n == uniform_plan.max_num_splits; }));
+    EXPECT_GT(per_sequence_efficiency, uniform_efficiency);
+    EXPECT_GT(uniform_efficiency, 4 * unsplit_efficiency);
+}
+
+TEST(TestFmhaFwdSplitKVPlanner, Simulation)
+{
+    // 8 heads of 76 equal workgroups fill 608 slots once
+    auto args       = MakeDecodeArgs(std::vector<index_t>(76, 1024));
+    args.max_splits = 1;
+
+    const auto plan       = ck_tile::make_fmha_fwd_splitkv_plan(args);
+    const auto simulation = ck_tile::simulate_fmha_fwd_splitkv(plan, args);
+
+    EXPECT_EQ(simulation.num_workgroups, 608);
+    EXPECT_FLOAT_EQ(simulation.split_time, args.workgroup_overhead + 8);
+    EXPECT_FLOAT_EQ(simulation.combine_time, 0);
+    EXPECT_FLOAT_EQ(simulation.wave_efficiency, 1);
+    EXPECT_FLOAT_EQ(simulation.efficiency, 8 / (args.workgroup_overhead + 8));
+}
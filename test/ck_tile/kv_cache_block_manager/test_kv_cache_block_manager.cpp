@@ -0,0 +1,339 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/kv_cache_block_manager.hpp"
+
+using ck_tile::index_t;
+using ck_tile::KVCacheBlockManager;
+
+namespace {
+
+// host copy of the paged cache, one value per token, updated the way the kernels would
+struct PagedCache
+{
+    PagedCache(const KVCacheBlockManager& manager)
+        : page_block_size(manager.get_page_block_size()),
+          tokens(manager.get_num_blocks() * page_block_size, -1)
+    {
+    }
+
+    void apply(const std::vector<ck_tile::KVCacheBlockCopy>& copies)
+    {
+        for(const auto& copy : copies)
+            std::copy_n(tokens.begin() + copy.src_block * page_block_size,
+                        copy.num_tokens,
+                        tokens.begin() + copy.dst_block * page_block_size);
+    }
+
+    int& at(const KVCacheBlockManager& manager, index_t seq_id, index_t i_token)
+    {
+        const index_t block = manager.get_blocks(seq_id)[i_token / page_block_size];
+
+        return tokens[block * page_block_size + i_token % page_block_size];
+    }
+
+    index_t page_block_size;
+    std::vector<int> tokens;
+};
+
+void CheckRefCounts(const KVCacheBlockManager& manager,
+                    const std::map<index_t, std::vector<int>>& seqs)
+{
+    std::vector<index_t> ref_counts(manager.get_num_blocks(), 0);
+
+    for(const auto& [seq_id, expected] : seqs)
+    {
+        const auto& blocks = manager.get_blocks(seq_id);
+
+        ASSERT_EQ(blocks.size(),
+                  ck_tile::integer_divide_ceil(expected.size(), manager.get_page_block_size()));
+        for(index_t block : blocks)
+            ++ref_counts[block];
+    }
+
+    index_t num_free = 0;
+
+    for(index_t block = 0; block < manager.get_num_blocks(); ++block)
+    {
+        ASSERT_EQ(manager.get_ref_count(block), ref_counts[block]);
+        num_free += (ref_counts[block] == 0);
+    }
+    ASSERT_EQ(manager.get_num_free_blocks(), num_free);
+}
+
+} // namespace
+
+TEST(TestKVCacheBlockManager, BlockTable)
+{
+    KVCacheBlockManager manager(16, 4);
+
+    const index_t seq0 = manager.create_sequence();
+    const index_t seq1 = manager.create_sequence();
+
+    ASSERT_TRUE(manager.append_tokens(seq0, 6));
+    ASSERT_TRUE(manager.append_tokens(seq1, 4));
+    ASSERT_TRUE(manager.append_tokens(seq0, 3));
+
+    EXPECT_EQ(manager.get_blocks(seq0), (std::vector<index_t>{0, 1, 3}));
+    EXPECT_EQ(manager.get_blocks(seq1), (std::vector<index_t>{2}));
+    EXPECT_EQ(manager.get_num_used_blocks(), 4);
+
+    std::vector<int32_t> block_table(2 * 4, -1);
+    std::vector<int32_t> seqlen_k(2);
+    std::vector<int32_t> cache_batch_idx(2);
+
+    EXPECT_EQ(manager.get_max_num_blocks({seq1, seq0}), 3);
+    EXPECT_THROW(manager.fill_block_table({seq1, seq0}, block_table.data(), 2),
+                 std::runtime_error);
+    manager.fill_block_table({seq1, seq0}, block_table.data(), 4);
+    manager.fill_seqlen_k({seq1, seq0}, seqlen_k.data());
+    manager.fill_cache_batch_idx({seq1, seq0}, cache_batch_idx.data());
+
+    EXPECT_EQ(block_table, (std::vector<int32_t>{2, 0, 0, 0, 0, 1, 3, 0}));
+    EXPECT_EQ(seqlen_k, (std::vector<int32_t>{4, 9}));
+    EXPECT_EQ(cache_batch_idx, (std::vector<int32_t>{seq1, seq0}));
+
+    // the blocks and the id of a freed sequence are reused
+    manager.free_sequence(seq0);
+    EXPECT_EQ(manager.get_num_free_blocks(), 15);
+    EXPECT_THROW(manager.get_blocks(seq0), std::runtime_error);
+    EXPECT_EQ(manager.create_sequence(), seq0);
+    ASSERT_TRUE(manager.append_tokens(seq0, 1));
+    EXPECT_EQ(manager.get_blocks(seq0), (std::vector<index_t>{3}));
+
+    // a failed append leaves the sequence unchanged
+    EXPECT_FALSE(manager.append_tokens(seq1, 15 * 4 + 1));
+    EXPECT_EQ(manager.get_seqlen(seq1), 4);
+    EXPECT_EQ(manager.get_num_free_blocks(), 14);
+
+    KVCacheBlockManager limited(16, 4, 2);
+    const index_t seq = limited.create_sequence();
+    EXPECT_THROW(limited.append_tokens(seq, 9), std::runtime_error);
+}
+
+TEST(TestKVCacheBlockManager, CopyOnWrite)
+{
+    KVCacheBlockManager manager(16, 4);
+
+    // a 6 token prompt shared by two requests
+    const index_t seq0 = manager.create_sequence();
+    ASSERT_TRUE(manager.append_tokens(seq0, 6));
+
+    const index_t seq1 = manager.fork_sequence(seq0);
+    EXPECT_EQ(manager.get_num_used_blocks(), 2);
+    EXPECT_EQ(manager.get_ref_count(0), 2);
+    EXPECT_EQ(manager.get_ref_count(1), 2);
+
+    // the first append to the shared partial block copies it
+    EXPECT_EQ(manager.get_num_blocks_to_append(seq1, 1), 1);
+    ASSERT_TRUE(manager.append_tokens(seq1, 1));
+    EXPECT_EQ(manager.get_blocks(seq1), (std::vector<index_t>{0, 2}));
+
+    auto copies = manager.take_block_copies();
+    ASSERT_EQ(copies.size(), 1);
+    EXPECT_EQ(copies[0].src_block, 1);
+    EXPECT_EQ(copies[0].dst_block, 2);
+    EXPECT_EQ(copies[0].num_tokens, 2);
+    EXPECT_TRUE(manager.take_block_copies().empty());
+
+    // the parent owns its last block again and is not copied
+    ASSERT_TRUE(manager.append_tokens(seq0, 2));
+    EXPECT_EQ(manager.get_blocks(seq0), (std::vector<index_t>{0, 1}));
+    EXPECT_TRUE(manager.take_block_copies().empty());
+
+    // a prefix ending at a block boundary is never copied
+    const index_t seq2 = manager.fork_sequence(seq0, 4);
+    ASSERT_TRUE(manager.append_tokens(seq2, 4));
+    EXPECT_EQ(manager.get_blocks(seq2), (std::vector<index_t>{0, 3}));
+    EXPECT_TRUE(manager.take_block_copies().empty());
+    EXPECT_EQ(manager.get_ref_count(0), 3);
+}
+
+TEST(TestKVCacheBlockManager, Compact)
+{
+    KVCacheBlockManager manager(8, 2);
+
+    std::vector<index_t> seq_ids;
+
+    for(int i = 0; i < 4; ++i)
+    {
+        seq_ids.push_back(manager.create_sequence());
+        ASSERT_TRUE(manager.append_tokens(seq_ids.back(), 4));
+    }
+    manager.free_sequence(seq_ids[0]);
+    manager.free_sequence(seq_ids[2]);
+
+    const index_t seq = manager.fork_sequence(seq_ids[3]);
+
+    manager.compact();
+
+    // blocks 6 and 7 of the last sequence and its fork move to the free blocks 0 and 1
+    EXPECT_EQ(manager.get_blocks(seq_ids[1]), (std::vector<index_t>{2, 3}));
+    EXPECT_EQ(manager.get_blocks(seq_ids[3]), (std::vector<index_t>{0, 1}));
+    EXPECT_EQ(manager.get_blocks(seq), (std::vector<index_t>{0, 1}));
+    EXPECT_EQ(manager.get_ref_count(0), 2);
+
+    auto copies = manager.take_block_copies();
+    ASSERT_EQ(copies.size(), 2);
+    EXPECT_EQ(copies[0].src_block, 6);
+    EXPECT_EQ(copies[0].dst_block, 0);
+    EXPECT_EQ(copies[1].src_block, 7);
+    EXPECT_EQ(copies[1].dst_block, 1);
+
+    // the free blocks are allocated from the lowest one
+    const index_t seq_new = manager.create_sequence();
+    ASSERT_TRUE(manager.append_tokens(seq_new, 3));
+    EXPECT_EQ(manager.get_blocks(seq_new), (std::vector<index_t>{4, 5}));
+}
+
+TEST(TestKVCacheBlockManager, Stress)
+{
+    // random create/fork/append/free/compact operations, the tokens written to the host cache
+    // must read back through the block tables of the sequences
+    KVCacheBlockManager manager(32, 16);
+    PagedCache cache(manager);
+
+    std::map<index_t, std::vector<int>> seqs;
+    std::mt19937 engine(42);
+    int next_token = 0;
+
+    for(int i_op = 0; i_op < 20000; ++i_op)
+    {
+        const int op = std::uniform_int_distribution<int>(0, 99)(engine);
+
+        auto random_seq = [&] {
+            auto it = seqs.begin();
+
+            std::advance(it, std::uniform_int_distribution<int>(0, seqs.size() - 1)(engine));
+            return it->first;
+        };
+
+        if(seqs.empty() || op < 8)
+        {
+            seqs[manager.create_sequence()];
+        }
+        else if(op < 20)
+        {
+            const index_t parent = random_seq();
+            const auto& tokens   = seqs[parent];
+            const index_t prefix = std::uniform_int_distribution<index_t>(
+                0, static_cast<index_t>(tokens.size()))(engine);
+            const index_t child  = manager.fork_sequence(parent, prefix);
+
+            seqs[child].assign(seqs[parent].begin(), seqs[parent].begin() + prefix);
+        }
+        else if(op < 70)
+        {
+            const index_t seq_id     = random_seq();
+            const index_t num_tokens = std::uniform_int_distribution<index_t>(0, 40)(engine);
+            const index_t seqlen     = manager.get_seqlen(seq_id);
+            const index_t num_free   = manager.get_num_free_blocks();
+            const index_t num_blocks = manager.get_num_blocks_to_append(seq_id, num_tokens);
+
+            if(!manager.append_tokens(seq_id, num_tokens))
+            {
+                ASSERT_LT(num_free, num_blocks);
+                ASSERT_EQ(manager.get_seqlen(seq_id), seqlen);
+                continue;
+            }
+            ASSERT_EQ(manager.get_num_free_blocks(), num_free - num_blocks);
+
+            cache.apply(manager.take_block_copies());
+
+            for(index_t i = 0; i < num_tokens; ++i)
+            {
+                cache.at(manager, seq_id, seqlen + i) = next_token;
+                seqs[seq_id].push_back(next_token++);
+            }
+        }
+        else if(op < 98)
+        {
+            const index_t seq_id = random_seq();
+
+            manager.free_sequence(seq_id);
+            seqs.erase(seq_id);
+        }
+        else
+        {
+            manager.compact();
+            cache.apply(manager.take_block_copies());
+
+            for(index_t block = 0; block < manager.get_num_blocks(); ++block)
+                ASSERT_EQ(manager.get_ref_count(block) != 0, block < manager.get_num_used_blocks());
+        }
+
+        if(i_op % 100 == 0)
+            CheckRefCounts(manager, seqs);
+
+        if(i_op % 1000 == 0)
+        {
+            for(const auto& [seq_id, expected] : seqs)
+                for(std::size_t i = 0; i < expected.size(); ++i)
+                    ASSERT_EQ(cache.at(manager, seq_id, i), expected[i]);
+        }
+    }
+}
+
+// a benchmark, run with --gtest_also_run_disabled_tests
+TEST(TestKVCacheBlockManager, DISABLED_Throughput)
+{
+    // decoding steps of a batch of 256 sequences, every step appends one token to each sequence
+    // and a finished sequence is replaced by a fresh one with a 512 token prompt
+    KVCacheBlockManager manager(65536, 16);
+
+    std::vector<index_t> seq_ids;
+    std::vector<int32_t> block_table;
+    std::mt19937 engine(7);
+
+    for(int i = 0; i < 256; ++i)
+    {
+        seq_ids.push_back(manager.create_sequence());
+        ASSERT_TRUE(manager.append_tokens(seq_ids.back(), 512));
+    }
+
+    const int num_steps   = 2000;
+    std::size_t num_calls = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for(int step = 0; step < num_steps; ++step)
+    {
+        for(index_t& seq_id : seq_ids)
+        {
+            if(std::uniform_int_distribution<int>(0, 999)(engine) == 0)
+            {
+                manager.free_sequence(seq_id);
+                seq_id = manager.create_sequence();
+                ASSERT_TRUE(manager.append_tokens(seq_id, 512));
+                num_calls += 2;
+            }
+            ASSERT_TRUE(manager.append_tokens(seq_id, 1));
+            ++num_calls;
+        }
+
+        const index_t batch_stride = manager.get_max_num_blocks(seq_ids);
+
+        block_table.resize(seq_ids.size() * batch_stride);
+        manager.fill_block_table(seq_ids, block_table.data(), batch_stride);
+    }
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    RecordProperty("calls_per_second", std::to_string(num_calls / seconds));
+    RecordProperty("steps_per_second", std::to_string(num_steps / seconds));
+    std::cout << "kv cache block manager: " << num_calls / seconds / 1e6 << " M calls/s, "
+              << num_steps / seconds << " decoding steps/s (batch 256, with block table)"
+              << std::endl;
+}
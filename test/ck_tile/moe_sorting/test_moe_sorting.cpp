@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
+#include "ck_tile/host/reference/reference_moe_sorting.hpp"
+
+using ck_tile::HostTensor;
+using ck_tile::index_t;
+
+namespace {
+
+// the former serial implementation of reference_moe_sorting
+void SerialMoeSorting(const HostTensor<index_t>& topk_ids,
+                      const HostTensor<float>& weights,
+                      HostTensor<index_t>& sorted_token_ids,
+                      HostTensor<float>& sorted_weight,
+                      HostTensor<index_t>& sorted_expert_ids,
+                      index_t& unit_cnt,
+                      const index_t experts,
+                      const index_t unit_size)
+{
+    const index_t num_token = topk_ids.mDesc.get_lengths()[0];
+    const index_t topk      = topk_ids.mDesc.get_lengths()[1];
+
+    std::vector<std::vector<index_t>> expert_tokens(experts,
+                                                    std::vector<index_t>(unit_size, num_token));
+    std::vector<std::vector<float>> expert_token_weights(experts,
+                                                         std::vector<float>(unit_size, 0));
+    std::vector<index_t> expert_slices(experts, 1);
+    std::vector<index_t> expert_slice_idxs(experts, 0);
+
+    for(index_t t = 0; t < num_token; t++)
+    {
+        for(index_t k = 0; k < topk; k++)
+        {
+            const index_t e   = topk_ids(t, k);
+            const index_t idx = expert_slice_idxs[e];
+
+            if(idx > expert_slices[e] * unit_size - 1)
+            {
+                expert_slices[e]++;
+                expert_tokens[e].resize(expert_slices[e] * unit_size, num_token);
+                expert_token_weights[e].resize(expert_slices[e] * unit_size, 0);
+            }
+            expert_tokens[e][idx]        = t;
+            expert_token_weights[e][idx] = weights(t, k);
+            expert_slice_idxs[e]++;
+        }
+    }
+
+    index_t* out_tokens    = sorted_token_ids.data();
+    float* out_weights     = sorted_weight.data();
+    index_t* out_expert_id = sorted_expert_ids.data();
+
+    for(index_t e = 0; e < experts; e++)
+    {
+        const index_t size = expert_slices[e] * unit_size;
+
+        std::memcpy(out_tokens, expert_tokens[e].data(), sizeof(index_t) * size);
+        std::memcpy(out_weights, expert_token_weights[e].data(), sizeof(float) * size);
+        out_tokens += size;
+        out_weights += size;
+
+        for(index_t s = 0; s < expert_slices[e]; s++)
+        {
+            out_expert_id[s] = e;
+            unit_cnt++;
+        }
+        out_expert_id += expert_slices[e];
+    }
+    unit_cnt *= unit_size;
+}
+
+struct MoeSortingProblem
+{
+    MoeSortingProblem(index_t num_token_, index_t experts_, index_t topk_, index_t unit_size_)
+        : num_token(num_token_),
+          experts(experts_),
+          topk(topk_),
+          unit_size(unit_size_),
+          // every expert has at least one unit, also without tokens
+          max_output_ids(std::max(ck_tile::integer_least_multiple(
+                                      num_token * topk + experts * unit_size - topk, unit_size),
+                                  experts * unit_size)),
+          topk_ids({num_token, topk}, {topk, 1}),
+          weights({num_token, topk}, {topk, 1})
+    {
+        // distinct experts per token, skewed towards the low expert ids like real routing
+        std::mt19937 engine(num_token * 31 + experts * 7 + topk);
+        std::uniform_real_distribution<float> uniform(0.f, 1.f);
+
+        for(index_t t = 0; t < num_token; ++t)
+        {
+            for(index_t k = 0; k < topk; ++k)
+            {
+                index_t e;
+
+                do
+                {
+                    const float u = uniform(engine);
+                    e = std::min(static_cast<index_t>(u * u * experts), experts - 1);
+                } while(std::count(&topk_ids(t, 0), &topk_ids(t, 0) + k, e) != 0);
+
+                topk_ids(t, k) = e;
+                weights(t, k)  = uniform(engine) - .5f;
+            }
+        }
+    }
+
+    index_t num_token;
+    index_t experts;
+    index_t topk;
+    index_t unit_size;
+    index_t max_output_ids;
+    HostTensor<index_t> topk_ids;
+    HostTensor<float> weights;
+};
+
+struct MoeSortingResult
+{
+    MoeSortingResult(const MoeSortingProblem& problem)
+        : sorted_token_ids({problem.max_output_ids}, {1}),
+          sorted_weight({problem.max_output_ids}, {1}),
+          sorted_expert_ids({problem.max_output_ids / problem.unit_size}, {1})
+    {
+        // unwritten elements differ from the padding
+        std::fill(sorted_token_ids.begin(), sorted_token_ids.end(), -1);
+        std::fill(sorted_weight.begin(), sorted_weight.end(), -1.f);
+        std::fill(sorted_expert_ids.begin(), sorted_expert_ids.end(), -1);
+    }
+
+    HostTensor<index_t> sorted_token_ids;
+    HostTensor<float> sorted_weight;
+    HostTensor<index_t> sorted_expert_ids;
+    index_t unit_cnt = 0;
+};
+
+MoeSortingResult RunSerial(const MoeSortingProblem& problem)
+{
+    MoeSortingResult result(problem);
+
+    SerialMoeSorting(problem.topk_ids,
+                     problem.weights,
+                     result.sorted_token_ids,
+                     result.sorted_weight,
+                     result.sorted_expert_ids,
+                     result.unit_cnt,
+                     problem.experts,
+                     problem.unit_size);
+    return result;
+}
+
+MoeSortingResult RunReference(const MoeSortingProblem& problem)
+{
+    MoeSortingResult result(problem);
+
+    ck_tile::reference_moe_sorting<float, index_t>(problem.topk_ids,
+                                                   problem.weights,
+                                                   result.sorted_token_ids,
+                                                   result.sorted_weight,
+                                                   result.sorted_expert_ids,
+                                                   result.unit_cnt,
+                                                   problem.experts,
+                                                   problem.unit_size);
+    return result;
+}
+
+void ExpectIdentical(const MoeSortingResult& result, const MoeSortingResult& expected)
+{
+    EXPECT_EQ(result.unit_cnt, expected.unit_cnt);
+    EXPECT_EQ(result.sorted_token_ids.mData, expected.sorted_token_ids.mData);
+    EXPECT_EQ(result.sorted_expert_ids.mData, expected.sorted_expert_ids.mData);
+    EXPECT_EQ(0,
+              std::memcmp(result.sorted_weight.data(),
+                          expected.sorted_weight.data(),
+                          sizeof(float) * result.sorted_weight.mData.size()));
+}
+
+} // namespace
+
+TEST(TestMoeSorting, MatchesSerial)
+{
+    for(index_t num_token : {0, 1, 7, 1000, 4099})
+        for(index_t experts : {1, 8, 64})
+            for(index_t topk : {1, 2, 8})
+                for(index_t unit_size : {1, 32})
+                {
+                    if(experts < topk)
+                        continue;
+
+                    SCOPED_TRACE(::testing::Message() << "tokens " << num_token << ", experts "
+                                                      << experts << ", topk " << topk
+                                                      << ", unit " << unit_size);
+
+                    const MoeSortingProblem problem(num_token, experts, topk, unit_size);
+
+                    ExpectIdentical(RunReference(problem), RunSerial(problem));
+                }
+}
+
+TEST(TestMoeSorting, ThreadCountIndependent)
+{
+    const MoeSortingProblem problem(20000, 64, 6, 16);
+    const MoeSortingResult expected = RunSerial(problem);
+
+    auto& pool = ck_tile::host_thread_pool::instance();
+
+    // the tokens are split into more chunks with more threads
+    for(std::size_t num_thread : {1, 3, 16})
+    {
+        pool.set_num_threads(num_thread);
+        ExpectIdentical(RunReference(problem), expected);
+    }
+    pool.set_num_threads(0);
+
+    // moe_sorting_host() returns the number of units and takes the row stride of the inputs
+    MoeSortingResult result(problem);
+
+    const index_t num_unit = ck_tile::moe_sorting_host(problem.topk_ids.data(),
+                                                       problem.weights.data(),
+                                                       result.sorted_token_ids.data(),
+                                                       result.sorted_weight.data(),
+                                                       result.sorted_expert_ids.data(),
+                                                       problem.num_token,
+                                                       problem.topk,
+                                                       problem.topk,
+                                                       problem.experts,
+                                                       problem.unit_size,
+                                                       /*max_thread=*/2);
+
+    result.unit_cnt = num_unit * problem.unit_size;
+    ExpectIdentical(result, expected);
+}
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_fmha_bwd.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+
+using ck_tile::HostTensor;
+using ck_tile::index_t;
+
+namespace {
+
+// keys i_n with i_m + lo <= i_n <= i_m + hi are visible
+struct WindowMask
+{
+    index_t lo;
+    index_t hi;
+    index_t x_total;
+
+    bool IsOutOfBound(index_t i_m, index_t i_n) const
+    {
+        return i_n >= x_total || i_n < i_m + lo || i_n > i_m + hi;
+    }
+};
+
+template <typename T>
+void FillUniform(HostTensor<T>& t, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+
+    for(auto& x : t)
+        x = dis(gen);
+}
+
+constexpr index_t kNHead   = 4;
+constexpr index_t kNHeadK  = 2;
+constexpr index_t kSeqLenQ = 45;
+constexpr index_t kSeqLenK = 150;
+constexpr index_t kHDimQ   = 24;
+constexpr index_t kHDimV   = 16;
+
+constexpr uint8_t kPUndropInUint8 = 200;
+constexpr float kRpUndrop         = 255.f / 200.f;
+
+uint8_t RandVal(index_t i_head, index_t i_m, index_t i_n)
+{
+    uint32_t x = (i_head * 7919u + i_m) * 104729u + i_n;
+    x ^= x >> 13;
+    x *= 0x5bd1e995u;
+    x ^= x >> 15;
+    return static_cast<uint8_t>(x);
+}
+
+const auto bias = [](index_t h, index_t m, index_t n) { return 0.01f * ((h + m * 3 + n) % 7); };
+
+class TestReferenceFmhaBwd : public ::testing::Test
+{
+    protected:
+    void SetUp() override
+    {
+        FillUniform(q, 1);
+        FillUniform(k, 2);
+        FillUniform(v, 3);
+        FillUniform(d_o, 4);
+
+        ck_tile::reference_fmha_fwd<float, float>(q,
+                                                  ck_tile::make_reference_fmha_kv_view(k),
+                                                  ck_tile::make_reference_fmha_kv_view(v),
+                                                  o,
+                                                  mask,
+                                                  scale_s,
+                                                  bias,
+                                                  lse,
+                                                  dropout);
+    }
+
+    void TearDown() override { ck_tile::set_host_num_threads(0); }
+
+    // materializes P, dP and dS in double precision
+    void NaiveFmhaBwd(HostTensor<double>& dq, HostTensor<double>& dk, HostTensor<double>& dv)
+    {
+        for(index_t h = 0; h < kNHead; ++h)
+        {
+            const index_t hk = h / (kNHead / kNHeadK);
+
+            for(index_t m = 0; m < kSeqLenQ; ++m)
+            {
+                double d = 0;
+                for(index_t i_o = 0; i_o < kHDimV; ++i_o)
+                    d += double(d_o(h, m, i_o)) * o(h, m, i_o);
+
+                for(index_t n = 0; n < kSeqLenK; ++n)
+                {
+                    if(mask.IsOutOfBound(m, n))
+                    {
+                        dbias_ref(h, m, n) = 0;
+                        continue;
+                    }
+
+                    double s = 0;
+                    for(index_t i_k = 0; i_k < kHDimQ; ++i_k)
+                        s += double(q(h, m, i_k)) * k(hk, n, i_k);
+
+                    const double p = std::exp(s * scale_s + bias(h, m, n) - lse(h, m));
+
+                    double dp = 0;
+                    for(index_t i_o = 0; i_o < kHDimV; ++i_o)
+                        dp += double(d_o(h, m, i_o)) * v(hk, n, i_o);
+
+                    const bool is_kept = dropout.is_kept(h, m, n);
+                    const double p_dropped = is_kept ? p * kRpUndrop : 0;
+                    dp                     = is_kept ? dp * kRpUndrop : 0;
+
+                    const double ds    = p * (dp - d);
+                    dbias_ref(h, m, n) = ds;
+
+                    for(index_t i_o = 0; i_o < kHDimV; ++i_o)
+                        dv(h, n, i_o) += p_dropped * d_o(h, m, i_o);
+
+                    for(index_t i_k = 0; i_k < kHDimQ; ++i_k)
+                    {
+                        dq(h, m, i_k) += scale_s * ds * k(hk, n, i_k);
+                        dk(h, n, i_k) += scale_s * ds * q(h, m, i_k);
+                    }
+                }
+            }
+        }
+    }
+
+    void RunReference()
+    {
+        ck_tile::reference_fmha_bwd<float, float>(q,
+                                                  ck_tile::make_reference_fmha_kv_view(k),
+                                                  ck_tile::make_reference_fmha_kv_view(v),
+                                                  o,
+                                                  lse,
+                                                  d_o,
+                                                  dq,
+                                                  dk,
+                                                  dv,
+                                                  mask,
+                                                  scale_s,
+                                                  bias,
+                                                  dropout,
+                                                  [&](index_t h, index_t m, index_t n, float ds) {
+                                                      dbias(h, m, n) = ds;
+                                                  });
+    }
+
+    const WindowMask mask{-40, 80, kSeqLenK};
+    const float scale_s = 1.f / std::sqrt(float(kHDimQ));
+    const ck_tile::reference_fmha_dropout<uint8_t (*)(index_t, index_t, index_t)> dropout =
+        ck_tile::make_reference_fmha_dropout(&RandVal, kPUndropInUint8, kRpUndrop);
+
+    HostTensor<float> q{kNHead, kSeqLenQ, kHDimQ};
+    HostTensor<float> k{kNHeadK, kSeqLenK, kHDimQ};
+    HostTensor<float> v{kNHeadK, kSeqLenK, kHDimV};
+    HostTensor<float> o{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse{kNHead, kSeqLenQ};
+    HostTensor<float> d_o{kNHead, kSeqLenQ, kHDimV};
+
+    HostTensor<float> dq{kNHead, kSeqLenQ, kHDimQ};
+    HostTensor<float> dk{kNHead, kSeqLenK, kHDimQ};
+    HostTensor<float> dv{kNHead, kSeqLenK, kHDimV};
+    HostTensor<float> dbias{kNHead, kSeqLenQ, kSeqLenK};
+    HostTensor<double> dbias_ref{kNHead, kSeqLenQ, kSeqLenK};
+};
+
+template <typename T>
+void ExpectNear(const HostTensor<float>& out, const HostTensor<T>& ref, double tol)
+{
+    ASSERT_EQ(out.get_element_space_size(), ref.get_element_space_size());
+
+    for(std::size_t i = 0; i < out.get_element_space_size(); ++i)
+        EXPECT_NEAR(out.mData[i], ref.mData[i], tol) << "at " << i;
+}
+
+} // namespace
+
+TEST_F(TestReferenceFmhaBwd, MatchesNaive)
+{
+    RunReference();
+
+    HostTensor<double> dq_ref{kNHead, kSeqLenQ, kHDimQ};
+    HostTensor<double> dk_ref{kNHead, kSeqLenK, kHDimQ};
+    HostTensor<double> dv_ref{kNHead, kSeqLenK, kHDimV};
+
+    dq_ref.SetZero();
+    dk_ref.SetZero();
+    dv_ref.SetZero();
+
+    NaiveFmhaBwd(dq_ref, dk_ref, dv_ref);
+
+    ExpectNear(dq, dq_ref, 1e-5);
+    ExpectNear(dk, dk_ref, 1e-5);
+    ExpectNear(dv, dv_ref, 1e-5);
+    ExpectNear(dbias, dbias_ref, 1e-5);
+}
+
+TEST_F(TestReferenceFmhaBwd, IndependentOfThreadCount)
+{
+    ck_tile::set_host_num_threads(1);
+    RunReference();
+
+    const auto dq_1 = dq.mData;
+    const auto dk_1 = dk.mData;
+    const auto dv_1 = dv.mData;
+
+    ck_tile::set_host_num_threads(5);
+    RunReference();
+
+    EXPECT_EQ(dq.mData, dq_1);
+    EXPECT_EQ(dk.mData, dk_1);
+    EXPECT_EQ(dv.mData, dv_1);
+}
@@ -0,0 +1,380 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/reference/reference_fmha_fwd.hpp"
+
+using ck_tile::HostTensor;
+using ck_tile::index_t;
+
+namespace {
+
+// keys i_n with i_m + lo <= i_n <= i_m + hi are visible
+struct WindowMask
+{
+    index_t lo;
+    index_t hi;
+    index_t x_total;
+
+    bool IsOutOfBound(index_t i_m, index_t i_n) const
+    {
+        return i_n >= x_total || i_n < i_m + lo || i_n > i_m + hi;
+    }
+};
+
+template <typename T>
+void FillUniform(HostTensor<T>& t, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+
+    for(auto& x : t)
+        x = dis(gen);
+}
+
+// S and P materialized in double precision, keys restricted to [i_n_begin, i_n_end)
+template <typename Bias>
+void NaiveFmhaFwd(const HostTensor<float>& q,
+                  const HostTensor<float>& k,
+                  const HostTensor<float>& v,
+                  const WindowMask& mask,
+                  float scale_s,
+                  const Bias& bias,
+                  index_t i_n_begin,
+                  index_t i_n_end,
+                  HostTensor<float>& o,
+                  HostTensor<float>& lse)
+{
+    const index_t nhead   = q.get_lengths()[0];
+    const index_t seqlen  = q.get_lengths()[1];
+    const index_t hdim_q  = q.get_lengths()[2];
+    const index_t hdim_v  = v.get_lengths()[2];
+    const index_t nhead_k = k.get_lengths()[0];
+
+    for(index_t h = 0; h < nhead; ++h)
+    {
+        const index_t hk = h / (nhead / nhead_k);
+
+        for(index_t m = 0; m < seqlen; ++m)
+        {
+            std::vector<double> s(i_n_end - i_n_begin, -std::numeric_limits<double>::infinity());
+
+            double s_max = -std::numeric_limits<double>::infinity();
+
+            for(index_t n = i_n_begin; n < i_n_end; ++n)
+            {
+                if(mask.IsOutOfBound(m, n))
+                    continue;
+
+                double acc = 0;
+                for(index_t d = 0; d < hdim_q; ++d)
+                    acc += double(q(h, m, d)) * k(hk, n, d);
+
+                s[n - i_n_begin] = acc * scale_s + bias(h, m, n);
+                s_max            = std::max(s_max, s[n - i_n_begin]);
+            }
+
+            double sum = 0;
+            for(auto& x : s)
+            {
+                x = std::isinf(s_max) ? 0 : std::exp(x - s_max);
+                sum += x;
+            }
+
+            for(index_t d = 0; d < hdim_v; ++d)
+            {
+                double acc = 0;
+                for(index_t n = i_n_begin; n < i_n_end; ++n)
+                    acc += s[n - i_n_begin] * v(hk, n, d);
+
+                o(h, m, d) = sum == 0 ? 0 : acc / sum;
+            }
+
+            lse(h, m) = sum == 0 ? -std::numeric_limits<float>::infinity() : s_max + std::log(sum);
+        }
+    }
+}
+
+void ExpectNear(const HostTensor<float>& out, const HostTensor<float>& ref, float tol)
+{
+    ASSERT_EQ(out.get_element_space_size(), ref.get_element_space_size());
+
+    for(std::size_t i = 0; i < out.get_element_space_size(); ++i)
+    {
+        if(std::isinf(ref.mData[i]))
+            EXPECT_EQ(out.mData[i], ref.mData[i]) << "at " << i;
+        else
+            EXPECT_NEAR(out.mData[i], ref.mData[i], tol) << "at " << i;
+    }
+}
+
+constexpr index_t kNHead   = 4;
+constexpr index_t kNHeadK  = 2;
+constexpr index_t kSeqLenQ = 37;
+constexpr index_t kSeqLenK = 150;
+constexpr index_t kHDimQ   = 24;
+constexpr index_t kHDimV   = 16;
+
+class TestReferenceFmhaFwd : public ::testing::TestWithParam<std::size_t>
+{
+    protected:
+    void SetUp() override
+    {
+        ck_tile::set_host_num_threads(GetParam());
+
+        FillUniform(q, 1);
+        FillUniform(k, 2);
+        FillUniform(v, 3);
+    }
+
+    void TearDown() override { ck_tile::set_host_num_threads(0); }
+
+    HostTensor<float> q{kNHead, kSeqLenQ, kHDimQ};
+    HostTensor<float> k{kNHeadK, kSeqLenK, kHDimQ};
+    HostTensor<float> v{kNHeadK, kSeqLenK, kHDimV};
+
+    const float scale_s = 1.f / std::sqrt(float(kHDimQ));
+};
+
+} // namespace
+
+TEST_P(TestReferenceFmhaFwd, MatchesNaiveWithGqaMaskAndAlibi)
+{
+    // bottom-right aligned causal mask and per-head ALiBi slopes
+    const WindowMask mask{-kSeqLenK, kSeqLenK - kSeqLenQ, kSeqLenK};
+    const auto alibi = [](index_t h, index_t m, index_t n) {
+        return -std::ldexp(1.f, -(h + 1)) * std::abs(float(m + kSeqLenK - kSeqLenQ - n));
+    };
+
+    HostTensor<float> o{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse{kNHead, kSeqLenQ};
+    HostTensor<float> o_ref{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse_ref{kNHead, kSeqLenQ};
+
+    ck_tile::reference_fmha_fwd<float, float>(q,
+                                              ck_tile::make_reference_fmha_kv_view(k),
+                                              ck_tile::make_reference_fmha_kv_view(v),
+                                              o,
+                                              mask,
+                                              scale_s,
+                                              alibi,
+                                              lse);
+
+    NaiveFmhaFwd(q, k, v, mask, scale_s, alibi, 0, kSeqLenK, o_ref, lse_ref);
+
+    ExpectNear(o, o_ref, 1e-5f);
+    ExpectNear(lse, lse_ref, 1e-5f);
+}
+
+TEST_P(TestReferenceFmhaFwd, FullyMaskedRows)
+{
+    // row i_m only sees key i_m - 20, rows 0..19 see no key at all
+    const WindowMask mask{-20, -20, kSeqLenK};
+
+    HostTensor<float> o{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse{kNHead, kSeqLenQ};
+    HostTensor<float> o_ref{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse_ref{kNHead, kSeqLenQ};
+
+    ck_tile::reference_fmha_fwd<float, float>(q,
+                                              ck_tile::make_reference_fmha_kv_view(k),
+                                              ck_tile::make_reference_fmha_kv_view(v),
+                                              o,
+                                              mask,
+                                              scale_s,
+                                              ck_tile::reference_fmha_no_bias{},
+                                              lse);
+
+    NaiveFmhaFwd(
+        q, k, v, mask, scale_s, ck_tile::reference_fmha_no_bias{}, 0, kSeqLenK, o_ref, lse_ref);
+
+    EXPECT_EQ(o(1, 19, 0), 0.f);
+    EXPECT_TRUE(std::isinf(lse(1, 19)));
+    ExpectNear(o, o_ref, 1e-5f);
+    ExpectNear(lse, lse_ref, 1e-5f);
+}
+
+TEST_P(TestReferenceFmhaFwd, PagedKvMatchesContiguous)
+{
+    constexpr index_t kPageSize = 16;
+    constexpr index_t kNumPage  = ck_tile::integer_divide_ceil(kSeqLenK, kPageSize) + 3;
+
+    // pages in reverse order, [num_page, page_size, nhead_k, hdim] layout
+    std::vector<index_t> block_table(kNumPage - 3);
+    std::iota(block_table.rbegin(), block_table.rend(), 2);
+
+    HostTensor<float> k_paged{kNumPage, kPageSize, kNHeadK, kHDimQ};
+    HostTensor<float> v_paged{kNumPage, kPageSize, kNHeadK, kHDimV};
+
+    for(index_t hk = 0; hk < kNHeadK; ++hk)
+    {
+        for(index_t n = 0; n < kSeqLenK; ++n)
+        {
+            const index_t page = block_table[n / kPageSize];
+
+            for(index_t d = 0; d < kHDimQ; ++d)
+                k_paged(page, n % kPageSize, hk, d) = k(hk, n, d);
+            for(index_t d = 0; d < kHDimV; ++d)
+                v_paged(page, n % kPageSize, hk, d) = v(hk, n, d);
+        }
+    }
+
+    const WindowMask mask{-50, 20, kSeqLenK};
+
+    HostTensor<float> o{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> o_paged{kNHead, kSeqLenQ, kHDimV};
+
+    ck_tile::reference_fmha_fwd<float, float>(q,
+                                              ck_tile::make_reference_fmha_kv_view(k),
+                                              ck_tile::make_reference_fmha_kv_view(v),
+                                              o,
+                                              mask,
+                                              scale_s);
+
+    ck_tile::reference_fmha_fwd<float, float>(
+        q,
+        ck_tile::make_reference_fmha_paged_kv_view(k_paged, block_table.data(), kSeqLenK, false),
+        ck_tile::make_reference_fmha_paged_kv_view(v_paged, block_table.data(), kSeqLenK, false),
+        o_paged,
+        mask,
+        scale_s);
+
+    EXPECT_EQ(o.mData, o_paged.mData);
+}
+
+TEST_P(TestReferenceFmhaFwd, SplitKv)
+{
+    constexpr index_t kNumSplit  = 3;
+    constexpr index_t kSplitSize = ck_tile::integer_divide_ceil(kSeqLenK, kNumSplit);
+
+    // causal mask shifted by 60, so the last split is empty for every row
+    const WindowMask mask{-kSeqLenK, 60, kSeqLenK};
+
+    HostTensor<float> o_acc{kNumSplit, kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse_acc{kNumSplit, kNHead, kSeqLenQ};
+    HostTensor<float> o{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse{kNHead, kSeqLenQ};
+
+    ck_tile::reference_fmha_fwd_splitkv<float, float>(q,
+                                                      ck_tile::make_reference_fmha_kv_view(k),
+                                                      ck_tile::make_reference_fmha_kv_view(v),
+                                                      kNumSplit,
+                                                      o_acc,
+                                                      lse_acc,
+                                                      o,
+                                                      mask,
+                                                      scale_s,
+                                                      ck_tile::reference_fmha_no_bias{},
+                                                      lse);
+
+    HostTensor<float> o_ref{kNHead, kSeqLenQ, kHDimV};
+    HostTensor<float> lse_ref{kNHead, kSeqLenQ};
+
+    NaiveFmhaFwd(
+        q, k, v, mask, scale_s, ck_tile::reference_fmha_no_bias{}, 0, kSeqLenK, o_ref, lse_ref);
+
+    ExpectNear(o, o_ref, 1e-5f);
+    ExpectNear(lse, lse_ref, 1e-5f);
+
+    for(index_t i_split = 0; i_split < kNumSplit; ++i_split)
+    {
+        HostTensor<float> o_split{kNHead, kSeqLenQ, kHDimV};
+        HostTensor<float> lse_split{kNHead, kSeqLenQ};
+
+        for(index_t h = 0; h < kNHead; ++h)
+        {
+            for(index_t m = 0; m < kSeqLenQ; ++m)
+            {
+                for(index_t d = 0; d < kHDimV; ++d)
+                    o_split(h, m, d) = o_acc(i_split, h, m, d);
+                lse_split(h, m) = lse_acc(i_split, h, m);
+            }
+        }
+
+        NaiveFmhaFwd(q,
+                     k,
+                     v,
+                     mask,
+                     scale_s,
+                     ck_tile::reference_fmha_no_bias{},
+                     i_split * kSplitSize,
+                     std::min((i_split + 1) * kSplitSize, kSeqLenK),
+                     o_ref,
+                     lse_ref);
+
+        ExpectNear(o_split, o_ref, 1e-5f);
+        ExpectNear(lse_split, lse_ref, 1e-5f);
+    }
+
+    EXPECT_TRUE(std::isinf(lse_acc(kNumSplit - 1, 0, 0)));
+}
+
+INSTANTIATE_TEST_SUITE_P(HostThreads, TestReferenceFmhaFwd, ::testing::Values(1, 4));
+
+// BlockDropoutBwd with 16x16 warp gemms generates the same random values as the 32x32 layout of
+// reference_fmha_philox_randval through different streams, words and rows per lane; replay it.
+TEST(TestReferenceFmhaDropout, PhiloxMatchesWarpGemm16Layout)
+{
+    constexpr unsigned long long kSeed   = 7;
+    constexpr unsigned long long kOffset = 123;
+    constexpr index_t kBatch             = 1;
+    constexpr index_t kNHeadQ            = 3;
+
+    const ck_tile::reference_fmha_philox_randval randval{kSeed, kOffset, kBatch, kNHeadQ};
+
+    std::vector<int> histogram(256);
+
+    for(index_t i_head = 0; i_head < kNHeadQ; ++i_head)
+    {
+        for(index_t i_tile_m = 0; i_tile_m < 2; ++i_tile_m)
+        {
+            for(index_t i_tile_n = 0; i_tile_n < 3; ++i_tile_n)
+            {
+                const unsigned long long subsequence =
+                    static_cast<unsigned long long>(i_tile_m) |
+                    (static_cast<unsigned long long>(i_tile_n) << 32);
+
+                // 2 warps cover the 32 columns of a tile, 2 iterations of 16 rows its rows
+                for(index_t warp = 0; warp < 2; ++warp)
+                {
+                    for(index_t lane = 0; lane < 64; ++lane)
+                    {
+                        const ck_tile::philox ph(
+                            kSeed,
+                            kOffset + (kBatch * kNHeadQ + i_head) * 64 + (lane & 47) +
+                                (warp << 4));
+
+                        uint8_t random[8];
+                        ph.get_random_8x8(random, subsequence, (lane >> 4) & 1);
+
+                        for(index_t i_iter = 0; i_iter < 2; ++i_iter)
+                        {
+                            for(index_t i = 0; i < 4; ++i)
+                            {
+                                const index_t i_m = i_tile_m * 32 + i_iter * 16 + lane / 16 * 4 + i;
+                                const index_t i_n = i_tile_n * 32 + warp * 16 + lane % 16;
+
+                                ASSERT_EQ(randval(i_head, i_m, i_n), random[i_iter * 4 + i])
+                                    << "at " << i_head << ", " << i_m << ", " << i_n;
+
+                                ++histogram[random[i_iter * 4 + i]];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // every byte value shows up, the values are not all alike
+    EXPECT_EQ(std::count(histogram.begin(), histogram.end(), 0), 0);
+}
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "ck_tile/host/host_tensor.hpp"
+#include "ck_tile/host/host_thread_pool.hpp"
+#include "ck_tile/host/reference/reference_fused_moe.hpp"
+#include "ck_tile/host/reference/reference_moe_sorting.hpp"
+
+using ck_tile::HostTensor;
+using ck_tile::index_t;
+
+namespace {
+
+struct Silu
+{
+    void operator()(float& y, const float& x) const { y = x / (1.f + std::exp(-x)); }
+};
+
+using DataType = ck_tile::fp16_t;
+
+struct FusedMoeProblem
+{
+    FusedMoeProblem(index_t tokens_,
+                    index_t experts_,
+                    index_t topk_,
+                    index_t hidden_size_,
+                    index_t intermediate_size_1_,
+                    bool gate_only_,
+                    index_t block_m_ = 32)
+        : tokens(tokens_),
+          experts(experts_),
+          topk(topk_),
+          hidden_size(hidden_size_),
+          intermediate_size(intermediate_size_1_ * (gate_only_ ? 1 : 2)),
+          gate_only(gate_only_),
+          block_m(block_m_),
+          max_num_tokens_padded(tokens * topk + experts * block_m - topk),
+          a({tokens, hidden_size}),
+          g({experts, intermediate_size, hidden_size}),
+          d({experts, hidden_size, intermediate_size_1_}),
+          topk_ids({tokens, topk}, {topk, 1}),
+          topk_weights({tokens, topk}, {topk, 1}),
+          sorted_token_ids({max_num_tokens_padded}),
+          sorted_weight({max_num_tokens_padded}),
+          sorted_expert_ids({ck_tile::integer_divide_ceil(max_num_tokens_padded, block_m)}),
+          num_sorted_tiles({1}),
+          scale({1})
+    {
+        std::mt19937 engine(tokens * 13 + experts);
+        std::uniform_real_distribution<float> uniform(-1.f, 1.f);
+
+        for(auto& x : a.mData)
+            x = static_cast<DataType>(uniform(engine));
+        for(auto& x : g.mData)
+            x = static_cast<DataType>(uniform(engine) / 8);
+        for(auto& x : d.mData)
+            x = static_cast<DataType>(uniform(engine) / 8);
+
+        // distinct experts per token
+        std::vector<index_t> expert_ids(experts);
+        std::iota(expert_ids.begin(), expert_ids.end(), 0);
+
+        for(index_t t = 0; t < tokens; ++t)
+        {
+            std::shuffle(expert_ids.begin(), expert_ids.end(), engine);
+
+            for(index_t k = 0; k < topk; ++k)
+            {
+                topk_ids(t, k)     = expert_ids[k];
+                topk_weights(t, k) = (uniform(engine) + 1.f) / 2;
+            }
+        }
+
+        ck_tile::reference_moe_sorting<float, index_t>(topk_ids,
+                                                       topk_weights,
+                                                       sorted_token_ids,
+                                                       sorted_weight,
+                                                       sorted_expert_ids,
+                                                       num_sorted_tiles.mData[0],
+                                                       experts,
+                                                       block_m);
+    }
+
+    index_t tokens;
+    index_t experts;
+    index_t topk;
+    index_t hidden_size;
+    index_t intermediate_size;
+    bool gate_only;
+    index_t block_m;
+    index_t max_num_tokens_padded;
+
+    HostTensor<DataType> a;
+    HostTensor<DataType> g;
+    HostTensor<DataType> d;
+    HostTensor<index_t> topk_ids;
+    HostTensor<float> topk_weights;
+    HostTensor<index_t> sorted_token_ids;
+    HostTensor<float> sorted_weight;
+    HostTensor<index_t> sorted_expert_ids;
+    HostTensor<index_t> num_sorted_tiles;
+    HostTensor<float> scale; // the scales are not used
+};
+
+// the former row by row implementation of reference_fused_moe
+HostTensor<float> RowwiseFusedMoe(const FusedMoeProblem& p)
+{
+    const index_t intermediate_size_1 = p.intermediate_size / (p.gate_only ? 1 : 2);
+    const index_t num_sorted_tiles    = p.num_sorted_tiles.mData[0] / p.block_m;
+
+    HostTensor<float> out_topk_tokens({p.tokens, p.topk, p.hidden_size});
+    HostTensor<float> o({p.tokens, p.hidden_size});
+
+    for(index_t i_flatten = 0; i_flatten < p.max_num_tokens_padded; i_flatten++)
+    {
+        const index_t i_tile = i_flatten / p.block_m;
+        if(i_tile >= num_sorted_tiles)
+            continue;
+
+        const index_t i_expert = p.sorted_expert_ids.mData[i_tile];
+        const index_t i_token  = p.sorted_token_ids.mData[i_flatten];
+        if(i_token >= p.tokens)
+            continue;
+
+        index_t i_topk = 0;
+        while(p.topk_ids(i_token, i_topk) != i_expert)
+            i_topk++;
+
+        const float weight = p.sorted_weight.mData[i_flatten];
+
+        std::vector<float> acc_0(p.intermediate_size);
+        for(index_t i_n = 0; i_n < p.intermediate_size; i_n++)
+        {
+            float acc = 0;
+            for(index_t i_k = 0; i_k < p.hidden_size; i_k++)
+                acc += static_cast<float>(p.a(i_token, i_k)) *
+                       static_cast<float>(p.g(i_expert, i_n, i_k));
+            acc_0[i_n] = acc;
+        }
+
+        std::vector<float> y(intermediate_size_1);
+        for(index_t i_n = 0; i_n < intermediate_size_1; i_n++)
+        {
+            float tmp;
+            Silu{}(tmp, acc_0[i_n]);
+            y[i_n] = p.gate_only ? tmp : tmp * acc_0[i_n + intermediate_size_1];
+        }
+
+        for(index_t i_n = 0; i_n < p.hidden_size; i_n++)
+        {
+            float acc = 0;
+            for(index_t i_k = 0; i_k < intermediate_size_1; i_k++)
+                acc += y[i_k] * static_cast<float>(p.d(i_expert, i_n, i_k));
+            out_topk_tokens(i_token, i_topk, i_n) = acc * weight;
+        }
+    }
+
+    for(index_t i_token = 0; i_token < p.tokens; i_token++)
+        for(index_t i_n = 0; i_n < p.hidden_size; i_n++)
+        {
+            float acc = 0;
+            for(index_t i_topk = 0; i_topk < p.topk; i_topk++)
+                acc += out_topk_tokens(i_token, i_topk, i_n);
+            o(i_token, i_n) = acc;
+        }
+
+    return o;
+}
+
+HostTensor<float> RunReference(const FusedMoeProblem& p)
+{
+    HostTensor<float> o({p.tokens, p.hidden_size});
+
+    ck_tile::reference_fused_moe<float, Silu>(p.a,
+                                              p.g,
+                                              p.d,
+                                              p.scale,
+                                              p.scale,
+                                              p.scale,
+                                              p.scale,
+                                              o,
+                                              p.sorted_token_ids,
+                                              p.sorted_weight,
+                                              p.sorted_expert_ids,
+                                              p.num_sorted_tiles,
+                                              p.topk_ids,
+                                              p.block_m,
+                                              p.tokens,
+                                              p.experts,
+                                              p.hidden_size,
+                                              p.intermediate_size,
+                                              p.topk,
+                                              p.gate_only);
+    return o;
+}
+
+} // namespace
+
+TEST(TestReferenceFusedMoe, MatchesRowwise)
+{
+    // sizes that are not multiples of the panels and micro tiles
+    for(bool gate_only : {false, true})
+        for(index_t tokens : {1, 37, 150})
+        {
+            SCOPED_TRACE(::testing::Message() << "tokens " << tokens << ", gate_only "
+                                              << gate_only);
+
+            const FusedMoeProblem problem(tokens, 8, 2, 200, 150, gate_only);
+
+            // the k order of every element is the same, so the results are identical
+            EXPECT_EQ(RunReference(problem).mData, RowwiseFusedMoe(problem).mData);
+        }
+}
+
+TEST(TestReferenceFusedMoe, ThreadCountIndependent)
+{
+    const FusedMoeProblem problem(64, 4, 3, 96, 80, false, 16);
+    const auto expected = RowwiseFusedMoe(problem);
+
+    auto& pool = ck_tile::host_thread_pool::instance();
+
+    for(std::size_t num_thread : {1, 5})
+    {
+        pool.set_num_threads(num_thread);
+        EXPECT_EQ(RunReference(problem).mData, expected.mData);
+    }
+    pool.set_num_threads(0);
+}
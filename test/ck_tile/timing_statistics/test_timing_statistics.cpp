@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck_tile/host/kernel_launch.hpp"
+#include "ck_tile/host/timing_statistics.hpp"
+
+namespace {
+
+// kernel time with relative gaussian noise and occasional launches delayed by a neighbour
+struct synthetic_timing_source
+{
+    float time_ms;
+    float relative_noise;
+    float outlier_probability = 0;
+    float outlier_scale       = 3;
+
+    std::mt19937 gen{42};
+
+    float operator()()
+    {
+        std::normal_distribution<float> noise(0, relative_noise);
+        std::bernoulli_distribution is_outlier(outlier_probability);
+
+        const float time = time_ms * (1 + noise(gen));
+
+        return is_outlier(gen) ? time * outlier_scale : time;
+    }
+};
+
+} // namespace
+
+TEST(TestCkTileTimingStatistics, Summary)
+{
+    std::vector<float> samples{10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 100};
+
+    const auto summary = ck_tile::summarize_timings(samples, ck_tile::timing_config{});
+
+    EXPECT_EQ(summary.num_samples, 10);
+    EXPECT_EQ(summary.num_outliers, 1);
+    EXPECT_FLOAT_EQ(summary.median, 5.5f);
+    EXPECT_FLOAT_EQ(summary.mean, 5.5f);
+    EXPECT_FLOAT_EQ(summary.p10, 1.9f);
+    EXPECT_FLOAT_EQ(summary.p90, 9.1f);
+    EXPECT_LE(summary.ci_low, summary.median);
+    EXPECT_GE(summary.ci_high, summary.median);
+}
+
+TEST(TestCkTileTimingStatistics, AdaptiveSampleCount)
+{
+    ck_tile::timing_config config;
+
+    config.min_samples        = 20;
+    config.max_samples        = 500;
+    config.target_relative_ci = 0.01f;
+
+    const auto stable = ck_tile::run_adaptive_timing(config, synthetic_timing_source{1.f, 0.005f});
+    const auto noisy  = ck_tile::run_adaptive_timing(config, synthetic_timing_source{1.f, 0.05f});
+
+    EXPECT_TRUE(stable.converged);
+    EXPECT_EQ(stable.num_launches, config.min_samples);
+    EXPECT_TRUE(noisy.converged);
+    EXPECT_GT(noisy.num_launches, 4 * stable.num_launches);
+    EXPECT_LE(noisy.get_relative_ci(), config.target_relative_ci);
+}
+
+TEST(TestCkTileTimingStatistics, AdaptiveLaunchKernel)
+{
+    ck_tile::timing_summary summary;
+
+    ck_tile::stream_config s{nullptr, true, 0, 3, 10, false};
+
+    s.adaptive_timing_ = true;
+    s.max_nrepeat_     = 50;
+    s.timing_summary_  = &summary;
+
+    int num_calls = 0;
+
+    const float ms = ck_tile::launch_kernel(s, [&](const ck_tile::stream_config&) { ++num_calls; });
+
+    // the warm up plus the timed launches, which are batched into samples of at least 0.1 ms
+    EXPECT_EQ(num_calls, s.cold_niters_ + summary.num_launches);
+    EXPECT_GE(summary.num_samples + summary.num_outliers, s.nrepeat_);
+    EXPECT_LE(summary.num_samples + summary.num_outliers, s.max_nrepeat_);
+    EXPECT_FLOAT_EQ(ms, summary.median);
+}
@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/type_convert.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+#include "ck/library/utility/host_type_convert.hpp"
+
+using ck::bf8_fnuz_t;
+using ck::bf8_ocp_t;
+using ck::bhalf_t;
+using ck::f8_fnuz_t;
+using ck::f8_ocp_t;
+using ck::half_t;
+
+namespace {
+
+template <typename T>
+uint32_t GetBits(const T& x)
+{
+    uint32_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(T));
+    return bits;
+}
+
+template <typename T>
+T FromBits(uint32_t bits)
+{
+    T x;
+    std::memcpy(&x, &bits, sizeof(T));
+    return x;
+}
+
+// every bit pattern of an 8-bit or 16-bit type
+template <typename T>
+std::vector<T> GetAllValues()
+{
+    std::vector<T> values(std::size_t{1} << (8 * sizeof(T)));
+
+    for(std::size_t i = 0; i < values.size(); ++i)
+        values[i] = FromBits<T>(i);
+
+    return values;
+}
+
+template <typename Y, typename X>
+void CheckTypeConvert(const std::vector<X>& x)
+{
+    std::vector<Y> y(x.size());
+    ck::utils::type_convert_n(x.data(), x.size(), y.data());
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+        ASSERT_EQ(GetBits(y[i]), GetBits(ck::type_convert<Y>(x[i]))) << "at " << i;
+}
+
+template <typename Y, typename X>
+void CheckF8ConvertRne(const std::vector<X>& x)
+{
+    std::vector<Y> y(x.size());
+    ck::utils::f8_convert_rne_n(x.data(), x.size(), y.data());
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+        ASSERT_EQ(GetBits(y[i]), GetBits(ck::f8_convert_rne<Y>(x[i]))) << "at " << i;
+}
+
+// floats around the fp8/bf8 range, and special values
+std::vector<float> GetFloatSamples()
+{
+    std::vector<float> x = {0.f,
+                            -0.f,
+                            std::numeric_limits<float>::min(),
+                            std::numeric_limits<float>::denorm_min(),
+                            std::numeric_limits<float>::max(),
+                            std::numeric_limits<float>::lowest(),
+                            std::numeric_limits<float>::infinity(),
+                            -std::numeric_limits<float>::infinity(),
+                            std::numeric_limits<float>::quiet_NaN()};
+
+    std::mt19937 gen(11939);
+    std::uniform_int_distribution<int> exponent(-30, 20);
+    std::uniform_real_distribution<float> mantissa(-2.f, 2.f);
+
+    while(x.size() < (1 << 20))
+        x.push_back(std::ldexp(mantissa(gen), exponent(gen)));
+
+    return x;
+}
+
+template <typename F8>
+void CheckFromFloat8()
+{
+    const auto x = GetAllValues<F8>();
+
+    CheckTypeConvert<float>(x);
+    CheckTypeConvert<half_t>(x);
+}
+
+template <typename F8>
+void CheckToFloat8()
+{
+    const auto x_half  = GetAllValues<half_t>();
+    const auto x_float = GetFloatSamples();
+
+    CheckTypeConvert<F8>(x_half);
+    CheckF8ConvertRne<F8>(x_half);
+    CheckTypeConvert<F8>(x_float);
+    CheckF8ConvertRne<F8>(x_float);
+}
+
+// stochastic rounding keeps values that are representable
+template <typename F8>
+void CheckF8ConvertSrOfRepresentable()
+{
+    std::vector<float> x;
+
+    for(const F8 v : GetAllValues<F8>())
+    {
+        const float f = ck::type_convert<float>(v);
+
+        if(std::isfinite(f))
+            x.push_back(f);
+    }
+
+    std::vector<F8> y(x.size());
+    ck::utils::f8_convert_sr_n(x.data(), x.size(), y.data());
+
+    for(std::size_t i = 0; i < x.size(); ++i)
+        ASSERT_EQ(GetBits(y[i]), GetBits(ck::f8_convert_rne<F8>(x[i]))) << "at " << x[i];
+}
+
+} // namespace
+
+TEST(HostTypeConvert, FromFp8Fnuz)
+{
+    CheckFromFloat8<f8_fnuz_t>();
+    CheckFromFloat8<bf8_fnuz_t>();
+}
+
+TEST(HostTypeConvert, FromFp8Ocp)
+{
+    CheckFromFloat8<f8_ocp_t>();
+    CheckFromFloat8<bf8_ocp_t>();
+}
+
+TEST(HostTypeConvert, ToFp8Fnuz)
+{
+    CheckToFloat8<f8_fnuz_t>();
+    CheckToFloat8<bf8_fnuz_t>();
+}
+
+TEST(HostTypeConvert, ToFp8Ocp)
+{
+    CheckToFloat8<f8_ocp_t>();
+    CheckToFloat8<bf8_ocp_t>();
+}
+
+TEST(HostTypeConvert, F8ConvertSr)
+{
+    CheckF8ConvertSrOfRepresentable<f8_fnuz_t>();
+    CheckF8ConvertSrOfRepresentable<bf8_fnuz_t>();
+    CheckF8ConvertSrOfRepresentable<f8_ocp_t>();
+    CheckF8ConvertSrOfRepresentable<bf8_ocp_t>();
+}
+
+TEST(HostTypeConvert, FromFp16AndBf16)
+{
+    const auto x_half  = GetAllValues<half_t>();
+    const auto x_bhalf = GetAllValues<bhalf_t>();
+
+    CheckTypeConvert<float>(x_half);
+    CheckTypeConvert<bhalf_t>(x_half);
+    CheckTypeConvert<float>(x_bhalf);
+    CheckTypeConvert<half_t>(x_bhalf);
+}
+
+namespace {
+
+// Converts the fp32 bit patterns that get_chunk_bits(chunk, bits) writes for every chunk to fp16
+// and bf16 and returns the number of results that differ from type_convert()
+template <typename GetChunkBits>
+std::size_t CountFromFp32Errors(std::size_t num_chunk, GetChunkBits get_chunk_bits)
+{
+    std::atomic<std::size_t> num_error{0};
+
+    ck::HostThreadPool::Instance().ParallelFor(
+        num_chunk, 0, [&](std::size_t chunk_begin, std::size_t chunk_end) {
+            std::vector<uint32_t> bits;
+            std::vector<float> x;
+            std::vector<half_t> y_half;
+            std::vector<bhalf_t> y_bhalf;
+
+            for(std::size_t chunk = chunk_begin; chunk < chunk_end; ++chunk)
+            {
+                bits.clear();
+                get_chunk_bits(chunk, bits);
+
+                x.resize(bits.size());
+                y_half.resize(bits.size());
+                y_bhalf.resize(bits.size());
+
+                for(std::size_t i = 0; i < bits.size(); ++i)
+                    x[i] = FromBits<float>(bits[i]);
+
+                // runs serially inside of the parallel region
+                ck::utils::type_convert_n(x.data(), x.size(), y_half.data());
+                ck::utils::type_convert_n(x.data(), x.size(), y_bhalf.data());
+
+                std::size_t num_chunk_error = 0;
+
+                for(std::size_t i = 0; i < x.size(); ++i)
+                {
+                    num_chunk_error +=
+                        GetBits(y_half[i]) != GetBits(ck::type_convert<half_t>(x[i]));
+                    num_chunk_error +=
+                        GetBits(y_bhalf[i]) != GetBits(ck::type_convert<bhalf_t>(x[i]));
+                }
+
+                num_error += num_chunk_error;
+            }
+        });
+
+    return num_error.load();
+}
+
+} // namespace
+
+// Every sign and exponent with a strided subset of the mantissas, plus the mantissas around the
+// rounding point of every number of dropped bits (fp16 subnormals drop more than 13 bits, bf16
+// drops 16) with random kept bits, so both round-to-even directions are hit
+TEST(HostTypeConvert, FromFp32)
+{
+    constexpr uint32_t kMantissaStride = 251;
+    constexpr int kNumKeptBitsSample   = 8;
+
+    const std::size_t num_error =
+        CountFromFp32Errors(512, [&](std::size_t chunk, std::vector<uint32_t>& bits) {
+            const uint32_t sign_exponent = static_cast<uint32_t>(chunk) << 23;
+
+            for(uint32_t m = 0; m < (1u << 23); m += kMantissaStride)
+                bits.push_back(sign_exponent | m);
+
+            std::mt19937 engine(static_cast<uint32_t>(chunk));
+
+            for(int dropped = 1; dropped <= 23; ++dropped)
+            {
+                const uint32_t half_ulp = 1u << (dropped - 1);
+                const uint32_t low_mask = (1u << dropped) - 1;
+
+                for(int sample = 0; sample < kNumKeptBitsSample; ++sample)
+                {
+                    const uint32_t kept = engine() & ((1u << 23) - 1) & ~low_mask;
+
+                    for(const uint32_t low : {half_ulp - 1, half_ulp, half_ulp + 1, low_mask})
+                        bits.push_back(sign_exponent | kept | (low & low_mask));
+                }
+            }
+        });
+
+    EXPECT_EQ(num_error, 0);
+}
+
+// all 2^32 floats, run with --gtest_also_run_disabled_tests
+TEST(HostTypeConvert, DISABLED_FromFp32Exhaustive)
+{
+    constexpr std::size_t kChunkSize = 1 << 16;
+    constexpr std::size_t kNumChunk  = (std::size_t{1} << 32) / kChunkSize;
+
+    const std::size_t num_error =
+        CountFromFp32Errors(kNumChunk, [&](std::size_t chunk, std::vector<uint32_t>& bits) {
+            for(std::size_t i = 0; i < kChunkSize; ++i)
+                bits.push_back(static_cast<uint32_t>(chunk * kChunkSize + i));
+        });
+
+    EXPECT_EQ(num_error, 0);
+}
+
+TEST(HostTypeConvert, IndependentOfThreadCount)
+{
+    const auto x = GetFloatSamples();
+
+    std::vector<f8_fnuz_t> y_1(x.size());
+    std::vector<f8_fnuz_t> y_n(x.size());
+
+    ck::HostThreadPool::Instance().SetNumThreads(1);
+    ck::utils::f8_convert_rne_n(x.data(), x.size(), y_1.data());
+
+    ck::HostThreadPool::Instance().SetNumThreads(0);
+    ck::utils::f8_convert_rne_n(x.data(), x.size(), y_n.data());
+
+    EXPECT_EQ(std::memcmp(y_1.data(), y_n.data(), x.size()), 0);
+}
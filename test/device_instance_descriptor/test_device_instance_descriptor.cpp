@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <sstream>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/device_instance_descriptor.hpp"
+#include "ck/library/tensor_operation_instance/gemm_tuning_database.hpp"
+#include "ck/library/tensor_operation_instance/gpu/gemm_universal.hpp"
+
+using ck::tensor_operation::device::DeviceInstanceDescriptor;
+using ck::tensor_operation::device::GemmSpecialization;
+using ck::tensor_operation::device::MatrixInstruction;
+
+using F16         = ck::half_t;
+using Row         = ck::tensor_layout::gemm::RowMajor;
+using Col         = ck::tensor_layout::gemm::ColumnMajor;
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+template <typename ALayout, typename BLayout>
+using DeviceGemmF16 = ck::tensor_operation::device::
+    DeviceGemmV2<ALayout, BLayout, Row, F16, F16, F16, PassThrough, PassThrough, PassThrough>;
+
+template <typename DeviceOp>
+void CheckUniversalGemmDescriptors()
+{
+    using ck::tensor_operation::device::instance::DeviceOperationInstanceFactory;
+    using ck::tensor_operation::device::instance::ParseGemmTileConfig;
+
+    const auto op_ptrs = DeviceOperationInstanceFactory<DeviceOp>::GetInstances();
+
+    ASSERT_FALSE(op_ptrs.empty());
+
+    for(const auto& op_ptr : op_ptrs)
+    {
+        const auto desc = op_ptr->GetInstanceDescriptor();
+        const auto tile = ParseGemmTileConfig(op_ptr->GetTypeString());
+
+        ASSERT_TRUE(desc.has_value()) << op_ptr->GetTypeString();
+        ASSERT_TRUE(tile.has_value()) << op_ptr->GetTypeString();
+
+        EXPECT_EQ(desc->instruction, MatrixInstruction::Xdl);
+        EXPECT_EQ(desc->block_size, tile->block_size);
+        EXPECT_EQ(desc->m_per_block, tile->m_per_block);
+        EXPECT_EQ(desc->n_per_block, tile->n_per_block);
+        EXPECT_EQ(desc->k_per_block, tile->k_per_block);
+        EXPECT_EQ(desc->m_per_block % (desc->m_per_instr * desc->m_instr_per_wave), 0);
+        EXPECT_EQ(desc->n_per_block % (desc->n_per_instr * desc->n_instr_per_wave), 0);
+        EXPECT_GE(desc->pipeline_version, 1);
+        EXPECT_LE(desc->pipeline_version, 5);
+        EXPECT_GT(desc->lds_bytes, 0);
+        EXPECT_LE(desc->lds_bytes, 64 * 1024);
+    }
+}
+
+TEST(TestDeviceInstanceDescriptor, UniversalGemmMatchesTypeString)
+{
+    CheckUniversalGemmDescriptors<DeviceGemmF16<Row, Row>>();
+    CheckUniversalGemmDescriptors<DeviceGemmF16<Row, Col>>();
+}
+
+TEST(TestDeviceInstanceDescriptor, Json)
+{
+    constexpr DeviceInstanceDescriptor desc = [] {
+        DeviceInstanceDescriptor d;
+        d.op_name            = "DeviceGemmXdlUniversal";
+        d.instruction        = MatrixInstruction::Xdl;
+        d.gemm_spec          = GemmSpecialization::MNKPadding;
+        d.block_size         = 256;
+        d.pipeline_scheduler = "Intrawave";
+        d.lds_bytes          = 32768;
+        return d;
+    }();
+
+    static_assert(desc.block_size == 256);
+
+    const std::string json = desc.ToJson();
+
+    EXPECT_NE(json.find("\"op_name\": \"DeviceGemmXdlUniversal\""), std::string::npos);
+    EXPECT_NE(json.find("\"instruction\": \"Xdl\""), std::string::npos);
+    EXPECT_NE(json.find("\"gemm_spec\": \"MNKPadding\""), std::string::npos);
+    EXPECT_NE(json.find("\"block_size\": 256,"), std::string::npos);
+    EXPECT_NE(json.find("\"lds_bytes\": 32768}"), std::string::npos);
+}
+
+TEST(TestDeviceInstanceDescriptor, WriteInstancesJson)
+{
+    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+        DeviceGemmF16<Row, Row>>::GetInstances();
+
+    std::ostringstream os;
+    ck::tensor_operation::device::WriteInstanceDescriptorsJson(os, op_ptrs);
+
+    const std::string json = os.str();
+
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_NE(json.find("\"index\": " + std::to_string(op_ptrs.size() - 1) + ","),
+              std::string::npos);
+    EXPECT_EQ(json.find("\"descriptor\": null"), std::string::npos);
+}
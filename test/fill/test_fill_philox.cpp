@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+using namespace ck::utils;
+
+namespace {
+
+template <typename Fill, typename T>
+std::vector<T> FillWithThreads(const Fill& fill, std::size_t n, std::size_t num_thread)
+{
+    ck::SetHostNumThreads(num_thread);
+
+    std::vector<T> v(n);
+    fill(v);
+
+    ck::SetHostNumThreads(0);
+    return v;
+}
+
+} // namespace
+
+TEST(FillPhilox, KnownAnswer)
+{
+    // Random123 known answer test for philox4x32-10 with zero counter and key
+    uint32_t words[4];
+    Philox4x32(0).Generate(0, 1, words);
+
+    EXPECT_EQ(words[0], 0x6627e8d5u);
+    EXPECT_EQ(words[1], 0xe169c58du);
+    EXPECT_EQ(words[2], 0xbc57ac4cu);
+    EXPECT_EQ(words[3], 0x9b00dbd8u);
+}
+
+TEST(FillPhilox, IndependentOfThreadCount)
+{
+    // odd size, the last block is only partially used
+    constexpr std::size_t n = 1000003;
+
+    const FillUniformDistributionPhilox<float> uniform{-1.f, 1.f};
+    const FillNormalDistributionPhilox<float> normal{0.f, 2.f};
+    const FillSparseUniformDistributionPhilox<float> sparse{-1.f, 1.f, 0.3f};
+    const FillUniformDistributionIntegerValuePhilox<int32_t> integer{-8.f, 8.f};
+
+    for(std::size_t num_thread : {2, 5, 16})
+    {
+        EXPECT_EQ((FillWithThreads<decltype(uniform), float>(uniform, n, 1)),
+                  (FillWithThreads<decltype(uniform), float>(uniform, n, num_thread)));
+        EXPECT_EQ((FillWithThreads<decltype(normal), float>(normal, n, 1)),
+                  (FillWithThreads<decltype(normal), float>(normal, n, num_thread)));
+        EXPECT_EQ((FillWithThreads<decltype(sparse), float>(sparse, n, 1)),
+                  (FillWithThreads<decltype(sparse), float>(sparse, n, num_thread)));
+        EXPECT_EQ((FillWithThreads<decltype(integer), int32_t>(integer, n, 1)),
+                  (FillWithThreads<decltype(integer), int32_t>(integer, n, num_thread)));
+    }
+}
+
+TEST(FillPhilox, PrefixIsStable)
+{
+    // a tensor with more elements starts with the values of a smaller one
+    const FillUniformDistributionPhilox<float> uniform{0.f, 1.f, 7};
+
+    const auto small = FillWithThreads<decltype(uniform), float>(uniform, 1000, 4);
+    const auto large = FillWithThreads<decltype(uniform), float>(uniform, 5000, 4);
+
+    EXPECT_TRUE(std::equal(small.begin(), small.end(), large.begin()));
+}
+
+TEST(FillPhilox, Distributions)
+{
+    constexpr std::size_t n = 1 << 20;
+
+    std::vector<float> v(n);
+
+    FillUniformDistributionPhilox<float>{-2.f, 4.f}(v);
+
+    double sum = 0;
+    for(float x : v)
+    {
+        EXPECT_TRUE(x >= -2.f && x < 4.f);
+        sum += x;
+    }
+    EXPECT_NEAR(sum / n, 1., 0.02);
+
+    FillNormalDistributionPhilox<float>{3.f, 4.f}(v);
+
+    sum        = 0;
+    double ssq = 0;
+    for(float x : v)
+    {
+        sum += x;
+        ssq += (x - 3.) * (x - 3.);
+    }
+    EXPECT_NEAR(sum / n, 3., 0.02);
+    EXPECT_NEAR(ssq / n, 4., 0.05);
+
+    FillSparseUniformDistributionPhilox<float>{1.f, 2.f, 0.25f}(v);
+
+    std::size_t num_zero = 0;
+    for(float x : v)
+        num_zero += x == 0.f;
+    EXPECT_NEAR(static_cast<double>(num_zero) / n, 0.25, 0.01);
+
+    std::vector<int32_t> w(n);
+    FillUniformDistributionIntegerValuePhilox<int32_t>{-3.f, 3.f}(w);
+
+    EXPECT_EQ(*std::min_element(w.begin(), w.end()), -3);
+    EXPECT_EQ(*std::max_element(w.begin(), w.end()), 3);
+}
@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/tensor_operation_instance/gemm_tuning_database.hpp"
+
+using namespace ck::tensor_operation::device::instance;
+
+namespace {
+
+struct FakeGemmInstance
+{
+    std::string mTypeString;
+
+    std::string GetTypeString() const { return mTypeString; }
+};
+
+struct FakeDescriptor
+{
+    int block_size  = 0;
+    int m_per_block = 0;
+    int n_per_block = 0;
+    int k_per_block = 0;
+};
+
+struct FakeDescribedGemmInstance
+{
+    FakeDescriptor mDescriptor;
+
+    std::string GetTypeString() const { return "DeviceGemmWithoutTileInTypeString"; }
+
+    std::optional<FakeDescriptor> GetInstanceDescriptor() const { return mDescriptor; }
+};
+
+std::string GetUniversalTypeString(int block_size, int m, int n, int k)
+{
+    return "DeviceGemmXdlUniversal<Default, RRR> BlkSize: " + std::to_string(block_size) +
+           ", BlkTile: " + std::to_string(m) + "x" + std::to_string(n) + "x" +
+           std::to_string(k) + ", WaveTile: 32x32, WaveMap: 2x2, VmemReadVec: 8x8";
+}
+
+class TestGemmTuningDatabase : public ::testing::Test
+{
+    protected:
+    std::string GetFileName() const
+    {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        return std::string("test_gemm_tuning_database_") + info->name() + ".txt";
+    }
+
+    void TearDown() override { std::remove(GetFileName().c_str()); }
+};
+
+} // namespace
+
+TEST_F(TestGemmTuningDatabase, StoreKeepsFastest)
+{
+    GemmTuningDatabase db;
+    const GemmTuningKey key{"gemm_f16", 1024, 1024, 4096};
+
+    EXPECT_TRUE(db.Store(key, {"a", 1, 2.f}));
+    EXPECT_FALSE(db.Store(key, {"b", 2, 3.f}));
+    EXPECT_TRUE(db.Store(key, {"c", 4, 1.f}));
+
+    const auto entry = db.Find(key);
+
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->instance_name, "c");
+    EXPECT_EQ(entry->kbatch, 4);
+    EXPECT_FALSE(db.Find({"gemm_bf16", 1024, 1024, 4096}).has_value());
+    EXPECT_THROW(db.Store(key, {"tab\tname", 1, 0.f}), std::runtime_error);
+}
+
+TEST_F(TestGemmTuningDatabase, FindNearestStaysWithinOperation)
+{
+    GemmTuningDatabase db;
+
+    db.Store({"gemm_f16", 1024, 1024, 1024}, {"medium", 1, 1.f});
+    db.Store({"gemm_f16", 64, 64, 8192}, {"skinny", 8, 1.f});
+    db.Store({"gemm_bf16", 1000, 1000, 1000}, {"other_op", 1, 1.f});
+
+    const auto nearest = db.FindNearest({"gemm_f16", 960, 1100, 1024});
+
+    ASSERT_TRUE(nearest.has_value());
+    EXPECT_EQ(nearest->second.instance_name, "medium");
+    EXPECT_EQ(db.FindNearest({"gemm_f16", 32, 80, 8192})->second.instance_name, "skinny");
+    EXPECT_FALSE(db.FindNearest({"gemm_f16", 1 << 20, 1 << 20, 1 << 20}).has_value());
+    EXPECT_FALSE(db.FindNearest({"gemm_f32", 1024, 1024, 1024}).has_value());
+}
+
+TEST_F(TestGemmTuningDatabase, SaveLoadRoundTrip)
+{
+    GemmTuningDatabase db;
+    const GemmTuningKey key{"gemm_f16", 3840, 4096, 4096};
+    const std::string name = GetUniversalTypeString(256, 224, 256, 64);
+
+    db.Store(key, {name, 2, 0.123456f});
+    db.Store({"gemm_f16", 1, 2, 3}, {"small", 1, 0.001f});
+    db.Save(GetFileName());
+
+    const GemmTuningDatabase loaded(GetFileName());
+
+    EXPECT_EQ(loaded.GetNumEntries(), 2);
+
+    const auto entry = loaded.Find(key);
+
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->instance_name, name);
+    EXPECT_EQ(entry->kbatch, 2);
+    EXPECT_EQ(entry->ave_time, 0.123456f);
+}
+
+TEST_F(TestGemmTuningDatabase, LoadRejectsMalformedFiles)
+{
+    GemmTuningDatabase db;
+
+    EXPECT_THROW(db.Load(GetFileName()), std::runtime_error);
+
+    {
+        std::ofstream file(GetFileName());
+        file << "not a database\n";
+    }
+    EXPECT_THROW(db.Load(GetFileName()), std::runtime_error);
+
+    {
+        std::ofstream file(GetFileName());
+        file << GemmTuningDatabase::kFileHeader << "\n";
+        file << "gemm_f16\t16\t16\tsixteen\t1\t0.5\tname\n";
+    }
+    EXPECT_THROW(db.Load(GetFileName()), std::runtime_error);
+
+    EXPECT_EQ(db.GetNumEntries(), 0);
+}
+
+TEST_F(TestGemmTuningDatabase, ParseGemmTileConfig)
+{
+    const auto tile = ParseGemmTileConfig(GetUniversalTypeString(256, 128, 64, 32));
+
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ(tile->block_size, 256);
+    EXPECT_EQ(tile->m_per_block, 128);
+    EXPECT_EQ(tile->n_per_block, 64);
+    EXPECT_EQ(tile->k_per_block, 32);
+
+    EXPECT_FALSE(ParseGemmTileConfig("DeviceGemmXdl<256, 128, 128, 4, 8>").has_value());
+    EXPECT_FALSE(ParseGemmTileConfig("BlkSize: 256, BlkTile: 128x128").has_value());
+}
+
+TEST_F(TestGemmTuningDatabase, TileFromInstanceDescriptor)
+{
+    const FakeDescribedGemmInstance instance{{256, 256, 128, 32}};
+    const auto tile = GetGemmTileConfig(instance, instance.GetTypeString());
+
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ(tile->m_per_block, 256);
+    EXPECT_EQ(tile->n_per_block, 128);
+    EXPECT_EQ(tile->k_per_block, 32);
+
+    // falls back to the type string when the descriptor is incomplete
+    const FakeDescribedGemmInstance empty{{}};
+
+    EXPECT_FALSE(GetGemmTileConfig(empty, empty.GetTypeString()).has_value());
+    EXPECT_TRUE(GetGemmTileConfig(empty, GetUniversalTypeString(64, 32, 32, 64)).has_value());
+}
+
+TEST_F(TestGemmTuningDatabase, TileEfficiencyModel)
+{
+    const GemmTileConfig tile{256, 128, 128, 64};
+
+    // evenly divisible problem filling whole waves
+    const auto even = EstimateGemmTileEfficiency(tile, 128 * 8, 128 * 38, 4096, 1, 304);
+
+    EXPECT_DOUBLE_EQ(even.padding, 1.0);
+    EXPECT_DOUBLE_EQ(even.wave, 1.0);
+    EXPECT_DOUBLE_EQ(even.reuse, 0.5);
+
+    // one extra row wastes almost a whole tile row
+    const auto padded = EstimateGemmTileEfficiency(tile, 129, 128, 4096, 1, 304);
+
+    EXPECT_NEAR(padded.padding, 129.0 / 256.0, 1e-12);
+
+    // a single tile leaves the device idle, splitting K fills it
+    const auto split = SelectGemmKBatch(tile, 128, 128, 8192, 304);
+
+    EXPECT_GT(split.kbatch, 1);
+    EXPECT_LE(split.kbatch * 64, 8192);
+    EXPECT_GT(split.GetScore(),
+              EstimateGemmTileEfficiency(tile, 128, 128, 8192, 1, 304).GetScore());
+
+    // K too short for splitting
+    EXPECT_EQ(SelectGemmKBatch(tile, 128, 128, 64, 304).kbatch, 1);
+}
+
+TEST_F(TestGemmTuningDatabase, RankCandidates)
+{
+    std::vector<std::unique_ptr<FakeGemmInstance>> instances;
+
+    instances.push_back(std::make_unique<FakeGemmInstance>(
+        FakeGemmInstance{GetUniversalTypeString(256, 256, 256, 64)}));
+    instances.push_back(std::make_unique<FakeGemmInstance>(FakeGemmInstance{"DeviceGemmXdl<>"}));
+    instances.push_back(std::make_unique<FakeGemmInstance>(
+        FakeGemmInstance{GetUniversalTypeString(256, 128, 128, 64)}));
+    instances.push_back(std::make_unique<FakeGemmInstance>(
+        FakeGemmInstance{GetUniversalTypeString(64, 32, 32, 64)}));
+
+    GemmTuningDatabase db;
+    const GemmTuningKey key{"gemm_f16", 4096, 4096, 4096};
+
+    // untuned: 256x256 tiles fill a large problem best, the unparsable instance comes last
+    auto candidates = RankGemmInstanceCandidates(db, key, instances, 304);
+
+    ASSERT_EQ(candidates.size(), instances.size());
+    EXPECT_EQ(candidates[0].index, 0);
+    EXPECT_EQ(candidates.back().index, 1);
+
+    // nearest tuned shape goes before the model, the exact match before both
+    db.Store({"gemm_f16", 4096, 4096, 3000}, {instances[2]->GetTypeString(), 2, 1.f});
+    candidates = RankGemmInstanceCandidates(db, key, instances, 304);
+
+    EXPECT_EQ(candidates[0].index, 2);
+    EXPECT_EQ(candidates[0].kbatch, 2);
+
+    db.Store(key, {instances[3]->GetTypeString(), 1, 1.f});
+    candidates = RankGemmInstanceCandidates(db, key, instances, 304);
+
+    ASSERT_EQ(candidates.size(), instances.size());
+    EXPECT_EQ(candidates[0].index, 3);
+    EXPECT_EQ(candidates[1].index, 2);
+    EXPECT_EQ(candidates[2].index, 0);
+    EXPECT_EQ(candidates[3].index, 1);
+}
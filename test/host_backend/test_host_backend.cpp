@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+#include "ck/library/tensor_operation_instance/host/gemm_multiple_d.hpp"
+#include "ck/library/tensor_operation_instance/host/grouped_convolution_forward.hpp"
+
+#include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm_multiple_d.hpp"
+
+namespace {
+
+using ck::index_t;
+using ck::tensor_operation::device::DeviceGemmMultipleD;
+using ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD;
+using ck::tensor_operation::device::instance::DeviceOperationInstanceFactory;
+using ck::tensor_operation::device::instance::HostInstanceTag;
+
+using Row = ck::tensor_layout::gemm::RowMajor;
+using Col = ck::tensor_layout::gemm::ColumnMajor;
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Add         = ck::tensor_operation::element_wise::Add;
+
+using DeviceGemmAdd = DeviceGemmMultipleD<Row,
+                                          Col,
+                                          ck::Tuple<Row>,
+                                          Row,
+                                          float,
+                                          float,
+                                          ck::Tuple<float>,
+                                          float,
+                                          PassThrough,
+                                          PassThrough,
+                                          Add>;
+
+using DeviceConvFwd = DeviceGroupedConvFwdMultipleABD<2,
+                                                      ck::tensor_layout::convolution::GNHWC,
+                                                      ck::tensor_layout::convolution::GKYXC,
+                                                      ck::Tuple<>,
+                                                      ck::tensor_layout::convolution::GNHWK,
+                                                      float,
+                                                      float,
+                                                      ck::Tuple<>,
+                                                      float,
+                                                      PassThrough,
+                                                      PassThrough,
+                                                      PassThrough>;
+
+using HostGemmAddFactory = DeviceOperationInstanceFactory<DeviceGemmAdd, HostInstanceTag>;
+using HostConvFwdFactory = DeviceOperationInstanceFactory<DeviceConvFwd, HostInstanceTag>;
+
+struct GemmProblem
+{
+    index_t M;
+    index_t N;
+    index_t K;
+    index_t StrideA;
+    index_t StrideB;
+    index_t StrideD;
+    index_t StrideE;
+};
+
+struct GemmTensors
+{
+    explicit GemmTensors(const GemmProblem& p)
+        : a_m_k(HostTensorDescriptor({p.M, p.K}, {p.StrideA, 1})),
+          b_k_n(HostTensorDescriptor({p.K, p.N}, {1, p.StrideB})),
+          ds_m_n{Tensor<float>(HostTensorDescriptor({p.M, p.N}, {p.StrideD, 1}))},
+          e_m_n_host(HostTensorDescriptor({p.M, p.N}, {p.StrideE, 1})),
+          e_m_n_ref(HostTensorDescriptor({p.M, p.N}, {p.StrideE, 1}))
+    {
+        ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(a_m_k);
+        ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(b_k_n);
+        ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(ds_m_n[0]);
+    }
+
+    Tensor<float> a_m_k;
+    Tensor<float> b_k_n;
+    std::array<Tensor<float>, 1> ds_m_n;
+    Tensor<float> e_m_n_host;
+    Tensor<float> e_m_n_ref;
+};
+
+std::unique_ptr<ck::tensor_operation::device::BaseArgument>
+MakeGemmArgument(DeviceGemmAdd& op, const GemmProblem& p, GemmTensors& t)
+{
+    return op.MakeArgumentPointer(t.a_m_k.mData.data(),
+                                  t.b_k_n.mData.data(),
+                                  {t.ds_m_n[0].mData.data()},
+                                  t.e_m_n_host.mData.data(),
+                                  p.M,
+                                  p.N,
+                                  p.K,
+                                  p.StrideA,
+                                  p.StrideB,
+                                  {p.StrideD},
+                                  p.StrideE,
+                                  PassThrough{},
+                                  PassThrough{},
+                                  Add{});
+}
+
+void RunReferenceGemm(GemmTensors& t)
+{
+    using ReferenceGemm = ck::tensor_operation::host::ReferenceGemmMultipleD<float,
+                                                                            float,
+                                                                            ck::Tuple<float>,
+                                                                            float,
+                                                                            float,
+                                                                            PassThrough,
+                                                                            PassThrough,
+                                                                            Add>;
+
+    auto ref_gemm     = ReferenceGemm{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        t.a_m_k, t.b_k_n, t.ds_m_n, t.e_m_n_ref, PassThrough{}, PassThrough{}, Add{});
+
+    ref_invoker.Run(ref_argument);
+}
+
+} // namespace
+
+TEST(HostBackend, GemmMultipleD)
+{
+    const auto op_ptrs = HostGemmAddFactory::GetInstances();
+
+    // sequential and fused accumulation for a float accumulator
+    ASSERT_EQ(op_ptrs.size(), 2);
+
+    // odd sizes that are not multiples of the blocking, and padded leading dimensions
+    const GemmProblem problem{67, 45, 129, 131, 133, 48, 47};
+
+    GemmTensors tensors(problem);
+    RunReferenceGemm(tensors);
+
+    for(auto& op_ptr : op_ptrs)
+    {
+        tensors.e_m_n_host.SetZero();
+
+        auto argument_ptr = MakeGemmArgument(*op_ptr, problem, tensors);
+        auto invoker_ptr  = op_ptr->MakeInvokerPointer();
+
+        ASSERT_TRUE(op_ptr->IsSupportedArgument(argument_ptr.get())) << op_ptr->GetTypeString();
+
+        invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, false});
+
+        EXPECT_TRUE(ck::utils::check_err(tensors.e_m_n_host, tensors.e_m_n_ref))
+            << op_ptr->GetTypeString();
+    }
+}
+
+TEST(HostBackend, GemmMultipleDInvalidStride)
+{
+    const auto op_ptrs = HostGemmAddFactory::GetInstances();
+
+    const GemmProblem problem{16, 16, 32, 32, 32, 16, 16};
+
+    GemmTensors tensors(problem);
+
+    for(auto& op_ptr : op_ptrs)
+    {
+        GemmProblem bad_problem = problem;
+        bad_problem.StrideA     = problem.K - 1;
+
+        auto argument_ptr = MakeGemmArgument(*op_ptr, bad_problem, tensors);
+
+        EXPECT_FALSE(op_ptr->IsSupportedArgument(argument_ptr.get())) << op_ptr->GetTypeString();
+    }
+}
+
+TEST(HostBackend, GemmMultipleDTimeKernel)
+{
+    const auto op_ptrs = HostGemmAddFactory::GetInstances();
+
+    const GemmProblem problem{32, 32, 32, 32, 32, 32, 32};
+
+    GemmTensors tensors(problem);
+
+    auto argument_ptr = MakeGemmArgument(*op_ptrs[0], problem, tensors);
+    auto invoker_ptr  = op_ptrs[0]->MakeInvokerPointer();
+
+    EXPECT_GE(invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, true, 0, 1, 3}), 0.f);
+}
+
+TEST(HostBackend, GroupedConvFwd)
+{
+    const auto op_ptrs = HostConvFwdFactory::GetInstances();
+
+    ASSERT_EQ(op_ptrs.size(), 2);
+
+    // groups, stride, dilation and asymmetric padding
+    const ck::utils::conv::ConvParam conv_param(
+        2, 2, 3, 5, 7, {3, 3}, {11, 13}, {2, 1}, {1, 2}, {1, 2}, {0, 1});
+
+    using InLayout  = ck::tensor_layout::convolution::GNHWC;
+    using WeiLayout = ck::tensor_layout::convolution::GKYXC;
+    using OutLayout = ck::tensor_layout::convolution::GNHWK;
+
+    const auto in_g_n_c_wis_desc =
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param);
+    const auto wei_g_k_c_xs_desc =
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(conv_param);
+    const auto out_g_n_k_wos_desc =
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param);
+
+    Tensor<float> input(in_g_n_c_wis_desc);
+    Tensor<float> weights(wei_g_k_c_xs_desc);
+    Tensor<float> out_host(out_g_n_k_wos_desc);
+    Tensor<float> out_ref(out_g_n_k_wos_desc);
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(weights);
+
+    auto ref_conv     = ck::tensor_operation::host::
+        ReferenceConvFwd<2, float, float, float, PassThrough, PassThrough, PassThrough>();
+    auto ref_invoker  = ref_conv.MakeInvoker();
+    auto ref_argument = ref_conv.MakeArgument(input,
+                                              weights,
+                                              out_ref,
+                                              conv_param.conv_filter_strides_,
+                                              conv_param.conv_filter_dilations_,
+                                              conv_param.input_left_pads_,
+                                              conv_param.input_right_pads_,
+                                              PassThrough{},
+                                              PassThrough{},
+                                              PassThrough{});
+    ref_invoker.Run(ref_argument);
+
+    std::array<index_t, 5> a_g_n_c_wis_lengths{};
+    std::array<index_t, 5> a_g_n_c_wis_strides{};
+    std::array<index_t, 5> b_g_k_c_xs_lengths{};
+    std::array<index_t, 5> b_g_k_c_xs_strides{};
+    std::array<index_t, 5> e_g_n_k_wos_lengths{};
+    std::array<index_t, 5> e_g_n_k_wos_strides{};
+    std::array<index_t, 2> conv_filter_strides{};
+    std::array<index_t, 2> conv_filter_dilations{};
+    std::array<index_t, 2> input_left_pads{};
+    std::array<index_t, 2> input_right_pads{};
+
+    auto copy = [](const auto& x, auto& y) { ck::ranges::copy(x, y.begin()); };
+
+    copy(in_g_n_c_wis_desc.GetLengths(), a_g_n_c_wis_lengths);
+    copy(in_g_n_c_wis_desc.GetStrides(), a_g_n_c_wis_strides);
+    copy(wei_g_k_c_xs_desc.GetLengths(), b_g_k_c_xs_lengths);
+    copy(wei_g_k_c_xs_desc.GetStrides(), b_g_k_c_xs_strides);
+    copy(out_g_n_k_wos_desc.GetLengths(), e_g_n_k_wos_lengths);
+    copy(out_g_n_k_wos_desc.GetStrides(), e_g_n_k_wos_strides);
+    copy(conv_param.conv_filter_strides_, conv_filter_strides);
+    copy(conv_param.conv_filter_dilations_, conv_filter_dilations);
+    copy(conv_param.input_left_pads_, input_left_pads);
+    copy(conv_param.input_right_pads_, input_right_pads);
+
+    for(auto& op_ptr : op_ptrs)
+    {
+        out_host.SetZero();
+
+        auto argument_ptr = op_ptr->MakeArgumentPointer(input.mData.data(),
+                                                        weights.mData.data(),
+                                                        {},
+                                                        out_host.mData.data(),
+                                                        a_g_n_c_wis_lengths,
+                                                        a_g_n_c_wis_strides,
+                                                        b_g_k_c_xs_lengths,
+                                                        b_g_k_c_xs_strides,
+                                                        {},
+                                                        {},
+                                                        e_g_n_k_wos_lengths,
+                                                        e_g_n_k_wos_strides,
+                                                        conv_filter_strides,
+                                                        conv_filter_dilations,
+                                                        input_left_pads,
+                                                        input_right_pads,
+                                                        PassThrough{},
+                                                        PassThrough{},
+                                                        PassThrough{});
+        auto invoker_ptr  = op_ptr->MakeInvokerPointer();
+
+        ASSERT_TRUE(op_ptr->IsSupportedArgument(argument_ptr.get())) << op_ptr->GetTypeString();
+
+        invoker_ptr->Run(argument_ptr.get(), StreamConfig{nullptr, false});
+
+        EXPECT_TRUE(ck::utils::check_err(out_host, out_ref)) << op_ptr->GetTypeString();
+    }
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_io.hpp"
+
+namespace {
+
+class TestHostTensorIO : public ::testing::Test
+{
+    protected:
+    std::string GetFileName(const std::string& suffix) const
+    {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        return std::string("test_host_tensor_io_") + info->name() + suffix;
+    }
+
+    void TearDown() override
+    {
+        for(const char* suffix : {".npy", ".bin"})
+            std::remove(GetFileName(suffix).c_str());
+    }
+};
+
+template <typename T>
+void FillIota(Tensor<T>& tensor)
+{
+    for(std::size_t i = 0; i < tensor.mData.size(); ++i)
+        tensor.mData[i] = static_cast<T>(i);
+}
+
+} // namespace
+
+TEST_F(TestHostTensorIO, NpyRoundTrip)
+{
+    const auto file_name = GetFileName(".npy");
+
+    Tensor<float> tensor(HostTensorDescriptor({3, 4, 5}));
+    FillIota(tensor);
+
+    ck::utils::SaveNpy(file_name, tensor);
+
+    const auto mapped = ck::utils::MapNpy<float>(file_name);
+    const auto loaded = ck::utils::LoadNpy<float>(file_name);
+
+    EXPECT_EQ(mapped.GetLengths(), tensor.GetLengths());
+    EXPECT_EQ(loaded.GetStrides(), tensor.GetStrides());
+
+    for(std::size_t i = 0; i < 3; ++i)
+        for(std::size_t j = 0; j < 4; ++j)
+            for(std::size_t k = 0; k < 5; ++k)
+            {
+                EXPECT_EQ(mapped(i, j, k), tensor(i, j, k));
+                EXPECT_EQ(loaded(i, j, k), tensor(i, j, k));
+            }
+}
+
+TEST_F(TestHostTensorIO, NpyColumnMajorKeepsLayout)
+{
+    const auto file_name = GetFileName(".npy");
+
+    Tensor<int32_t> tensor(HostTensorDescriptor({3, 4}, {1, 3}));
+    FillIota(tensor);
+
+    ck::utils::SaveNpy(file_name, tensor);
+
+    const auto mapped = ck::utils::MapNpy<int32_t>(file_name);
+
+    EXPECT_EQ(mapped.GetStrides(), tensor.GetStrides());
+
+    for(std::size_t i = 0; i < 3; ++i)
+        for(std::size_t j = 0; j < 4; ++j)
+            EXPECT_EQ(mapped(i, j), tensor(i, j));
+}
+
+TEST_F(TestHostTensorIO, NpyGathersStridedTensor)
+{
+    const auto file_name = GetFileName(".npy");
+
+    Tensor<double> tensor(HostTensorDescriptor({2, 3}, {8, 2}));
+    FillIota(tensor);
+
+    ck::utils::SaveNpy(file_name, tensor);
+
+    const auto loaded = ck::utils::LoadNpy<double>(file_name);
+
+    EXPECT_EQ(loaded.GetStrides(), (std::vector<std::size_t>{3, 1}));
+
+    for(std::size_t i = 0; i < 2; ++i)
+        for(std::size_t j = 0; j < 3; ++j)
+            EXPECT_EQ(loaded(i, j), tensor(i, j));
+}
+
+TEST_F(TestHostTensorIO, RawKeepsStrides)
+{
+    const auto file_name = GetFileName(".bin");
+
+    Tensor<ck::half_t> tensor(HostTensorDescriptor({2, 3, 4}, {1, 32, 8}));
+    FillIota(tensor);
+
+    ck::utils::SaveRaw(file_name, tensor);
+
+    const auto loaded = ck::utils::LoadRaw<ck::half_t>(file_name);
+
+    EXPECT_EQ(loaded.GetLengths(), tensor.GetLengths());
+    EXPECT_EQ(loaded.GetStrides(), tensor.GetStrides());
+    EXPECT_EQ(loaded.mData, tensor.mData);
+}
+
+TEST_F(TestHostTensorIO, BHalfRoundTripsBits)
+{
+    Tensor<ck::bhalf_t> tensor(HostTensorDescriptor({17}));
+
+    for(std::size_t i = 0; i < tensor.mData.size(); ++i)
+        tensor.mData[i] = static_cast<ck::bhalf_t>(0x3f80 + i);
+
+    ck::utils::SaveNpy(GetFileName(".npy"), tensor);
+    ck::utils::SaveRaw(GetFileName(".bin"), tensor);
+
+    EXPECT_EQ(ck::utils::LoadNpy<ck::bhalf_t>(GetFileName(".npy")).mData, tensor.mData);
+    EXPECT_EQ(ck::utils::LoadRaw<ck::bhalf_t>(GetFileName(".bin")).mData, tensor.mData);
+}
+
+TEST_F(TestHostTensorIO, DataTypeMismatchThrows)
+{
+    Tensor<float> tensor(HostTensorDescriptor({4, 4}));
+    FillIota(tensor);
+
+    ck::utils::SaveNpy(GetFileName(".npy"), tensor);
+    ck::utils::SaveRaw(GetFileName(".bin"), tensor);
+
+    EXPECT_THROW(ck::utils::LoadNpy<int32_t>(GetFileName(".npy")), std::runtime_error);
+    EXPECT_THROW(ck::utils::MapRaw<ck::half_t>(GetFileName(".bin")), std::runtime_error);
+    EXPECT_THROW(ck::utils::LoadNpy<float>(GetFileName(".missing")), std::runtime_error);
+}
+
+TEST_F(TestHostTensorIO, SameSizeDataTypeMismatchThrows)
+{
+    Tensor<ck::half_t> tensor(HostTensorDescriptor({4, 4}));
+    FillIota(tensor);
+
+    ck::utils::SaveNpy(GetFileName(".npy"), tensor);
+    ck::utils::SaveRaw(GetFileName(".bin"), tensor);
+
+    EXPECT_THROW(ck::utils::MapNpy<ck::bhalf_t>(GetFileName(".npy")), std::runtime_error);
+    EXPECT_THROW(ck::utils::MapRaw<ck::bhalf_t>(GetFileName(".bin")), std::runtime_error);
+
+    Tensor<ck::f8_ocp_t> fp8_tensor(HostTensorDescriptor({16}));
+
+    ck::utils::SaveRaw(GetFileName(".bin"), fp8_tensor);
+
+    EXPECT_THROW(ck::utils::MapRaw<ck::f8_fnuz_t>(GetFileName(".bin")), std::runtime_error);
+
+    // the raw bits of bf16/fp8 come as unsigned integers from numpy
+    Tensor<uint16_t> bits(HostTensorDescriptor({4, 4}));
+    FillIota(bits);
+
+    ck::utils::SaveNpy(GetFileName(".npy"), bits);
+
+    EXPECT_NO_THROW(ck::utils::MapNpy<ck::bhalf_t>(GetFileName(".npy")));
+}
@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_elementwise.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_softmax.hpp"
+
+using ck::utils::TensorView;
+
+namespace {
+
+template <typename T>
+void FillIota(Tensor<T>& tensor)
+{
+    std::iota(tensor.mData.begin(), tensor.mData.end(), T{0});
+}
+
+} // namespace
+
+TEST(TestHostTensorView, Indexing)
+{
+    std::vector<int> data(2 * 3 * 4);
+    std::iota(data.begin(), data.end(), 0);
+
+    const TensorView<int, 3> view(data.data(), {2, 3, 4});
+
+    EXPECT_EQ(view.GetStrides(), (std::array<std::size_t, 3>{12, 4, 1}));
+    EXPECT_EQ(view.GetElementSize(), 24);
+    EXPECT_TRUE(view.IsPacked());
+    EXPECT_EQ(view(1, 2, 3), 23);
+    EXPECT_EQ(view({1, 0, 2}), 14);
+
+    view(0, 1, 1) = -1;
+    EXPECT_EQ(data[5], -1);
+
+    const TensorView<const int, 3> const_view = view;
+    EXPECT_EQ(const_view(0, 1, 1), -1);
+}
+
+TEST(TestHostTensorView, ViewsShareStorage)
+{
+    std::vector<int> data(2 * 3 * 4);
+    std::iota(data.begin(), data.end(), 0);
+
+    const TensorView<int, 3> view(data.data(), {2, 3, 4});
+
+    const auto slice = view.Slice(2, 1, 3);
+    EXPECT_EQ(slice.GetLengths(), (std::array<std::size_t, 3>{2, 3, 2}));
+    EXPECT_EQ(slice(1, 2, 0), view(1, 2, 1));
+    EXPECT_FALSE(slice.IsPacked());
+    EXPECT_TRUE(slice.IsInnermostContiguous());
+
+    const auto row = view.Select(0, 1).Select(0, 2);
+    EXPECT_EQ(row.GetLengths(), (std::array<std::size_t, 1>{4}));
+    EXPECT_EQ(row(3), 23);
+
+    const auto permuted = view.Permute({2, 0, 1});
+    EXPECT_EQ(permuted.GetLengths(), (std::array<std::size_t, 3>{4, 2, 3}));
+    EXPECT_EQ(permuted(3, 1, 2), view(1, 2, 3));
+    EXPECT_FALSE(permuted.IsInnermostContiguous());
+
+    const auto transposed = view.Transpose(1, 2);
+    EXPECT_EQ(transposed(1, 3, 2), view(1, 2, 3));
+
+    const auto broadcast = view.Slice(1, 2, 3).Broadcast(1, 5);
+    EXPECT_EQ(broadcast.GetLength(1), 5);
+    EXPECT_EQ(broadcast(1, 4, 3), view(1, 2, 3));
+
+    row(0) = 100;
+    EXPECT_EQ(view(1, 2, 0), 100);
+
+    EXPECT_THROW(view.Slice(0, 1, 3), std::out_of_range);
+    EXPECT_THROW(view.Select(2, 4), std::out_of_range);
+    EXPECT_THROW(view.Permute({0, 0, 1}), std::invalid_argument);
+    EXPECT_THROW(view.Broadcast(0, 3), std::invalid_argument);
+}
+
+TEST(TestHostTensorView, Iteration)
+{
+    std::vector<int> data(3 * 4);
+    std::iota(data.begin(), data.end(), 0);
+
+    const TensorView<int, 2> view(data.data(), {3, 4});
+
+    // row-major order of the transposed view walks the columns of the data
+    std::vector<int> visited;
+    view.Transpose(0, 1).ForEach([&](int x) { visited.push_back(x); });
+
+    EXPECT_EQ(visited, (std::vector<int>{0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11}));
+
+    std::size_t num_rows = 0;
+    view.ForEachRow([&](const auto& idx, int* p, std::size_t length, std::size_t stride) {
+        EXPECT_EQ(idx[0], num_rows);
+        EXPECT_EQ(idx[1], 0);
+        EXPECT_EQ(p, &view(num_rows, 0));
+        EXPECT_EQ(length, 4);
+        EXPECT_EQ(stride, 1);
+        ++num_rows;
+    });
+    EXPECT_EQ(num_rows, 3);
+
+    // empty views are not iterated
+    view.Slice(0, 1, 1).ForEach([](int) { FAIL(); });
+}
+
+TEST(TestHostTensorView, TensorAsView)
+{
+    Tensor<float> tensor(HostTensorDescriptor({2, 3, 4}, {1, 8, 2}));
+    FillIota(tensor);
+
+    const auto view = tensor.AsView<3>();
+
+    EXPECT_EQ(view.data(), tensor.data());
+
+    for(std::size_t i = 0; i < 2; ++i)
+        for(std::size_t j = 0; j < 3; ++j)
+            for(std::size_t k = 0; k < 4; ++k)
+                EXPECT_EQ(view(i, j, k), tensor(i, j, k));
+
+    EXPECT_THROW(tensor.AsView<2>(), std::runtime_error);
+
+    EXPECT_TRUE(ck::utils::DispatchTensorRank(3, [](auto rank) { EXPECT_EQ(rank.value, 3); }));
+    EXPECT_FALSE(ck::utils::DispatchTensorRank(7, [](auto) { FAIL(); }));
+}
+
+TEST(TestHostTensorView, ReferenceElementwiseStrided)
+{
+    using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+    using ReferenceElementwise =
+        ck::tensor_operation::host::ReferenceElementwise<1, float, float, PassThrough>;
+
+    // copy between a packed and a transposed layout
+    std::array<Tensor<float>, 1> in{Tensor<float>(HostTensorDescriptor({5, 7}))};
+    Tensor<float> out(HostTensorDescriptor({5, 7}, {1, 5}));
+    FillIota(in[0]);
+
+    auto ref_elementwise = ReferenceElementwise{};
+    auto ref_invoker     = ref_elementwise.MakeInvoker();
+    auto ref_argument    = ref_elementwise.MakeArgument(in, out, PassThrough{});
+
+    ref_invoker.Run(ref_argument);
+
+    for(std::size_t i = 0; i < 5; ++i)
+        for(std::size_t j = 0; j < 7; ++j)
+            EXPECT_EQ(out(i, j), in[0](i, j));
+}
+
+TEST(TestHostTensorView, ReferenceSoftmax)
+{
+    using ReferenceSoftmax = ck::tensor_operation::host::ReferenceSoftmax<float, float, float>;
+
+    Tensor<float> in(HostTensorDescriptor({2, 3, 4}));
+    Tensor<float> out(HostTensorDescriptor({2, 3, 4}));
+
+    for(std::size_t i = 0; i < in.mData.size(); ++i)
+        in.mData[i] = 0.25f * static_cast<float>(i % 7);
+
+    out.SetZero();
+
+    // softmax over dimensions 0 and 2
+    auto ref_softmax  = ReferenceSoftmax{};
+    auto ref_invoker  = ref_softmax.MakeInvoker();
+    auto ref_argument = ref_softmax.MakeArgument(in, out, 1.0, 0.0, {0, 2});
+
+    ref_invoker.Run(ref_argument);
+
+    for(std::size_t j = 0; j < 3; ++j)
+    {
+        float max = in(0, j, 0);
+
+        for(std::size_t i = 0; i < 2; ++i)
+            for(std::size_t k = 0; k < 4; ++k)
+                max = std::max(max, in(i, j, k));
+
+        float sum = 0;
+
+        for(std::size_t i = 0; i < 2; ++i)
+            for(std::size_t k = 0; k < 4; ++k)
+                sum += std::exp(in(i, j, k) - max);
+
+        for(std::size_t i = 0; i < 2; ++i)
+            for(std::size_t k = 0; k < 4; ++k)
+                EXPECT_FLOAT_EQ(out(i, j, k), std::exp(in(i, j, k) - max) / sum);
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_thread_pool.hpp"
+
+class TestHostThreadPool : public ::testing::TestWithParam<std::size_t>
+{
+    protected:
+    void SetUp() override { ck::SetHostNumThreads(GetParam()); }
+
+    void TearDown() override { ck::SetHostNumThreads(0); }
+};
+
+TEST_P(TestHostThreadPool, VisitsEveryIndexOnce)
+{
+    for(std::size_t n : {1, 7, 64, 1000, 100003})
+    {
+        std::vector<int> visits(n, 0);
+
+        ck::HostThreadPool::Instance().ParallelFor(n, 0, [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i = begin; i < end; ++i)
+                ++visits[i];
+        });
+
+        EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+    }
+}
+
+TEST_P(TestHostThreadPool, NestedCallsRunSerially)
+{
+    std::atomic<std::size_t> total{0};
+
+    ck::HostThreadPool::Instance().ParallelFor(32, 0, [&](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            ck::HostThreadPool::Instance().ParallelFor(
+                100, 0, [&](std::size_t inner_begin, std::size_t inner_end) {
+                    EXPECT_EQ(inner_begin, 0);
+                    EXPECT_EQ(inner_end, 100);
+                    total += inner_end - inner_begin;
+                });
+        }
+    });
+
+    EXPECT_EQ(total.load(), 3200);
+}
+
+TEST_P(TestHostThreadPool, ExceptionIsPropagated)
+{
+    auto throwing = [](std::size_t begin, std::size_t end) {
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            if(i == 777)
+                throw std::runtime_error("failure");
+        }
+    };
+
+    EXPECT_THROW(ck::HostThreadPool::Instance().ParallelFor(1000, 0, throwing), std::runtime_error);
+
+    // the pool stays usable afterwards
+    std::atomic<std::size_t> count{0};
+    ck::HostThreadPool::Instance().ParallelFor(
+        1000, 0, [&](std::size_t begin, std::size_t end) { count += end - begin; });
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST_P(TestHostThreadPool, ParallelTensorFunctorMatchesSerial)
+{
+    Tensor<float> parallel({13, 17, 19});
+    Tensor<float> serial({13, 17, 19});
+
+    auto gen = [](auto i0, auto i1, auto i2) {
+        return static_cast<float>(i0 * 1000 + i1 * 10 + i2);
+    };
+
+    parallel.GenerateTensorValue(gen, GetParam());
+    serial.GenerateTensorValue(gen, 1);
+
+    EXPECT_EQ(parallel.mData, serial.mData);
+}
+
+INSTANTIATE_TEST_SUITE_P(HostThreadPool, TestHostThreadPool, ::testing::Values(1, 2, 3, 8));
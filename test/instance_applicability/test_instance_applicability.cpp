@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <memory>
+#include <optional>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/device_gemm_applicability.hpp"
+#include "ck/tensor_operation/gpu/device/device_instance_descriptor.hpp"
+#include "ck/library/tensor_operation_instance/instance_applicability_cache.hpp"
+#include "ck/library/tensor_operation_instance/gpu/gemm_universal.hpp"
+
+using ck::tensor_operation::device::DeviceInstanceDescriptor;
+using ck::tensor_operation::device::GemmProblemSignature;
+using ck::tensor_operation::device::GemmSpecialization;
+using ck::tensor_operation::device::IsGemmProblemApplicable;
+using ck::tensor_operation::device::instance::GemmApplicabilityCache;
+
+using F16         = ck::half_t;
+using Row         = ck::tensor_layout::gemm::RowMajor;
+using Col         = ck::tensor_layout::gemm::ColumnMajor;
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+namespace {
+
+DeviceInstanceDescriptor MakeUniversalGemmDescriptor(GemmSpecialization gemm_spec)
+{
+    DeviceInstanceDescriptor desc;
+
+    desc.op_name                 = "DeviceGemmXdlUniversal";
+    desc.a_layout                = "RowMajor";
+    desc.b_layout                = "RowMajor";
+    desc.c_layout                = "RowMajor";
+    desc.gemm_spec               = gemm_spec;
+    desc.block_size              = 256;
+    desc.m_per_block             = 128;
+    desc.n_per_block             = 128;
+    desc.k_per_block             = 64;
+    desc.ak1                     = 8;
+    desc.bk1                     = 8;
+    desc.pipeline_version        = 3;
+    desc.prefetch_stages         = 2;
+    desc.a_src_scalar_per_vector = 8;
+    desc.b_src_scalar_per_vector = 8;
+    desc.c_dst_scalar_per_vector = 8;
+
+    return desc;
+}
+
+GemmProblemSignature MakeProblem(int M, int N, int K, int KBatch = 1)
+{
+    GemmProblemSignature problem;
+
+    problem.M       = M;
+    problem.N       = N;
+    problem.K       = K;
+    problem.StrideA = K;
+    problem.StrideB = N;
+    problem.StrideE = N;
+    problem.KBatch  = KBatch;
+
+    return problem;
+}
+
+struct FakeInstance
+{
+    std::optional<DeviceInstanceDescriptor> GetInstanceDescriptor() const { return desc; }
+
+    std::optional<DeviceInstanceDescriptor> desc;
+};
+
+} // namespace
+
+TEST(TestInstanceApplicability, PaddingSpecialization)
+{
+    const auto no_pad  = MakeUniversalGemmDescriptor(GemmSpecialization::Default);
+    const auto mnk_pad = MakeUniversalGemmDescriptor(GemmSpecialization::MNKPadding);
+
+    EXPECT_TRUE(IsGemmProblemApplicable(no_pad, MakeProblem(256, 256, 512)));
+    EXPECT_TRUE(IsGemmProblemApplicable(mnk_pad, MakeProblem(256, 256, 512)));
+
+    // B is row-major, so N has to be a multiple of NPerBlock without N padding
+    EXPECT_FALSE(IsGemmProblemApplicable(no_pad, MakeProblem(256, 200, 512)));
+    EXPECT_TRUE(IsGemmProblemApplicable(mnk_pad, MakeProblem(256, 200, 512)));
+
+    // K not a multiple of KPerBlock
+    EXPECT_FALSE(IsGemmProblemApplicable(no_pad, MakeProblem(256, 256, 520)));
+    EXPECT_TRUE(IsGemmProblemApplicable(mnk_pad, MakeProblem(256, 256, 520)));
+}
+
+TEST(TestInstanceApplicability, VectorWidth)
+{
+    const auto mnk_pad = MakeUniversalGemmDescriptor(GemmSpecialization::MNKPadding);
+
+    // contiguous dimensions K (A), N (B) and N (C) have to be multiples of the vector width
+    EXPECT_FALSE(IsGemmProblemApplicable(mnk_pad, MakeProblem(256, 256, 514)));
+    EXPECT_FALSE(IsGemmProblemApplicable(mnk_pad, MakeProblem(256, 260, 512)));
+    EXPECT_TRUE(IsGemmProblemApplicable(mnk_pad, MakeProblem(250, 256, 512)));
+
+    auto col_a     = mnk_pad;
+    col_a.a_layout = "ColumnMajor";
+
+    EXPECT_FALSE(IsGemmProblemApplicable(col_a, MakeProblem(250, 256, 512)));
+}
+
+TEST(TestInstanceApplicability, SplitKAndPipeline)
+{
+    const auto no_pad = MakeUniversalGemmDescriptor(GemmSpecialization::Default);
+
+    EXPECT_TRUE(IsGemmProblemApplicable(no_pad, MakeProblem(256, 256, 1024, 4)));
+    EXPECT_FALSE(IsGemmProblemApplicable(no_pad, MakeProblem(256, 256, 1024, 3)));
+    EXPECT_FALSE(IsGemmProblemApplicable(no_pad, MakeProblem(256, 256, 1024, 0)));
+
+    // 2 K loops do not fill the 2 prefetch stages of the pipeline, v1 has no such limit
+    EXPECT_FALSE(IsGemmProblemApplicable(no_pad, MakeProblem(256, 256, 128)));
+
+    auto v1             = no_pad;
+    v1.pipeline_version = 1;
+
+    EXPECT_TRUE(IsGemmProblemApplicable(v1, MakeProblem(256, 256, 128)));
+}
+
+TEST(TestInstanceApplicability, OtherFamiliesPass)
+{
+    auto desc    = MakeUniversalGemmDescriptor(GemmSpecialization::Default);
+    desc.op_name = "DeviceGemmXdl";
+
+    EXPECT_TRUE(IsGemmProblemApplicable(desc, MakeProblem(1, 1, 1)));
+}
+
+TEST(TestInstanceApplicability, CacheMemoizesFullCheck)
+{
+    std::vector<std::unique_ptr<FakeInstance>> instances;
+
+    instances.push_back(std::make_unique<FakeInstance>(
+        FakeInstance{MakeUniversalGemmDescriptor(GemmSpecialization::Default)}));
+    instances.push_back(std::make_unique<FakeInstance>(
+        FakeInstance{MakeUniversalGemmDescriptor(GemmSpecialization::MNKPadding)}));
+    instances.push_back(std::make_unique<FakeInstance>(FakeInstance{std::nullopt}));
+
+    GemmApplicabilityCache cache;
+
+    std::vector<std::size_t> checked;
+
+    const auto is_supported = [&](std::size_t index) {
+        checked.push_back(index);
+        return true;
+    };
+
+    // instance 0 is ruled out by its descriptor, the full check runs for 1 and 2 only
+    const auto& supported = cache.Find(instances, MakeProblem(256, 200, 512), is_supported);
+
+    EXPECT_EQ(supported, (std::vector<std::size_t>{1, 2}));
+    EXPECT_EQ(checked, (std::vector<std::size_t>{1, 2}));
+
+    const auto& supported_again = cache.Find(instances, MakeProblem(256, 200, 512), is_supported);
+
+    EXPECT_EQ(&supported_again, &supported);
+    EXPECT_EQ(checked.size(), 2);
+
+    cache.Find(instances, MakeProblem(256, 256, 512), is_supported);
+
+    const auto stats = cache.GetStats();
+
+    EXPECT_EQ(cache.GetNumEntries(), 2);
+    EXPECT_EQ(stats.num_hits, 1);
+    EXPECT_EQ(stats.num_misses, 2);
+    EXPECT_EQ(stats.num_prefiltered, 1);
+    EXPECT_EQ(stats.num_checked, 5);
+
+    instances.pop_back();
+
+    EXPECT_THROW(cache.Find(instances, MakeProblem(1, 1, 1), is_supported), std::runtime_error);
+}
+
+// the pre-filter never rejects a problem that IsSupportedArgument() accepts
+TEST(TestInstanceApplicability, ConsistentWithIsSupportedArgument)
+{
+    using DeviceOp = ck::tensor_operation::device::
+        DeviceGemmV2<Row, Col, Row, F16, F16, F16, PassThrough, PassThrough, PassThrough>;
+
+    const auto op_ptrs =
+        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+            DeviceOp>::GetInstances();
+
+    ASSERT_FALSE(op_ptrs.empty());
+
+    std::size_t num_prefiltered = 0;
+
+    for(const int M : {1, 64, 200, 256})
+    {
+        for(const int N : {8, 100, 256})
+        {
+            for(const int K : {8, 72, 256, 1024})
+            {
+                for(const int KBatch : {1, 2, 4})
+                {
+                    GemmProblemSignature problem = MakeProblem(M, N, K, KBatch);
+                    problem.StrideB              = K;
+
+                    for(const auto& op_ptr : op_ptrs)
+                    {
+                        const auto desc = op_ptr->GetInstanceDescriptor();
+
+                        ASSERT_TRUE(desc.has_value());
+
+                        if(IsGemmProblemApplicable(*desc, problem))
+                            continue;
+
+                        ++num_prefiltered;
+
+                        auto argument_ptr = op_ptr->MakeArgumentPointer(nullptr,
+                                                                        nullptr,
+                                                                        nullptr,
+                                                                        M,
+                                                                        N,
+                                                                        K,
+                                                                        problem.StrideA,
+                                                                        problem.StrideB,
+                                                                        problem.StrideE,
+                                                                        KBatch,
+                                                                        PassThrough{},
+                                                                        PassThrough{},
+                                                                        PassThrough{});
+
+                        EXPECT_FALSE(op_ptr->IsSupportedArgument(argument_ptr.get()))
+                            << op_ptr->GetTypeString() << " M " << M << " N " << N << " K " << K
+                            << " KBatch " << KBatch;
+                    }
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(num_prefiltered, 0);
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Device operation interfaces and instance factory standing in for the real ones, so that the
+// plugin mechanism can be tested without building device code.
+namespace ck {
+namespace test {
+
+template <int Variant>
+struct FakeDeviceOp
+{
+    virtual ~FakeDeviceOp() = default;
+
+    virtual std::string GetTypeString() const = 0;
+};
+
+template <typename DeviceOp, typename Tag = void>
+struct FakeInstanceFactory;
+
+} // namespace test
+} // namespace ck
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <tuple>
+
+#include "ck/library/tensor_operation_instance/instance_plugin.hpp"
+#include "fake_device_op.hpp"
+
+namespace ck {
+namespace test {
+
+template <int Variant, int Tile>
+struct FakeDeviceOpImpl : public FakeDeviceOp<Variant>
+{
+    std::string GetTypeString() const override
+    {
+        return "FakeDeviceOp<" + std::to_string(Variant) + ", " + std::to_string(Tile) + ">";
+    }
+};
+
+template <>
+struct FakeInstanceFactory<FakeDeviceOp<0>>
+{
+    static auto GetInstances()
+    {
+        std::vector<std::unique_ptr<FakeDeviceOp<0>>> op_ptrs;
+
+        op_ptrs.push_back(std::make_unique<FakeDeviceOpImpl<0, 64>>());
+        op_ptrs.push_back(std::make_unique<FakeDeviceOpImpl<0, 128>>());
+
+        return op_ptrs;
+    }
+};
+
+template <>
+struct FakeInstanceFactory<FakeDeviceOp<1>>
+{
+    static auto GetInstances()
+    {
+        std::vector<std::unique_ptr<FakeDeviceOp<1>>> op_ptrs;
+
+        op_ptrs.push_back(std::make_unique<FakeDeviceOpImpl<1, 256>>());
+
+        return op_ptrs;
+    }
+};
+
+using FakeDeviceOps = std::tuple<FakeDeviceOp<0>, FakeDeviceOp<1>>;
+
+} // namespace test
+} // namespace ck
+
+CK_INSTANCE_PLUGIN(ck::test::FakeInstanceFactory, ck::test::FakeDeviceOps)
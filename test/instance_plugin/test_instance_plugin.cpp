@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/tensor_operation_instance/instance_plugin.hpp"
+#include "fake_device_op.hpp"
+
+using ck::tensor_operation::device::instance::GetPluginInstances;
+using ck::tensor_operation::device::instance::InstancePluginRegistry;
+using ck::tensor_operation::device::instance::InstancePluginStats;
+
+namespace {
+
+InstancePluginStats GetBucketStats(const std::string& bucket)
+{
+    for(const auto& stats : InstancePluginRegistry::Instance().GetStats())
+    {
+        if(stats.bucket == bucket)
+            return stats;
+    }
+
+    throw std::runtime_error("no stats for bucket " + bucket);
+}
+
+} // namespace
+
+TEST(TestInstancePlugin, LoadsOnFirstUse)
+{
+    auto& registry = InstancePluginRegistry::Instance();
+
+    std::vector<InstancePluginStats> loaded;
+    registry.SetStatsCallback([&](const InstancePluginStats& stats) { loaded.push_back(stats); });
+
+    registry.AddBucket("fake", CK_TEST_INSTANCE_PLUGIN);
+
+    EXPECT_TRUE(registry.HasBucket("fake"));
+    EXPECT_FALSE(GetBucketStats("fake").loaded);
+
+    const auto instances = GetPluginInstances<ck::test::FakeDeviceOp<0>>("fake");
+
+    ASSERT_EQ(instances.size(), 2);
+    EXPECT_EQ(instances[0]->GetTypeString(), "FakeDeviceOp<0, 64>");
+    EXPECT_EQ(instances[1]->GetTypeString(), "FakeDeviceOp<0, 128>");
+
+    const auto other_instances = GetPluginInstances<ck::test::FakeDeviceOp<1>>("fake");
+
+    ASSERT_EQ(other_instances.size(), 1);
+    EXPECT_EQ(other_instances[0]->GetTypeString(), "FakeDeviceOp<1, 256>");
+
+    // device operations the plugin does not provide have no instances
+    EXPECT_TRUE(GetPluginInstances<ck::test::FakeDeviceOp<2>>("fake").empty());
+
+    const auto stats = GetBucketStats("fake");
+
+    EXPECT_TRUE(stats.loaded);
+    EXPECT_GE(stats.load_time_ms, 0);
+    EXPECT_EQ(stats.num_get_instances, 3);
+    EXPECT_EQ(stats.num_instances, 3);
+
+    ASSERT_EQ(loaded.size(), 1);
+    EXPECT_EQ(loaded[0].bucket, "fake");
+    EXPECT_EQ(loaded[0].library_path, CK_TEST_INSTANCE_PLUGIN);
+
+    registry.SetStatsCallback(nullptr);
+}
+
+TEST(TestInstancePlugin, Manifest)
+{
+    const std::string file_name = "test_instance_plugin.manifest";
+
+    {
+        std::ofstream file(file_name);
+        file << "# <bucket> <library>\n";
+        file << "\n";
+        file << "manifest_absolute " << CK_TEST_INSTANCE_PLUGIN << "\n";
+        file << "manifest_relative libck_instance_plugin_missing.so\n";
+    }
+
+    auto& registry = InstancePluginRegistry::Instance();
+    registry.LoadManifest(file_name);
+
+    EXPECT_TRUE(registry.HasBucket("manifest_absolute"));
+    EXPECT_EQ(GetBucketStats("manifest_relative").library_path,
+              "libck_instance_plugin_missing.so");
+
+    EXPECT_EQ(GetPluginInstances<ck::test::FakeDeviceOp<1>>("manifest_absolute").size(), 1);
+    EXPECT_THROW(GetPluginInstances<ck::test::FakeDeviceOp<1>>("manifest_relative"),
+                 std::runtime_error);
+    EXPECT_FALSE(GetBucketStats("manifest_relative").loaded);
+
+    std::remove(file_name.c_str());
+}
+
+TEST(TestInstancePlugin, Errors)
+{
+    auto& registry = InstancePluginRegistry::Instance();
+
+    EXPECT_THROW(GetPluginInstances<ck::test::FakeDeviceOp<0>>("unknown"), std::runtime_error);
+    EXPECT_THROW(registry.LoadManifest("missing.manifest"), std::runtime_error);
+
+    {
+        std::ofstream file("test_instance_plugin_bad.manifest");
+        file << "bucket_without_library\n";
+    }
+
+    EXPECT_THROW(registry.LoadManifest("test_instance_plugin_bad.manifest"), std::runtime_error);
+    std::remove("test_instance_plugin_bad.manifest");
+}
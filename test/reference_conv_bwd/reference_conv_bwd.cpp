@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
+
+namespace {
+
+using InElementOp  = ck::tensor_operation::element_wise::PassThrough;
+using WeiElementOp = ck::tensor_operation::element_wise::PassThrough;
+using OutElementOp = ck::tensor_operation::element_wise::PassThrough;
+
+template <ck::index_t NDimSpatial, typename InLayout, typename WeiLayout, typename OutLayout>
+bool check_bwd_data_phase_gemm_matches_naive(const ck::utils::conv::ConvParam& conv_param)
+{
+    using ck::tensor_operation::host::ReferenceConvBwdDataAlgorithm;
+
+    Tensor<float> in_naive(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<float> in_gemm(in_naive.mDesc);
+    Tensor<float> weights(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(conv_param));
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(weights);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(output);
+
+    auto ref_conv    = ck::tensor_operation::host::ReferenceConvBwdData<NDimSpatial,
+                                                                     float,
+                                                                     float,
+                                                                     float,
+                                                                     InElementOp,
+                                                                     WeiElementOp,
+                                                                     OutElementOp>();
+    auto ref_invoker = ref_conv.MakeInvoker();
+
+    for(auto [algorithm, input] :
+        {std::make_pair(ReferenceConvBwdDataAlgorithm::Naive, &in_naive),
+         std::make_pair(ReferenceConvBwdDataAlgorithm::PhaseGemm, &in_gemm)})
+    {
+        auto ref_argument = ref_conv.MakeArgument(*input,
+                                                  weights,
+                                                  output,
+                                                  conv_param.conv_filter_strides_,
+                                                  conv_param.conv_filter_dilations_,
+                                                  conv_param.input_left_pads_,
+                                                  conv_param.input_right_pads_,
+                                                  InElementOp{},
+                                                  WeiElementOp{},
+                                                  OutElementOp{},
+                                                  {},
+                                                  {},
+                                                  {},
+                                                  algorithm);
+        ref_invoker.Run(ref_argument);
+    }
+
+    return ck::utils::check_err(in_gemm, in_naive);
+}
+
+template <ck::index_t NDimSpatial, typename InLayout, typename WeiLayout, typename OutLayout>
+bool check_bwd_weight_im2col_gemm_matches_naive(const ck::utils::conv::ConvParam& conv_param)
+{
+    using ck::tensor_operation::host::ReferenceConvBwdWeightAlgorithm;
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<float> wei_naive(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(conv_param));
+    Tensor<float> wei_gemm(wei_naive.mDesc);
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param));
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(output);
+
+    auto ref_conv    = ck::tensor_operation::host::ReferenceConvBwdWeight<NDimSpatial,
+                                                                       float,
+                                                                       float,
+                                                                       float,
+                                                                       InElementOp,
+                                                                       WeiElementOp,
+                                                                       OutElementOp>();
+    auto ref_invoker = ref_conv.MakeInvoker();
+
+    for(auto [algorithm, weights] :
+        {std::make_pair(ReferenceConvBwdWeightAlgorithm::Naive, &wei_naive),
+         std::make_pair(ReferenceConvBwdWeightAlgorithm::Im2colGemm, &wei_gemm)})
+    {
+        auto ref_argument = ref_conv.MakeArgument(input,
+                                                  *weights,
+                                                  output,
+                                                  conv_param.conv_filter_strides_,
+                                                  conv_param.conv_filter_dilations_,
+                                                  conv_param.input_left_pads_,
+                                                  conv_param.input_right_pads_,
+                                                  InElementOp{},
+                                                  WeiElementOp{},
+                                                  OutElementOp{},
+                                                  {},
+                                                  {},
+                                                  {},
+                                                  algorithm);
+        ref_invoker.Run(ref_argument);
+    }
+
+    return ck::utils::check_err(wei_gemm, wei_naive);
+}
+
+template <ck::index_t NDimSpatial, typename InLayout, typename WeiLayout, typename OutLayout>
+bool check_bwd_matches_naive(const ck::utils::conv::ConvParam& conv_param)
+{
+    return check_bwd_data_phase_gemm_matches_naive<NDimSpatial, InLayout, WeiLayout, OutLayout>(
+               conv_param) &&
+           check_bwd_weight_im2col_gemm_matches_naive<NDimSpatial, InLayout, WeiLayout, OutLayout>(
+               conv_param);
+}
+
+} // anonymous namespace
+
+TEST(ReferenceConvolutionBWD, GemmMatchesNaive1D)
+{
+    ck::utils::conv::ConvParam conv_param(1,
+                                          2,
+                                          3,
+                                          17,
+                                          5,
+                                          std::vector<ck::index_t>{3},
+                                          std::vector<ck::index_t>{37},
+                                          std::vector<ck::index_t>{2},
+                                          std::vector<ck::index_t>{2},
+                                          std::vector<ck::index_t>{1},
+                                          std::vector<ck::index_t>{2});
+
+    EXPECT_TRUE((check_bwd_matches_naive<1,
+                                         ck::tensor_layout::convolution::GNWC,
+                                         ck::tensor_layout::convolution::GKXC,
+                                         ck::tensor_layout::convolution::GNWK>(conv_param)));
+}
+
+TEST(ReferenceConvolutionBWD, GemmMatchesNaive2D)
+{
+    ck::utils::conv::ConvParam conv_param(2,
+                                          2,
+                                          2,
+                                          33,
+                                          7,
+                                          std::vector<ck::index_t>{3, 5},
+                                          std::vector<ck::index_t>{14, 17},
+                                          std::vector<ck::index_t>{2, 3},
+                                          std::vector<ck::index_t>{2, 1},
+                                          std::vector<ck::index_t>{1, 2},
+                                          std::vector<ck::index_t>{1, 2});
+
+    EXPECT_TRUE((check_bwd_matches_naive<2,
+                                         ck::tensor_layout::convolution::GNHWC,
+                                         ck::tensor_layout::convolution::GKYXC,
+                                         ck::tensor_layout::convolution::GNHWK>(conv_param)));
+}
+
+// stride larger than the filter: some input positions receive no contribution at all
+TEST(ReferenceConvolutionBWD, GemmMatchesNaive2DStrideLargerThanFilter)
+{
+    ck::utils::conv::ConvParam conv_param(2,
+                                          1,
+                                          3,
+                                          16,
+                                          8,
+                                          std::vector<ck::index_t>{1, 1},
+                                          std::vector<ck::index_t>{11, 12},
+                                          std::vector<ck::index_t>{2, 3},
+                                          std::vector<ck::index_t>{1, 1},
+                                          std::vector<ck::index_t>{0, 0},
+                                          std::vector<ck::index_t>{0, 0});
+
+    EXPECT_TRUE((check_bwd_matches_naive<2,
+                                         ck::tensor_layout::convolution::GNHWC,
+                                         ck::tensor_layout::convolution::GKYXC,
+                                         ck::tensor_layout::convolution::GNHWK>(conv_param)));
+}
+
+TEST(ReferenceConvolutionBWD, GemmMatchesNaive3D)
+{
+    ck::utils::conv::ConvParam conv_param(3,
+                                          1,
+                                          2,
+                                          8,
+                                          3,
+                                          std::vector<ck::index_t>{3, 3, 3},
+                                          std::vector<ck::index_t>{7, 8, 9},
+                                          std::vector<ck::index_t>{2, 2, 1},
+                                          std::vector<ck::index_t>{1, 1, 2},
+                                          std::vector<ck::index_t>{1, 1, 1},
+                                          std::vector<ck::index_t>{1, 1, 1});
+
+    EXPECT_TRUE((check_bwd_matches_naive<3,
+                                         ck::tensor_layout::convolution::GNDHWC,
+                                         ck::tensor_layout::convolution::GKZYXC,
+                                         ck::tensor_layout::convolution::GNDHWK>(conv_param)));
+}
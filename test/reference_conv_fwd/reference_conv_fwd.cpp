@@ -80,6 +80,56 @@ run_reference_convolution_forward(const ck::utils::conv::ConvParam& conv_param,
     return host_output;
 }
 
+template <ck::index_t NDimSpatial, typename InLayout, typename WeiLayout, typename OutLayout>
+bool check_im2col_gemm_matches_naive(const ck::utils::conv::ConvParam& conv_param)
+{
+    using ck::tensor_operation::host::ReferenceConvFwdAlgorithm;
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<InLayout>(conv_param));
+    Tensor<float> weights(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<WeiLayout>(conv_param));
+    Tensor<float> out_naive(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<OutLayout>(
+            conv_param));
+    Tensor<float> out_im2col(out_naive.mDesc);
+
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(input);
+    ck::utils::FillUniformDistribution<float>{-1.f, 1.f}(weights);
+
+    auto ref_conv    = ck::tensor_operation::host::ReferenceConvFwd<NDimSpatial,
+                                                                 float,
+                                                                 float,
+                                                                 float,
+                                                                 InElementOp,
+                                                                 WeiElementOp,
+                                                                 OutElementOp>();
+    auto ref_invoker = ref_conv.MakeInvoker();
+
+    for(auto [algorithm, output] : {std::make_pair(ReferenceConvFwdAlgorithm::Naive, &out_naive),
+                                    std::make_pair(ReferenceConvFwdAlgorithm::Im2colGemm,
+                                                   &out_im2col)})
+    {
+        auto ref_argument = ref_conv.MakeArgument(input,
+                                                  weights,
+                                                  *output,
+                                                  conv_param.conv_filter_strides_,
+                                                  conv_param.conv_filter_dilations_,
+                                                  conv_param.input_left_pads_,
+                                                  conv_param.input_right_pads_,
+                                                  InElementOp{},
+                                                  WeiElementOp{},
+                                                  OutElementOp{},
+                                                  {},
+                                                  {},
+                                                  {},
+                                                  algorithm);
+        ref_invoker.Run(ref_argument);
+    }
+
+    return ck::utils::check_err(out_im2col, out_naive);
+}
+
 } // anonymous namespace
 
 // Eeference convolution assume dimensions of tensor descriptors are in GNCDHW/GKCZYX/GNKDHW order,
@@ -390,3 +440,66 @@ TEST(ReferenceConvolutionFWD, Conv3DGNCDHWStridesDilations)
     EXPECT_TRUE(ck::utils::check_err(
         out_tensor, ref_data, "Error [case 2]: incorrect results!", 1e-4f, 1e-6f));
 }
+
+TEST(ReferenceConvolutionFWD, Im2colGemmMatchesNaive1D)
+{
+    ck::utils::conv::ConvParam conv_param(1,
+                                          2,
+                                          3,
+                                          17,
+                                          5,
+                                          std::vector<ck::index_t>{3},
+                                          std::vector<ck::index_t>{37},
+                                          std::vector<ck::index_t>{2},
+                                          std::vector<ck::index_t>{2},
+                                          std::vector<ck::index_t>{1},
+                                          std::vector<ck::index_t>{2});
+
+    EXPECT_TRUE((check_im2col_gemm_matches_naive<1,
+                                                 ck::tensor_layout::convolution::GNWC,
+                                                 ck::tensor_layout::convolution::GKXC,
+                                                 ck::tensor_layout::convolution::GNWK>(
+        conv_param)));
+}
+
+TEST(ReferenceConvolutionFWD, Im2colGemmMatchesNaive2D)
+{
+    ck::utils::conv::ConvParam conv_param(2,
+                                          2,
+                                          2,
+                                          33,
+                                          7,
+                                          std::vector<ck::index_t>{3, 5},
+                                          std::vector<ck::index_t>{14, 17},
+                                          std::vector<ck::index_t>{1, 2},
+                                          std::vector<ck::index_t>{2, 1},
+                                          std::vector<ck::index_t>{1, 2},
+                                          std::vector<ck::index_t>{1, 2});
+
+    EXPECT_TRUE((check_im2col_gemm_matches_naive<2,
+                                                 ck::tensor_layout::convolution::GNHWC,
+                                                 ck::tensor_layout::convolution::GKYXC,
+                                                 ck::tensor_layout::convolution::GNHWK>(
+        conv_param)));
+}
+
+TEST(ReferenceConvolutionFWD, Im2colGemmMatchesNaive3D)
+{
+    ck::utils::conv::ConvParam conv_param(3,
+                                          1,
+                                          2,
+                                          8,
+                                          3,
+                                          std::vector<ck::index_t>{3, 3, 3},
+                                          std::vector<ck::index_t>{7, 8, 9},
+                                          std::vector<ck::index_t>{2, 2, 1},
+                                          std::vector<ck::index_t>{1, 1, 2},
+                                          std::vector<ck::index_t>{1, 1, 1},
+                                          std::vector<ck::index_t>{1, 1, 1});
+
+    EXPECT_TRUE((check_im2col_gemm_matches_naive<3,
+                                                 ck::tensor_layout::convolution::GNDHWC,
+                                                 ck::tensor_layout::convolution::GKZYXC,
+                                                 ck::tensor_layout::convolution::GNDHWK>(
+        conv_param)));
+}
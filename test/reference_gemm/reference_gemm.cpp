@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_blocked_gemm.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_gemm.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+
+using ck::tensor_operation::host::ReferenceGemmAlgorithm;
+
+HostTensorDescriptor make_descriptor(std::size_t row, std::size_t col, bool row_major)
+{
+    if(row_major)
+        return HostTensorDescriptor({row, col}, {col, std::size_t{1}});
+    else
+        return HostTensorDescriptor({row, col}, {std::size_t{1}, row});
+}
+
+template <typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename AccDataType,
+          typename AElementOp = PassThrough,
+          typename BElementOp = PassThrough>
+std::tuple<Tensor<CDataType>, Tensor<CDataType>>
+run_naive_and_blocked(std::size_t M,
+                      std::size_t N,
+                      std::size_t K,
+                      bool a_row_major,
+                      bool b_row_major,
+                      AElementOp a_op                  = {},
+                      BElementOp b_op                  = {},
+                      ReferenceGemmAlgorithm algorithm = ReferenceGemmAlgorithm::Blocked)
+{
+    Tensor<ADataType> a_m_k(make_descriptor(M, K, a_row_major));
+    Tensor<BDataType> b_k_n(make_descriptor(K, N, b_row_major));
+    Tensor<CDataType> c_naive(make_descriptor(M, N, true));
+    Tensor<CDataType> c_blocked(make_descriptor(M, N, true));
+
+    ck::utils::FillUniformDistributionIntegerValue<ADataType>{-3.f, 3.f}(a_m_k);
+    ck::utils::FillUniformDistribution<BDataType>{-1.f, 1.f}(b_k_n);
+
+    using ReferenceGemm = ck::tensor_operation::host::ReferenceGemm<ADataType,
+                                                                    BDataType,
+                                                                    CDataType,
+                                                                    AccDataType,
+                                                                    AElementOp,
+                                                                    BElementOp,
+                                                                    PassThrough>;
+
+    auto invoker = ReferenceGemm::MakeInvoker();
+
+    auto naive_arg = ReferenceGemm::MakeArgument(
+        a_m_k, b_k_n, c_naive, a_op, b_op, PassThrough{}, ReferenceGemmAlgorithm::Naive);
+    invoker.Run(naive_arg);
+
+    auto blocked_arg =
+        ReferenceGemm::MakeArgument(a_m_k, b_k_n, c_blocked, a_op, b_op, PassThrough{}, algorithm);
+    invoker.Run(blocked_arg);
+
+    return {c_naive, c_blocked};
+}
+
+} // anonymous namespace
+
+// Blocked keeps the k order and the separate multiply and add of the naive loop, so the results
+// are identical
+TEST(ReferenceGemm, BlockedMatchesNaiveF32)
+{
+    for(bool a_row_major : {true, false})
+    {
+        for(bool b_row_major : {true, false})
+        {
+            auto [c_naive, c_blocked] = run_naive_and_blocked<float, float, float, float>(
+                67, 131, 301, a_row_major, b_row_major);
+
+            EXPECT_EQ(c_blocked.mData, c_naive.mData);
+        }
+    }
+}
+
+TEST(ReferenceGemm, BlockedMatchesNaiveF16)
+{
+    auto [c_naive, c_blocked] =
+        run_naive_and_blocked<ck::half_t, ck::half_t, ck::half_t, float>(128, 520, 64, true, false);
+
+    EXPECT_EQ(c_blocked.mData, c_naive.mData);
+}
+
+TEST(ReferenceGemm, BlockedMatchesNaiveI8)
+{
+    auto [c_naive, c_blocked] =
+        run_naive_and_blocked<int8_t, int8_t, int32_t, int32_t>(33, 45, 1000, false, true);
+
+    EXPECT_EQ(c_blocked.mData, c_naive.mData);
+}
+
+TEST(ReferenceGemm, BlockedAppliesElementwiseOps)
+{
+    auto [c_naive, c_blocked] = run_naive_and_blocked<float, float, float, float, Scale, Scale>(
+        17, 19, 23, true, true, Scale{0.5f}, Scale{2.f});
+
+    EXPECT_EQ(c_blocked.mData, c_naive.mData);
+}
+
+TEST(ReferenceGemm, BlockedEmptyK)
+{
+    auto [c_naive, c_blocked] =
+        run_naive_and_blocked<float, float, float, float>(5, 7, 0, true, true);
+
+    EXPECT_EQ(c_blocked.mData, c_naive.mData);
+}
+
+TEST(ReferenceGemm, BlockedMatchesNaiveLongK)
+{
+    using BlockedGemm = ck::utils::HostBlockedGemm<float>;
+
+    // K is longer than the packed B panel, so the accumulators are kept between the K chunks
+    const std::size_t K = 2 * BlockedGemm::PackedBBudget / (BlockedGemm::NC * sizeof(float)) + 3;
+
+    auto [c_naive, c_blocked] =
+        run_naive_and_blocked<float, float, float, float>(5, 7, K, true, false);
+
+    EXPECT_EQ(c_blocked.mData, c_naive.mData);
+}
+
+TEST(ReferenceGemm, BlockedFusedMatchesNaive)
+{
+    // fused multiply-add rounds differently from the naive loop
+    auto [c_naive, c_blocked] = run_naive_and_blocked<float, float, float, float>(
+        67, 131, 301, true, false, {}, {}, ReferenceGemmAlgorithm::BlockedFused);
+
+    EXPECT_TRUE(ck::utils::check_err(c_blocked, c_naive));
+}
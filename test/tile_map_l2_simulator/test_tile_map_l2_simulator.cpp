@@ -0,0 +1,194 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/block_to_ctile_map_schedule.hpp"
+#include "ck/library/utility/host_l2_cache_simulator.hpp"
+
+using ck::utils::CacheConfig;
+using ck::utils::SetAssociativeCache;
+using ck::utils::SimulateTileScheduleCache;
+using ck::utils::TileSchedule;
+using ck::utils::TileScheduleProblem;
+using ck::utils::TileWorkItem;
+
+namespace {
+
+TileScheduleProblem MakeProblem(ck::index_t M, ck::index_t N, ck::index_t K)
+{
+    TileScheduleProblem problem;
+
+    problem.M                     = M;
+    problem.N                     = N;
+    problem.K                     = K;
+    problem.MPerBlock             = 128;
+    problem.NPerBlock             = 128;
+    problem.KPerBlock             = 64;
+    problem.num_concurrent_blocks = 16;
+
+    return problem;
+}
+
+// how often every (m tile, n tile, k iteration) of the problem is computed by schedule
+std::vector<int> CountTileIterations(const TileSchedule& schedule,
+                                     const TileScheduleProblem& problem)
+{
+    const ck::index_t M0        = (problem.M + problem.MPerBlock - 1) / problem.MPerBlock;
+    const ck::index_t N0        = (problem.N + problem.NPerBlock - 1) / problem.NPerBlock;
+    const ck::index_t num_k_itr = (problem.K + problem.KPerBlock - 1) / problem.KPerBlock;
+
+    std::vector<int> counts(M0 * N0 * num_k_itr, 0);
+
+    for(const auto& items : schedule)
+    {
+        for(const auto& item : items)
+        {
+            EXPECT_GE(item.m_tile, 0);
+            EXPECT_LT(item.m_tile, M0);
+            EXPECT_GE(item.n_tile, 0);
+            EXPECT_LT(item.n_tile, N0);
+            EXPECT_GE(item.k_iter_begin, 0);
+            EXPECT_LE(item.k_iter_end, num_k_itr);
+
+            for(auto k = item.k_iter_begin; k < item.k_iter_end; ++k)
+                ++counts[(item.m_tile * N0 + item.n_tile) * num_k_itr + k];
+        }
+    }
+
+    return counts;
+}
+
+} // namespace
+
+TEST(TestTileMapL2Simulator, LruReplacement)
+{
+    // one set of 2 ways
+    SetAssociativeCache cache(CacheConfig{256, 128, 2, false});
+
+    EXPECT_FALSE(cache.Access(0));
+    EXPECT_FALSE(cache.Access(1));
+    EXPECT_TRUE(cache.Access(0));
+    // evicts 1, the least recently used line
+    EXPECT_FALSE(cache.Access(2));
+    EXPECT_TRUE(cache.Access(0));
+    EXPECT_FALSE(cache.Access(1));
+
+    EXPECT_THROW(SetAssociativeCache(CacheConfig{128, 128, 2, false}), std::invalid_argument);
+}
+
+TEST(TestTileMapL2Simulator, ReuseWithinWave)
+{
+    const auto problem = MakeProblem(256, 256, 128);
+
+    // 4 blocks compute the 2 x 2 tiles, A panels are shared along n, B panels along m
+    TileSchedule schedule;
+
+    for(ck::index_t m = 0; m < 2; ++m)
+        for(ck::index_t n = 0; n < 2; ++n)
+            schedule.push_back({TileWorkItem{m, n, 0, 2}});
+
+    const auto result = SimulateTileScheduleCache(schedule, problem, CacheConfig{});
+
+    // every line of A and B comes from DRAM once and is hit once more
+    EXPECT_EQ(result.a_dram_bytes + result.b_dram_bytes, result.compulsory_bytes);
+    EXPECT_EQ(result.num_a_misses * 2, result.num_a_accesses);
+    EXPECT_EQ(result.num_b_misses * 2, result.num_b_accesses);
+    EXPECT_DOUBLE_EQ(result.GetHitRate(), 0.5);
+    EXPECT_EQ(result.c_dram_bytes, 256 * 256 * 2);
+}
+
+TEST(TestTileMapL2Simulator, SmallCacheLosesReuse)
+{
+    auto problem                  = MakeProblem(1024, 1024, 1024);
+    problem.num_concurrent_blocks = 1;
+
+    const ck::BlockToCTileMap_M00_N0_M01Adapt<128, 128> map(problem.M, problem.N, 1);
+
+    const auto schedule = ck::utils::MakeDataParallelTileSchedule(map, problem);
+
+    // row by row, B (2 MiB) has to be re-read for every m tile unless the cache holds all of it
+    const auto small = SimulateTileScheduleCache(schedule, problem, CacheConfig{512 << 10});
+    const auto large = SimulateTileScheduleCache(schedule, problem, CacheConfig{8 << 20});
+
+    EXPECT_EQ(large.a_dram_bytes + large.b_dram_bytes, large.compulsory_bytes);
+    EXPECT_GT(small.b_dram_bytes, 4 * large.b_dram_bytes);
+}
+
+TEST(TestTileMapL2Simulator, DataParallelScheduleCoversTiles)
+{
+    const auto problem = MakeProblem(1000, 700, 300);
+
+    for(const ck::index_t M01 : {1, 3, 4, 8})
+    {
+        const ck::BlockToCTileMap_M00_N0_M01Adapt<128, 128> map(problem.M, problem.N, M01);
+
+        for(const int count :
+            CountTileIterations(ck::utils::MakeDataParallelTileSchedule(map, problem), problem))
+            EXPECT_EQ(count, 1) << "M01 " << M01;
+
+        const ck::BlockToCTileMap_Grouped_M00_N0_M01Adapt<8, 128, 128> grouped_map(
+            problem.M, problem.N, M01);
+
+        for(const int count : CountTileIterations(
+                ck::utils::MakeDataParallelTileSchedule(grouped_map, problem), problem))
+            EXPECT_EQ(count, 1) << "grouped M01 " << M01;
+    }
+}
+
+TEST(TestTileMapL2Simulator, StreamKScheduleCoversTiles)
+{
+    for(const ck::index_t K : {64, 640, 4096})
+    {
+        const auto problem = MakeProblem(1000, 2000, K);
+
+        for(const unsigned num_cu : {7, 64, 304})
+        {
+            const ck::BlockToCTileMap_GemmStreamK<128, 128, 64> map(
+                problem.M, problem.N, problem.K, num_cu, 1);
+
+            for(const int count : CountTileIterations(
+                    ck::utils::MakeStreamKTileSchedule(map, problem), problem))
+                EXPECT_EQ(count, 1) << "K " << K << " CUs " << num_cu;
+        }
+    }
+}
+
+TEST(TestTileMapL2Simulator, SweepPrefersSquareWaveFootprint)
+{
+    auto problem                  = MakeProblem(4096, 4096, 512);
+    problem.num_concurrent_blocks = 64;
+
+    // 64 concurrent 128 x 128 tiles read the fewest panels as an 8 x 8 square, and a row of
+    // 32 tiles plus 32 tiles of the next row needs 2 A panels but 32 B panels
+    const auto results = ck::utils::SweepM01AdaptTileMap<128, 128>(
+        problem, CacheConfig{2 << 20}, std::vector<ck::index_t>{1, 8});
+
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_LT(results[1].result.GetDramBytes(), results[0].result.GetDramBytes());
+    EXPECT_EQ(ck::utils::GetBestTileMapSweepResult(results).M01, 8);
+
+    // the block tile of the problem has to match the map
+    const auto sweep_256x128 = [&] {
+        ck::utils::SweepM01AdaptTileMap<256, 128>(problem, CacheConfig{}, {1});
+    };
+
+    EXPECT_THROW(sweep_256x128(), std::invalid_argument);
+}
+
+TEST(TestTileMapL2Simulator, GroupedSweepChecksBlockTile)
+{
+    const auto problem = MakeProblem(1024, 1024, 256);
+
+    const auto results = ck::utils::SweepGroupedM01AdaptTileMap<8, 128, 128>(
+        problem, CacheConfig{}, std::vector<ck::index_t>{1, 4});
+
+    EXPECT_EQ(results.size(), 2);
+
+    const auto sweep_256x128 = [&] {
+        ck::utils::SweepGroupedM01AdaptTileMap<8, 256, 128>(problem, CacheConfig{}, {1});
+    };
+
+    EXPECT_THROW(sweep_256x128(), std::invalid_argument);
+}
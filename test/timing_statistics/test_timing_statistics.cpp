@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/host_utility/timing_statistics.hpp"
+
+using ck::utility::RunAdaptiveTiming;
+using ck::utility::SummarizeTimings;
+using ck::utility::TimingConfig;
+
+namespace {
+
+// kernel time with relative gaussian noise and occasional launches delayed by a neighbour
+struct SyntheticTimingSource
+{
+    float time_ms;
+    float relative_noise;
+    float outlier_probability = 0;
+    float outlier_scale       = 3;
+
+    std::mt19937 gen{42};
+
+    float operator()()
+    {
+        std::normal_distribution<float> noise(0, relative_noise);
+        std::bernoulli_distribution is_outlier(outlier_probability);
+
+        const float time = time_ms * (1 + noise(gen));
+
+        return is_outlier(gen) ? time * outlier_scale : time;
+    }
+};
+
+} // namespace
+
+TEST(TestTimingStatistics, Summary)
+{
+    std::vector<float> samples{10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+
+    auto summary = SummarizeTimings(samples, TimingConfig{});
+
+    EXPECT_EQ(summary.num_samples, 10);
+    EXPECT_EQ(summary.num_outliers, 0);
+    EXPECT_FLOAT_EQ(summary.median, 5.5f);
+    EXPECT_FLOAT_EQ(summary.mean, 5.5f);
+    EXPECT_FLOAT_EQ(summary.p10, 1.9f);
+    EXPECT_FLOAT_EQ(summary.p90, 9.1f);
+    EXPECT_FLOAT_EQ(summary.min, 1);
+    EXPECT_FLOAT_EQ(summary.max, 10);
+    EXPECT_LE(summary.ci_low, summary.median);
+    EXPECT_GE(summary.ci_high, summary.median);
+
+    // a delayed launch is rejected and does not move the mean
+    samples.push_back(100);
+    summary = SummarizeTimings(samples, TimingConfig{});
+
+    EXPECT_EQ(summary.num_samples, 10);
+    EXPECT_EQ(summary.num_outliers, 1);
+    EXPECT_FLOAT_EQ(summary.mean, 5.5f);
+    EXPECT_FLOAT_EQ(summary.max, 10);
+
+    // identical samples have no outliers and an empty confidence interval
+    summary = SummarizeTimings(std::vector<float>(20, 2.f), TimingConfig{});
+
+    EXPECT_EQ(summary.num_outliers, 0);
+    EXPECT_FLOAT_EQ(summary.GetRelativeCI(), 0);
+    EXPECT_TRUE(summary.converged);
+
+    // but too few samples for the confidence level never converge
+    EXPECT_FALSE(SummarizeTimings(std::vector<float>(2, 2.f), TimingConfig{}).converged);
+    EXPECT_EQ(SummarizeTimings({}, TimingConfig{}).num_samples, 0);
+}
+
+TEST(TestTimingStatistics, AdaptiveSampleCount)
+{
+    TimingConfig config;
+
+    config.min_samples        = 20;
+    config.max_samples        = 500;
+    config.target_relative_ci = 0.01f;
+
+    const auto stable = RunAdaptiveTiming(config, SyntheticTimingSource{1.f, 0.005f});
+    const auto noisy  = RunAdaptiveTiming(config, SyntheticTimingSource{1.f, 0.05f});
+
+    EXPECT_TRUE(stable.converged);
+    EXPECT_EQ(stable.num_launches, config.min_samples);
+    EXPECT_TRUE(noisy.converged);
+    EXPECT_GT(noisy.num_launches, 4 * stable.num_launches);
+    EXPECT_LE(noisy.num_launches, config.max_samples);
+    EXPECT_LE(noisy.GetRelativeCI(), config.target_relative_ci);
+
+    // an unreachable target stops at max_samples
+    config.target_relative_ci = 1e-5f;
+
+    const auto capped = RunAdaptiveTiming(config, SyntheticTimingSource{1.f, 0.05f});
+
+    EXPECT_FALSE(capped.converged);
+    EXPECT_EQ(capped.num_launches, config.max_samples);
+}
+
+TEST(TestTimingStatistics, DetectsSmallRegression)
+{
+    TimingConfig config;
+
+    config.min_samples        = 50;
+    config.max_samples        = 2000;
+    config.target_relative_ci = 0.005f;
+
+    // 3 % slower, with 3 % noise and 5 % of the launches delayed threefold
+    const auto baseline =
+        RunAdaptiveTiming(config, SyntheticTimingSource{1.f, 0.03f, 0.05f});
+    const auto regressed =
+        RunAdaptiveTiming(config, SyntheticTimingSource{1.03f, 0.03f, 0.05f});
+
+    EXPECT_TRUE(baseline.converged);
+    EXPECT_TRUE(regressed.converged);
+    EXPECT_GT(baseline.num_outliers, 0);
+    EXPECT_NEAR(baseline.median, 1.f, 0.01f);
+    EXPECT_NEAR(regressed.median, 1.03f, 0.01f);
+    EXPECT_LT(baseline.ci_high, regressed.ci_low);
+}